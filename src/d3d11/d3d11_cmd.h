@@ -2,6 +2,8 @@
 
 #include "d3d11_include.h"
 
+#include "../dxvk/dxvk_buffer.h"
+
 namespace dxvk {
 
   /**
@@ -13,6 +15,7 @@ namespace dxvk {
   enum class D3D11CmdType {
     DrawIndirect,
     DrawIndirectIndexed,
+    UpdateBuffer,
   };
 
 
@@ -40,4 +43,31 @@ namespace dxvk {
     uint32_t            stride;
   };
 
+
+
+  /**
+   * \brief Buffer update command data
+   * 
+   * Stores ranges of the destination buffer that are
+   * written with data from a single source buffer, so
+   * that consecutive updates to the same buffer can be
+   * performed with one single copy. If no source buffer
+   * is set, the command performs a single small update
+   * using data stored in the CS chunk's payload memory.
+   *
+   * The range array itself also lives in payload memory
+   * and grows on demand, so that the command does not
+   * take up more space in the chunk than necessary.
+   */
+  struct D3D11CmdUpdateBufferData : public D3D11CmdData {
+    constexpr static uint32_t MaxRanges = 64u;
+
+    Rc<DxvkBuffer>      dstBuffer;
+    Rc<DxvkBuffer>      srcBuffer;
+    const void*         srcData;
+    VkBufferCopy*       ranges;
+    uint32_t            rangeCount;
+    uint32_t            rangeCapacity;
+  };
+
 }
\ No newline at end of file
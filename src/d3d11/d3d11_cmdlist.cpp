@@ -60,7 +60,10 @@ namespace dxvk {
     // This will be the chunk ID of the first chunk
     // added, for the purpose of resource tracking.
     uint64_t baseChunkId = m_chunks.size();
-    
+
+    m_chunks.reserve(m_chunks.size() + pCommandList->m_chunks.size());
+    m_resources.reserve(m_resources.size() + pCommandList->m_resources.size());
+
     for (const auto& chunk : pCommandList->m_chunks)
       m_chunks.push_back(chunk);
 
@@ -107,6 +110,40 @@ namespace dxvk {
   }
   
   
+  void D3D11CommandList::Finalize() {
+    // Sequence numbers are overwritten every time a resource is
+    // tracked, and chunks are dispatched in order, so only the
+    // last chunk that uses any given subresource is relevant.
+    // Sort by resource and reverse chunk order to find those.
+    std::sort(m_resources.begin(), m_resources.end(),
+      [] (const TrackedResource& a, const TrackedResource& b) {
+        if (a.ref.Get() != b.ref.Get())
+          return std::less<ID3D11Resource*>()(a.ref.Get(), b.ref.Get());
+
+        if (a.ref.GetSubresource() != b.ref.GetSubresource())
+          return a.ref.GetSubresource() < b.ref.GetSubresource();
+
+        return a.chunkId > b.chunkId;
+      });
+
+    auto end = std::unique(m_resources.begin(), m_resources.end(),
+      [] (const TrackedResource& a, const TrackedResource& b) {
+        return a.ref.Get() == b.ref.Get()
+            && a.ref.GetSubresource() == b.ref.GetSubresource();
+      });
+
+    m_resources.erase(end, m_resources.end());
+
+    // Restore chunk order for EmitToCsThread
+    std::sort(m_resources.begin(), m_resources.end(),
+      [] (const TrackedResource& a, const TrackedResource& b) {
+        return a.chunkId < b.chunkId;
+      });
+
+    m_resources.shrink_to_fit();
+  }
+
+
   void D3D11CommandList::TrackResourceUsage(
           ID3D11Resource*     pResource,
           D3D11_RESOURCE_DIMENSION ResourceType,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 
 #include "d3d11_context.h"
@@ -36,6 +37,17 @@ namespace dxvk {
     void EmitToCsThread(
       const D3D11ChunkDispatchProc& DispatchProc);
 
+    /**
+     * \brief Finalizes command list
+     *
+     * Called once all commands have been recorded. Compacts
+     * the resource tracking table so that each subresource
+     * is only tracked for the last chunk that uses it, which
+     * keeps repeated executions of the same command list
+     * cheap. No resources can be tracked afterwards.
+     */
+    void Finalize();
+
     void TrackResourceUsage(
             ID3D11Resource*     pResource,
             D3D11_RESOURCE_DIMENSION ResourceType,
@@ -3299,10 +3299,13 @@ namespace dxvk {
         pc.rasterizerSampleCount = 1;
     }
 
+    // Only update the sample count, the remaining push
+    // constant data is managed by the backend.
     EmitCs([
-      cPushConstants = pc
+      cSampleCount = pc.rasterizerSampleCount
     ] (DxvkContext* ctx) {
-      ctx->pushConstants(0, sizeof(cPushConstants), &cPushConstants);
+      ctx->pushConstants(offsetof(DxbcPushConstants, rasterizerSampleCount),
+        sizeof(cSampleCount), &cSampleCount);
     });
   }
 
@@ -4473,10 +4476,10 @@ namespace dxvk {
         }
       }
 
-      // Initialize push constants
-      DxbcPushConstants pc;
-      pc.rasterizerSampleCount = 1;
-      ctx->pushConstants(0, sizeof(pc), &pc);
+      // Initialize rasterizer sample count
+      uint32_t sampleCount = 1u;
+      ctx->pushConstants(offsetof(DxbcPushConstants, rasterizerSampleCount),
+        sizeof(sampleCount), &sampleCount);
     });
   }
 
@@ -5103,6 +5106,90 @@ namespace dxvk {
   }
 
 
+  template<typename ContextType>
+  bool D3D11CommonContext<ContextType>::CanMergeBufferUpdate(
+    const D3D11CmdUpdateBufferData*         pCmdData,
+    const DxvkBufferSlice&                  DstSlice) const {
+    if (!pCmdData || pCmdData->type != D3D11CmdType::UpdateBuffer
+     || pCmdData->dstBuffer != DstSlice.buffer()
+     || pCmdData->rangeCount >= D3D11CmdUpdateBufferData::MaxRanges)
+      return false;
+
+    // Ranges may get copied in any order, so we
+    // cannot merge updates that overlap each other
+    for (uint32_t i = 0; i < pCmdData->rangeCount; i++) {
+      const auto& range = pCmdData->ranges[i];
+
+      if (DstSlice.offset() < range.dstOffset + range.size
+       && DstSlice.offset() + DstSlice.length() > range.dstOffset)
+        return false;
+    }
+
+    return true;
+  }
+
+
+  template<typename ContextType>
+  D3D11CmdUpdateBufferData* D3D11CommonContext<ContextType>::EmitUpdateBufferCmd(
+    const Rc<DxvkBuffer>&                   DstBuffer,
+    const Rc<DxvkBuffer>&                   SrcBuffer,
+          uint32_t                          RangeCapacity) {
+    auto cmdData = EmitCsCmd<D3D11CmdUpdateBufferData>(
+      [] (DxvkContext* ctx, const D3D11CmdUpdateBufferData* data) {
+        const auto& range = data->ranges[0];
+
+        if (!data->srcBuffer) {
+          ctx->updateBuffer(data->dstBuffer,
+            range.dstOffset, range.size, data->srcData);
+        } else if (data->rangeCount == 1u) {
+          ctx->copyBuffer(data->dstBuffer, range.dstOffset,
+            data->srcBuffer, range.srcOffset, range.size);
+        } else {
+          ctx->copyBufferRanges(data->dstBuffer, data->srcBuffer,
+            data->rangeCount, data->ranges);
+        }
+      });
+
+    cmdData->type = D3D11CmdType::UpdateBuffer;
+    cmdData->dstBuffer = DstBuffer;
+    cmdData->srcBuffer = SrcBuffer;
+    cmdData->srcData = nullptr;
+
+    // Allocate ranges only after emitting the command since
+    // that may have caused the context to start a new chunk
+    cmdData->ranges = static_cast<VkBufferCopy*>(
+      m_csChunk->allocPayload(RangeCapacity * sizeof(VkBufferCopy)));
+    cmdData->rangeCount = 0u;
+    cmdData->rangeCapacity = RangeCapacity;
+    return cmdData;
+  }
+
+
+  template<typename ContextType>
+  void D3D11CommonContext<ContextType>::AddBufferUpdateRange(
+          D3D11CmdUpdateBufferData*         pCmdData,
+    const VkBufferCopy&                     Range) {
+    if (unlikely(pCmdData->rangeCount == pCmdData->rangeCapacity)) {
+      // Merging only ever happens within the current chunk,
+      // so we can reallocate from the same payload memory.
+      // The old array is freed along with the chunk.
+      uint32_t newCapacity = std::min(pCmdData->rangeCapacity * 2u,
+        D3D11CmdUpdateBufferData::MaxRanges);
+
+      auto newRanges = static_cast<VkBufferCopy*>(
+        m_csChunk->allocPayload(newCapacity * sizeof(VkBufferCopy)));
+
+      std::memcpy(newRanges, pCmdData->ranges,
+        pCmdData->rangeCount * sizeof(VkBufferCopy));
+
+      pCmdData->ranges = newRanges;
+      pCmdData->rangeCapacity = newCapacity;
+    }
+
+    pCmdData->ranges[pCmdData->rangeCount++] = Range;
+  }
+
+
   template<typename ContextType>
   void D3D11CommonContext<ContextType>::UpdateBuffer(
           D3D11Buffer*                      pDstBuffer,
@@ -5113,38 +5200,52 @@ namespace dxvk {
 
     DxvkBufferSlice bufferSlice = pDstBuffer->GetBufferSlice(Offset, Length);
 
-    if (Length <= MaxDirectUpdateSize && !((Offset | Length) & 0x3)) {
+    // If the previous command updated the same buffer, try to append
+    // this update to it so that the backend can perform all of them
+    // with one single copy and one set of barriers.
+    auto cmdData = static_cast<D3D11CmdUpdateBufferData*>(m_cmdData);
+    bool canMerge = CanMergeBufferUpdate(cmdData, bufferSlice);
+
+    if (!canMerge && Length <= MaxDirectUpdateSize && !((Offset | Length) & 0x3)) {
       // The backend has special code paths for small buffer updates,
       // however both offset and size must be aligned to four bytes.
-      std::array<char, MaxDirectUpdateSize> data;
-      std::memcpy(data.data(), pSrcData, Length);
+      // Store the data out of line so that it only gets copied once
+      // and does not take up space in the command chunk itself.
+      cmdData = EmitUpdateBufferCmd(bufferSlice.buffer(), nullptr, 1u);
 
-      EmitCs([
-        cBufferData = data,
-        cBufferSlice = std::move(bufferSlice)
-      ] (DxvkContext* ctx) {
-        ctx->updateBuffer(
-          cBufferSlice.buffer(),
-          cBufferSlice.offset(),
-          cBufferSlice.length(),
-          cBufferData.data());
-      });
+      void* payload = m_csChunk->allocPayload(Length);
+      std::memcpy(payload, pSrcData, Length);
+
+      cmdData->srcData = payload;
+
+      AddBufferUpdateRange(cmdData, { 0u, bufferSlice.offset(), Length });
     } else {
       // Write directly to a staging buffer and dispatch a copy
-      DxvkBufferSlice stagingSlice = AllocStagingBuffer(Length);
+      DxvkBufferSlice stagingSlice;
+
+      if (canMerge && !cmdData->srcBuffer) {
+        // The previous update stores its data inline, move it to
+        // the staging buffer so that both can use a single copy
+        auto& range = cmdData->ranges[0];
+
+        stagingSlice = AllocStagingBuffer(range.size + Length);
+        std::memcpy(stagingSlice.mapPtr(0), cmdData->srcData, range.size);
+
+        cmdData->srcBuffer = stagingSlice.buffer();
+        cmdData->srcData = nullptr;
+        range.srcOffset = stagingSlice.offset();
+
+        stagingSlice = stagingSlice.subSlice(range.size, Length);
+      } else {
+        stagingSlice = AllocStagingBuffer(Length);
+      }
+
       std::memcpy(stagingSlice.mapPtr(0), pSrcData, Length);
 
-      EmitCs([
-        cStagingSlice = std::move(stagingSlice),
-        cBufferSlice  = std::move(bufferSlice)
-      ] (DxvkContext* ctx) {
-        ctx->copyBuffer(
-          cBufferSlice.buffer(),
-          cBufferSlice.offset(),
-          cStagingSlice.buffer(),
-          cStagingSlice.offset(),
-          cBufferSlice.length());
-      });
+      if (!canMerge || cmdData->srcBuffer != stagingSlice.buffer())
+        cmdData = EmitUpdateBufferCmd(bufferSlice.buffer(), stagingSlice.buffer(), 4u);
+
+      AddBufferUpdateRange(cmdData, { stagingSlice.offset(), bufferSlice.offset(), Length });
     }
 
     if (pDstBuffer->HasSequenceNumber())
@@ -1033,6 +1033,19 @@ namespace dxvk {
     void TrackResourceSequenceNumber(
             ID3D11Resource*                   pResource);
 
+    bool CanMergeBufferUpdate(
+      const D3D11CmdUpdateBufferData*         pCmdData,
+      const DxvkBufferSlice&                  DstSlice) const;
+
+    D3D11CmdUpdateBufferData* EmitUpdateBufferCmd(
+      const Rc<DxvkBuffer>&                   DstBuffer,
+      const Rc<DxvkBuffer>&                   SrcBuffer,
+            uint32_t                          RangeCapacity);
+
+    void AddBufferUpdateRange(
+            D3D11CmdUpdateBufferData*         pCmdData,
+      const VkBufferCopy&                     Range);
+
     void UpdateBuffer(
             D3D11Buffer*                      pDstBuffer,
             UINT                              Offset,
@@ -173,7 +173,9 @@ namespace dxvk {
 
     // Make sure all commands are visible to the command list
     FlushCsChunk();
-    
+
+    m_commandList->Finalize();
+
     if (ppCommandList)
       *ppCommandList = m_commandList.ref();
 
@@ -48,7 +48,7 @@ namespace dxvk {
       InitTiledTexture(pTexture);
     else if (pTexture->GetMapMode() == D3D11_COMMON_TEXTURE_MAP_MODE_DIRECT)
       InitHostVisibleTexture(pTexture, pInitialData);
-    else
+    else if (!InitHostCopyTexture(pTexture, pInitialData))
       InitDeviceLocalTexture(pTexture, pInitialData);
 
     SyncSharedTexture(pTexture);
@@ -80,14 +80,21 @@ namespace dxvk {
   void D3D11Initializer::InitDeviceLocalBuffer(
           D3D11Buffer*                pBuffer,
     const D3D11_SUBRESOURCE_DATA*     pInitialData) {
-    std::lock_guard<dxvk::mutex> lock(m_mutex);
-
     Rc<DxvkBuffer> buffer = pBuffer->GetBuffer();
 
     if (pInitialData != nullptr && pInitialData->pSysMem != nullptr) {
-      auto stagingSlice = m_stagingBuffer.alloc(buffer->info().size);
+      DxvkBufferSlice stagingSlice;
+
+      { std::lock_guard<dxvk::mutex> lock(m_mutex);
+        stagingSlice = m_stagingBuffer.alloc(buffer->info().size);
+      }
+
+      // Staging slices keep the underlying buffer alive, so copy
+      // the data without holding the lock in case another thread
+      // flushes and resets the staging buffer in the meantime.
       std::memcpy(stagingSlice.mapPtr(0), pInitialData->pSysMem, stagingSlice.length());
 
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
       m_transferCommands += 1;
 
       EmitCs([
@@ -98,7 +105,10 @@ namespace dxvk {
           cStagingSlice.buffer(),
           cStagingSlice.offset());
       });
+
+      ThrottleAllocationLocked();
     } else {
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
       m_transferCommands += 1;
 
       EmitCs([
@@ -106,9 +116,9 @@ namespace dxvk {
       ] (DxvkContext* ctx) {
         ctx->initBuffer(cBuffer);
       });
-    }
 
-    ThrottleAllocationLocked();
+      ThrottleAllocationLocked();
+    }
   }
 
 
@@ -128,8 +138,6 @@ namespace dxvk {
   void D3D11Initializer::InitDeviceLocalTexture(
           D3D11CommonTexture*         pTexture,
     const D3D11_SUBRESOURCE_DATA*     pInitialData) {
-    std::lock_guard<dxvk::mutex> lock(m_mutex);
-    
     // Image migt be null if this is a staging resource
     Rc<DxvkImage> image = pTexture->GetImage();
     auto desc = pTexture->Desc();
@@ -149,11 +157,14 @@ namespace dxvk {
             packedFormat, image->mipLevelExtent(mip), formatInfo->aspectMask), CACHE_LINE_SIZE);
         }
 
+        std::lock_guard<dxvk::mutex> lock(m_mutex);
         stagingSlice = m_stagingBuffer.alloc(dataSize);
       }
 
       // Copy initial data for each subresource into the staging buffer,
-      // as well as the mapped per-subresource buffers if available.
+      // as well as the mapped per-subresource buffers if available. This
+      // is the expensive part, so do it without holding the lock in order
+      // to allow multiple threads to initialize resources in parallel.
       VkDeviceSize dataOffset = 0u;
 
       for (uint32_t mip = 0; mip < desc->MipLevels; mip++) {
@@ -165,8 +176,6 @@ namespace dxvk {
             VkDeviceSize mipSizePerLayer = util::computeImageDataSize(
               packedFormat, image->mipLevelExtent(mip), formatInfo->aspectMask);
 
-            m_transferCommands += 1;
-
             util::packImageData(stagingSlice.mapPtr(dataOffset),
               pInitialData[index].pSysMem, pInitialData[index].SysMemPitch, pInitialData[index].SysMemSlicePitch,
               0, 0, pTexture->GetVkImageType(), mipLevelExtent, 1, formatInfo, formatInfo->aspectMask);
@@ -183,7 +192,11 @@ namespace dxvk {
       }
 
       // Upload all subresources of the image in one go
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
+
       if (pTexture->HasImage()) {
+        m_transferCommands += pTexture->CountSubresources();
+
         EmitCs([
           cImage        = std::move(image),
           cStagingSlice = std::move(stagingSlice),
@@ -195,7 +208,18 @@ namespace dxvk {
             CACHE_LINE_SIZE, cFormat);
         });
       }
+
+      ThrottleAllocationLocked();
     } else {
+      if (pTexture->HasPersistentBuffers()) {
+        for (uint32_t i = 0; i < pTexture->CountSubresources(); i++) {
+          auto layout = pTexture->GetSubresourceLayout(formatInfo->aspectMask, i);
+          std::memset(pTexture->GetMapPtr(i, layout.Offset), 0, layout.Size);
+        }
+      }
+
+      std::lock_guard<dxvk::mutex> lock(m_mutex);
+
       if (pTexture->HasImage()) {
         m_transferCommands += 1;
         
@@ -211,15 +235,8 @@ namespace dxvk {
         });
       }
 
-      if (pTexture->HasPersistentBuffers()) {
-        for (uint32_t i = 0; i < pTexture->CountSubresources(); i++) {
-          auto layout = pTexture->GetSubresourceLayout(formatInfo->aspectMask, i);
-          std::memset(pTexture->GetMapPtr(i, layout.Offset), 0, layout.Size);
-        }
-      }
+      ThrottleAllocationLocked();
     }
-
-    ThrottleAllocationLocked();
   }
 
 
@@ -288,6 +305,60 @@ namespace dxvk {
   }
 
 
+  bool D3D11Initializer::InitHostCopyTexture(
+          D3D11CommonTexture*         pTexture,
+    const D3D11_SUBRESOURCE_DATA*     pInitialData) {
+    if (!pInitialData || !pInitialData->pSysMem || !pTexture->HasImage())
+      return false;
+
+    Rc<DxvkImage> image = pTexture->GetImage();
+
+    if (!(image->info().usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT))
+      return false;
+
+    auto desc = pTexture->Desc();
+    auto formatInfo = image->formatInfo();
+
+    small_vector<VkMemoryToImageCopyEXT, 16> regions;
+
+    for (uint32_t layer = 0; layer < desc->ArraySize; layer++) {
+      for (uint32_t mip = 0; mip < desc->MipLevels; mip++) {
+        uint32_t index = D3D11CalcSubresource(mip, layer, desc->MipLevels);
+        const auto& initialData = pInitialData[index];
+
+        VkMemoryToImageCopyEXT region = { VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT };
+        region.pHostPointer = initialData.pSysMem;
+        region.imageSubresource = { formatInfo->aspectMask, mip, layer, 1u };
+        region.imageExtent = image->mipLevelExtent(mip);
+
+        // Host copies take row length and image height in texels, so
+        // fall back to the regular path if the pitch is not a multiple
+        // of the block size. Pitches are ignored for 1D textures.
+        if (pTexture->GetVkImageType() != VK_IMAGE_TYPE_1D) {
+          if (initialData.SysMemPitch % formatInfo->elementSize)
+            return false;
+
+          region.memoryRowLength = initialData.SysMemPitch / formatInfo->elementSize * formatInfo->blockSize.width;
+        }
+
+        if (pTexture->GetVkImageType() == VK_IMAGE_TYPE_3D) {
+          if (!initialData.SysMemPitch || initialData.SysMemSlicePitch % initialData.SysMemPitch)
+            return false;
+
+          region.memoryImageHeight = initialData.SysMemSlicePitch / initialData.SysMemPitch * formatInfo->blockSize.height;
+        }
+
+        regions.push_back(region);
+      }
+    }
+
+    // The image was just created and is not used anywhere
+    // else yet, so we can write it without synchronization.
+    image->initFromMemory(regions.size(), regions.data());
+    return true;
+  }
+
+
   void D3D11Initializer::InitTiledTexture(
           D3D11CommonTexture*         pTexture) {
     std::lock_guard<dxvk::mutex> lock(m_mutex);
@@ -88,6 +88,10 @@ namespace dxvk {
             D3D11CommonTexture*         pTexture,
       const D3D11_SUBRESOURCE_DATA*     pInitialData);
 
+    bool InitHostCopyTexture(
+            D3D11CommonTexture*         pTexture,
+      const D3D11_SUBRESOURCE_DATA*     pInitialData);
+
     void InitTiledTexture(
             D3D11CommonTexture*         pTexture);
 
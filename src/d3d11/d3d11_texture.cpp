@@ -221,6 +221,31 @@ namespace dxvk {
     if (imageInfo.tiling == VK_IMAGE_TILING_OPTIMAL && !isMultiPlane && imageInfo.sharing.mode == DxvkSharedHandleMode::None)
       imageInfo.layout = OptimizeLayout(imageInfo.usage);
 
+    // Let GenerateMips use the single-pass compute path if possible. Do
+    // this after picking the layout, since render targets should not use
+    // the general layout just because mip generation temporarily needs it.
+    if ((m_desc.MiscFlags & D3D11_RESOURCE_MISC_GENERATE_MIPS)
+     && !(imageInfo.usage & VK_IMAGE_USAGE_STORAGE_BIT)
+     && m_device->GetDXVKDevice()->canUseComputeMipGen(imageInfo)) {
+      imageInfo.usage  |= VK_IMAGE_USAGE_STORAGE_BIT;
+      imageInfo.stages |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+      imageInfo.access |= VK_ACCESS_SHADER_READ_BIT
+                       |  VK_ACCESS_SHADER_WRITE_BIT;
+
+      if (imageInfo.flags & VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT)
+        imageInfo.flags |= VK_IMAGE_CREATE_EXTENDED_USAGE_BIT;
+    }
+
+    // Immutable textures are written exactly once on creation, so
+    // initialize them on the host if we can in order to avoid any
+    // staging memory and GPU copies. This is limited to formats
+    // that do not need any repacking of the initial data.
+    if (m_desc.Usage == D3D11_USAGE_IMMUTABLE && m_mapMode == D3D11_COMMON_TEXTURE_MAP_MODE_NONE
+     && isColorFormat && !isMultiPlane && formatInfo.Format == m_packedFormat
+     && imageInfo.sampleCount == VK_SAMPLE_COUNT_1_BIT
+     && m_device->GetDXVKDevice()->canUseHostImageCopy(imageInfo))
+      imageInfo.usage |= VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT;
+
     // Check if we can actually create the image
     if (!CheckImageSupport(&imageInfo, imageInfo.tiling)) {
       throw DxvkError(str::format(
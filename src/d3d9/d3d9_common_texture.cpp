@@ -428,6 +428,19 @@ namespace dxvk {
     if (imageInfo.tiling == VK_IMAGE_TILING_OPTIMAL && imageInfo.sharing.mode == DxvkSharedHandleMode::None)
       imageInfo.layout = OptimizeLayout(imageInfo.usage);
 
+    // Let automatic mip generation use the single-pass compute path if
+    // possible. Do this after picking the layout, since render targets
+    // should not use the general layout just because of mip generation.
+    if (isAutoGen && !(imageInfo.usage & VK_IMAGE_USAGE_STORAGE_BIT)
+     && m_device->GetDXVKDevice()->canUseComputeMipGen(imageInfo)) {
+      imageInfo.usage  |= VK_IMAGE_USAGE_STORAGE_BIT;
+      imageInfo.stages |= VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+      imageInfo.access |= VK_ACCESS_SHADER_WRITE_BIT;
+
+      if (imageInfo.flags & VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT)
+        imageInfo.flags |= VK_IMAGE_CREATE_EXTENDED_USAGE_BIT;
+    }
+
     // Check if we can actually create the image
     if (!CheckImageSupport(&imageInfo, imageInfo.tiling)) {
       throw DxvkError(str::format(
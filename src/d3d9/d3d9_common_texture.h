@@ -9,6 +9,7 @@
 #include "../dxvk/dxvk_device.h"
 
 #include "../util/util_bit.h"
+#include "../util/util_lru.h"
 
 namespace dxvk {
 
@@ -238,6 +239,24 @@ namespace dxvk {
       m_data.Unmap();
     }
 
+    /**
+     * \brief Moves data to compressed storage
+     *
+     * Falls back to unmapping the data if it does not
+     * compress well. Decompressed on the next access.
+     */
+    void CompressData() {
+      if (!m_data.Compress())
+        m_data.Unmap();
+    }
+
+    /**
+     * \brief Link in the device's list of mapped textures
+     */
+    lru_list_link<D3D9CommonTexture>& GetMappedTextureLink() {
+      return m_mappedTextureLink;
+    }
+
     /**
      * \brief Destroys a buffer
      * Destroys mapping and staging buffers for a given subresource
@@ -502,6 +521,9 @@ namespace dxvk {
     Rc<DxvkBuffer>                m_buffer;
     D3D9Memory                    m_data = { };
 
+    lru_list_link<
+      D3D9CommonTexture>          m_mappedTextureLink;
+
     D3D9SubresourceArray<
       uint64_t>                   m_seqs = { };
 
@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include "../util/util_bit.h"
+
+#include "d3d9_convert_cpu.h"
+
+namespace dxvk {
+
+  // Mirrors g_yuv_to_rgb in d3d9_convert_common.h, including its
+  // integer divisions, so that both paths give the same results.
+  // Each row holds the coefficients for one output channel.
+  static const float g_yuvToRgb[3][4] = {
+    { 298 / 256,  0,          409 / 256, 0.5f },
+    { 298 / 256, -100 / 256, -208 / 256, 0.5f },
+    { 298 / 256,  516 / 256,  0,         0.5f },
+  };
+
+  // Mirrors g_bt709_to_rgb in d3d9_convert_common.h.
+  // Each row holds the coefficients for one output channel.
+  static const float g_bt709ToRgb[3][3] = {
+    { 1.164f,  0.0f,    1.793f },
+    { 1.164f, -0.213f, -0.533f },
+    { 1.164f,  2.112f,  0.0f   },
+  };
+
+
+  static float Unormalize(uint32_t value, uint32_t bits) {
+    return float(value) / float((1u << bits) - 1u);
+  }
+
+
+  static float Snormalize(int32_t value, uint32_t bits) {
+    return std::max(float(value) / float((1 << (bits - 1u)) - 1), -1.0f);
+  }
+
+
+  static int32_t ExtractSigned(uint32_t value, uint32_t offset, uint32_t bits) {
+    return int32_t(value << (32u - offset - bits)) >> (32u - bits);
+  }
+
+
+  static uint32_t PackUnorm8(float value) {
+    return uint32_t(std::lrint(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+  }
+
+
+  static uint16_t PackSnorm16(float value) {
+    return uint16_t(int16_t(std::lrint(std::clamp(value, -1.0f, 1.0f) * 32767.0f)));
+  }
+
+
+  static uint16_t PackHalf(float value) {
+    // All converted values are either zero or larger than the
+    // smallest normal half in magnitude, and never exceed 1.0,
+    // so denormals, infinities and NaN need not be handled.
+    // Rounds to nearest even, unlike some drivers' image stores.
+    uint32_t bits = bit::cast<uint32_t>(value);
+    uint32_t sign = (bits >> 16u) & 0x8000u;
+    uint32_t abs  = bits & 0x7fffffffu;
+
+    if (abs < 0x38800000u)
+      return sign;
+
+    abs += 0xfffu + ((abs >> 13u) & 1u);
+    return sign | ((abs - 0x38000000u) >> 13u);
+  }
+
+
+  static void StorePixel(uint8_t* dst, uint16_t r, uint16_t g, uint16_t b, uint16_t a) {
+    std::array<uint16_t, 4> data = { r, g, b, a };
+    std::memcpy(dst, data.data(), sizeof(data));
+  }
+
+
+  static void ConvertPixelYUY2(uint8_t* dst, uint32_t value, bool uyvy) {
+    std::array<float, 4> data = { };
+
+    for (uint32_t i = 0; i < 4; i++)
+      data[i] = float((value >> (8u * i)) & 0xffu) / 255.0f;
+
+    if (uyvy) {
+      std::swap(data[0], data[1]);
+      std::swap(data[2], data[3]);
+    }
+
+    float y0 = data[0] - (16.0f  / 255.0f);
+    float u  = data[1] - (128.0f / 255.0f);
+    float y1 = data[2] - (16.0f  / 255.0f);
+    float v  = data[3] - (128.0f / 255.0f);
+
+    std::array<float, 2> y = { y0, y1 };
+
+    for (uint32_t i = 0; i < 2; i++) {
+      std::array<uint32_t, 3> rgb = { };
+
+      for (uint32_t c = 0; c < 3; c++) {
+        rgb[c] = PackUnorm8(y[i] * g_yuvToRgb[c][0] + u * g_yuvToRgb[c][1]
+          + v * g_yuvToRgb[c][2] + (1.0f / 255.0f) * g_yuvToRgb[c][3]);
+      }
+
+      // Destination format is B8G8R8A8
+      uint32_t pixel = rgb[2] | (rgb[1] << 8u) | (rgb[0] << 16u) | (0xffu << 24u);
+      std::memcpy(dst + 4u * i, &pixel, sizeof(pixel));
+    }
+  }
+
+
+  static uint32_t ConvertPixelBT709(float y, float u, float v) {
+    std::array<uint32_t, 3> rgb = { };
+
+    for (uint32_t c = 0; c < 3; c++)
+      rgb[c] = PackUnorm8(y * g_bt709ToRgb[c][0] + u * g_bt709ToRgb[c][1] + v * g_bt709ToRgb[c][2]);
+
+    // Destination format is B8G8R8A8
+    return rgb[2] | (rgb[1] << 8u) | (rgb[0] << 16u) | (0xffu << 24u);
+  }
+
+
+  static void ConvertPixelL6V5U5(uint8_t* dst, uint32_t value) {
+    StorePixel(dst,
+      PackHalf(Snormalize(ExtractSigned(value, 0, 5), 5)),
+      PackHalf(Snormalize(ExtractSigned(value, 5, 5), 5)),
+      PackHalf(Unormalize(bit::extract(value, 10, 15), 6)),
+      PackHalf(1.0f));
+  }
+
+
+  static void ConvertPixelX8L8V8U8(uint8_t* dst, uint32_t value) {
+    StorePixel(dst,
+      PackHalf(Snormalize(ExtractSigned(value, 0, 8), 8)),
+      PackHalf(Snormalize(ExtractSigned(value, 8, 8), 8)),
+      PackHalf(Unormalize(bit::extract(value, 16, 23), 8)),
+      PackHalf(1.0f));
+  }
+
+
+  static void ConvertPixelA2W10V10U10(uint8_t* dst, uint32_t value) {
+    StorePixel(dst,
+      PackHalf(Snormalize(ExtractSigned(value, 0,  10), 10)),
+      PackHalf(Snormalize(ExtractSigned(value, 10, 10), 10)),
+      PackHalf(Snormalize(ExtractSigned(value, 20, 10), 10)),
+      PackHalf(Unormalize(bit::extract(value, 30, 31), 2)));
+  }
+
+
+  static void ConvertPixelW11V11U10(uint8_t* dst, uint32_t value) {
+    // The shader normalizes all components to 10 bits
+    StorePixel(dst,
+      PackSnorm16(Snormalize(ExtractSigned(value, 0,  10), 10)),
+      PackSnorm16(Snormalize(ExtractSigned(value, 10, 11), 10)),
+      PackSnorm16(Snormalize(ExtractSigned(value, 21, 11), 10)),
+      PackSnorm16(1.0f));
+  }
+
+
+#ifdef DXVK_ARCH_X86
+  template<uint32_t Offset, uint32_t Bits, uint32_t NormBits = Bits>
+  static __m128 SnormalizeSse(__m128i value) {
+    __m128i v = _mm_srai_epi32(_mm_slli_epi32(value, 32u - Offset - Bits), 32u - Bits);
+    __m128 f = _mm_div_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(float((1u << (NormBits - 1u)) - 1u)));
+    return _mm_max_ps(f, _mm_set1_ps(-1.0f));
+  }
+
+
+  template<uint32_t Offset, uint32_t Bits>
+  static __m128 UnormalizeSse(__m128i value) {
+    __m128i v = _mm_and_si128(_mm_srli_epi32(value, Offset), _mm_set1_epi32((1u << Bits) - 1u));
+    return _mm_div_ps(_mm_cvtepi32_ps(v), _mm_set1_ps(float((1u << Bits) - 1u)));
+  }
+
+
+  static __m128i PackUnorm8Sse(__m128 value) {
+    value = _mm_min_ps(_mm_max_ps(value, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(255.0f)));
+  }
+
+
+  static __m128i PackSnorm16Sse(__m128 value) {
+    value = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f));
+    __m128i result = _mm_cvtps_epi32(_mm_mul_ps(value, _mm_set1_ps(32767.0f)));
+    return _mm_and_si128(result, _mm_set1_epi32(0xffff));
+  }
+
+
+  static __m128i PackHalfSse(__m128 value) {
+    // Same constraints as the scalar version
+    __m128i bits = _mm_castps_si128(value);
+    __m128i sign = _mm_and_si128(_mm_srli_epi32(bits, 16), _mm_set1_epi32(0x8000));
+    __m128i abs  = _mm_and_si128(bits, _mm_set1_epi32(0x7fffffff));
+    __m128i zero = _mm_cmplt_epi32(abs, _mm_set1_epi32(0x38800000));
+
+    __m128i round = _mm_and_si128(_mm_srli_epi32(abs, 13), _mm_set1_epi32(1));
+    abs = _mm_add_epi32(abs, _mm_add_epi32(round, _mm_set1_epi32(0xfff)));
+    abs = _mm_srli_epi32(_mm_sub_epi32(abs, _mm_set1_epi32(0x38000000)), 13);
+
+    return _mm_or_si128(sign, _mm_andnot_si128(zero, abs));
+  }
+
+
+  static void StorePixelsSse(uint8_t* dst, __m128i r, __m128i g, __m128i b, __m128i a) {
+    // Components are 16-bit values in 32-bit lanes
+    __m128i rg = _mm_or_si128(r, _mm_slli_epi32(g, 16));
+    __m128i ba = _mm_or_si128(b, _mm_slli_epi32(a, 16));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst +  0), _mm_unpacklo_epi32(rg, ba));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 16), _mm_unpackhi_epi32(rg, ba));
+  }
+
+
+  static __m128i ConvertYUVSse(__m128 y, __m128 u, __m128 v) {
+    __m128i rgb[3];
+
+    for (uint32_t c = 0; c < 3; c++) {
+      __m128 value = _mm_mul_ps(y, _mm_set1_ps(g_yuvToRgb[c][0]));
+      value = _mm_add_ps(value, _mm_mul_ps(u, _mm_set1_ps(g_yuvToRgb[c][1])));
+      value = _mm_add_ps(value, _mm_mul_ps(v, _mm_set1_ps(g_yuvToRgb[c][2])));
+      value = _mm_add_ps(value, _mm_set1_ps((1.0f / 255.0f) * g_yuvToRgb[c][3]));
+      rgb[c] = PackUnorm8Sse(value);
+    }
+
+    return _mm_or_si128(_mm_or_si128(rgb[2], _mm_slli_epi32(rgb[1], 8)),
+      _mm_or_si128(_mm_slli_epi32(rgb[0], 16), _mm_set1_epi32(int32_t(0xff000000u))));
+  }
+#endif
+
+
+  static void ConvertRowYUY2(uint8_t* dst, const uint8_t* src, uint32_t width, bool uyvy, bool simd) {
+    uint32_t count = width / 2u;
+    uint32_t i = 0;
+
+#ifdef DXVK_ARCH_X86
+    for ( ; simd && i + 4u <= count; i += 4u) {
+      __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4u * i));
+
+      __m128 data[4];
+
+      data[0] = UnormalizeSse<0,  8>(value);
+      data[1] = UnormalizeSse<8,  8>(value);
+      data[2] = UnormalizeSse<16, 8>(value);
+      data[3] = UnormalizeSse<24, 8>(value);
+
+      if (uyvy) {
+        std::swap(data[0], data[1]);
+        std::swap(data[2], data[3]);
+      }
+
+      __m128 y0 = _mm_sub_ps(data[0], _mm_set1_ps(16.0f  / 255.0f));
+      __m128 u  = _mm_sub_ps(data[1], _mm_set1_ps(128.0f / 255.0f));
+      __m128 y1 = _mm_sub_ps(data[2], _mm_set1_ps(16.0f  / 255.0f));
+      __m128 v  = _mm_sub_ps(data[3], _mm_set1_ps(128.0f / 255.0f));
+
+      __m128i color0 = ConvertYUVSse(y0, u, v);
+      __m128i color1 = ConvertYUVSse(y1, u, v);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8u * i +  0), _mm_unpacklo_epi32(color0, color1));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 8u * i + 16), _mm_unpackhi_epi32(color0, color1));
+    }
+#endif
+
+    for ( ; i < count; i++) {
+      uint32_t value;
+      std::memcpy(&value, src + 4u * i, sizeof(value));
+      ConvertPixelYUY2(dst + 8u * i, value, uyvy);
+    }
+
+    // Odd widths end in a partial macropixel
+    if (width & 1u) {
+      uint32_t value;
+      std::memcpy(&value, src + 4u * count, sizeof(value));
+
+      std::array<uint8_t, 8> pixels;
+      ConvertPixelYUY2(pixels.data(), value, uyvy);
+      std::memcpy(dst + 8u * count, pixels.data(), 4u);
+    }
+  }
+
+
+  static void ConvertRowL6V5U5(uint8_t* dst, const uint8_t* src, uint32_t width, bool simd) {
+    uint32_t i = 0;
+
+#ifdef DXVK_ARCH_X86
+    for ( ; simd && i + 4u <= width; i += 4u) {
+      __m128i value = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 2u * i));
+      value = _mm_unpacklo_epi16(value, _mm_setzero_si128());
+
+      StorePixelsSse(dst + 8u * i,
+        PackHalfSse(SnormalizeSse<0, 5>(value)),
+        PackHalfSse(SnormalizeSse<5, 5>(value)),
+        PackHalfSse(UnormalizeSse<10, 6>(value)),
+        PackHalfSse(_mm_set1_ps(1.0f)));
+    }
+#endif
+
+    for ( ; i < width; i++) {
+      uint16_t value;
+      std::memcpy(&value, src + 2u * i, sizeof(value));
+      ConvertPixelL6V5U5(dst + 8u * i, value);
+    }
+  }
+
+
+  static void ConvertRowX8L8V8U8(uint8_t* dst, const uint8_t* src, uint32_t width, bool simd) {
+    uint32_t i = 0;
+
+#ifdef DXVK_ARCH_X86
+    for ( ; simd && i + 4u <= width; i += 4u) {
+      __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4u * i));
+
+      StorePixelsSse(dst + 8u * i,
+        PackHalfSse(SnormalizeSse<0, 8>(value)),
+        PackHalfSse(SnormalizeSse<8, 8>(value)),
+        PackHalfSse(UnormalizeSse<16, 8>(value)),
+        PackHalfSse(_mm_set1_ps(1.0f)));
+    }
+#endif
+
+    for ( ; i < width; i++) {
+      uint32_t value;
+      std::memcpy(&value, src + 4u * i, sizeof(value));
+      ConvertPixelX8L8V8U8(dst + 8u * i, value);
+    }
+  }
+
+
+  static void ConvertRowA2W10V10U10(uint8_t* dst, const uint8_t* src, uint32_t width, bool simd) {
+    uint32_t i = 0;
+
+#ifdef DXVK_ARCH_X86
+    for ( ; simd && i + 4u <= width; i += 4u) {
+      __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4u * i));
+
+      StorePixelsSse(dst + 8u * i,
+        PackHalfSse(SnormalizeSse<0,  10>(value)),
+        PackHalfSse(SnormalizeSse<10, 10>(value)),
+        PackHalfSse(SnormalizeSse<20, 10>(value)),
+        PackHalfSse(UnormalizeSse<30, 2>(value)));
+    }
+#endif
+
+    for ( ; i < width; i++) {
+      uint32_t value;
+      std::memcpy(&value, src + 4u * i, sizeof(value));
+      ConvertPixelA2W10V10U10(dst + 8u * i, value);
+    }
+  }
+
+
+  static void ConvertRowW11V11U10(uint8_t* dst, const uint8_t* src, uint32_t width, bool simd) {
+    uint32_t i = 0;
+
+#ifdef DXVK_ARCH_X86
+    for ( ; simd && i + 4u <= width; i += 4u) {
+      __m128i value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 4u * i));
+
+      StorePixelsSse(dst + 8u * i,
+        PackSnorm16Sse(SnormalizeSse<0,  10>(value)),
+        PackSnorm16Sse(SnormalizeSse<10, 11, 10>(value)),
+        PackSnorm16Sse(SnormalizeSse<21, 11, 10>(value)),
+        PackSnorm16Sse(_mm_set1_ps(1.0f)));
+    }
+#endif
+
+    for ( ; i < width; i++) {
+      uint32_t value;
+      std::memcpy(&value, src + 4u * i, sizeof(value));
+      ConvertPixelW11V11U10(dst + 8u * i, value);
+    }
+  }
+
+
+  void ConvertFormatRowCpu(
+          D3D9CpuConversion conversion,
+          uint8_t*          dst,
+    const uint8_t*          src,
+          uint32_t          width,
+          bool              simd) {
+    switch (conversion) {
+      case D3D9CpuConversion::YUY2:
+      case D3D9CpuConversion::UYVY:
+        ConvertRowYUY2(dst, src, width, conversion == D3D9CpuConversion::UYVY, simd);
+        break;
+
+      case D3D9CpuConversion::L6V5U5:
+        ConvertRowL6V5U5(dst, src, width, simd);
+        break;
+
+      case D3D9CpuConversion::X8L8V8U8:
+        ConvertRowX8L8V8U8(dst, src, width, simd);
+        break;
+
+      case D3D9CpuConversion::A2W10V10U10:
+        ConvertRowA2W10V10U10(dst, src, width, simd);
+        break;
+
+      case D3D9CpuConversion::W11V11U10:
+        ConvertRowW11V11U10(dst, src, width, simd);
+        break;
+
+      case D3D9CpuConversion::NV12:
+      case D3D9CpuConversion::YV12:
+        // Planar formats need more than one source row
+        break;
+    }
+  }
+
+
+  void ConvertPlanarRowCpu(
+          D3D9CpuConversion conversion,
+          uint8_t*          dst,
+    const uint8_t*          luma,
+    const uint8_t*          chroma0,
+    const uint8_t*          chroma1,
+          uint32_t          width) {
+    for (uint32_t i = 0; i < width; i++) {
+      float y = float(luma[i]) / 255.0f - (16.0f / 255.0f);
+      float u, v;
+
+      if (conversion == D3D9CpuConversion::NV12) {
+        u = float(chroma0[i & ~1u]) / 255.0f - (128.0f / 255.0f);
+        v = float(chroma0[i |  1u]) / 255.0f - (128.0f / 255.0f);
+      } else {
+        v = float(chroma0[i / 2u]) / 255.0f - (128.0f / 255.0f);
+        u = float(chroma1[i / 2u]) / 255.0f - (128.0f / 255.0f);
+      }
+
+      uint32_t pixel = ConvertPixelBT709(y, u, v);
+      std::memcpy(dst + 4u * i, &pixel, sizeof(pixel));
+    }
+  }
+
+}
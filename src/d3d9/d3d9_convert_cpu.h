@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+
+namespace dxvk {
+
+  /**
+   * \brief CPU format conversion
+   *
+   * Subset of the compute shader format
+   * conversions that can run on the CPU.
+   */
+  enum class D3D9CpuConversion : uint32_t {
+    YUY2,
+    UYVY,
+    L6V5U5,
+    X8L8V8U8,
+    A2W10V10U10,
+    W11V11U10,
+    NV12,
+    YV12,
+  };
+
+  /**
+   * \brief Converts one row of texels on the CPU
+   *
+   * Follows the math of the compute shaders. YUY2 and UYVY
+   * produce B8G8R8A8 texels, W11V11U10 produces RGBA16 snorm
+   * texels, all other conversions produce RGBA16F texels.
+   *
+   * Half-float values are rounded to nearest even. Image stores
+   * to RGBA16F may round toward zero on some drivers, in which
+   * case the compute shaders can differ by one ulp.
+   * \param [in] conversion Conversion to perform
+   * \param [out] dst Destination texels
+   * \param [in] src Source texels
+   * \param [in] width Row width, in pixels
+   * \param [in] simd Whether to use SIMD code where supported.
+   *    Disabling this is only useful to test the SIMD code.
+   */
+  void ConvertFormatRowCpu(
+          D3D9CpuConversion conversion,
+          uint8_t*          dst,
+    const uint8_t*          src,
+          uint32_t          width,
+          bool              simd = true);
+
+  /**
+   * \brief Converts one row of planar YUV texels on the CPU
+   *
+   * Supports NV12 and YV12, which both produce B8G8R8A8
+   * texels. For NV12, \c chroma0 points to the row of
+   * interleaved UV samples and \c chroma1 is unused.
+   * For YV12, \c chroma0 and \c chroma1 point to the
+   * rows of V and U samples, respectively. The width
+   * must be even, since chroma is subsampled.
+   * \param [in] conversion Conversion to perform
+   * \param [out] dst Destination texels
+   * \param [in] luma Row of Y samples
+   * \param [in] chroma0 First chroma row
+   * \param [in] chroma1 Second chroma row
+   * \param [in] width Row width, in pixels
+   */
+  void ConvertPlanarRowCpu(
+          D3D9CpuConversion conversion,
+          uint8_t*          dst,
+    const uint8_t*          luma,
+    const uint8_t*          chroma0,
+    const uint8_t*          chroma1,
+          uint32_t          width);
+
+}
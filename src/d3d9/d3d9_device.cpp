@@ -52,6 +52,7 @@ namespace dxvk {
     , m_stagingBuffer      ( dxvkDevice, StagingBufferSize )
     , m_stagingBufferFence ( new sync::Fence() )
     , m_d3d9Options        ( dxvkDevice, pParent->GetInstance()->config() )
+    , m_shaderCache        ( this )
     , m_multithread        ( BehaviorFlags & D3DCREATE_MULTITHREADED )
     , m_isSWVP             ( (BehaviorFlags & D3DCREATE_SOFTWARE_VERTEXPROCESSING) ? true : false )
     , m_isD3D8Compatible   ( pParent->IsD3D8Compatible() )
@@ -150,6 +151,13 @@ namespace dxvk {
 
     CreateConstantBuffers();
 
+    // Recreate fixed-function and SWVP shaders from previous runs
+    // so that the state cache can compile their pipelines early
+    m_shaderCache.StartPreload([this] {
+      m_ffModules.Preload(this);
+      m_swvpEmulator.Preload(this);
+    });
+
     m_availableMemory = DetermineInitialTextureMemory();
 
     m_hazardLayout = dxvkDevice->features().extAttachmentFeedbackLoopLayout.attachmentFeedbackLoopLayout
@@ -201,6 +209,8 @@ namespace dxvk {
     if (this_thread::isInModuleDetachment())
       return;
 
+    m_shaderCache.StopPreload();
+
     Flush();
     SynchronizeCsThread(DxvkCsThread::SynchronizeAll);
 
@@ -5225,28 +5235,52 @@ namespace dxvk {
       VkExtent3D srcBlockCount = util::computeBlockCount(srcTexLevelExtent, srcBlockSize);
       srcBlockCount.height *= std::min(pSrcTexture->GetPlaneCount(), 2u);
 
-      // the converter can not handle the 4 aligned pitch so we always repack into a staging buffer
-      D3D9BufferSlice slice = AllocStagingBuffer(pSrcTexture->GetMipSize(SrcSubresource));
       VkDeviceSize pitch = align(srcBlockCount.width * formatElementSize, 4);
 
       const DxvkFormatInfo* convertedFormatInfo = lookupFormatInfo(convertFormat.FormatColor);
       VkImageSubresourceLayers convertedDstLayers = { convertedFormatInfo->aspectMask, dstSubresource.mipLevel, dstSubresource.arrayLayer, 1 };
 
-      util::packImageData(
-        slice.mapPtr, mapPtr, srcBlockCount, formatElementSize,
-        pitch, std::min(pSrcTexture->GetPlaneCount(), 2u) * pitch * srcBlockCount.height);
-
-      EmitCs([this,
-        cConvertFormat    = convertFormat,
-        cDstImage         = std::move(image),
-        cDstLayers        = convertedDstLayers,
-        cSrcSlice         = std::move(slice.slice)
-      ] (DxvkContext* ctx) {
-        auto contextObjects = ctx->beginExternalRendering();
+      if (D3D9FormatHelper::CanConvertFormatCpu(convertFormat, srcTexLevelExtent)) {
+        // Small images are converted directly into the staging buffer,
+        // which saves the compute dispatch and its barrier entirely.
+        D3D9BufferSlice slice = AllocStagingBuffer(
+          srcTexLevelExtent.width * srcTexLevelExtent.height * convertedFormatInfo->elementSize);
 
-        m_converter->ConvertFormat(contextObjects,
-          cConvertFormat, cDstImage, cDstLayers, cSrcSlice);
-      });
+        D3D9FormatHelper::ConvertFormatCpu(convertFormat,
+          srcTexLevelExtent, slice.mapPtr, mapPtr, pitch);
+
+        EmitCs([
+          cSrcSlice       = std::move(slice.slice),
+          cDstImage       = std::move(image),
+          cDstLayers      = convertedDstLayers,
+          cDstLevelExtent = dstTexLevelExtent
+        ] (DxvkContext* ctx) {
+          ctx->copyBufferToImage(
+            cDstImage,  cDstLayers,
+            VkOffset3D { 0, 0, 0 }, cDstLevelExtent,
+            cSrcSlice.buffer(), cSrcSlice.offset(),
+            0, 0, VK_FORMAT_UNDEFINED);
+        });
+      } else {
+        // the converter can not handle the 4 aligned pitch so we always repack into a staging buffer
+        D3D9BufferSlice slice = AllocStagingBuffer(pSrcTexture->GetMipSize(SrcSubresource));
+
+        util::packImageData(
+          slice.mapPtr, mapPtr, srcBlockCount, formatElementSize,
+          pitch, std::min(pSrcTexture->GetPlaneCount(), 2u) * pitch * srcBlockCount.height);
+
+        EmitCs([this,
+          cConvertFormat    = convertFormat,
+          cDstImage         = std::move(image),
+          cDstLayers        = convertedDstLayers,
+          cSrcSlice         = std::move(slice.slice)
+        ] (DxvkContext* ctx) {
+          auto contextObjects = ctx->beginExternalRendering();
+
+          m_converter->ConvertFormat(contextObjects,
+            cConvertFormat, cDstImage, cDstLayers, cSrcSlice);
+        });
+      }
     }
     UnmapTextures();
     ConsiderFlush(GpuFlushType::ImplicitWeakHint);
@@ -5688,7 +5722,7 @@ namespace dxvk {
     uint64_t chunkId = GetCurrentSequenceNumber();
     uint64_t submissionId = m_submissionFence->value();
 
-    if (m_flushTracker.considerFlush(FlushType, chunkId, submissionId))
+    if (m_flushTracker.considerFlush(FlushType, chunkId, submissionId, m_dxvkDevice->estimateGpuBusyTime()))
       Flush();
   }
 
@@ -5896,6 +5930,8 @@ namespace dxvk {
 
     auto mapPtr = dstBuffer.Alloc(size);
     std::memcpy(mapPtr, src, size);
+
+    m_constantUploadBytes += size;
     return mapPtr;
   }
 
@@ -5935,6 +5971,8 @@ namespace dxvk {
     void* mapPtr = constSet.buffer.Alloc(bufferSize);
     auto* dst = reinterpret_cast<HardwareLayoutType*>(mapPtr);
 
+    m_constantUploadBytes += bufferSize;
+
     const uint32_t intDataSize = constSet.meta.maxConstIndexI * sizeof(Vector4i);
     if (constSet.meta.maxConstIndexI != 0)
       std::memcpy(dst->iConsts, Src.iConsts, intDataSize);
@@ -6136,6 +6174,8 @@ namespace dxvk {
   void D3D9DeviceEx::EndFrame(Rc<DxvkLatencyTracker> LatencyTracker) {
     D3D9DeviceLock lock = LockDevice();
 
+    m_publishedConstantUploadBytes.store(m_constantUploadBytes, std::memory_order_relaxed);
+
     EmitCs<false>([
       cTracker = std::move(LatencyTracker)
     ] (DxvkContext* ctx) {
@@ -7712,20 +7752,33 @@ namespace dxvk {
         pConstantData,
         Count);
 
+    // Games frequently re-set the same constants for every draw. Skip
+    // re-uploading the constant set if none of the values change and
+    // the update does not grow the range of constants we upload.
+    bool redundant = IsRedundantConstantUpdate<ProgramType, ConstantType, T>(
+      &m_state, StartRegister, pConstantData, Count,
+      m_d3d9Options.d3d9FloatEmulation == D3D9FloatEmulation::Enabled);
+
     if constexpr (ProgramType == DxsoProgramType::VertexShader) {
       if constexpr (ConstantType == D3D9ConstantType::Float) {
+        redundant &= StartRegister + Count <= m_vsFloatConstsCount;
         m_vsFloatConstsCount = std::max(m_vsFloatConstsCount, StartRegister + Count);
       } else if constexpr (ConstantType == D3D9ConstantType::Int) {
+        redundant &= StartRegister + Count <= m_vsIntConstsCount;
         m_vsIntConstsCount = std::max(m_vsIntConstsCount, StartRegister + Count);
       } else /* if constexpr (ConstantType == D3D9ConstantType::Bool) */ {
         m_vsBoolConstsCount = std::max(m_vsBoolConstsCount, StartRegister + Count);
       }
     } else {
       if constexpr (ConstantType == D3D9ConstantType::Float) {
+        redundant &= StartRegister + Count <= m_psFloatConstsCount;
         m_psFloatConstsCount = std::max(m_psFloatConstsCount, StartRegister + Count);
       }
     }
 
+    if (redundant)
+      return D3D_OK;
+
     if constexpr (ConstantType != D3D9ConstantType::Bool) {
       uint32_t maxCount = ConstantType == D3D9ConstantType::Float
         ? m_consts[ProgramType].meta.maxConstIndexF
@@ -8576,8 +8629,9 @@ namespace dxvk {
     if (pTexture->GetMapMode() != D3D9_COMMON_TEXTURE_MAP_MODE_UNMAPPABLE)
       return;
 
-    D3D9DeviceLock lock = LockDevice();
-    m_mappedTextures.touch(pTexture);
+    // Only sets a flag on the texture itself, the list
+    // is updated when textures are actually evicted.
+    m_mappedTextures.markUsed(pTexture);
 #endif
   }
 
@@ -8601,15 +8655,43 @@ namespace dxvk {
 
     uint32_t threshold = (m_d3d9Options.textureMemory / 4) * 3;
 
-    auto iter = m_mappedTextures.leastRecentlyUsedIter();
-    while (m_memoryAllocator.MappedMemory() >= threshold && iter != m_mappedTextures.leastRecentlyUsedEndIter()) {
-      if (unlikely((*iter)->IsAnySubresourceLocked() != 0)) {
-        iter++;
+    // Limit the number of visited textures so that eviction takes bounded
+    // time even if most textures are locked or were recently used.
+    // Recently used textures get moved to the back of the list.
+    uint32_t budget = m_mappedTextures.size();
+
+    // Compression runs on the calling thread, so cap the amount of data
+    // compressed per call. Any other textures only get unmapped.
+    constexpr uint32_t MaxCompressedSizePerCall = 2u << 20;
+
+    uint32_t compressBudget = m_d3d9Options.compressUnmappedTextures
+      ? MaxCompressedSizePerCall : 0u;
+
+    D3D9CommonTexture* texture = m_mappedTextures.leastRecentlyUsed();
+
+    while (m_memoryAllocator.MappedMemory() >= threshold && texture && budget--) {
+      D3D9CommonTexture* next = m_mappedTextures.next(texture);
+
+      if (unlikely(texture->IsAnySubresourceLocked() != 0)) {
+        texture = next;
+        continue;
+      }
+
+      if (m_mappedTextures.checkAndClearUsed(texture)) {
+        m_mappedTextures.touch(texture);
+        texture = next;
         continue;
       }
-      (*iter)->UnmapData();
 
-      iter = m_mappedTextures.remove(iter);
+      if (texture->GetTotalSize() <= compressBudget) {
+        compressBudget -= texture->GetTotalSize();
+        texture->CompressData();
+      } else {
+        texture->UnmapData();
+      }
+
+      m_mappedTextures.remove(texture);
+      texture = next;
     }
 #endif
   }
@@ -23,6 +23,7 @@
 #include "../dxso/dxso_modinfo.h"
 
 #include "d3d9_fixed_function.h"
+#include "d3d9_shader_cache.h"
 #include "d3d9_swvp_emu.h"
 
 #include "d3d9_spec_constants.h"
@@ -1016,7 +1017,11 @@ namespace dxvk {
     void* MapTexture(D3D9CommonTexture* pTexture, UINT Subresource);
 
     /**
-     * \brief Moves the texture to the front of the LRU list of mapped textures
+     * \brief Marks the texture as recently used
+     *
+     * Does not need to lock the device. The texture will be
+     * moved to the back of the LRU list of mapped textures
+     * the next time textures are evicted.
      */
     void TouchMappedTexture(D3D9CommonTexture* pTexture);
 
@@ -1101,6 +1106,22 @@ namespace dxvk {
       return m_swvpEmulator.GetShaderCount();
     }
 
+    /**
+     * \brief Returns the on-disk cache for fixed function and SWVP shaders.
+     */
+    D3D9ShaderCache& GetShaderCache() {
+      return m_shaderCache;
+    }
+
+    /**
+     * \brief Returns the total number of bytes written to shader constant buffers.
+     *
+     * Only updated once per frame, since uploads are counted on the API thread.
+     */
+    uint64_t GetConstantUploadBytes() const {
+      return m_publishedConstantUploadBytes.load(std::memory_order_relaxed);
+    }
+
     void InjectCsChunk(
             DxvkCsChunkRef&&            Chunk,
             bool                        Synchronize);
@@ -1451,6 +1472,8 @@ namespace dxvk {
     const D3D9Options               m_d3d9Options;
     DxsoOptions                     m_dxsoOptions;
 
+    D3D9ShaderCache                 m_shaderCache;
+
     std::unordered_map<
       DWORD,
       Com<D3D9VertexDecl,
@@ -1560,7 +1583,8 @@ namespace dxvk {
     D3D9SwapChainEx*                m_mostRecentlyUsedSwapchain = nullptr;
 
 #ifdef D3D9_ALLOW_UNMAPPING
-    lru_list<D3D9CommonTexture*>    m_mappedTextures;
+    lru_list<D3D9CommonTexture,
+      &D3D9CommonTexture::GetMappedTextureLink> m_mappedTextures;
 #endif
 
     // m_state should be declared last (i.e. freed first), because it
@@ -1580,6 +1604,10 @@ namespace dxvk {
     uint64_t                        m_lastSamplerLiveCount = 0u;
     uint64_t                        m_lastSamplerBindCount = 0u;
 
+    // Constant upload statistics, published for the HUD on present
+    uint64_t                        m_constantUploadBytes = 0u;
+    std::atomic<uint64_t>           m_publishedConstantUploadBytes = { 0u };
+
     // Written by CS thread
     alignas(CACHE_LINE_SIZE)
     std::atomic<uint64_t>           m_lastSamplerStats = { 0u };
@@ -337,12 +337,12 @@ namespace dxvk {
   }
 
 
-  uint32_t SetupRenderStateBlock(SpirvModule& spvModule) {
+  uint32_t SetupRenderStateBlock(SpirvModule& spvModule, bool samplerHeap) {
     uint32_t floatType = spvModule.defFloatType(32);
     uint32_t uintType  = spvModule.defIntType(32, 0);
     uint32_t vec3Type  = spvModule.defVectorType(floatType, 3);
 
-    std::array<uint32_t, 11> rsMembers = {{
+    std::array<uint32_t, 12> rsMembers = {{
       vec3Type,
       floatType,
       floatType,
@@ -358,7 +358,18 @@ namespace dxvk {
       floatType,
     }};
 
-    uint32_t rsStruct = spvModule.defStructTypeUnique(rsMembers.size(), rsMembers.data());
+    uint32_t rsMemberCount = rsMembers.size() - 1;
+
+    // Heap indices are packed into dwords, two at a time
+    if (samplerHeap) {
+      uint32_t arrayType = spvModule.defArrayTypeUnique(uintType,
+        spvModule.constu32(sizeof(D3D9SamplerHeapIndices) / sizeof(uint32_t)));
+      spvModule.decorateArrayStride(arrayType, sizeof(uint32_t));
+
+      rsMembers[rsMemberCount++] = arrayType;
+    }
+
+    uint32_t rsStruct = spvModule.defStructTypeUnique(rsMemberCount, rsMembers.data());
     uint32_t rsBlock = spvModule.newVar(
       spvModule.defPointerType(rsStruct, spv::StorageClassPushConstant),
       spv::StorageClassPushConstant);
@@ -387,6 +398,9 @@ namespace dxvk {
     SetMemberName("point_scale_b",  offsetof(D3D9RenderStateInfo, pointScaleB));
     SetMemberName("point_scale_c",  offsetof(D3D9RenderStateInfo, pointScaleC));
 
+    if (samplerHeap)
+      SetMemberName("sampler_heap_indices", sizeof(D3D9RenderStateInfo));
+
     return rsBlock;
   }
 
@@ -2496,13 +2510,24 @@ namespace dxvk {
 
     std::string name = str::format("FF_", shaderKey.toString());
 
-    D3D9FFShaderCompiler compiler(
-      pDevice->GetDXVKDevice(),
-      Key, name,
-      pDevice->GetOptions());
+    // Only use the packed key data so that we never
+    // read any padding bytes from the key structure
+    auto& cache = pDevice->GetShaderCache();
+    auto& cacheKey = Key.Data.Primitive;
+
+    m_shader = cache.Lookup(D3D9ShaderCacheEntryType::FixedFunctionVS, cacheKey, sizeof(cacheKey));
 
-    m_shader = compiler.compile();
-    m_isgn   = compiler.isgn();
+    if (m_shader == nullptr) {
+      D3D9FFShaderCompiler compiler(
+        pDevice->GetDXVKDevice(),
+        Key, name,
+        pDevice->GetOptions());
+
+      m_shader = compiler.compile();
+      m_isgn   = compiler.isgn();
+
+      cache.Store(D3D9ShaderCacheEntryType::FixedFunctionVS, cacheKey, sizeof(cacheKey), m_shader);
+    }
 
     Dump(pDevice, Key, name);
 
@@ -2519,13 +2544,22 @@ namespace dxvk {
 
     std::string name = str::format("FF_", shaderKey.toString());
 
-    D3D9FFShaderCompiler compiler(
-      pDevice->GetDXVKDevice(),
-      Key, name,
-      pDevice->GetOptions());
+    auto& cache = pDevice->GetShaderCache();
+    auto cacheKey = GetCacheKey(Key);
+
+    m_shader = cache.Lookup(D3D9ShaderCacheEntryType::FixedFunctionFS, cacheKey.data(), sizeof(cacheKey));
+
+    if (m_shader == nullptr) {
+      D3D9FFShaderCompiler compiler(
+        pDevice->GetDXVKDevice(),
+        Key, name,
+        pDevice->GetOptions());
 
-    m_shader = compiler.compile();
-    m_isgn   = compiler.isgn();
+      m_shader = compiler.compile();
+      m_isgn   = compiler.isgn();
+
+      cache.Store(D3D9ShaderCacheEntryType::FixedFunctionFS, cacheKey.data(), sizeof(cacheKey), m_shader);
+    }
 
     Dump(pDevice, Key, name);
 
@@ -2533,6 +2567,19 @@ namespace dxvk {
     pDevice->GetDXVKDevice()->registerShader(m_shader);
   }
 
+  D3D9FFShader::FSCacheKey D3D9FFShader::GetCacheKey(
+    const D3D9FFShaderKeyFS&    Key) {
+    FSCacheKey result = { };
+
+    for (uint32_t i = 0; i < caps::TextureStageCount; i++) {
+      result[2u * i + 0u] = Key.Stages[i].Primitive[0];
+      result[2u * i + 1u] = Key.Stages[i].Primitive[1];
+    }
+
+    return result;
+  }
+
+
   template <typename T>
   void D3D9FFShader::Dump(D3D9DeviceEx* pDevice, const T& Key, const std::string& Name) {
     const std::string& dumpPath = pDevice->GetOptions()->shaderDumpPath;
@@ -2551,16 +2598,21 @@ namespace dxvk {
           D3D9DeviceEx*         pDevice,
     const D3D9FFShaderKeyVS&    ShaderKey) {
     // Use the shader's unique key for the lookup
-    auto entry = m_vsModules.find(ShaderKey);
-    if (entry != m_vsModules.end())
-      return entry->second;
-    
+    { std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+      auto entry = m_vsModules.find(ShaderKey);
+      if (entry != m_vsModules.end())
+        return entry->second;
+    }
+
+    // Shaders may get preloaded on a worker thread, so don't
+    // hold the lock while compiling and return the existing
+    // module if another thread has created it in the meantime.
     D3D9FFShader shader(
       pDevice, ShaderKey);
 
-    m_vsModules.insert({ShaderKey, shader});
-
-    return shader;
+    std::lock_guard<dxvk::mutex> lock(m_mutex);
+    return m_vsModules.insert({ShaderKey, shader}).first->second;
   }
 
 
@@ -2568,16 +2620,52 @@ namespace dxvk {
           D3D9DeviceEx*         pDevice,
     const D3D9FFShaderKeyFS&    ShaderKey) {
     // Use the shader's unique key for the lookup
-    auto entry = m_fsModules.find(ShaderKey);
-    if (entry != m_fsModules.end())
-      return entry->second;
-    
+    { std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+      auto entry = m_fsModules.find(ShaderKey);
+      if (entry != m_fsModules.end())
+        return entry->second;
+    }
+
     D3D9FFShader shader(
       pDevice, ShaderKey);
 
-    m_fsModules.insert({ShaderKey, shader});
+    std::lock_guard<dxvk::mutex> lock(m_mutex);
+    return m_fsModules.insert({ShaderKey, shader}).first->second;
+  }
+
+
+  void D3D9FFShaderModuleSet::Preload(
+          D3D9DeviceEx*         pDevice) {
+    auto& cache = pDevice->GetShaderCache();
 
-    return shader;
+    for (const auto& data : cache.GetKeys(D3D9ShaderCacheEntryType::FixedFunctionVS)) {
+      if (cache.IsPreloadCanceled())
+        return;
+
+      D3D9FFShaderKeyVS key;
+
+      if (data.size() == sizeof(key.Data.Primitive)) {
+        std::memcpy(key.Data.Primitive, data.data(), data.size());
+        GetShaderModule(pDevice, key);
+      }
+    }
+
+    for (const auto& data : cache.GetKeys(D3D9ShaderCacheEntryType::FixedFunctionFS)) {
+      if (cache.IsPreloadCanceled())
+        return;
+
+      D3D9FFShaderKeyFS key;
+
+      if (data.size() == sizeof(D3D9FFShader::FSCacheKey)) {
+        for (uint32_t i = 0; i < caps::TextureStageCount; i++) {
+          std::memcpy(key.Stages[i].Primitive, data.data() + i * sizeof(key.Stages[i].Primitive),
+            sizeof(key.Stages[i].Primitive));
+        }
+
+        GetShaderModule(pDevice, key);
+      }
+    }
   }
 
 
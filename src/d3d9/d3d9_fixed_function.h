@@ -62,8 +62,9 @@ namespace dxvk {
 
   void DoFixedFunctionAlphaTest(SpirvModule& spvModule, const D3D9AlphaTestContext& ctx);
 
-  // Returns a render state block
-  uint32_t SetupRenderStateBlock(SpirvModule& spvModule);
+  // Returns a render state block, optionally
+  // including the sampler heap indices
+  uint32_t SetupRenderStateBlock(SpirvModule& spvModule, bool samplerHeap = false);
 
   struct D3D9PointSizeInfoVS {
     uint32_t defaultValue;
@@ -224,6 +225,8 @@ namespace dxvk {
             D3D9DeviceEx*         pDevice,
       const D3D9FFShaderKeyFS&    Key);
 
+    using FSCacheKey = std::array<uint32_t, 2u * caps::TextureStageCount>;
+
     template <typename T>
     void Dump(D3D9DeviceEx* pDevice, const T& Key, const std::string& Name);
 
@@ -231,6 +234,17 @@ namespace dxvk {
       return m_shader;
     }
 
+    /**
+     * \brief Packs pixel shader key for the shader cache
+     *
+     * Only copies the packed stage data, so that
+     * the result is fully defined.
+     * \param [in] Key Shader key
+     * \returns Shader cache key
+     */
+    static FSCacheKey GetCacheKey(
+      const D3D9FFShaderKeyFS&    Key);
+
   private:
 
     Rc<DxvkShader> m_shader;
@@ -252,6 +266,16 @@ namespace dxvk {
             D3D9DeviceEx*         pDevice,
       const D3D9FFShaderKeyFS&    ShaderKey);
 
+    /**
+     * \brief Creates all shaders found in the shader cache
+     *
+     * Registers the shaders with the DXVK device, so that
+     * pipelines from the state cache can be compiled early.
+     * \param [in] pDevice The device
+     */
+    void Preload(
+            D3D9DeviceEx*         pDevice);
+
     UINT GetVSCount() const {
       return m_vsModules.size();
     }
@@ -272,6 +296,8 @@ namespace dxvk {
       D3D9FFShader,
       D3D9FFShaderKeyHash, D3D9FFShaderKeyEq> m_fsModules;
 
+    dxvk::mutex m_mutex;
+
   };
 
 
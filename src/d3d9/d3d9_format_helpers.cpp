@@ -1,4 +1,5 @@
 #include "d3d9_format_helpers.h"
+#include "d3d9_convert_cpu.h"
 
 #include <d3d9_convert_yuy2_uyvy.h>
 #include <d3d9_convert_l6v5u5.h>
@@ -10,6 +11,13 @@
 
 namespace dxvk {
 
+  // Images up to this size are converted on the CPU. This is a
+  // heuristic rather than a measured break-even point: below it,
+  // the compute dispatch, descriptor updates and barrier should
+  // cost more than converting the data on the CPU, while larger
+  // images would stall the calling thread for too long.
+  constexpr uint32_t D3D9CpuConversionMaxPixels = 256u * 256u;
+
   D3D9FormatHelper::D3D9FormatHelper(const Rc<DxvkDevice>& device)
   : m_device          (device)
   , m_setLayout       (CreateSetLayout())
@@ -72,6 +80,100 @@ namespace dxvk {
   }
 
 
+  bool D3D9FormatHelper::CanConvertFormatCpu(
+          D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+          VkExtent3D                    extent) {
+    // The compute shaders only ever convert a single slice
+    if (extent.depth != 1u || extent.width * extent.height > D3D9CpuConversionMaxPixels)
+      return false;
+
+    switch (conversionFormat.FormatType) {
+      case D3D9ConversionFormat_YUY2:
+      case D3D9ConversionFormat_UYVY:
+      case D3D9ConversionFormat_L6V5U5:
+      case D3D9ConversionFormat_X8L8V8U8:
+      case D3D9ConversionFormat_A2W10V10U10:
+      case D3D9ConversionFormat_W11V11U10:
+        return true;
+
+      // Chroma is subsampled, and the shaders
+      // drop the last column or row if odd
+      case D3D9ConversionFormat_NV12:
+      case D3D9ConversionFormat_YV12:
+        return !(extent.width & 1u) && !(extent.height & 1u);
+
+      default:
+        return false;
+    }
+  }
+
+
+  void D3D9FormatHelper::ConvertFormatCpu(
+          D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+          VkExtent3D                    extent,
+          void*                         dst,
+    const void*                         src,
+          VkDeviceSize                  srcPitch) {
+    auto dstData = reinterpret_cast<uint8_t*>(dst);
+    auto srcData = reinterpret_cast<const uint8_t*>(src);
+
+    // All conversion formats used here have 32-bit or 64-bit texels
+    VkDeviceSize dstPitch = extent.width * lookupFormatInfo(conversionFormat.FormatColor)->elementSize;
+
+    // Planar formats store chroma after the luma plane. NV12 uses
+    // the same pitch for all planes, while YV12 chroma planes
+    // use half the pitch of the luma plane.
+    if (conversionFormat.FormatType == D3D9ConversionFormat_NV12) {
+      const uint8_t* uvData = srcData + srcPitch * extent.height;
+
+      for (uint32_t y = 0; y < extent.height; y++) {
+        ConvertPlanarRowCpu(D3D9CpuConversion::NV12, dstData,
+          srcData + srcPitch * y, uvData + srcPitch * (y / 2u), nullptr, extent.width);
+        dstData += dstPitch;
+      }
+
+      return;
+    }
+
+    if (conversionFormat.FormatType == D3D9ConversionFormat_YV12) {
+      VkDeviceSize chromaPitch = srcPitch / 2u;
+
+      const uint8_t* vData = srcData + srcPitch * extent.height;
+      const uint8_t* uData = vData + chromaPitch * (extent.height / 2u);
+
+      for (uint32_t y = 0; y < extent.height; y++) {
+        ConvertPlanarRowCpu(D3D9CpuConversion::YV12, dstData, srcData + srcPitch * y,
+          vData + chromaPitch * (y / 2u), uData + chromaPitch * (y / 2u), extent.width);
+        dstData += dstPitch;
+      }
+
+      return;
+    }
+
+    D3D9CpuConversion conversion;
+
+    switch (conversionFormat.FormatType) {
+      case D3D9ConversionFormat_YUY2:         conversion = D3D9CpuConversion::YUY2;        break;
+      case D3D9ConversionFormat_UYVY:         conversion = D3D9CpuConversion::UYVY;        break;
+      case D3D9ConversionFormat_L6V5U5:       conversion = D3D9CpuConversion::L6V5U5;      break;
+      case D3D9ConversionFormat_X8L8V8U8:     conversion = D3D9CpuConversion::X8L8V8U8;    break;
+      case D3D9ConversionFormat_A2W10V10U10:  conversion = D3D9CpuConversion::A2W10V10U10; break;
+      case D3D9ConversionFormat_W11V11U10:    conversion = D3D9CpuConversion::W11V11U10;   break;
+
+      default:
+        Logger::warn("Unimplemented format conversion");
+        return;
+    }
+
+    for (uint32_t y = 0; y < extent.height; y++) {
+      ConvertFormatRowCpu(conversion, dstData, srcData, extent.width);
+
+      dstData += dstPitch;
+      srcData += srcPitch;
+    }
+  }
+
+
   void D3D9FormatHelper::ConvertGenericFormat(
     const DxvkContextObjects&           ctx,
           D3D9_CONVERSION_FORMAT_INFO   videoFormat,
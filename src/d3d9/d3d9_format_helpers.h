@@ -24,6 +24,42 @@ namespace dxvk {
             VkImageSubresourceLayers      dstSubresource,
       const DxvkBufferSlice&              srcSlice);
 
+    /**
+     * \brief Checks whether to convert on the CPU
+     *
+     * Small images are cheaper to convert on the CPU and
+     * upload with a regular copy than to convert with a
+     * compute shader. Planar YUV formats are supported
+     * if the image has even dimensions.
+     * \param [in] conversionFormat Conversion format
+     * \param [in] extent Extent of the mip level
+     * \returns \c true if \ref ConvertFormatCpu can be used
+     */
+    static bool CanConvertFormatCpu(
+            D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+            VkExtent3D                    extent);
+
+    /**
+     * \brief Converts image data on the CPU
+     *
+     * Follows the math of the compute shaders, see
+     * \ref ConvertFormatRowCpu for rounding differences.
+     * The destination is tightly packed and laid out in
+     * the conversion format, so it can be copied to the
+     * image directly.
+     * \param [in] conversionFormat Conversion format
+     * \param [in] extent Extent of the mip level
+     * \param [out] dst Destination data
+     * \param [in] src Source data
+     * \param [in] srcPitch Source row pitch, in bytes
+     */
+    static void ConvertFormatCpu(
+            D3D9_CONVERSION_FORMAT_INFO   conversionFormat,
+            VkExtent3D                    extent,
+            void*                         dst,
+      const void*                         src,
+            VkDeviceSize                  srcPitch);
+
   private:
 
     void ConvertGenericFormat(
@@ -32,7 +32,8 @@ namespace dxvk::hud {
   HudTextureMemory::HudTextureMemory(D3D9DeviceEx* device)
   : m_device          (device)
   , m_allocatedString ("")
-  , m_mappedString    ("") { }
+  , m_mappedString    ("")
+  , m_compressedString("") { }
 
 
   void HudTextureMemory::update(dxvk::high_resolution_clock::time_point time) {
@@ -41,6 +42,7 @@ namespace dxvk::hud {
     m_maxAllocated = std::max(m_maxAllocated, allocator->AllocatedMemory());
     m_maxUsed = std::max(m_maxUsed, allocator->UsedMemory());
     m_maxMapped = std::max(m_maxMapped, allocator->MappedMemory());
+    m_maxCompressed = std::max(m_maxCompressed, allocator->CompressedMemory());
 
     auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate);
 
@@ -49,9 +51,11 @@ namespace dxvk::hud {
 
     m_allocatedString = str::format(m_maxAllocated >> 20, " MB (Used: ", m_maxUsed >> 20, " MB)");
     m_mappedString = str::format(m_maxMapped >> 20, " MB");
+    m_compressedString = str::format(m_maxCompressed >> 20, " MB");
     m_maxAllocated = 0;
     m_maxUsed = 0;
     m_maxMapped = 0;
+    m_maxCompressed = 0;
     m_lastUpdate = time;
   }
 
@@ -70,6 +74,12 @@ namespace dxvk::hud {
     renderer.drawText(16, position, 0xffc0ff00u, "Mapped:");
     renderer.drawText(16, { position.x + 120, position.y }, 0xffffffffu, m_mappedString);
 
+    if (m_device->GetOptions()->compressUnmappedTextures) {
+      position.y += 20;
+      renderer.drawText(16, position, 0xffc0ff00u, "Compressed:");
+      renderer.drawText(16, { position.x + 120, position.y }, 0xffffffffu, m_compressedString);
+    }
+
     position.y += 8;
     return position;
   }
@@ -103,6 +113,45 @@ namespace dxvk::hud {
   }
 
 
+  HudConstantUploads::HudConstantUploads(D3D9DeviceEx* device)
+  : m_device        (device)
+  , m_lastBytes     (device->GetConstantUploadBytes())
+  , m_uploadString  ("--") { }
+
+
+  void HudConstantUploads::update(dxvk::high_resolution_clock::time_point time) {
+    m_frameCount += 1;
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(time - m_lastUpdate);
+
+    if (elapsed.count() < UpdateInterval)
+      return;
+
+    uint64_t bytes = m_device->GetConstantUploadBytes();
+    uint64_t bytesPerFrame = (bytes - m_lastBytes) / m_frameCount;
+
+    m_uploadString = str::format(bytesPerFrame >> 10, " kB / frame");
+    m_lastBytes = bytes;
+    m_frameCount = 0;
+    m_lastUpdate = time;
+  }
+
+
+  HudPos HudConstantUploads::render(
+    const DxvkContextObjects& ctx,
+    const HudPipelineKey&     key,
+    const HudOptions&         options,
+          HudRenderer&        renderer,
+          HudPos              position) {
+    position.y += 16;
+    renderer.drawText(16, position, 0xffc0ff00u, "Constants:");
+    renderer.drawText(16, { position.x + 155, position.y }, 0xffffffffu, m_uploadString);
+
+    position.y += 8;
+    return position;
+  }
+
+
   HudSWVPState::HudSWVPState(D3D9DeviceEx* device)
           : m_device          (device)
           , m_isSWVPText ("") {}
@@ -56,12 +56,14 @@ namespace dxvk::hud {
     uint32_t m_maxAllocated = 0;
     uint32_t m_maxUsed      = 0;
     uint32_t m_maxMapped    = 0;
+    uint32_t m_maxCompressed = 0;
 
     dxvk::high_resolution_clock::time_point m_lastUpdate
       = dxvk::high_resolution_clock::now();
 
     std::string m_allocatedString;
     std::string m_mappedString;
+    std::string m_compressedString;
 
   };
 
@@ -93,6 +95,39 @@ namespace dxvk::hud {
   };
 
 
+  /**
+   * \brief HUD item to display shader constant upload size
+   */
+  class HudConstantUploads : public HudItem {
+    constexpr static int64_t UpdateInterval = 500'000;
+  public:
+
+    HudConstantUploads(D3D9DeviceEx* device);
+
+    void update(dxvk::high_resolution_clock::time_point time);
+
+    HudPos render(
+      const DxvkContextObjects& ctx,
+      const HudPipelineKey&     key,
+      const HudOptions&         options,
+            HudRenderer&        renderer,
+            HudPos              position);
+
+  private:
+
+    D3D9DeviceEx* m_device;
+
+    uint64_t m_lastBytes  = 0;
+    uint32_t m_frameCount = 0;
+
+    dxvk::high_resolution_clock::time_point m_lastUpdate
+      = dxvk::high_resolution_clock::now();
+
+    std::string m_uploadString;
+
+  };
+
+
   /**
    * \brief HUD item to whether or not we're in SWVP mode
    */
@@ -3,6 +3,8 @@
 #include "../util/util_math.h"
 #include "../util/log/log.h"
 #include "../util/util_likely.h"
+#include "../util/util_error.h"
+#include "../util/util_lz.h"
 #include <utility>
 #include <algorithm>
 
@@ -56,6 +58,14 @@ namespace dxvk {
       FreeChunk(chunk);
   }
 
+  void D3D9MemoryAllocator::Shrink(D3D9Memory* Memory, uint32_t Size) {
+    std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+    uint32_t oldSize = Memory->GetSize();
+    Memory->GetChunk()->ShrinkLocked(Memory, Size);
+    m_usedMemory -= oldSize - Memory->GetSize();
+  }
+
   void D3D9MemoryAllocator::FreeChunk(D3D9MemoryChunk *Chunk) {
     // Has to be called in the lock
 
@@ -95,6 +105,10 @@ namespace dxvk {
     return m_allocatedMemory.load();
   }
 
+  uint32_t D3D9MemoryAllocator::CompressedMemory() const {
+    return m_compressedMemory.load();
+  }
+
   D3D9MemoryChunk::D3D9MemoryChunk(D3D9MemoryAllocator* Allocator, uint32_t Size)
     : m_allocator(Allocator), m_size(Size) {
     m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE | SEC_COMMIT, 0, Size, nullptr);
@@ -213,8 +227,28 @@ namespace dxvk {
   void D3D9MemoryChunk::FreeLocked(D3D9Memory *Memory) {
     // Has to be protected by the allocator lock
 
-    uint32_t offset = Memory->GetOffset();
-    uint32_t size = Memory->GetSize();
+    FreeRangeLocked(Memory->GetOffset(), Memory->GetSize());
+  }
+
+  void D3D9MemoryChunk::ShrinkLocked(D3D9Memory* Memory, uint32_t Size) {
+    // Has to be protected by the allocator lock, and the
+    // memory must not be mapped since the mapping depends
+    // on the allocation size.
+
+    uint32_t alignedSize = align(Size, CACHE_LINE_SIZE);
+
+    if (alignedSize >= Memory->GetSize())
+      return;
+
+    FreeRangeLocked(Memory->GetOffset() + alignedSize, Memory->GetSize() - alignedSize);
+    Memory->m_size = alignedSize;
+  }
+
+  void D3D9MemoryChunk::FreeRangeLocked(uint32_t Offset, uint32_t Size) {
+    // Has to be protected by the allocator lock
+
+    uint32_t offset = Offset;
+    uint32_t size = Size;
 
     auto curr = m_freeRanges.begin();
 
@@ -248,13 +282,16 @@ namespace dxvk {
 
 
   D3D9Memory::D3D9Memory(D3D9MemoryChunk* Chunk, size_t Offset, size_t Size)
-    : m_chunk(Chunk), m_offset(Offset), m_size(Size) {}
+    : m_allocator(Chunk->Allocator()), m_chunk(Chunk), m_offset(Offset), m_size(Size) {}
 
   D3D9Memory::D3D9Memory(D3D9Memory&& other)
-    : m_chunk(std::exchange(other.m_chunk, nullptr)),
+    : m_allocator(std::exchange(other.m_allocator, nullptr)),
+      m_chunk(std::exchange(other.m_chunk, nullptr)),
       m_ptr(std::exchange(other.m_ptr, nullptr)),
       m_offset(std::exchange(other.m_offset, 0)),
-      m_size(std::exchange(other.m_size, 0)) {}
+      m_size(std::exchange(other.m_size, 0)),
+      m_compressedSize(std::exchange(other.m_compressedSize, 0)),
+      m_decompressedSize(std::exchange(other.m_decompressedSize, 0)) {}
 
   D3D9Memory::~D3D9Memory() {
     this->Free();
@@ -263,10 +300,13 @@ namespace dxvk {
   D3D9Memory& D3D9Memory::operator = (D3D9Memory&& other) {
     this->Free();
 
+    m_allocator = std::exchange(other.m_allocator, nullptr);
     m_chunk = std::exchange(other.m_chunk, nullptr);
     m_ptr = std::exchange(other.m_ptr, nullptr);
     m_offset = std::exchange(other.m_offset, 0);
     m_size = std::exchange(other.m_size, 0);
+    m_compressedSize = std::exchange(other.m_compressedSize, 0);
+    m_decompressedSize = std::exchange(other.m_decompressedSize, 0);
     return *this;
   }
 
@@ -274,6 +314,12 @@ namespace dxvk {
     if (unlikely(m_chunk == nullptr))
       return;
 
+    if (unlikely(IsCompressed())) {
+      m_allocator->m_compressedMemory -= m_size;
+      m_compressedSize = 0;
+      m_decompressedSize = 0;
+    }
+
     if (m_ptr != nullptr)
       Unmap();
 
@@ -288,9 +334,82 @@ namespace dxvk {
     if (unlikely(m_chunk == nullptr))
       return;
 
+    if (unlikely(IsCompressed())) {
+      Decompress();
+      return;
+    }
+
     m_ptr = m_chunk->Allocator()->Map(this);
   }
 
+  bool D3D9Memory::Compress() {
+    // Tiny allocations are not worth compressing
+    if (m_chunk == nullptr || IsCompressed() || m_size < 4u * CACHE_LINE_SIZE)
+      return false;
+
+    Map();
+
+    if (unlikely(m_ptr == nullptr))
+      return false;
+
+    // Only keep the compressed copy if it saves a meaningful
+    // amount of memory, otherwise decompression isn't worth it.
+    // Compress straight into mapping-backed memory so that no
+    // additional address space is needed once we're done.
+    D3D9Memory compressed = m_allocator->Alloc((m_size / 4) * 3);
+    compressed.Map();
+
+    if (unlikely(compressed.m_ptr == nullptr))
+      return false;
+
+    size_t compressedSize = lz::compress(compressed.m_ptr, compressed.m_size, m_ptr, m_size);
+    compressed.Unmap();
+
+    if (!compressedSize)
+      return false;
+
+    m_allocator->Shrink(&compressed, compressedSize);
+    m_allocator->m_compressedMemory += compressed.m_size;
+
+    compressed.m_compressedSize = compressedSize;
+    compressed.m_decompressedSize = m_size;
+
+    *this = std::move(compressed);
+    return true;
+  }
+
+  void D3D9Memory::Decompress() {
+    // Keep the compressed data intact until the decompressed copy is
+    // complete. On failure, leave the memory unmapped and compressed
+    // so that callers get a null pointer, same as a failed mapping.
+    D3D9Memory memory = m_allocator->Alloc(m_decompressedSize);
+    memory.Map();
+
+    if (unlikely(memory.m_ptr == nullptr)) {
+      Logger::err("D3D9Memory: Failed to map memory for decompression");
+      return;
+    }
+
+    m_ptr = m_allocator->Map(this);
+
+    if (unlikely(m_ptr == nullptr)) {
+      Logger::err("D3D9Memory: Failed to map compressed memory");
+      return;
+    }
+
+    // The compressed data only ever comes from Compress, so
+    // failing to decode it means that memory got corrupted.
+    if (unlikely(!lz::decompress(memory.m_ptr, m_decompressedSize, m_ptr, m_compressedSize))) {
+      Logger::err("D3D9Memory: Failed to decompress memory");
+      Unmap();
+      return;
+    }
+
+    Unmap();
+
+    *this = std::move(memory);
+  }
+
   void D3D9Memory::Unmap() {
     if (unlikely(m_ptr == nullptr))
       return;
@@ -56,6 +56,8 @@ namespace dxvk {
 
       D3D9Memory AllocLocked(uint32_t Size);
       void FreeLocked(D3D9Memory* Memory);
+      void FreeRangeLocked(uint32_t Offset, uint32_t Size);
+      void ShrinkLocked(D3D9Memory* Memory, uint32_t Size);
       void* MapLocked(D3D9Memory* memory, uint32_t& mappedSize);
       uint32_t UnmapLocked(D3D9Memory* memory);
 
@@ -86,21 +88,38 @@ namespace dxvk {
       void Unmap();
       void* Ptr();
 
+      /**
+       * \brief Moves memory contents to compressed storage
+       *
+       * Compresses the data straight into a smaller allocation
+       * from the same allocator, and releases the original one
+       * if the contents compress well. Leaves the data as is
+       * otherwise. The data is decompressed on the next \ref Map.
+       * \returns \c true if the memory was compressed
+       */
+      bool Compress();
+
     private:
       D3D9Memory(D3D9MemoryChunk* Chunk, size_t Offset, size_t Size);
       void Free();
+      void Decompress();
+      bool IsCompressed() const { return m_decompressedSize != 0; }
       D3D9MemoryChunk* GetChunk() const { return m_chunk; }
       size_t GetOffset() const { return m_offset; }
       size_t GetSize() const { return m_size; }
 
+      D3D9MemoryAllocator* m_allocator = nullptr;
       D3D9MemoryChunk* m_chunk = nullptr;
       void* m_ptr              = nullptr;
       size_t m_offset          = 0;
       size_t m_size            = 0;
+      size_t m_compressedSize   = 0;
+      size_t m_decompressedSize = 0;
   };
 
   class D3D9MemoryAllocator {
     friend D3D9MemoryChunk;
+    friend D3D9Memory;
 
     public:
       D3D9MemoryAllocator();
@@ -108,11 +127,13 @@ namespace dxvk {
       D3D9Memory Alloc(uint32_t Size);
       D3D9Memory AllocFromChunk(D3D9MemoryChunk* Chunk, uint32_t Size);
       void Free(D3D9Memory* Memory);
+      void Shrink(D3D9Memory* Memory, uint32_t Size);
       void* Map(D3D9Memory* Memory);
       void Unmap(D3D9Memory* Memory);
       uint32_t MappedMemory() const;
       uint32_t UsedMemory() const;
       uint32_t AllocatedMemory() const;
+      uint32_t CompressedMemory() const;
       uint32_t AllocationGranularity() const { return m_allocationGranularity; }
       uint32_t MappingGranularity() const { return m_mappingGranularity; }
 
@@ -124,6 +145,7 @@ namespace dxvk {
       std::atomic<size_t> m_mappedMemory = 0;
       std::atomic<size_t> m_allocatedMemory = 0;
       std::atomic<size_t> m_usedMemory = 0;
+      std::atomic<size_t> m_compressedMemory = 0;
       uint32_t m_allocationGranularity;
       uint32_t m_mappingGranularity;
   };
@@ -164,6 +186,7 @@ namespace dxvk {
       uint32_t MappedMemory() const;
       uint32_t UsedMemory() const;
       uint32_t AllocatedMemory() const;
+      uint32_t CompressedMemory() const { return 0; }
       void NotifyFreed(uint32_t Size) {
         m_allocatedMemory -= Size;
       }
@@ -135,9 +135,15 @@ namespace dxvk {
     /// How much virtual memory will be used for textures (in MB).
     int32_t textureMemory;
 
+    /// Compress texture data that gets unmapped to save memory
+    bool compressUnmappedTextures;
+
     /// Shader dump path
     std::string shaderDumpPath;
 
+    /// Cache fixed-function and SWVP shaders on disk
+    bool shaderModuleCache;
+
     /// Enable emulation of device loss when a fullscreen app loses focus
     bool deviceLossOnFocusLoss;
 
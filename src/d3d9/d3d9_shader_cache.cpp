@@ -0,0 +1,434 @@
+#include <version.h>
+
+#include "d3d9_shader_cache.h"
+
+#include "d3d9_device.h"
+#include "d3d9_fixed_function.h"
+#include "d3d9_swvp_emu.h"
+
+#include "../util/util_singleton.h"
+
+namespace dxvk {
+
+  constexpr uint32_t D3D9ShaderCacheVersion = 2;
+
+  constexpr size_t D3D9ShaderCacheMinSize = 64u << 10u;
+
+
+  static size_t GetEntrySize(
+          uint32_t                  KeySize,
+          uint32_t                  BindingCount,
+          uint32_t                  CodeSize) {
+    return sizeof(D3D9ShaderCacheEntryHeader)
+      + align(KeySize, sizeof(uint32_t))
+      + sizeof(DxvkBindingInfo) * BindingCount
+      + sizeof(uint32_t) * CodeSize;
+  }
+
+
+  static Singleton<D3D9ShaderCacheFile> g_shaderCacheFile;
+
+
+  D3D9ShaderCacheFile::D3D9ShaderCacheFile() {
+    if (!Open()) {
+      m_file.close();
+      return;
+    }
+
+    Logger::info(str::format("D3D9: Found ", m_keys.size(), " shader cache entries"));
+  }
+
+
+  D3D9ShaderCacheFile::~D3D9ShaderCacheFile() {
+
+  }
+
+
+  Rc<DxvkShader> D3D9ShaderCacheFile::Lookup(
+          D3D9ShaderCacheEntryType  Type,
+    const std::string&              Key) {
+    DxvkShaderCreateInfo info;
+    std::vector<DxvkBindingInfo> bindings;
+    SpirvCodeBuffer code;
+
+    { std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+      if (!m_file.isOpen())
+        return nullptr;
+
+      auto entry = m_entries.find(MakeKey(Type, Key.data(), Key.size()));
+
+      if (entry == m_entries.end())
+        return nullptr;
+
+      // Entries were validated when the file was
+      // read, or written by ourselves, so trust them
+      auto base = reinterpret_cast<const char*>(m_file.data()) + entry->second;
+
+      D3D9ShaderCacheEntryHeader header;
+      std::memcpy(&header, base, sizeof(header));
+
+      size_t offset = sizeof(header) + align(header.keySize, sizeof(uint32_t));
+
+      bindings.resize(header.bindingCount);
+      std::memcpy(bindings.data(), base + offset, sizeof(DxvkBindingInfo) * header.bindingCount);
+
+      offset += sizeof(DxvkBindingInfo) * header.bindingCount;
+      code = SpirvCodeBuffer(header.codeSize, reinterpret_cast<const uint32_t*>(base + offset));
+
+      info.stage = VkShaderStageFlagBits(Type == D3D9ShaderCacheEntryType::FixedFunctionVS
+        ? VK_SHADER_STAGE_VERTEX_BIT : (Type == D3D9ShaderCacheEntryType::FixedFunctionFS
+        ? VK_SHADER_STAGE_FRAGMENT_BIT : VK_SHADER_STAGE_GEOMETRY_BIT));
+      info.inputMask = header.inputMask;
+      info.outputMask = header.outputMask;
+      info.flatShadingInputs = header.flatShadingInputs;
+      info.pushConstStages = header.pushConstStages;
+      info.pushConstSize = header.pushConstSize;
+    }
+
+    info.bindingCount = bindings.size();
+    info.bindings = bindings.data();
+
+    return new DxvkShader(info, std::move(code));
+  }
+
+
+  void D3D9ShaderCacheFile::Store(
+          D3D9ShaderCacheEntryType  Type,
+    const std::string&              Key,
+    const Rc<DxvkShader>&           Shader) {
+    std::string key = MakeKey(Type, Key.data(), Key.size());
+
+    std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+    if (!m_file.isOpen() || m_entries.find(key) != m_entries.end())
+      return;
+
+    // The shader does not retain its create info bindings,
+    // but we can recover them from the binding layout.
+    const DxvkShaderCreateInfo& info = Shader->info();
+    const DxvkBindingLayout& layout = Shader->getBindings();
+
+    std::vector<DxvkBindingInfo> bindings;
+
+    for (uint32_t i = 0; i < DxvkDescriptorSets::SetCount; i++) {
+      for (uint32_t j = 0; j < layout.getBindingCount(i); j++)
+        bindings.push_back(layout.getBinding(i, j));
+    }
+
+    SpirvCodeBuffer code = Shader->getRawCode();
+
+    D3D9ShaderCacheEntryHeader header = { };
+    header.type = Type;
+    header.keySize = Key.size();
+    header.bindingCount = bindings.size();
+    header.codeSize = code.dwords();
+    header.inputMask = info.inputMask;
+    header.outputMask = info.outputMask;
+    header.flatShadingInputs = info.flatShadingInputs;
+    header.pushConstStages = info.pushConstStages;
+    header.pushConstSize = info.pushConstSize;
+    header.entrySize = GetEntrySize(header.keySize, header.bindingCount, header.codeSize);
+
+    size_t offset = GetHeader()->dataSize;
+
+    if (!Grow(offset + header.entrySize)) {
+      Logger::warn("D3D9: Failed to grow shader cache file");
+      m_file.close();
+      return;
+    }
+
+    auto base = reinterpret_cast<char*>(m_file.data()) + offset;
+    std::memset(base, 0, header.entrySize);
+    std::memcpy(base, &header, sizeof(header));
+
+    size_t dataOffset = sizeof(header);
+    std::memcpy(base + dataOffset, Key.data(), Key.size());
+
+    dataOffset += align(header.keySize, sizeof(uint32_t));
+    std::memcpy(base + dataOffset, bindings.data(), sizeof(DxvkBindingInfo) * bindings.size());
+
+    dataOffset += sizeof(DxvkBindingInfo) * bindings.size();
+    std::memcpy(base + dataOffset, code.data(), code.size());
+
+    // Only publish the entry once all of its data is written
+    // so that a crash cannot leave a partial entry behind
+    auto fileHeader = GetHeader();
+    fileHeader->dataSize += header.entrySize;
+    fileHeader->entryCount += 1u;
+
+    m_entries.insert({ key, offset });
+    m_keys.push_back(std::move(key));
+  }
+
+
+  std::vector<std::string> D3D9ShaderCacheFile::GetKeys(
+          D3D9ShaderCacheEntryType  Type) {
+    std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+    std::vector<std::string> result;
+
+    for (const auto& key : m_keys) {
+      D3D9ShaderCacheEntryType type;
+      std::memcpy(&type, key.data(), sizeof(type));
+
+      if (type == Type)
+        result.push_back(key.substr(sizeof(type)));
+    }
+
+    return result;
+  }
+
+
+  bool D3D9ShaderCacheFile::Open() {
+    std::string useStateCache = env::getEnvVar("DXVK_STATE_CACHE");
+
+    m_codeHash = ComputeCodeHash();
+
+    str::path_string fileName = GetCacheFileName();
+
+    if (!m_file.open(fileName, true)) {
+      if (!env::createDirectory(env::getEnvVar("DXVK_STATE_CACHE_PATH"))
+       || !m_file.open(fileName, true)) {
+        Logger::warn("D3D9: Failed to open shader cache file");
+        return false;
+      }
+    }
+
+    // Another process with the same executable name may already be
+    // using the file, in which case we must not touch it at all
+    if (!m_file.lock()) {
+      Logger::warn("D3D9: Shader cache file is in use by another process");
+      return false;
+    }
+
+    auto header = GetHeader();
+
+    if (useStateCache == "reset" || !header
+     || std::memcmp(header->magic, "D9SC", 4)
+     || header->version != D3D9ShaderCacheVersion
+     || header->codeHash != m_codeHash
+     || header->dataSize > m_file.size())
+      return Reset();
+
+    // Read entry headers and build the lookup table. If we
+    // encounter an invalid entry, discard it and everything
+    // after it instead of discarding the entire file.
+    size_t offset = sizeof(D3D9ShaderCacheHeader);
+    uint32_t entryCount = 0;
+
+    auto base = reinterpret_cast<const char*>(m_file.data());
+
+    while (entryCount < header->entryCount && offset + sizeof(D3D9ShaderCacheEntryHeader) <= header->dataSize) {
+      D3D9ShaderCacheEntryHeader entry;
+      std::memcpy(&entry, base + offset, sizeof(entry));
+
+      if (entry.type > D3D9ShaderCacheEntryType::SoftwareVP
+       || entry.entrySize != GetEntrySize(entry.keySize, entry.bindingCount, entry.codeSize)
+       || offset + entry.entrySize > header->dataSize)
+        break;
+
+      std::string key = MakeKey(entry.type, base + offset + sizeof(entry), entry.keySize);
+
+      if (m_entries.insert({ key, offset }).second)
+        m_keys.push_back(std::move(key));
+
+      offset += entry.entrySize;
+      entryCount += 1u;
+    }
+
+    header->dataSize = offset;
+    header->entryCount = entryCount;
+    return true;
+  }
+
+
+  bool D3D9ShaderCacheFile::Reset() {
+    Logger::warn("D3D9: Creating new shader cache file");
+
+    m_keys.clear();
+    m_entries.clear();
+
+    if (!m_file.resize(0) || !Grow(sizeof(D3D9ShaderCacheHeader)))
+      return false;
+
+    D3D9ShaderCacheHeader header = { };
+    std::memcpy(header.magic, "D9SC", 4);
+    header.version = D3D9ShaderCacheVersion;
+    header.codeHash = m_codeHash;
+    header.entryCount = 0;
+    header.dataSize = sizeof(header);
+
+    std::memcpy(m_file.data(), &header, sizeof(header));
+    return true;
+  }
+
+
+  bool D3D9ShaderCacheFile::Grow(
+          size_t                    Size) {
+    if (Size <= m_file.size())
+      return true;
+
+    size_t newSize = std::max(D3D9ShaderCacheMinSize, m_file.size());
+
+    while (newSize < Size)
+      newSize *= 2u;
+
+    return m_file.resize(newSize);
+  }
+
+
+  D3D9ShaderCacheHeader* D3D9ShaderCacheFile::GetHeader() const {
+    if (m_file.size() < sizeof(D3D9ShaderCacheHeader))
+      return nullptr;
+
+    return reinterpret_cast<D3D9ShaderCacheHeader*>(m_file.data());
+  }
+
+
+  std::string D3D9ShaderCacheFile::MakeKey(
+          D3D9ShaderCacheEntryType  Type,
+    const void*                     pKey,
+          size_t                    KeySize) {
+    std::string key(sizeof(Type) + KeySize, '\0');
+    std::memcpy(key.data(), &Type, sizeof(Type));
+    std::memcpy(key.data() + sizeof(Type), pKey, KeySize);
+    return key;
+  }
+
+
+  Sha1Hash D3D9ShaderCacheFile::ComputeCodeHash() {
+    // The version string is generated by git describe and thus
+    // identifies the exact commit, including local modifications.
+    // Also include key sizes in case the key layout changes.
+    std::string data = str::format(DXVK_VERSION,
+      ";vsKey=", sizeof(D3D9FFShaderKeyVS),
+      ";fsKey=", sizeof(D3D9FFShaderKeyFS),
+      ";swvpKey=", sizeof(uint16_t) * 3u);
+
+    return Sha1Hash::compute(data.data(), data.size());
+  }
+
+
+  str::path_string D3D9ShaderCacheFile::GetCacheFileName() {
+    std::string path = env::getEnvVar("DXVK_STATE_CACHE_PATH");
+
+    if (!path.empty() && *path.rbegin() != '/')
+      path += '/';
+
+    path += env::getExeBaseName() + ".dxvk-d3d9-cache";
+    return str::topath(path.c_str());
+  }
+
+
+
+  D3D9ShaderCache::D3D9ShaderCache(
+          D3D9DeviceEx*             pDevice) {
+    // Use the same settings as the state cache, since the
+    // main purpose of this is to compile cached pipelines
+    std::string useStateCache = env::getEnvVar("DXVK_STATE_CACHE");
+
+    if (useStateCache == "0" || useStateCache == "disable"
+     || !pDevice->GetDXVKDevice()->config().enableStateCache
+     || !pDevice->GetOptions()->shaderModuleCache)
+      return;
+
+    m_file = g_shaderCacheFile.acquire();
+    m_optionsHash = ComputeOptionsHash(pDevice);
+  }
+
+
+  D3D9ShaderCache::~D3D9ShaderCache() {
+    StopPreload();
+
+    if (m_file != nullptr) {
+      m_file = nullptr;
+      g_shaderCacheFile.release();
+    }
+  }
+
+
+  Rc<DxvkShader> D3D9ShaderCache::Lookup(
+          D3D9ShaderCacheEntryType  Type,
+    const void*                     pKey,
+          size_t                    KeySize) {
+    if (m_file == nullptr)
+      return nullptr;
+
+    return m_file->Lookup(Type, MakeKey(pKey, KeySize));
+  }
+
+
+  void D3D9ShaderCache::Store(
+          D3D9ShaderCacheEntryType  Type,
+    const void*                     pKey,
+          size_t                    KeySize,
+    const Rc<DxvkShader>&           Shader) {
+    if (m_file == nullptr)
+      return;
+
+    m_file->Store(Type, MakeKey(pKey, KeySize), Shader);
+  }
+
+
+  std::vector<std::string> D3D9ShaderCache::GetKeys(
+          D3D9ShaderCacheEntryType  Type) {
+    std::vector<std::string> result;
+
+    if (m_file == nullptr)
+      return result;
+
+    for (auto& key : m_file->GetKeys(Type)) {
+      if (key.size() >= sizeof(m_optionsHash)
+       && !std::memcmp(key.data(), &m_optionsHash, sizeof(m_optionsHash)))
+        result.push_back(key.substr(sizeof(m_optionsHash)));
+    }
+
+    return result;
+  }
+
+
+  void D3D9ShaderCache::StartPreload(
+          std::function<void ()>&&  Func) {
+    if (m_file == nullptr)
+      return;
+
+    m_preloadThread = dxvk::thread([func = std::move(Func)] {
+      env::setThreadName("dxvk-d9-preload");
+      func();
+    });
+  }
+
+
+  void D3D9ShaderCache::StopPreload() {
+    m_preloadCanceled.store(true, std::memory_order_relaxed);
+
+    if (m_preloadThread.joinable())
+      m_preloadThread.join();
+  }
+
+
+  std::string D3D9ShaderCache::MakeKey(
+    const void*                     pKey,
+          size_t                    KeySize) const {
+    std::string key(sizeof(m_optionsHash) + KeySize, '\0');
+    std::memcpy(key.data(), &m_optionsHash, sizeof(m_optionsHash));
+    std::memcpy(key.data() + sizeof(m_optionsHash), pKey, KeySize);
+    return key;
+  }
+
+
+  Sha1Hash D3D9ShaderCache::ComputeOptionsHash(
+          D3D9DeviceEx*             pDevice) {
+    // Fixed-function shaders depend on some of the D3D9 options
+    D3D9FixedFunctionOptions options(pDevice->GetOptions());
+
+    std::string data = str::format(
+      "invariantPosition=", options.invariantPosition ? 1 : 0,
+      ";forceSampleRateShading=", options.forceSampleRateShading ? 1 : 0,
+      ";drefScaling=", options.drefScaling);
+
+    return Sha1Hash::compute(data.data(), data.size());
+  }
+
+}
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "d3d9_include.h"
+
+#include "../dxvk/dxvk_shader.h"
+
+#include "../util/util_mmap.h"
+
+#include "../util/sha1/sha1_util.h"
+
+namespace dxvk {
+
+  class D3D9DeviceEx;
+
+  /**
+   * \brief Shader cache entry type
+   *
+   * Identifies which generator produced a shader,
+   * and thus how the stored key is to be interpreted.
+   */
+  enum class D3D9ShaderCacheEntryType : uint32_t {
+    FixedFunctionVS = 0,
+    FixedFunctionFS = 1,
+    SoftwareVP      = 2,
+  };
+
+
+  /**
+   * \brief Shader cache file header
+   *
+   * The code hash covers the DXVK version, which includes
+   * the git commit that the generators were built from, as
+   * well as the layout of all generator keys. Files with a
+   * mismatching hash are discarded. Options that affect
+   * code generation are instead part of each entry key,
+   * so that devices with different options can share one
+   * file.
+   */
+  struct D3D9ShaderCacheHeader {
+    char      magic[4];
+    uint32_t  version;
+    Sha1Hash  codeHash;
+    uint32_t  entryCount;
+    uint64_t  dataSize;
+  };
+
+
+  /**
+   * \brief Shader cache entry header
+   *
+   * Followed by the key, padded to four bytes, the
+   * binding infos and finally the SPIR-V code.
+   */
+  struct D3D9ShaderCacheEntryHeader {
+    D3D9ShaderCacheEntryType type;
+    uint32_t  entrySize;
+    uint32_t  keySize;
+    uint32_t  bindingCount;
+    uint32_t  codeSize;
+    uint32_t  inputMask;
+    uint32_t  outputMask;
+    uint32_t  flatShadingInputs;
+    uint32_t  pushConstStages;
+    uint32_t  pushConstSize;
+  };
+
+
+  /**
+   * \brief Shader cache file
+   *
+   * Persists generated shaders in a memory-mapped file.
+   * There is only one instance per process, which holds
+   * an exclusive lock on the file so that processes with
+   * the same executable name cannot corrupt each other's
+   * data. Entries are only ever appended.
+   */
+  class D3D9ShaderCacheFile : public RcObject {
+
+  public:
+
+    D3D9ShaderCacheFile();
+
+    ~D3D9ShaderCacheFile();
+
+    /**
+     * \brief Looks up cached shader
+     *
+     * \param [in] Type Entry type
+     * \param [in] Key Entry key
+     * \returns Shader object without a shader key,
+     *    or \c nullptr if the shader is not cached.
+     */
+    Rc<DxvkShader> Lookup(
+            D3D9ShaderCacheEntryType  Type,
+      const std::string&              Key);
+
+    /**
+     * \brief Adds shader to the cache
+     *
+     * Does nothing if the file could not be opened
+     * or if a shader with the given key exists.
+     * \param [in] Type Entry type
+     * \param [in] Key Entry key
+     * \param [in] Shader The shader
+     */
+    void Store(
+            D3D9ShaderCacheEntryType  Type,
+      const std::string&              Key,
+      const Rc<DxvkShader>&           Shader);
+
+    /**
+     * \brief Retrieves all cached keys of a given type
+     *
+     * Keys are returned in insertion order.
+     * \param [in] Type Entry type
+     * \returns Entry keys
+     */
+    std::vector<std::string> GetKeys(
+            D3D9ShaderCacheEntryType  Type);
+
+  private:
+
+    dxvk::mutex                             m_mutex;
+
+    MappedFile                              m_file;
+    Sha1Hash                                m_codeHash;
+
+    std::vector<std::string>                m_keys;
+    std::unordered_map<std::string, size_t> m_entries;
+
+    bool Open();
+
+    bool Reset();
+
+    bool Grow(
+            size_t                    Size);
+
+    D3D9ShaderCacheHeader* GetHeader() const;
+
+    static std::string MakeKey(
+            D3D9ShaderCacheEntryType  Type,
+      const void*                     pKey,
+            size_t                    KeySize);
+
+    static Sha1Hash ComputeCodeHash();
+
+    static str::path_string GetCacheFileName();
+
+  };
+
+
+  /**
+   * \brief Fixed-function and SWVP shader cache
+   *
+   * Per-device view of the shader cache file. Keys are
+   * prefixed with a hash of the device options that affect
+   * code generation. Also manages a worker thread which
+   * recreates cached shaders after device creation, so that
+   * pipelines in the state cache that use them can get
+   * compiled early without delaying device creation.
+   */
+  class D3D9ShaderCache {
+
+  public:
+
+    D3D9ShaderCache(
+            D3D9DeviceEx*             pDevice);
+
+    ~D3D9ShaderCache();
+
+    D3D9ShaderCache             (const D3D9ShaderCache&) = delete;
+    D3D9ShaderCache& operator = (const D3D9ShaderCache&) = delete;
+
+    /**
+     * \brief Looks up cached shader
+     *
+     * \param [in] Type Entry type
+     * \param [in] pKey Generator key
+     * \param [in] KeySize Key size, in bytes
+     * \returns Shader object without a shader key,
+     *    or \c nullptr if the shader is not cached.
+     */
+    Rc<DxvkShader> Lookup(
+            D3D9ShaderCacheEntryType  Type,
+      const void*                     pKey,
+            size_t                    KeySize);
+
+    /**
+     * \brief Adds shader to the cache
+     *
+     * Does nothing if the cache is disabled or
+     * if a shader with the given key exists.
+     * \param [in] Type Entry type
+     * \param [in] pKey Generator key
+     * \param [in] KeySize Key size, in bytes
+     * \param [in] Shader The shader
+     */
+    void Store(
+            D3D9ShaderCacheEntryType  Type,
+      const void*                     pKey,
+            size_t                    KeySize,
+      const Rc<DxvkShader>&           Shader);
+
+    /**
+     * \brief Retrieves all cached keys of a given type
+     *
+     * Only returns keys that were stored with the same
+     * device options. Keys are returned in insertion order.
+     * \param [in] Type Entry type
+     * \returns Raw key data
+     */
+    std::vector<std::string> GetKeys(
+            D3D9ShaderCacheEntryType  Type);
+
+    /**
+     * \brief Starts preloading shaders
+     *
+     * Runs the given function on a worker thread.
+     * Does nothing if the cache is disabled.
+     * \param [in] Func Preload function
+     */
+    void StartPreload(
+            std::function<void ()>&&  Func);
+
+    /**
+     * \brief Stops preloading shaders
+     *
+     * Signals the worker thread to stop early and waits
+     * for it to finish. Must be called before any object
+     * that the preload function accesses is destroyed.
+     */
+    void StopPreload();
+
+    /**
+     * \brief Checks whether preloading should stop
+     * \returns \c true if the device is being destroyed
+     */
+    bool IsPreloadCanceled() const {
+      return m_preloadCanceled.load(std::memory_order_relaxed);
+    }
+
+  private:
+
+    Rc<D3D9ShaderCacheFile>                 m_file;
+    Sha1Hash                                m_optionsHash;
+
+    std::atomic<bool>                       m_preloadCanceled = { false };
+    dxvk::thread                            m_preloadThread;
+
+    std::string MakeKey(
+      const void*                     pKey,
+            size_t                    KeySize) const;
+
+    static Sha1Hash ComputeOptionsHash(
+            D3D9DeviceEx*             pDevice);
+
+  };
+
+}
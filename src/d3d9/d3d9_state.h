@@ -54,6 +54,19 @@ namespace dxvk {
     float pointScaleC  = 0.0f;
   };
 
+  /**
+   * \brief Sampler heap indices
+   *
+   * Stored in push constants right after the render
+   * state block, and written by the backend whenever
+   * sampler bindings change. Only used by shaders
+   * that read their samplers from the sampler heap.
+   */
+  struct D3D9SamplerHeapIndices {
+    uint16_t ps[caps::MaxTexturesPS];
+    uint16_t vs[caps::MaxTexturesVS];
+  };
+
   enum class D3D9RenderStateItem {
     FogColor   = 0,
     FogScale   = 1,
@@ -317,6 +330,51 @@ namespace dxvk {
   using D3D9CapturableState = D3D9State<dynamic_item>;
   using D3D9DeviceState = D3D9State<static_item>;
 
+  /**
+   * \brief Checks whether a constant update changes any values
+   *
+   * Compares the given constant data against the current state,
+   * taking float emulation into account. Only float and integer
+   * constants are compared, bool constants are always treated
+   * as changed.
+   * \returns \c true if the update does not change any constant
+   */
+  template <
+    DxsoProgramType  ProgramType,
+    D3D9ConstantType ConstantType,
+    typename         T,
+    typename         StateType>
+  bool IsRedundantConstantUpdate(
+    const StateType*           pState,
+          UINT                 StartRegister,
+    const T*                   pConstantData,
+          UINT                 Count,
+          bool                 FloatEmu) {
+    auto CompareHelper = [&] (const auto& set) {
+      if constexpr (ConstantType == D3D9ConstantType::Float) {
+        if (!FloatEmu)
+          return !std::memcmp(set->fConsts[StartRegister].data, pConstantData, Count * sizeof(Vector4));
+
+        for (UINT i = 0; i < Count; i++) {
+          Vector4 value = replaceNaN(pConstantData + (i * 4));
+
+          if (std::memcmp(set->fConsts[StartRegister + i].data, value.data, sizeof(value)))
+            return false;
+        }
+
+        return true;
+      } else if constexpr (ConstantType == D3D9ConstantType::Int) {
+        return !std::memcmp(set->iConsts[StartRegister].data, pConstantData, Count * sizeof(Vector4i));
+      } else {
+        return false;
+      }
+    };
+
+    return ProgramType == DxsoProgramTypes::VertexShader
+      ? CompareHelper(pState->vsConsts)
+      : CompareHelper(pState->psConsts);
+  }
+
   template <
     DxsoProgramType  ProgramType,
     D3D9ConstantType ConstantType,
@@ -1066,6 +1066,7 @@ namespace dxvk {
       hud->addItem<hud::HudSamplerCount>("samplers", -1, m_parent);
       hud->addItem<hud::HudFixedFunctionShaders>("ffshaders", -1, m_parent);
       hud->addItem<hud::HudSWVPState>("swvp", -1, m_parent);
+      hud->addItem<hud::HudConstantUploads>("constants", -1, m_parent);
 
 #ifdef D3D9_ALLOW_UNMAPPING
       hud->addItem<hud::HudTextureMemory>("memory", -1, m_parent);
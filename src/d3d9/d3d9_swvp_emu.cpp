@@ -324,9 +324,20 @@ namespace dxvk {
     
     // This shader has not been compiled yet, so we have to create a
     // new module. This takes a while, so we won't lock the structure.
-    D3D9SWVPEmulatorGenerator generator(name);
-    generator.compile(elements);
-    Rc<DxvkShader> shader = generator.finalize();
+    auto& cache = pDevice->GetShaderCache();
+    auto cacheKey = GetCacheKey(elements);
+
+    Rc<DxvkShader> shader = cache.Lookup(D3D9ShaderCacheEntryType::SoftwareVP,
+      cacheKey.data(), cacheKey.size() * sizeof(cacheKey[0]));
+
+    if (shader == nullptr) {
+      D3D9SWVPEmulatorGenerator generator(name);
+      generator.compile(elements);
+      shader = generator.finalize();
+
+      cache.Store(D3D9ShaderCacheEntryType::SoftwareVP,
+        cacheKey.data(), cacheKey.size() * sizeof(cacheKey[0]), shader);
+    }
 
     shader->setShaderKey(key);
     pDevice->GetDXVKDevice()->registerShader(shader);
@@ -355,4 +366,55 @@ namespace dxvk {
     return shader;
   }
 
+
+  void D3D9SWVPEmulator::Preload(D3D9DeviceEx* pDevice) {
+    auto& cache = pDevice->GetShaderCache();
+    auto keys = cache.GetKeys(D3D9ShaderCacheEntryType::SoftwareVP);
+
+    for (const auto& key : keys) {
+      if (cache.IsPreloadCanceled())
+        return;
+
+      std::array<uint16_t, 3> data;
+
+      if (key.size() % sizeof(data))
+        continue;
+
+      D3D9CompactVertexElements elements;
+
+      for (size_t i = 0; i < key.size(); i += sizeof(data)) {
+        std::memcpy(data.data(), &key[i], sizeof(data));
+
+        D3DVERTEXELEMENT9 element = { };
+        element.Stream      = (data[0] >>  0) & 0xf;
+        element.Type        = (data[0] >>  4) & 0x1f;
+        element.Method      = (data[0] >>  9) & 0x7;
+        element.Usage       = (data[0] >> 12) & 0xf;
+        element.UsageIndex  = data[1];
+        element.Offset      = data[2];
+
+        elements.push_back(element);
+      }
+
+      GetShaderModule(pDevice, std::move(elements));
+    }
+  }
+
+
+  std::vector<uint16_t> D3D9SWVPEmulator::GetCacheKey(
+    const D3D9CompactVertexElements& elements) {
+    // Pack fields explicitly rather than copying the raw
+    // bit fields, whose layout is implementation-defined
+    std::vector<uint16_t> key;
+    key.reserve(elements.size() * 3u);
+
+    for (const auto& e : elements) {
+      key.push_back(uint16_t(e.Stream | (e.Type << 4) | (e.Method << 9) | (e.Usage << 12)));
+      key.push_back(e.UsageIndex);
+      key.push_back(e.Offset);
+    }
+
+    return key;
+  }
+
 }
\ No newline at end of file
@@ -40,6 +40,12 @@ namespace dxvk {
 
     Rc<DxvkShader> GetShaderModule(D3D9DeviceEx* pDevice,  D3D9CompactVertexElements&& elements);
 
+    /**
+     * \brief Creates all shaders found in the shader cache
+     * \param [in] pDevice The device
+     */
+    void Preload(D3D9DeviceEx* pDevice);
+
     UINT GetShaderCount() const {
       return m_modules.size();
     }
@@ -52,6 +58,9 @@ namespace dxvk {
       D3D9CompactVertexElements, Rc<DxvkShader>,
       D3D9VertexDeclHash, D3D9VertexDeclEq>   m_modules;
 
+    static std::vector<uint16_t> GetCacheKey(
+      const D3D9CompactVertexElements& elements);
+
   };
 
 }
@@ -58,6 +58,10 @@ namespace dxvk {
       m_vRegs.at(i) = DxbcRegisterPointer { };
       m_oRegs.at(i) = DxbcRegisterPointer { };
     }
+
+    // Hull and domain shaders keep using sampler descriptors
+    m_useSamplerHeap = m_moduleInfo.options.useSamplerHeap
+      && computeSamplerHeapIndexOffset(m_programInfo.type());
     
     this->emitInit();
   }
@@ -257,10 +261,15 @@ namespace dxvk {
     info.outputMask = m_outputMask;
     info.uniformSize = m_immConstData.size();
     info.uniformData = m_immConstData.data();
+    info.samplerHeapBindingCount = m_samplerHeapBindings.size();
+    info.samplerHeapBindings = m_samplerHeapBindings.data();
     info.pushConstStages = VK_SHADER_STAGE_FRAGMENT_BIT;
     info.pushConstSize = sizeof(DxbcPushConstants);
     info.outputTopology = m_outputTopology;
 
+    if (!m_samplerHeapBindings.empty())
+      info.pushConstStages |= m_programInfo.shaderStage();
+
     if (m_programInfo.type() == DxbcProgramType::HullShader)
       info.patchVertexCount = m_hs.vertexCountIn;
 
@@ -895,6 +904,30 @@ namespace dxvk {
     // The sampler type is opaque, but we still have to
     // define a pointer and a variable in oder to use it
     const uint32_t samplerType = m_module.defSamplerType();
+    
+    // Compute binding slot index for the sampler
+    uint32_t bindingId = computeSamplerBinding(
+      m_programInfo.type(), samplerId);
+    
+    m_samplers.at(samplerId).typeId = samplerType;
+    m_samplers.at(samplerId).index  = samplerId;
+    
+    if (m_useSamplerHeap) {
+      // Read the sampler from the global heap, using
+      // the heap index that is passed in push constants
+      if (!m_samplerHeapId)
+        m_samplerHeapId = emitSamplerHeap();
+      
+      m_samplers.at(samplerId).varId = m_samplerHeapId;
+      
+      DxvkSamplerHeapBinding binding = { };
+      binding.resourceBinding = bindingId;
+      binding.pushConstOffset = computeSamplerHeapIndexOffset(m_programInfo.type())
+                              + sizeof(uint16_t) * samplerId;
+      m_samplerHeapBindings.push_back(binding);
+      return;
+    }
+    
     const uint32_t samplerPtrType = m_module.defPointerType(
       samplerType, spv::StorageClassUniformConstant);
     
@@ -905,11 +938,6 @@ namespace dxvk {
       str::format("s", samplerId).c_str());
     
     m_samplers.at(samplerId).varId  = varId;
-    m_samplers.at(samplerId).typeId = samplerType;
-    
-    // Compute binding slot index for the sampler
-    uint32_t bindingId = computeSamplerBinding(
-      m_programInfo.type(), samplerId);
     
     m_module.decorateDescriptorSet(varId, 0);
     m_module.decorateBinding(varId, bindingId);
@@ -5144,7 +5172,39 @@ namespace dxvk {
 
     return m_module.opSampledImage(sampledImageType,
       m_module.opLoad(textureResource.imageTypeId, textureResource.varId),
-      m_module.opLoad(samplerResource.typeId,      samplerResource.varId));
+      emitLoadSampler(samplerResource));
+  }
+
+
+  uint32_t DxbcCompiler::emitLoadSampler(
+    const DxbcSampler&            samplerResource) {
+    if (!m_useSamplerHeap)
+      return m_module.opLoad(samplerResource.typeId, samplerResource.varId);
+
+    if (!m_pushConstantId)
+      m_pushConstantId = emitPushConstants();
+
+    // Heap indices are packed into dwords, two at a time
+    uint32_t uintTypeId = m_module.defIntType(32, 0);
+
+    std::array<uint32_t, 2> indices = {{
+      m_module.constu32(1),
+      m_module.constu32(samplerResource.index / 2u),
+    }};
+
+    uint32_t heapIndex = m_module.opLoad(uintTypeId,
+      m_module.opAccessChain(m_module.defPointerType(uintTypeId, spv::StorageClassPushConstant),
+        m_pushConstantId, indices.size(), indices.data()));
+
+    heapIndex = m_module.opBitFieldUExtract(uintTypeId, heapIndex,
+      m_module.constu32(16u * (samplerResource.index & 1u)),
+      m_module.constu32(16u));
+
+    uint32_t ptrTypeId = m_module.defPointerType(
+      samplerResource.typeId, spv::StorageClassUniformConstant);
+
+    return m_module.opLoad(samplerResource.typeId,
+      m_module.opAccessChain(ptrTypeId, samplerResource.varId, 1, &heapIndex));
   }
   
   
@@ -5578,8 +5638,8 @@ namespace dxvk {
     if (resource.type == DxbcOperandType::Rasterizer) {
       // SPIR-V has no gl_NumSamples equivalent, so we
       // have to work around it using a push constant
-      if (!m_ps.pushConstantId)
-        m_ps.pushConstantId = emitPushConstants();
+      if (!m_pushConstantId)
+        m_pushConstantId = emitPushConstants();
 
       uint32_t uintTypeId = m_module.defIntType(32, 0);
       uint32_t ptrTypeId = m_module.defPointerType(uintTypeId, spv::StorageClassPushConstant);
@@ -5589,7 +5649,7 @@ namespace dxvk {
       result.type.ctype  = DxbcScalarType::Uint32;
       result.type.ccount = 1;
       result.id = m_module.opLoad(uintTypeId,
-        m_module.opAccessChain(ptrTypeId, m_ps.pushConstantId, 1, &index));
+        m_module.opAccessChain(ptrTypeId, m_pushConstantId, 1, &index));
       return result;
     } else {
       DxbcBufferInfo info = getBufferInfo(resource);
@@ -7679,12 +7739,32 @@ namespace dxvk {
   
   uint32_t DxbcCompiler::emitPushConstants() {
     uint32_t uintTypeId = m_module.defIntType(32, 0);
-    uint32_t structTypeId = m_module.defStructTypeUnique(1, &uintTypeId);
 
+    std::array<uint32_t, 2> memberTypes = {{ uintTypeId, 0u }};
+    uint32_t memberCount = 1;
+
+    // Only declare the heap indices used by the current stage
+    if (m_useSamplerHeap) {
+      uint32_t arrayTypeId = m_module.defArrayTypeUnique(uintTypeId,
+        m_module.constu32(DxbcSamplerBindingCount / 2u));
+      m_module.decorateArrayStride(arrayTypeId, sizeof(uint32_t));
+
+      memberTypes[memberCount++] = arrayTypeId;
+    }
+
+    uint32_t structTypeId = m_module.defStructTypeUnique(memberCount, memberTypes.data());
+
+    m_module.decorateBlock(structTypeId);
     m_module.setDebugName(structTypeId, "pc_t");
     m_module.setDebugMemberName(structTypeId, 0, "RasterizerSampleCount");
     m_module.memberDecorateOffset(structTypeId, 0, 0);
 
+    if (m_useSamplerHeap) {
+      m_module.setDebugMemberName(structTypeId, 1, "SamplerHeapIndices");
+      m_module.memberDecorateOffset(structTypeId, 1,
+        computeSamplerHeapIndexOffset(m_programInfo.type()));
+    }
+
     uint32_t ptrTypeId = m_module.defPointerType(structTypeId, spv::StorageClassPushConstant);
     uint32_t varId = m_module.newVar(ptrTypeId, spv::StorageClassPushConstant);
 
@@ -7693,6 +7773,22 @@ namespace dxvk {
   }
 
 
+  uint32_t DxbcCompiler::emitSamplerHeap() {
+    uint32_t samplerTypeId = m_module.defSamplerType();
+    uint32_t arrayTypeId = m_module.defArrayType(samplerTypeId,
+      m_module.constu32(DxvkSamplerHeapInfo::DescriptorCount));
+
+    uint32_t varId = m_module.newVar(
+      m_module.defPointerType(arrayTypeId, spv::StorageClassUniformConstant),
+      spv::StorageClassUniformConstant);
+
+    m_module.setDebugName(varId, "sampler_heap");
+    m_module.decorateDescriptorSet(varId, 0);
+    m_module.decorateBinding(varId, DxvkSamplerHeapInfo::ShaderBinding);
+    return varId;
+  }
+
+
   DxbcCfgBlock* DxbcCompiler::cfgFindBlock(
     const std::initializer_list<DxbcCfgBlockType>& types) {
     for (auto cur =  m_controlFlowBlocks.rbegin();
@@ -191,8 +191,6 @@ namespace dxvk {
     uint32_t builtinLayer         = 0;
     uint32_t builtinViewportId    = 0;
     uint32_t builtinInnerCoverageId = 0;
-    
-    uint32_t pushConstantId       = 0;
   };
   
   
@@ -421,6 +419,7 @@ namespace dxvk {
     // Resource slot description for the shader. This will
     // be used to map D3D11 bindings to DXVK bindings.
     std::vector<DxvkBindingInfo> m_bindings;
+    std::vector<DxvkSamplerHeapBinding> m_samplerHeapBindings;
     
     ////////////////////////////////////////////////
     // Temporary r# vector registers with immediate
@@ -465,6 +464,17 @@ namespace dxvk {
     std::array<DxbcShaderResource, 128> m_textures;
     std::array<DxbcUav,             64> m_uavs;
 
+    ///////////////////////////////////////////////
+    // Global sampler heap, used instead of sampler
+    // descriptors if supported for the stage
+    bool m_useSamplerHeap = false;
+    uint32_t m_samplerHeapId = 0;
+
+    ///////////////////////////////////////////////
+    // Push constant block. Lazily declared if
+    // the shader needs any push constant data.
+    uint32_t m_pushConstantId = 0;
+
     bool m_hasGloballyCoherentUav = false;
     bool m_hasRasterizerOrderedUav = false;
 
@@ -932,6 +942,9 @@ namespace dxvk {
       const DxbcShaderResource&     textureResource,
       const DxbcSampler&            samplerResource,
             bool                    isDepthCompare);
+
+    uint32_t emitLoadSampler(
+      const DxbcSampler&            samplerResource);
     
     ////////////////////////
     // Address load methods
@@ -1191,6 +1204,8 @@ namespace dxvk {
 
     uint32_t emitPushConstants();
 
+    uint32_t emitSamplerHeap();
+
     ////////////////
     // Misc methods
     DxbcCfgBlock* cfgFindBlock(
@@ -48,6 +48,7 @@ namespace dxvk {
   struct DxbcSampler {
     uint32_t varId  = 0;
     uint32_t typeId = 0;
+    uint32_t index  = 0;
   };
   
   
@@ -30,6 +30,9 @@ namespace dxvk {
     /// Determines whether raw access chains are supported
     bool supportsRawAccessChains = false;
 
+    /// Read samplers from the global sampler heap
+    bool useSamplerHeap = false;
+
     /// Clear thread-group shared memory to zero
     bool zeroInitWorkgroupMemory = false;
 
@@ -7,9 +7,16 @@ namespace dxvk {
 
   /**
    * \brief Push constant struct
+   *
+   * Sampler heap indices are stored as 16-bit integers. Pixel
+   * and compute shaders share the same set of indices since
+   * they are never used within the same pipeline.
    */
   struct DxbcPushConstants {
     uint32_t rasterizerSampleCount;
+    uint16_t psSamplerHeapIndices[16];
+    uint16_t vsSamplerHeapIndices[16];
+    uint16_t gsSamplerHeapIndices[16];
   };
 
 
@@ -68,6 +75,31 @@ namespace dxvk {
   }
 
 
+  /**
+   * \brief Computes offset of sampler heap indices for a given stage
+   *
+   * Hull and domain shaders do not support the sampler heap,
+   * since indices for all stages would not fit into the
+   * available push constant space.
+   * \param [in] stage Shader stage
+   * \returns Push constant offset of the first heap index,
+   *    or \c 0 if the stage does not use the sampler heap.
+   */
+  inline uint32_t computeSamplerHeapIndexOffset(DxbcProgramType stage) {
+    switch (stage) {
+      case DxbcProgramType::PixelShader:
+      case DxbcProgramType::ComputeShader:
+        return offsetof(DxbcPushConstants, psSamplerHeapIndices);
+      case DxbcProgramType::VertexShader:
+        return offsetof(DxbcPushConstants, vsSamplerHeapIndices);
+      case DxbcProgramType::GeometryShader:
+        return offsetof(DxbcPushConstants, gsSamplerHeapIndices);
+      default:
+        return 0u;
+    }
+  }
+
+
   /**
    * \brief Computes sampler binding index
    * 
@@ -42,6 +42,8 @@ namespace dxvk {
     m_usedSamplers = 0;
     m_usedRTs      = 0;
     m_textureTypes = 0;
+
+    m_useSamplerHeap = m_moduleInfo.options.useSamplerHeap;
     m_rRegs.reserve(DxsoMaxTempRegs);
 
     for (uint32_t i = 0; i < m_rRegs.size(); i++)
@@ -229,9 +231,14 @@ namespace dxvk {
     info.bindings = m_bindings.data();
     info.inputMask = m_inputMask;
     info.outputMask = m_outputMask;
+    info.samplerHeapBindingCount = m_samplerHeapBindings.size();
+    info.samplerHeapBindings = m_samplerHeapBindings.data();
     info.pushConstStages = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT;
     info.pushConstSize = sizeof(D3D9RenderStateInfo);
 
+    if (m_useSamplerHeap)
+      info.pushConstSize += sizeof(D3D9SamplerHeapIndices);
+
     if (m_programInfo.type() == DxsoProgramTypes::PixelShader)
       info.flatShadingInputs = m_ps.flatShadingMask;
 
@@ -690,7 +697,11 @@ namespace dxvk {
 
     VkImageViewType viewType = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
 
-    auto DclSampler = [this, &viewType](
+    // Position of the heap index within the push constant array
+    const uint32_t heapIndex = m_programInfo.type() == DxsoProgramTypes::PixelShader
+      ? idx : caps::MaxTexturesPS + idx;
+
+    auto DclSampler = [this, &viewType, heapIndex](
       uint32_t        idx,
       uint32_t        bindingId,
       DxsoSamplerType type,
@@ -734,10 +745,14 @@ namespace dxvk {
         spv::ImageFormatUnknown);
 
       sampler.typeId = m_module.defSampledImageType(sampler.imageTypeId);
+      sampler.index = heapIndex;
 
+      // With the sampler heap, only the image itself is bound
+      // to the resource slot, and is combined at sample time.
       sampler.varId = m_module.newVar(
         m_module.defPointerType(
-          sampler.typeId, spv::StorageClassUniformConstant),
+          m_useSamplerHeap ? sampler.imageTypeId : sampler.typeId,
+          spv::StorageClassUniformConstant),
         spv::StorageClassUniformConstant);
 
       std::string name = str::format("s", idx, suffix, depth ? "_shadow" : "");
@@ -784,11 +799,24 @@ namespace dxvk {
     m_samplers[idx].type = type;
 
     // Store descriptor info for the shader interface
-    DxvkBindingInfo bindingInfo = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER };
+    DxvkBindingInfo bindingInfo = { m_useSamplerHeap
+      ? VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE
+      : VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER };
     bindingInfo.resourceBinding = binding;
     bindingInfo.viewType        = implicit ? VK_IMAGE_VIEW_TYPE_MAX_ENUM : viewType;
     bindingInfo.access          = VK_ACCESS_SHADER_READ_BIT;
     m_bindings.push_back(bindingInfo);
+
+    if (m_useSamplerHeap) {
+      if (!m_samplerHeapId)
+        m_samplerHeapId = emitSamplerHeap();
+
+      DxvkSamplerHeapBinding heapBinding = { };
+      heapBinding.resourceBinding = binding;
+      heapBinding.pushConstOffset = sizeof(D3D9RenderStateInfo)
+                                  + sizeof(uint16_t) * heapIndex;
+      m_samplerHeapBindings.push_back(heapBinding);
+    }
   }
 
 
@@ -3139,7 +3167,7 @@ void DxsoCompiler::emitControlFlowGenericLoop(
        (operands.flags & spv::ImageOperandsLodMask)
     || (operands.flags & spv::ImageOperandsGradMask);
 
-    const uint32_t sampledImage = m_module.opLoad(samplerInfo.typeId, samplerInfo.varId);
+    const uint32_t sampledImage = emitLoadSampledImage(samplerInfo);
 
     uint32_t val;
 
@@ -3572,7 +3600,55 @@ void DxsoCompiler::emitControlFlowGenericLoop(
 
 
   void DxsoCompiler::setupRenderStateInfo() {
-    m_rsBlock = SetupRenderStateBlock(m_module);
+    m_rsBlock = SetupRenderStateBlock(m_module, m_useSamplerHeap);
+  }
+
+
+  uint32_t DxsoCompiler::emitSamplerHeap() {
+    uint32_t samplerType = m_module.defSamplerType();
+    uint32_t arrayType = m_module.defArrayType(samplerType,
+      m_module.constu32(DxvkSamplerHeapInfo::DescriptorCount));
+
+    uint32_t varId = m_module.newVar(
+      m_module.defPointerType(arrayType, spv::StorageClassUniformConstant),
+      spv::StorageClassUniformConstant);
+
+    m_module.setDebugName         (varId, "sampler_heap");
+    m_module.decorateDescriptorSet(varId, 0);
+    m_module.decorateBinding      (varId, DxvkSamplerHeapInfo::ShaderBinding);
+    return varId;
+  }
+
+
+  uint32_t DxsoCompiler::emitLoadSampledImage(
+    const DxsoSamplerInfo&        samplerInfo) {
+    if (!m_useSamplerHeap)
+      return m_module.opLoad(samplerInfo.typeId, samplerInfo.varId);
+
+    // Heap indices are packed into dwords, two at a time
+    uint32_t uintType = m_module.defIntType(32, 0);
+    uint32_t samplerType = m_module.defSamplerType();
+
+    std::array<uint32_t, 2> indices = {{
+      m_module.constu32(uint32_t(D3D9RenderStateItem::Count)),
+      m_module.constu32(samplerInfo.index / 2u),
+    }};
+
+    uint32_t heapIndex = m_module.opLoad(uintType,
+      m_module.opAccessChain(m_module.defPointerType(uintType, spv::StorageClassPushConstant),
+        m_rsBlock, indices.size(), indices.data()));
+
+    heapIndex = m_module.opBitFieldUExtract(uintType, heapIndex,
+      m_module.constu32(16u * (samplerInfo.index & 1u)),
+      m_module.constu32(16u));
+
+    uint32_t sampler = m_module.opLoad(samplerType,
+      m_module.opAccessChain(m_module.defPointerType(samplerType, spv::StorageClassUniformConstant),
+        m_samplerHeapId, 1, &heapIndex));
+
+    return m_module.opSampledImage(samplerInfo.typeId,
+      m_module.opLoad(samplerInfo.imageTypeId, samplerInfo.varId),
+      sampler);
   }
 
 
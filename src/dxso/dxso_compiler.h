@@ -106,6 +106,8 @@ namespace dxvk {
     uint32_t typeId = 0;
 
     uint32_t imageTypeId = 0;
+
+    uint32_t index = 0;
   };
 
   enum DxsoSamplerType : uint32_t {
@@ -269,6 +271,7 @@ namespace dxvk {
     // Resource slot description for the shader. This will
     // be used to map D3D9 bindings to DXVK bindings.
     std::vector<DxvkBindingInfo>  m_bindings;
+    std::vector<DxvkSamplerHeapBinding> m_samplerHeapBindings;
 
     ////////////////////////////////////////////////
     // Temporary r# vector registers with immediate
@@ -366,6 +369,12 @@ namespace dxvk {
     uint32_t m_rsBlock = 0;
     uint32_t m_mainFuncLabel = 0;
 
+    /////////////////////////////////////////////
+    // Global sampler heap, if samplers are read
+    // from the heap rather than combined images
+    bool     m_useSamplerHeap = false;
+    uint32_t m_samplerHeapId = 0;
+
     //////////////////////////////////////
     // Common function definition methods
     void emitInit();
@@ -682,6 +691,12 @@ namespace dxvk {
 
     void emitVsClipping();
     void setupRenderStateInfo();
+
+    uint32_t emitSamplerHeap();
+
+    uint32_t emitLoadSampledImage(
+      const DxsoSamplerInfo&        samplerInfo);
+
     void emitFog();
     void emitPsProcessing();
     void emitOutputDepthClamp();
@@ -30,6 +30,8 @@ namespace dxvk {
     robustness2Supported = devFeatures.extRobustness2.robustBufferAccess2;
 
     drefScaling         = options.drefScaling;
+
+    useSamplerHeap      = device->canUseSamplerHeap();
   }
 
 }
\ No newline at end of file
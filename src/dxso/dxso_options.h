@@ -47,6 +47,9 @@ namespace dxvk {
     /// that expect a different depth test range, which was typically a D3D8 quirk on
     /// early NVIDIA hardware.
     int32_t drefScaling = 0;
+
+    /// Read samplers from the global sampler heap
+    bool useSamplerHeap = false;
   };
 
 }
\ No newline at end of file
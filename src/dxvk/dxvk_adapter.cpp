@@ -106,11 +106,15 @@ namespace dxvk {
       externalInfo.pNext = std::exchange(info.pNext, &externalInfo);
 
     VkExternalImageFormatProperties externalProperties = { VK_STRUCTURE_TYPE_EXTERNAL_IMAGE_FORMAT_PROPERTIES };
+    VkHostImageCopyDevicePerformanceQueryEXT hostCopyProperties = { VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY_EXT };
     VkImageFormatProperties2 properties = { VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2 };
 
     if (externalInfo.handleType)
       externalProperties.pNext = std::exchange(properties.pNext, &externalProperties);
 
+    if (query.usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT)
+      hostCopyProperties.pNext = std::exchange(properties.pNext, &hostCopyProperties);
+
     VkResult vr = m_vki->vkGetPhysicalDeviceImageFormatProperties2(
       m_handle, &info, &properties);
 
@@ -124,6 +128,7 @@ namespace dxvk {
     result.sampleCounts     = properties.imageFormatProperties.sampleCounts;
     result.maxResourceSize  = properties.imageFormatProperties.maxResourceSize;
     result.externalFeatures = externalProperties.externalMemoryProperties.externalMemoryFeatures;
+    result.optimalHostImageCopy = hostCopyProperties.optimalDeviceAccess;
     return result;
   }
 
@@ -227,6 +232,9 @@ namespace dxvk {
         && CHECK_FEATURE_NEED(core.features.inheritedQueries)
         && CHECK_FEATURE_NEED(vk11.shaderDrawParameters)
         && CHECK_FEATURE_NEED(vk12.samplerMirrorClampToEdge)
+        && CHECK_FEATURE_NEED(vk12.descriptorBindingSampledImageUpdateAfterBind)
+        && CHECK_FEATURE_NEED(vk12.descriptorBindingUpdateUnusedWhilePending)
+        && CHECK_FEATURE_NEED(vk12.descriptorBindingPartiallyBound)
         && CHECK_FEATURE_NEED(vk12.drawIndirectCount)
         && CHECK_FEATURE_NEED(vk12.hostQueryReset)
         && CHECK_FEATURE_NEED(vk12.timelineSemaphore)
@@ -256,6 +264,7 @@ namespace dxvk {
         && CHECK_FEATURE_NEED(extRobustness2.robustImageAccess2)
         && CHECK_FEATURE_NEED(extRobustness2.nullDescriptor)
         && CHECK_FEATURE_NEED(extShaderModuleIdentifier.shaderModuleIdentifier)
+        && CHECK_FEATURE_NEED(extShaderObject.shaderObject)
         && CHECK_FEATURE_NEED(extShaderStencilExport)
         && CHECK_FEATURE_NEED(extSwapchainColorSpace)
         && CHECK_FEATURE_NEED(extSwapchainMaintenance1.swapchainMaintenance1)
@@ -351,6 +360,16 @@ namespace dxvk {
     // Required for proper GPU synchronization
     enabledFeatures.vk12.timelineSemaphore = VK_TRUE;
 
+    // Used for the global sampler heap
+    enabledFeatures.core.features.shaderSampledImageArrayDynamicIndexing =
+      m_deviceFeatures.core.features.shaderSampledImageArrayDynamicIndexing;
+    enabledFeatures.vk12.descriptorBindingSampledImageUpdateAfterBind =
+      m_deviceFeatures.vk12.descriptorBindingSampledImageUpdateAfterBind;
+    enabledFeatures.vk12.descriptorBindingUpdateUnusedWhilePending =
+      m_deviceFeatures.vk12.descriptorBindingUpdateUnusedWhilePending;
+    enabledFeatures.vk12.descriptorBindingPartiallyBound =
+      m_deviceFeatures.vk12.descriptorBindingPartiallyBound;
+
     // Only enable the base image robustness feature if robustness 2 isn't
     // supported, since this is only a subset of what we actually want.
     enabledFeatures.vk13.robustImageAccess =
@@ -388,11 +407,23 @@ namespace dxvk {
     enabledFeatures.extExtendedDynamicState3.extendedDynamicState3LineRasterizationMode =
       m_deviceFeatures.extExtendedDynamicState3.extendedDynamicState3LineRasterizationMode;
 
+    // Used to keep blend state out of graphics pipeline keys
+    enabledFeatures.extExtendedDynamicState3.extendedDynamicState3ColorBlendEnable =
+      m_deviceFeatures.extExtendedDynamicState3.extendedDynamicState3ColorBlendEnable;
+    enabledFeatures.extExtendedDynamicState3.extendedDynamicState3ColorBlendEquation =
+      m_deviceFeatures.extExtendedDynamicState3.extendedDynamicState3ColorBlendEquation;
+    enabledFeatures.extExtendedDynamicState3.extendedDynamicState3ColorWriteMask =
+      m_deviceFeatures.extExtendedDynamicState3.extendedDynamicState3ColorWriteMask;
+
     // Used for both pNext shader module info, and fast-linking pipelines provided
     // that graphicsPipelineLibraryIndependentInterpolationDecoration is supported
     enabledFeatures.extGraphicsPipelineLibrary.graphicsPipelineLibrary =
       m_deviceFeatures.extGraphicsPipelineLibrary.graphicsPipelineLibrary;
 
+    // Used to initialize immutable textures without a GPU copy
+    enabledFeatures.extHostImageCopy.hostImageCopy =
+      m_deviceFeatures.extHostImageCopy.hostImageCopy;
+
     // Only enable non-default line rasterization features if at least wide lines
     // and rectangular lines are supported. This saves us several feature checks
     // in the actual code.
@@ -421,6 +452,10 @@ namespace dxvk {
     enabledFeatures.extShaderModuleIdentifier.shaderModuleIdentifier =
       m_deviceFeatures.extShaderModuleIdentifier.shaderModuleIdentifier;
 
+    // Used to avoid linking pipelines when pipeline libraries are not usable
+    enabledFeatures.extShaderObject.shaderObject =
+      m_deviceFeatures.extShaderObject.shaderObject;
+
     // Enable swap chain features that are transparent tot he device
     enabledFeatures.extSwapchainMaintenance1.swapchainMaintenance1 =
       m_deviceFeatures.extSwapchainMaintenance1.swapchainMaintenance1 &&
@@ -613,6 +648,10 @@ namespace dxvk {
           enabledFeatures.extGraphicsPipelineLibrary = *reinterpret_cast<const VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT*>(f);
           break;
 
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT:
+          enabledFeatures.extHostImageCopy = *reinterpret_cast<const VkPhysicalDeviceHostImageCopyFeaturesEXT*>(f);
+          break;
+
         case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_LINE_RASTERIZATION_FEATURES_EXT:
           enabledFeatures.extLineRasterization = *reinterpret_cast<const VkPhysicalDeviceLineRasterizationFeaturesEXT*>(f);
           break;
@@ -637,6 +676,10 @@ namespace dxvk {
           enabledFeatures.extShaderModuleIdentifier = *reinterpret_cast<const VkPhysicalDeviceShaderModuleIdentifierFeaturesEXT*>(f);
           break;
 
+        case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT:
+          enabledFeatures.extShaderObject = *reinterpret_cast<const VkPhysicalDeviceShaderObjectFeaturesEXT*>(f);
+          break;
+
         case VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SWAPCHAIN_MAINTENANCE_1_FEATURES_EXT:
           enabledFeatures.extSwapchainMaintenance1 = *reinterpret_cast<const VkPhysicalDeviceSwapchainMaintenance1FeaturesEXT*>(f);
           break;
@@ -813,6 +856,11 @@ namespace dxvk {
       m_deviceInfo.extGraphicsPipelineLibrary.pNext = std::exchange(m_deviceInfo.core.pNext, &m_deviceInfo.extGraphicsPipelineLibrary);
     }
 
+    if (m_deviceExtensions.supports(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME)) {
+      m_deviceInfo.extHostImageCopy.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES_EXT;
+      m_deviceInfo.extHostImageCopy.pNext = std::exchange(m_deviceInfo.core.pNext, &m_deviceInfo.extHostImageCopy);
+    }
+
     if (m_deviceExtensions.supports(VK_EXT_LINE_RASTERIZATION_EXTENSION_NAME)) {
       m_deviceInfo.extLineRasterization.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_LINE_RASTERIZATION_PROPERTIES_EXT;
       m_deviceInfo.extLineRasterization.pNext = std::exchange(m_deviceInfo.core.pNext, &m_deviceInfo.extLineRasterization);
@@ -840,6 +888,25 @@ namespace dxvk {
 
     // Query full device properties for all enabled extensions
     m_vki->vkGetPhysicalDeviceProperties2(m_handle, &m_deviceInfo.core);
+
+    // Host image copy layouts are returned as arrays, so we need to
+    // query them separately now that we know the number of layouts.
+    if (m_deviceExtensions.supports(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME)) {
+      auto& hostImageCopy = m_deviceInfo.extHostImageCopy;
+
+      m_hostImageCopyLayouts.resize(hostImageCopy.copySrcLayoutCount + hostImageCopy.copyDstLayoutCount);
+      hostImageCopy.pCopySrcLayouts = m_hostImageCopyLayouts.data();
+      hostImageCopy.pCopyDstLayouts = m_hostImageCopyLayouts.data() + hostImageCopy.copySrcLayoutCount;
+
+      VkPhysicalDeviceProperties2 properties = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2 };
+      VkPhysicalDeviceHostImageCopyPropertiesEXT layoutProperties = hostImageCopy;
+      layoutProperties.pNext = std::exchange(properties.pNext, &layoutProperties);
+
+      m_vki->vkGetPhysicalDeviceProperties2(m_handle, &properties);
+
+      hostImageCopy.copySrcLayoutCount = layoutProperties.copySrcLayoutCount;
+      hostImageCopy.copyDstLayoutCount = layoutProperties.copyDstLayoutCount;
+    }
     
     // Some drivers reports the driver version in a slightly different format
     m_deviceInfo.driverVersion = decodeDriverVersion(
@@ -923,6 +990,11 @@ namespace dxvk {
       m_deviceFeatures.extNonSeamlessCubeMap.pNext = std::exchange(m_deviceFeatures.core.pNext, &m_deviceFeatures.extNonSeamlessCubeMap);
     }
 
+    if (m_deviceExtensions.supports(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME)) {
+      m_deviceFeatures.extHostImageCopy.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+      m_deviceFeatures.extHostImageCopy.pNext = std::exchange(m_deviceFeatures.core.pNext, &m_deviceFeatures.extHostImageCopy);
+    }
+
     if (m_deviceExtensions.supports(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME)) {
       m_deviceFeatures.extPageableDeviceLocalMemory.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
       m_deviceFeatures.extPageableDeviceLocalMemory.pNext = std::exchange(m_deviceFeatures.core.pNext, &m_deviceFeatures.extPageableDeviceLocalMemory);
@@ -938,6 +1010,11 @@ namespace dxvk {
       m_deviceFeatures.extShaderModuleIdentifier.pNext = std::exchange(m_deviceFeatures.core.pNext, &m_deviceFeatures.extShaderModuleIdentifier);
     }
 
+    if (m_deviceExtensions.supports(VK_EXT_SHADER_OBJECT_EXTENSION_NAME)) {
+      m_deviceFeatures.extShaderObject.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT;
+      m_deviceFeatures.extShaderObject.pNext = std::exchange(m_deviceFeatures.core.pNext, &m_deviceFeatures.extShaderObject);
+    }
+
     if (m_deviceExtensions.supports(VK_EXT_SHADER_STENCIL_EXPORT_EXTENSION_NAME))
       m_deviceFeatures.extShaderStencilExport = VK_TRUE;
 
@@ -1041,6 +1118,7 @@ namespace dxvk {
       &devExtensions.extFullScreenExclusive,
       &devExtensions.extGraphicsPipelineLibrary,
       &devExtensions.extHdrMetadata,
+      &devExtensions.extHostImageCopy,
       &devExtensions.extLineRasterization,
       &devExtensions.extMemoryBudget,
       &devExtensions.extMemoryPriority,
@@ -1048,6 +1126,7 @@ namespace dxvk {
       &devExtensions.extPageableDeviceLocalMemory,
       &devExtensions.extRobustness2,
       &devExtensions.extShaderModuleIdentifier,
+      &devExtensions.extShaderObject,
       &devExtensions.extShaderStencilExport,
       &devExtensions.extSwapchainColorSpace,
       &devExtensions.extSwapchainMaintenance1,
@@ -1130,6 +1209,11 @@ namespace dxvk {
       enabledFeatures.extGraphicsPipelineLibrary.pNext = std::exchange(enabledFeatures.core.pNext, &enabledFeatures.extGraphicsPipelineLibrary);
     }
 
+    if (devExtensions.extHostImageCopy) {
+      enabledFeatures.extHostImageCopy.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+      enabledFeatures.extHostImageCopy.pNext = std::exchange(enabledFeatures.core.pNext, &enabledFeatures.extHostImageCopy);
+    }
+
     if (devExtensions.extLineRasterization) {
       enabledFeatures.extLineRasterization.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_LINE_RASTERIZATION_FEATURES_EXT;
       enabledFeatures.extLineRasterization.pNext = std::exchange(enabledFeatures.core.pNext, &enabledFeatures.extLineRasterization);
@@ -1163,6 +1247,11 @@ namespace dxvk {
       enabledFeatures.extShaderModuleIdentifier.pNext = std::exchange(enabledFeatures.core.pNext, &enabledFeatures.extShaderModuleIdentifier);
     }
 
+    if (devExtensions.extShaderObject) {
+      enabledFeatures.extShaderObject.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SHADER_OBJECT_FEATURES_EXT;
+      enabledFeatures.extShaderObject.pNext = std::exchange(enabledFeatures.core.pNext, &enabledFeatures.extShaderObject);
+    }
+
     if (devExtensions.extShaderStencilExport)
       enabledFeatures.extShaderStencilExport = VK_TRUE;
 
@@ -1284,6 +1373,9 @@ namespace dxvk {
       "\n  shaderDrawParameters                   : ", features.vk11.shaderDrawParameters,
       "\nVulkan 1.2",
       "\n  samplerMirrorClampToEdge               : ", features.vk12.samplerMirrorClampToEdge,
+      "\n  descriptorSampledImageUpdateAfterBind  : ", features.vk12.descriptorBindingSampledImageUpdateAfterBind,
+      "\n  descriptorUpdateUnusedWhilePending     : ", features.vk12.descriptorBindingUpdateUnusedWhilePending,
+      "\n  descriptorBindingPartiallyBound        : ", features.vk12.descriptorBindingPartiallyBound,
       "\n  drawIndirectCount                      : ", features.vk12.drawIndirectCount,
       "\n  samplerFilterMinmax                    : ", features.vk12.samplerFilterMinmax,
       "\n  hostQueryReset                         : ", features.vk12.hostQueryReset,
@@ -1321,6 +1413,9 @@ namespace dxvk {
       "\n  extDynamicState3RasterizationSamples   : ", features.extExtendedDynamicState3.extendedDynamicState3RasterizationSamples ? "1" : "0",
       "\n  extDynamicState3SampleMask             : ", features.extExtendedDynamicState3.extendedDynamicState3SampleMask ? "1" : "0",
       "\n  extDynamicState3LineRasterizationMode  : ", features.extExtendedDynamicState3.extendedDynamicState3LineRasterizationMode ? "1" : "0",
+      "\n  extDynamicState3ColorBlendEnable       : ", features.extExtendedDynamicState3.extendedDynamicState3ColorBlendEnable ? "1" : "0",
+      "\n  extDynamicState3ColorBlendEquation     : ", features.extExtendedDynamicState3.extendedDynamicState3ColorBlendEquation ? "1" : "0",
+      "\n  extDynamicState3ColorWriteMask         : ", features.extExtendedDynamicState3.extendedDynamicState3ColorWriteMask ? "1" : "0",
       "\n", VK_EXT_FRAGMENT_SHADER_INTERLOCK_EXTENSION_NAME,
       "\n  fragmentShaderSampleInterlock          : ", features.extFragmentShaderInterlock.fragmentShaderSampleInterlock ? "1" : "0",
       "\n  fragmentShaderPixelInterlock           : ", features.extFragmentShaderInterlock.fragmentShaderPixelInterlock ? "1" : "0",
@@ -1328,6 +1423,8 @@ namespace dxvk {
       "\n  extension supported                    : ", features.extFullScreenExclusive ? "1" : "0",
       "\n", VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME,
       "\n  graphicsPipelineLibrary                : ", features.extGraphicsPipelineLibrary.graphicsPipelineLibrary ? "1" : "0",
+      "\n", VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME,
+      "\n  hostImageCopy                          : ", features.extHostImageCopy.hostImageCopy ? "1" : "0",
       "\n", VK_EXT_LINE_RASTERIZATION_EXTENSION_NAME,
       "\n  rectangularLines                       : ", features.extLineRasterization.rectangularLines ? "1" : "0",
       "\n  smoothLines                            : ", features.extLineRasterization.smoothLines ? "1" : "0",
@@ -1345,6 +1442,8 @@ namespace dxvk {
       "\n  nullDescriptor                         : ", features.extRobustness2.nullDescriptor ? "1" : "0",
       "\n", VK_EXT_SHADER_MODULE_IDENTIFIER_EXTENSION_NAME,
       "\n  shaderModuleIdentifier                 : ", features.extShaderModuleIdentifier.shaderModuleIdentifier ? "1" : "0",
+      "\n", VK_EXT_SHADER_OBJECT_EXTENSION_NAME,
+      "\n  shaderObject                           : ", features.extShaderObject.shaderObject ? "1" : "0",
       "\n", VK_EXT_SHADER_STENCIL_EXPORT_EXTENSION_NAME,
       "\n  extension supported                    : ", features.extShaderStencilExport ? "1" : "0",
       "\n", VK_EXT_SWAPCHAIN_COLOR_SPACE_EXTENSION_NAME,
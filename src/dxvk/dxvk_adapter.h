@@ -368,6 +368,8 @@ namespace dxvk {
     DxvkDeviceInfo      m_deviceInfo;
     DxvkDeviceFeatures  m_deviceFeatures;
 
+    std::vector<VkImageLayout> m_hostImageCopyLayouts;
+
     bool                m_hasMemoryBudget;
 
     Rc<DxvkAdapter>     m_linkedIGPUAdapter;
@@ -4,12 +4,14 @@
 #include "dxvk_allocator.h"
 
 #include "../util/util_bit.h"
+#include "../util/util_error.h"
 #include "../util/util_likely.h"
+#include "../util/util_string.h"
 
 namespace dxvk {
 
   DxvkPageAllocator::DxvkPageAllocator() {
-
+    m_sizeClassLists.fill(-1);
   }
 
 
@@ -27,60 +29,65 @@ namespace dxvk {
 
 
   int32_t DxvkPageAllocator::allocPages(uint32_t count, uint32_t alignment) {
-    int32_t index = searchFreeList(count);
-
-    while (index--) {
-      PageRange entry = m_freeList[index];
+    if (unlikely(!count || count > SizeClassCount))
+      return -1;
 
-      // The chunk index is the same regardless of alignment.
-      // Skip chunk if it does not accept new allocations.
-      uint32_t chunkIndex = entry.index >> ChunkPageBits;
+    // Start with the smallest size class that can hold the allocation
+    // and only move on to larger ones if no range could be used
+    int32_t sizeClass = findSizeClass(count - 1u);
 
-      if (unlikely(m_chunks[chunkIndex].disabled))
-        continue;
+    while (sizeClass >= 0) {
+      int32_t rangeIndex = m_sizeClassLists[sizeClass];
 
-      if (likely(!(entry.index & (alignment - 1u)))) {
-        // If the current free range is sufficiently aligned, we can use
-        // it as-is and simply modify the remaining free list entry.
-        uint32_t pageIndex = entry.index;
+      while (rangeIndex >= 0) {
+        PageRange entry = m_ranges[rangeIndex];
 
-        entry.index += count;
-        entry.count -= count;
+        // The chunk index is the same regardless of alignment.
+        // Skip chunk if it does not accept new allocations.
+        uint32_t chunkIndex = entry.index >> ChunkPageBits;
 
-        insertFreeRange(entry, index);
+        if (unlikely(m_chunks[chunkIndex].disabled)) {
+          rangeIndex = entry.next;
+          continue;
+        }
 
-        m_chunks[chunkIndex].pagesUsed += count;
-        return pageIndex;
-      } else {
         // Apply alignment and skip if the free range is too small.
         uint32_t pageIndex = align(entry.index, alignment);
 
-        if (pageIndex + count > entry.index + entry.count)
+        if (pageIndex + count > entry.index + entry.count) {
+          rangeIndex = entry.next;
           continue;
+        }
 
-        // Insert free range before the first allocated page,
-        // guaranteed to be non-empty at this point.
-        PageRange prevRange = { };
-        prevRange.index = entry.index;
-        prevRange.count = pageIndex - entry.index;
+        removeRange(rangeIndex);
 
-        insertFreeRange(prevRange, index);
+        // Re-insert free ranges before and after the allocated pages,
+        // reusing the existing range object for the first one.
+        if (unlikely(pageIndex > entry.index)) {
+          insertRange(rangeIndex, entry.index, pageIndex - entry.index);
+          rangeIndex = -1;
+        }
 
-        // Insert free range after the last allocated page.
-        PageRange nextRange = { };
-        nextRange.index = pageIndex + count;
-        nextRange.count = entry.index + entry.count - nextRange.index;
+        uint32_t nextIndex = pageIndex + count;
+        uint32_t nextCount = entry.index + entry.count - nextIndex;
 
-        if (nextRange.count)
-          insertFreeRange(nextRange, -1);
+        if (nextCount) {
+          if (rangeIndex < 0)
+            rangeIndex = allocRange();
 
-        m_chunks[chunkIndex].pagesUsed += count;
+          insertRange(rangeIndex, nextIndex, nextCount);
+        } else if (rangeIndex >= 0) {
+          freeRange(rangeIndex);
+        }
 
+        m_chunks[chunkIndex].pagesUsed += count;
         return pageIndex;
       }
+
+      sizeClass = findSizeClass(uint32_t(sizeClass) + 1u);
     }
 
-    return -1;    
+    return -1;
   }
 
 
@@ -104,55 +111,47 @@ namespace dxvk {
     if ((index + count) & ChunkPageMask)
       nextRange = m_freeListLutByPage[index + count];
 
-    if (prevRange < 0) {
-      if (nextRange < 0) {
-        // No adjacent range, need to insert a new one
-        PageRange range = { };
-        range.index = index;
-        range.count = count;
+    uint32_t rangeIndex = index;
+    uint32_t rangeCount = count;
 
-        insertFreeRange(range, -1);
-      } else {
-        // One adjacent range after the current one
-        PageRange range = m_freeList[nextRange];
-        range.index = index;
-        range.count += count;
+    int32_t range = -1;
 
-        insertFreeRange(range, nextRange);
-      }
-    } else if (nextRange < 0) {
-        // One adjacent range before the current one
-      PageRange range = m_freeList[prevRange];
-      range.count += count;
+    if (prevRange >= 0) {
+      removeRange(prevRange);
 
-      insertFreeRange(range, prevRange);
-    } else {
-      // Two adjacent ranges, need to merge with both
-      // and replace one while removing the other.
-      PageRange prev = m_freeList[prevRange];
-      PageRange next = m_freeList[nextRange];
-
-      PageRange mergedRange = { };
-      mergedRange.index = prev.index;
-      mergedRange.count = next.index + next.count - prev.index;
-
-      PageRange emptyRange = { };
-
-      // Remove the range at the higher index, then replace the one at the
-      // lower index with the merged range. The order is important here since
-      // having overlapping entries in the free list would cause issues for
-      // the look-up table, and using the correct indices is important since
-      // the index for the second operation could otherwise be invalidated.
-      insertFreeRange(emptyRange, std::max(prevRange, nextRange));
-      insertFreeRange(mergedRange, std::min(prevRange, nextRange));
+      rangeIndex = m_ranges[prevRange].index;
+      rangeCount += m_ranges[prevRange].count;
+
+      range = prevRange;
     }
 
+    if (nextRange >= 0) {
+      removeRange(nextRange);
+
+      rangeCount += m_ranges[nextRange].count;
+
+      if (range < 0)
+        range = nextRange;
+      else
+        freeRange(nextRange);
+    }
+
+    if (range < 0)
+      range = allocRange();
+
+    insertRange(range, rangeIndex, rangeCount);
+
     uint32_t chunkIndex = index >> ChunkPageBits;
     return !(m_chunks[chunkIndex].pagesUsed -= count);
   }
 
 
   uint32_t DxvkPageAllocator::addChunk(uint64_t size) {
+    // A chunk without pages would insert an empty free range,
+    // and larger chunks would overlap the next chunk's pages
+    if (unlikely(size < PageSize || size > MaxChunkSize))
+      throw DxvkError(str::format("DxvkPageAllocator: Invalid chunk size ", size));
+
     int32_t chunkIndex = m_freeChunk;
 
     if (chunkIndex < 0) {
@@ -170,12 +169,7 @@ namespace dxvk {
     chunk.nextChunk = -1;
     chunk.disabled = false;
 
-    PageRange pageRange = { };
-    pageRange.index = uint32_t(chunkIndex) << ChunkPageBits;
-    pageRange.count = chunk.pageCount;
-
-    insertFreeRange(pageRange, -1);
-
+    insertRange(allocRange(), uint32_t(chunkIndex) << ChunkPageBits, chunk.pageCount);
     return uint32_t(chunkIndex);
   }
 
@@ -187,13 +181,14 @@ namespace dxvk {
     chunk.nextChunk = std::exchange(m_freeChunk, int32_t(chunkIndex));
     chunk.disabled = true;
 
-    uint32_t pageIndex = chunkIndex << ChunkPageBits;
-
-    PageRange pageRange = { };
-    pageRange.index = pageIndex;
-    pageRange.count = 0;
+    // The chunk is entirely unused, so its first page
+    // is the start of a free range covering all pages
+    int32_t range = m_freeListLutByPage[chunkIndex << ChunkPageBits];
 
-    insertFreeRange(pageRange, m_freeListLutByPage[pageIndex]);
+    if (range >= 0) {
+      removeRange(range);
+      freeRange(range);
+    }
   }
 
 
@@ -234,10 +229,11 @@ namespace dxvk {
     if (lastCount)
       pageMask[fullCount] = (1u << lastCount) - 1u;
 
-    // Iterate over free list and set all pages included
-    // in the current chunk to 0.
-    for (PageRange range : m_freeList) {
-      if ((range.index >> ChunkPageBits) != chunkIndex)
+    // Iterate over free ranges and set all pages included
+    // in the current chunk to 0. Unused range objects have
+    // a page count of 0 and can be ignored.
+    for (PageRange range : m_ranges) {
+      if (!range.count || (range.index >> ChunkPageBits) != chunkIndex)
         continue;
 
       range.index &= ChunkPageMask;
@@ -266,92 +262,98 @@ namespace dxvk {
   }
 
 
-  int32_t DxvkPageAllocator::searchFreeList(uint32_t count) {
-    // Find the insertion index of a free list entry with the given page count.
-    // All entries with an index lower than but not equal to the return value
-    // will have a page count greater than or equal to count.
-    if (unlikely(m_freeList.empty()))
-      return 0u;
+  int32_t DxvkPageAllocator::findSizeClass(uint32_t minClass) const {
+    // Find the smallest non-empty size class that is greater
+    // than or equal to the given class using the bit masks.
+    if (unlikely(minClass >= SizeClassCount))
+      return -1;
 
-    // Do a binary search, but optimize for the common
-    // case where we request a small page count
-    uint32_t lo = 0u;
-    uint32_t hi = m_freeList.size();
+    uint32_t maskIndex = minClass / 64u;
+    uint64_t mask = m_sizeClassMasks[maskIndex] & (~uint64_t(0u) << (minClass % 64u));
 
-    if (count <= m_freeList.back().count)
-      return int32_t(hi);
+    if (!mask) {
+      if (maskIndex + 1u >= SizeClassMaskCount)
+        return -1;
 
-    while (lo < hi) {
-      uint32_t mid = (lo + hi) / 2u;
+      uint64_t topMask = m_sizeClassMaskTop & (~uint64_t(0u) << (maskIndex + 1u));
 
-      if (count <= m_freeList[mid].count)
-        lo = mid + 1;
-      else
-        hi = mid;
+      if (!topMask)
+        return -1;
+
+      maskIndex = bit::tzcnt(topMask);
+      mask = m_sizeClassMasks[maskIndex];
     }
 
-    return int32_t(lo);
+    return int32_t(64u * maskIndex + bit::tzcnt(mask));
   }
 
 
-  void DxvkPageAllocator::addLutEntry(const PageRange& range, int32_t index) {
-    m_freeListLutByPage[range.index] = index;
-    m_freeListLutByPage[range.index + range.count - 1u] = index;
+  int32_t DxvkPageAllocator::allocRange() {
+    int32_t range = m_freeRange;
+
+    if (range < 0) {
+      range = int32_t(m_ranges.size());
+      m_ranges.emplace_back();
+    } else {
+      m_freeRange = m_ranges[range].next;
+    }
+
+    return range;
   }
 
 
-  void DxvkPageAllocator::removeLutEntry(const PageRange& range) {
-    m_freeListLutByPage[range.index] = -1;
-    m_freeListLutByPage[range.index + range.count - 1u] = -1;
+  void DxvkPageAllocator::freeRange(int32_t rangeIndex) {
+    auto& range = m_ranges[rangeIndex];
+    range.index = 0u;
+    range.count = 0u;
+    range.prev = -1;
+    range.next = std::exchange(m_freeRange, rangeIndex);
   }
 
 
-  void DxvkPageAllocator::insertFreeRange(PageRange newRange, int32_t currentIndex) {
-    size_t count = m_freeList.size();
-    size_t index = size_t(currentIndex);
+  void DxvkPageAllocator::insertRange(int32_t rangeIndex, uint32_t index, uint32_t count) {
+    uint32_t sizeClass = count - 1u;
+
+    auto& range = m_ranges[rangeIndex];
+    range.index = index;
+    range.count = count;
+    range.prev = -1;
+    range.next = std::exchange(m_sizeClassLists[sizeClass], rangeIndex);
 
-    if (unlikely(currentIndex < 0)) {
-      m_freeList.emplace_back();
-      index = count++;
+    if (range.next >= 0) {
+      m_ranges[range.next].prev = rangeIndex;
+    } else {
+      m_sizeClassMasks[sizeClass / 64u] |= uint64_t(1u) << (sizeClass % 64u);
+      m_sizeClassMaskTop |= uint64_t(1u) << (sizeClass / 64u);
     }
 
-    // Remove old range from the LUT since it gets replaced
-    PageRange oldRange = m_freeList[index];
+    m_freeListLutByPage[index] = rangeIndex;
+    m_freeListLutByPage[index + count - 1u] = rangeIndex;
+  }
 
-    if (likely(oldRange.count))
-      removeLutEntry(oldRange);
 
-    // Move range within the free list until the proper ordering
-    // is restored again and update LUT entries for all ranges we
-    // move in the process.
-    if (newRange.count < oldRange.count) {
-      while (index + 1u < count) {
-        PageRange next = m_freeList[index + 1u];
+  void DxvkPageAllocator::removeRange(int32_t rangeIndex) {
+    const auto& range = m_ranges[rangeIndex];
+    uint32_t sizeClass = range.count - 1u;
 
-        if (newRange.count >= next.count)
-          break;
+    if (range.prev >= 0)
+      m_ranges[range.prev].next = range.next;
+    else
+      m_sizeClassLists[sizeClass] = range.next;
 
-        addLutEntry(next, index);
-        m_freeList[index++] = next;
-      }
-    } else if (newRange.count > oldRange.count) {
-      while (index) {
-        PageRange prev = m_freeList[index - 1u];
+    if (range.next >= 0)
+      m_ranges[range.next].prev = range.prev;
 
-        if (newRange.count <= prev.count)
-          break;
+    if (m_sizeClassLists[sizeClass] < 0) {
+      uint32_t maskIndex = sizeClass / 64u;
+      m_sizeClassMasks[maskIndex] &= ~(uint64_t(1u) << (sizeClass % 64u));
 
-        addLutEntry(prev, index);
-        m_freeList[index--] = prev;
-      }
+      if (!m_sizeClassMasks[maskIndex])
+        m_sizeClassMaskTop &= ~(uint64_t(1u) << maskIndex);
     }
 
-    if (newRange.count) {
-      m_freeList[index] = newRange;
-      addLutEntry(newRange, index);
-    } else {
-      m_freeList.pop_back();
-    }
+    m_freeListLutByPage[range.index] = -1;
+    m_freeListLutByPage[range.index + range.count - 1u] = -1;
   }
 
 
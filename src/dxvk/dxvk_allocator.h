@@ -13,11 +13,14 @@ namespace dxvk {
   /**
    * \brief Page allocator
    *
-   * Implements a best-fit allocation strategy for coarse allocations
-   * using an ordered free list. While allocating and freeing memory
-   * are both linear in the worst case, minimum-size allocations can
-   * generally be performed in constant time, with larger allocations
-   * getting gradually slower.
+   * Implements a best-fit allocation strategy for coarse allocations.
+   * Free ranges are kept in one list per page count, with a two-level
+   * bit mask to quickly find the smallest non-empty list that can hold
+   * a given allocation. Since free ranges never cross chunk boundaries,
+   * every possible range size has its own list, which makes the search
+   * exact. Freeing memory is constant time, and allocation only needs
+   * to scan lists if ranges have to be skipped due to alignment or
+   * disabled chunks.
    */
   class DxvkPageAllocator {
 
@@ -128,7 +131,8 @@ namespace dxvk {
      *
      * Adds the given region to the free list, so
      * that subsequent allocations can succeed.
-     * \param [in] size Total chunk size, in bytes
+     * \param [in] size Total chunk size, in bytes. Must be
+     *    at least one page and at most \c MaxChunkSize.
      * \returns Chunk index
      */
     uint32_t addChunk(uint64_t size);
@@ -180,6 +184,13 @@ namespace dxvk {
 
   private:
 
+    /// Number of size classes. Free ranges with n pages are
+    /// stored in the list for size class n - 1.
+    constexpr static uint32_t SizeClassCount = 1u << ChunkPageBits;
+    constexpr static uint32_t SizeClassMaskCount = SizeClassCount / 64u;
+
+    static_assert(SizeClassMaskCount <= 64u);
+
     struct ChunkInfo {
       uint32_t  pageCount = 0u;
       uint32_t  pagesUsed = 0u;
@@ -190,21 +201,31 @@ namespace dxvk {
     struct PageRange {
       uint32_t  index = 0u;
       uint32_t  count = 0u;
+      int32_t   prev  = -1;
+      int32_t   next  = -1;
     };
 
-    std::vector<PageRange>  m_freeList;
+    std::vector<PageRange>  m_ranges;
+    int32_t                 m_freeRange = -1;
+
     std::vector<int32_t>    m_freeListLutByPage;
 
+    std::array<int32_t,  SizeClassCount>      m_sizeClassLists;
+    std::array<uint64_t, SizeClassMaskCount>  m_sizeClassMasks = { };
+    uint64_t                                  m_sizeClassMaskTop = 0u;
+
     std::vector<ChunkInfo>  m_chunks;
     int32_t                 m_freeChunk = -1;
 
-    int32_t searchFreeList(uint32_t count);
+    int32_t findSizeClass(uint32_t minClass) const;
+
+    int32_t allocRange();
 
-    void addLutEntry(const PageRange& range, int32_t index);
+    void freeRange(int32_t rangeIndex);
 
-    void removeLutEntry(const PageRange& range);
+    void insertRange(int32_t rangeIndex, uint32_t index, uint32_t count);
 
-    void insertFreeRange(PageRange newRange, int32_t currentIndex);
+    void removeRange(int32_t rangeIndex);
 
   };
 
@@ -28,7 +28,7 @@ namespace dxvk {
     }
 
     // Create and assign actual buffer resource
-    assignStorage(allocateStorage());
+    assignStorage(createStorage(nullptr, DxvkAllocationLifetime::Default));
   }
 
 
@@ -310,22 +310,14 @@ namespace dxvk {
      * \brief Allocates new buffer slice with cache
      *
      * Uses the given cache to service small allocations without
-     * having to block the actual allocator if possible.
+     * having to block the actual allocator if possible. If the
+     * buffer gets discarded frequently, the new storage will be
+     * hinted as transient.
      * \param [in] cache Optional allocation cache
      * \returns The new buffer slice
      */
     Rc<DxvkResourceAllocation> allocateStorage(DxvkLocalAllocationCache* cache) {
-      DxvkAllocationInfo allocationInfo = { };
-      allocationInfo.resourceCookie = cookie();
-      allocationInfo.properties = m_properties;
-
-      VkBufferCreateInfo info = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
-      info.flags = m_info.flags;
-      info.usage = m_info.usage;
-      info.size = m_info.size;
-      m_sharingMode.fill(info);
-
-      return m_allocator->createBufferResource(info, allocationInfo, cache);
+      return createStorage(cache, m_lifetime.notifyReplace(m_allocator->getTaskEpoch()));
     }
 
     /**
@@ -443,6 +435,25 @@ namespace dxvk {
 
     std::string                 m_debugName;
 
+    DxvkStorageLifetimeTracker  m_lifetime;
+
+    Rc<DxvkResourceAllocation> createStorage(
+            DxvkLocalAllocationCache*   cache,
+            DxvkAllocationLifetime      lifetime) {
+      DxvkAllocationInfo allocationInfo = { };
+      allocationInfo.resourceCookie = cookie();
+      allocationInfo.properties = m_properties;
+      allocationInfo.lifetime = lifetime;
+
+      VkBufferCreateInfo info = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+      info.flags = m_info.flags;
+      info.usage = m_info.usage;
+      info.size = m_info.size;
+      m_sharingMode.fill(info);
+
+      return m_allocator->createBufferResource(info, allocationInfo, cache);
+    }
+
     void updateDebugName();
 
     std::string createDebugName(const char* name) const;
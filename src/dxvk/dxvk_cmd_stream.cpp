@@ -0,0 +1,61 @@
+#include "dxvk_cmd_stream.h"
+
+namespace dxvk {
+
+  DxvkCmdStream::DxvkCmdStream() {
+
+  }
+
+
+  DxvkCmdStream::~DxvkCmdStream() {
+
+  }
+
+
+  void* DxvkCmdStream::alloc(size_t size) {
+    size = align(size, Alignment);
+
+    while (m_blockIndex < m_blocks.size()) {
+      auto& block = m_blocks[m_blockIndex];
+
+      if (likely(m_blockOffset + size <= block.size)) {
+        void* result = &block.data[m_blockOffset];
+        m_blockOffset += size;
+        return result;
+      }
+
+      m_blockIndex += 1u;
+      m_blockOffset = 0u;
+    }
+
+    // Allocate a new block, or a dedicated one
+    // for allocations that exceed the block size
+    auto& block = m_blocks.emplace_back();
+    block.size = std::max(size, BlockSize);
+    // Commands are over-aligned, so the block must be as well
+    block.data.reset(static_cast<char*>(
+      ::operator new[](block.size, std::align_val_t(Alignment))));
+
+    m_blockIndex = m_blocks.size() - 1u;
+    m_blockOffset = size;
+    return &block.data[0];
+  }
+
+
+  void DxvkCmdStream::execute(const vk::DeviceFn& vk) {
+    for (auto cmd = m_head; cmd; cmd = cmd->next())
+      cmd->exec(vk);
+
+    reset();
+  }
+
+
+  void DxvkCmdStream::reset() {
+    m_head = nullptr;
+    m_tail = nullptr;
+
+    m_blockIndex = 0u;
+    m_blockOffset = 0u;
+  }
+
+}
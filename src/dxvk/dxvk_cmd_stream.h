@@ -0,0 +1,181 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "dxvk_include.h"
+
+namespace dxvk {
+
+  /**
+   * \brief Deferred Vulkan command
+   *
+   * Stores a function object that records a command into a
+   * given command buffer. Commands are not destroyed when the
+   * stream is reset, so function objects must be trivially
+   * destructible and must only reference stream memory.
+   */
+  class DxvkCmdStreamCmd {
+
+  public:
+
+    DxvkCmdStreamCmd* next() const {
+      return m_next;
+    }
+
+    void setNext(DxvkCmdStreamCmd* next) {
+      m_next = next;
+    }
+
+    virtual void exec(const vk::DeviceFn& vk) const = 0;
+
+  private:
+
+    DxvkCmdStreamCmd* m_next = nullptr;
+
+  };
+
+
+  /**
+   * \brief Typed deferred command
+   */
+  template<typename T>
+  class alignas(16) DxvkCmdStreamTypedCmd : public DxvkCmdStreamCmd {
+
+  public:
+
+    DxvkCmdStreamTypedCmd(T&& cmd)
+    : m_command(std::move(cmd)) { }
+
+    void exec(const vk::DeviceFn& vk) const {
+      m_command(vk);
+    }
+
+  private:
+
+    T m_command;
+
+  };
+
+
+  /**
+   * \brief Deferred command stream
+   *
+   * Linear allocator for Vulkan commands as well as any data
+   * that those commands reference, such as arrays of vertex
+   * buffers or barriers. Allows recording commands on one
+   * thread and replaying them on another. Memory blocks are
+   * kept around when the stream gets reset.
+   */
+  class DxvkCmdStream {
+    constexpr static size_t BlockSize = 64u << 10u;
+    constexpr static size_t Alignment = 16u;
+  public:
+
+    DxvkCmdStream();
+    ~DxvkCmdStream();
+
+    DxvkCmdStream             (const DxvkCmdStream&) = delete;
+    DxvkCmdStream& operator = (const DxvkCmdStream&) = delete;
+
+    /**
+     * \brief Checks whether any commands are pending
+     * \returns \c true if the stream is empty
+     */
+    bool empty() const {
+      return m_head == nullptr;
+    }
+
+    /**
+     * \brief Allocates memory from the stream
+     *
+     * The returned memory remains valid until
+     * the stream gets executed or reset.
+     * \param [in] size Number of bytes to allocate
+     * \returns Pointer to allocated memory
+     */
+    void* alloc(size_t size);
+
+    /**
+     * \brief Copies an array into stream memory
+     *
+     * \param [in] data Data to copy, may be \c nullptr
+     * \param [in] count Number of elements
+     * \returns Pointer to the copy, or \c nullptr
+     *    if the source pointer was \c nullptr.
+     */
+    template<typename T>
+    T* copy(const T* data, size_t count) {
+      static_assert(std::is_trivially_copyable_v<T>);
+
+      if (!data || !count)
+        return nullptr;
+
+      auto result = reinterpret_cast<T*>(alloc(sizeof(T) * count));
+      std::memcpy(result, data, sizeof(T) * count);
+      return result;
+    }
+
+    /**
+     * \brief Adds a command to the stream
+     *
+     * \param [in] command Function object taking the
+     *    device function table as its only argument.
+     */
+    template<typename T>
+    void record(T&& command) {
+      using FuncType = DxvkCmdStreamTypedCmd<std::decay_t<T>>;
+      static_assert(std::is_trivially_destructible_v<FuncType>);
+
+      auto cmd = new (alloc(sizeof(FuncType))) FuncType(std::move(command));
+
+      if (likely(m_tail != nullptr))
+        m_tail->setNext(cmd);
+      else
+        m_head = cmd;
+
+      m_tail = cmd;
+    }
+
+    /**
+     * \brief Executes and resets the stream
+     *
+     * Records all commands in the order they were
+     * added, then frees all stream memory.
+     * \param [in] vk Device functions
+     */
+    void execute(const vk::DeviceFn& vk);
+
+    /**
+     * \brief Resets the stream
+     *
+     * Discards all commands without executing them.
+     */
+    void reset();
+
+  private:
+
+    struct BlockDeleter {
+      void operator () (char* data) const {
+        ::operator delete[](data, std::align_val_t(Alignment));
+      }
+    };
+
+    struct Block {
+      std::unique_ptr<char[], BlockDeleter> data;
+      size_t                                size = 0u;
+    };
+
+    std::vector<Block>  m_blocks;
+    size_t              m_blockIndex  = 0u;
+    size_t              m_blockOffset = 0u;
+
+    DxvkCmdStreamCmd*   m_head = nullptr;
+    DxvkCmdStreamCmd*   m_tail = nullptr;
+
+  };
+
+}
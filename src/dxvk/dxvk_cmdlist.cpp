@@ -232,6 +232,8 @@ namespace dxvk {
       m_transferPool = new DxvkCommandPool(device, transferQueue.queueFamily);
     else
       m_transferPool = m_graphicsPool;
+
+    m_deferExec = device->config().deferCommandRecording;
   }
   
   
@@ -255,6 +257,10 @@ namespace dxvk {
     const auto& transfer = m_device->queues().transfer;
     const auto& sparse = m_device->queues().sparse;
 
+    // Record deferred commands now that we are on the submission
+    // thread, all command buffers have already been begun.
+    flushDeferredCommands();
+
     m_commandSubmission.reset();
 
     for (size_t i = 0; i < m_cmdSubmissions.size(); i++) {
@@ -389,7 +395,7 @@ namespace dxvk {
     // regardless of whether they have been used.
     for (uint32_t i = 0; i < m_cmd.cmdBuffers.size(); i++) {
       if (m_cmd.cmdBuffers[i])
-        endCommandBuffer(m_cmd.cmdBuffers[i]);
+        endCommandBuffer(DxvkCmdBuffer(i), m_cmd.cmdBuffers[i]);
     }
 
     // Reset all command buffer handles
@@ -411,7 +417,7 @@ namespace dxvk {
         continue;
 
       if (m_cmd.cmdBuffers[i]) {
-        endCommandBuffer(m_cmd.cmdBuffers[i]);
+        endCommandBuffer(cmdBuffer, m_cmd.cmdBuffers[i]);
 
         m_cmd.cmdBuffers[i] = cmdBuffer == DxvkCmdBuffer::ExecBuffer
           ? allocateCommandBuffer(cmdBuffer)
@@ -461,20 +467,91 @@ namespace dxvk {
 
     m_wsiSemaphores = PresenterSync();
 
+    // Discard any commands that were never submitted
+    m_execStream.reset();
+
     // Reset actual command buffers and pools
     m_graphicsPool->reset();
     m_transferPool->reset();
   }
 
 
-  void DxvkCommandList::endCommandBuffer(VkCommandBuffer cmdBuffer) {
-    auto vk = m_device->vkd();
+  void DxvkCommandList::endCommandBuffer(DxvkCmdBuffer type, VkCommandBuffer cmdBuffer) {
+    recordCmd(type, cmdBuffer, [
+      vki   = m_vki.ptr(),
+      debug = m_device->isDebugEnabled()
+    ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+      if (debug)
+        vki->vkCmdEndDebugUtilsLabelEXT(cmd);
+
+      if (vk.vkEndCommandBuffer(cmd))
+        throw DxvkError("DxvkCommandList: Failed to end command buffer");
+    });
+  }
+
+
+  const VkRenderingInfo* DxvkCommandList::deferRenderingInfo(
+    const VkRenderingInfo*              info) {
+    if (likely(!m_deferExec))
+      return info;
+
+    VkRenderingInfo* result = m_execStream.copy(info, 1);
+    result->pColorAttachments = m_execStream.copy(info->pColorAttachments, info->colorAttachmentCount);
+    result->pDepthAttachment = m_execStream.copy(info->pDepthAttachment, 1);
+    result->pStencilAttachment = m_execStream.copy(info->pStencilAttachment, 1);
+    return result;
+  }
+
+
+  const VkDependencyInfo* DxvkCommandList::deferDependencyInfo(
+          DxvkCmdBuffer                 cmdBuffer,
+    const VkDependencyInfo*             info) {
+    if (likely(!m_deferExec || cmdBuffer != DxvkCmdBuffer::ExecBuffer))
+      return info;
+
+    VkDependencyInfo* result = m_execStream.copy(info, 1);
+    result->pMemoryBarriers = m_execStream.copy(info->pMemoryBarriers, info->memoryBarrierCount);
+    result->pBufferMemoryBarriers = m_execStream.copy(info->pBufferMemoryBarriers, info->bufferMemoryBarrierCount);
+    result->pImageMemoryBarriers = m_execStream.copy(info->pImageMemoryBarriers, info->imageMemoryBarrierCount);
+    return result;
+  }
+
+
+  const VkDebugUtilsLabelEXT* DxvkCommandList::deferLabelInfo(
+          DxvkCmdBuffer                 cmdBuffer,
+    const VkDebugUtilsLabelEXT*         info) {
+    if (likely(!m_deferExec || cmdBuffer != DxvkCmdBuffer::ExecBuffer))
+      return info;
+
+    VkDebugUtilsLabelEXT* result = m_execStream.copy(info, 1);
+
+    if (info->pLabelName)
+      result->pLabelName = m_execStream.copy(info->pLabelName, std::strlen(info->pLabelName) + 1u);
+
+    return result;
+  }
+
+
+  const VkDepthBiasInfoEXT* DxvkCommandList::deferDepthBiasInfo(
+    const VkDepthBiasInfoEXT*           info) {
+    if (likely(!m_deferExec))
+      return info;
+
+    // The only structure we ever chain is the depth bias representation
+    VkDepthBiasInfoEXT* result = m_execStream.copy(info, 1);
+
+    if (info->pNext) {
+      result->pNext = m_execStream.copy(
+        reinterpret_cast<const VkDepthBiasRepresentationInfoEXT*>(info->pNext), 1);
+    }
+
+    return result;
+  }
 
-    if (m_device->isDebugEnabled())
-      m_vki->vkCmdEndDebugUtilsLabelEXT(cmdBuffer);
 
-    if (vk->vkEndCommandBuffer(cmdBuffer))
-      throw DxvkError("DxvkCommandList: Failed to end command buffer");
+  void DxvkCommandList::flushDeferredCommands() {
+    if (!m_execStream.empty())
+      m_execStream.execute(*m_vkd);
   }
 
 
@@ -4,6 +4,7 @@
 
 #include "dxvk_bind_mask.h"
 #include "dxvk_buffer.h"
+#include "dxvk_cmd_stream.h"
 #include "dxvk_descriptor.h"
 #include "dxvk_fence.h"
 #include "dxvk_gpu_event.h"
@@ -343,6 +344,17 @@ namespace dxvk {
         m_objectTracker.track<DxvkResourceRef>(object, access);
     }
 
+    /**
+     * \brief Tracks a query with pending readback
+     *
+     * Keeps the query alive and marks its results as
+     * available once the command list has completed.
+     * \param [in] query Query object
+     */
+    void trackQueryReadback(Rc<DxvkGpuQuery>&& query) {
+      m_objectTracker.track<DxvkGpuQueryReadbackRef>(std::move(query));
+    }
+
     /**
      * \brief Tracks a graphics pipeline
      * \param [in] pipeline Pipeline
@@ -451,8 +463,10 @@ namespace dxvk {
     VkCommandBuffer endSecondaryCommandBuffer() {
       VkCommandBuffer cmd = getCmdBuffer();
 
-      if (m_vkd->vkEndCommandBuffer(cmd))
-        throw DxvkError("DxvkCommandList: Failed to end secondary command buffer");
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        if (vk.vkEndCommandBuffer(cmd))
+          throw DxvkError("DxvkCommandList: Failed to end secondary command buffer");
+      });
 
       m_cmd.cmdBuffers[uint32_t(DxvkCmdBuffer::ExecBuffer)] = m_execBuffer;
       m_execBuffer = VK_NULL_HANDLE;
@@ -466,10 +480,12 @@ namespace dxvk {
             VkQueryControlFlags     flags) {
       m_cmd.execCommands = true;
 
-      m_vkd->vkCmdBeginQuery(getCmdBuffer(), queryPool, query, flags);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBeginQuery(cmd, queryPool, query, flags);
+      });
     }
-    
-    
+
+
     void cmdBeginQueryIndexed(
             VkQueryPool             queryPool,
             uint32_t                query,
@@ -477,8 +493,9 @@ namespace dxvk {
             uint32_t                index) {
       m_cmd.execCommands = true;
 
-      m_vkd->vkCmdBeginQueryIndexedEXT(getCmdBuffer(),
-        queryPool, query, flags, index);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBeginQueryIndexedEXT(cmd, queryPool, query, flags, index);
+      });
     }
 
 
@@ -487,7 +504,11 @@ namespace dxvk {
       m_cmd.execCommands = true;
       m_statCounters.addCtr(DxvkStatCounter::CmdRenderPassCount, 1);
 
-      m_vkd->vkCmdBeginRendering(getCmdBuffer(), pRenderingInfo);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        pRenderingInfo = deferRenderingInfo(pRenderingInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBeginRendering(cmd, pRenderingInfo);
+      });
     }
 
 
@@ -496,11 +517,17 @@ namespace dxvk {
             uint32_t                  bufferCount,
       const VkBuffer*                 counterBuffers,
       const VkDeviceSize*             counterOffsets) {
-      m_vkd->vkCmdBeginTransformFeedbackEXT(getCmdBuffer(),
-        firstBuffer, bufferCount, counterBuffers, counterOffsets);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        firstBuffer, bufferCount,
+        counterBuffers = deferData(DxvkCmdBuffer::ExecBuffer, counterBuffers, bufferCount),
+        counterOffsets = deferData(DxvkCmdBuffer::ExecBuffer, counterOffsets, bufferCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBeginTransformFeedbackEXT(cmd,
+          firstBuffer, bufferCount, counterBuffers, counterOffsets);
+      });
     }
-    
-    
+
+
     void cmdBindDescriptorSet(
             DxvkCmdBuffer             cmdBuffer,
             VkPipelineBindPoint       pipeline,
@@ -508,12 +535,17 @@ namespace dxvk {
             VkDescriptorSet           descriptorSet,
             uint32_t                  dynamicOffsetCount,
       const uint32_t*                 pDynamicOffsets) {
-      m_vkd->vkCmdBindDescriptorSets(getCmdBuffer(cmdBuffer),
-        pipeline, pipelineLayout, 0, 1,
-        &descriptorSet, dynamicOffsetCount, pDynamicOffsets);
+      recordCmd(cmdBuffer, [
+        pipeline, pipelineLayout, descriptorSet, dynamicOffsetCount,
+        pDynamicOffsets = deferData(cmdBuffer, pDynamicOffsets, dynamicOffsetCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindDescriptorSets(cmd,
+          pipeline, pipelineLayout, 0, 1,
+          &descriptorSet, dynamicOffsetCount, pDynamicOffsets);
+      });
     }
-    
-    
+
+
     void cmdBindDescriptorSets(
             DxvkCmdBuffer             cmdBuffer,
             VkPipelineBindPoint       pipeline,
@@ -523,9 +555,15 @@ namespace dxvk {
       const VkDescriptorSet*          descriptorSets,
             uint32_t                  dynamicOffsetCount,
       const uint32_t*                 pDynamicOffsets) {
-      m_vkd->vkCmdBindDescriptorSets(getCmdBuffer(cmdBuffer),
-        pipeline, pipelineLayout, firstSet, descriptorSetCount,
-        descriptorSets, dynamicOffsetCount, pDynamicOffsets);
+      recordCmd(cmdBuffer, [
+        pipeline, pipelineLayout, firstSet, descriptorSetCount, dynamicOffsetCount,
+        descriptorSets = deferData(cmdBuffer, descriptorSets, descriptorSetCount),
+        pDynamicOffsets = deferData(cmdBuffer, pDynamicOffsets, dynamicOffsetCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindDescriptorSets(cmd,
+          pipeline, pipelineLayout, firstSet, descriptorSetCount,
+          descriptorSets, dynamicOffsetCount, pDynamicOffsets);
+      });
     }
 
 
@@ -533,18 +571,20 @@ namespace dxvk {
             VkBuffer                buffer,
             VkDeviceSize            offset,
             VkIndexType             indexType) {
-      m_vkd->vkCmdBindIndexBuffer(getCmdBuffer(),
-        buffer, offset, indexType);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindIndexBuffer(cmd, buffer, offset, indexType);
+      });
     }
-    
-    
+
+
     void cmdBindIndexBuffer2(
             VkBuffer                buffer,
             VkDeviceSize            offset,
             VkDeviceSize            size,
             VkIndexType             indexType) {
-      m_vkd->vkCmdBindIndexBuffer2KHR(getCmdBuffer(),
-        buffer, offset, size, indexType);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindIndexBuffer2KHR(cmd, buffer, offset, size, indexType);
+      });
     }
 
 
@@ -552,8 +592,23 @@ namespace dxvk {
             DxvkCmdBuffer           cmdBuffer,
             VkPipelineBindPoint     pipelineBindPoint,
             VkPipeline              pipeline) {
-      m_vkd->vkCmdBindPipeline(getCmdBuffer(cmdBuffer),
-        pipelineBindPoint, pipeline);
+      recordCmd(cmdBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindPipeline(cmd, pipelineBindPoint, pipeline);
+      });
+    }
+
+
+    void cmdBindShaders(
+            uint32_t                stageCount,
+      const VkShaderStageFlagBits*  pStages,
+      const VkShaderEXT*            pShaders) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        stageCount,
+        pStages = deferData(DxvkCmdBuffer::ExecBuffer, pStages, stageCount),
+        pShaders = deferData(DxvkCmdBuffer::ExecBuffer, pShaders, stageCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindShadersEXT(cmd, stageCount, pStages, pShaders);
+      });
     }
 
 
@@ -563,11 +618,18 @@ namespace dxvk {
       const VkBuffer*               pBuffers,
       const VkDeviceSize*           pOffsets,
       const VkDeviceSize*           pSizes) {
-      m_vkd->vkCmdBindTransformFeedbackBuffersEXT(getCmdBuffer(),
-        firstBinding, bindingCount, pBuffers, pOffsets, pSizes);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        firstBinding, bindingCount,
+        pBuffers = deferData(DxvkCmdBuffer::ExecBuffer, pBuffers, bindingCount),
+        pOffsets = deferData(DxvkCmdBuffer::ExecBuffer, pOffsets, bindingCount),
+        pSizes = deferData(DxvkCmdBuffer::ExecBuffer, pSizes, bindingCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindTransformFeedbackBuffersEXT(cmd,
+          firstBinding, bindingCount, pBuffers, pOffsets, pSizes);
+      });
     }
-    
-    
+
+
     void cmdBindVertexBuffers(
             uint32_t                firstBinding,
             uint32_t                bindingCount,
@@ -575,36 +637,57 @@ namespace dxvk {
       const VkDeviceSize*           pOffsets,
       const VkDeviceSize*           pSizes,
       const VkDeviceSize*           pStrides) {
-      m_vkd->vkCmdBindVertexBuffers2(getCmdBuffer(),
-        firstBinding, bindingCount, pBuffers, pOffsets,
-        pSizes, pStrides);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        firstBinding, bindingCount,
+        pBuffers = deferData(DxvkCmdBuffer::ExecBuffer, pBuffers, bindingCount),
+        pOffsets = deferData(DxvkCmdBuffer::ExecBuffer, pOffsets, bindingCount),
+        pSizes = deferData(DxvkCmdBuffer::ExecBuffer, pSizes, bindingCount),
+        pStrides = deferData(DxvkCmdBuffer::ExecBuffer, pStrides, bindingCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBindVertexBuffers2(cmd,
+          firstBinding, bindingCount, pBuffers, pOffsets,
+          pSizes, pStrides);
+      });
     }
-    
+
     void cmdLaunchCuKernel(VkCuLaunchInfoNVX launchInfo) {
       m_cmd.execCommands = true;
 
+      // Kernel parameters are opaque, so record these directly
+      flushDeferredCommands();
+
       m_vkd->vkCmdCuLaunchKernelNVX(getCmdBuffer(), &launchInfo);
     }
-    
+
 
     void cmdBlitImage(
         const VkBlitImageInfo2*     pBlitInfo) {
       m_cmd.execCommands = true;
 
-      m_vkd->vkCmdBlitImage2(getCmdBuffer(), pBlitInfo);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        pBlitInfo = deferRegionInfo(DxvkCmdBuffer::ExecBuffer, pBlitInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdBlitImage2(cmd, pBlitInfo);
+      });
     }
-    
-    
+
+
     void cmdClearAttachments(
             uint32_t                attachmentCount,
       const VkClearAttachment*      pAttachments,
             uint32_t                rectCount,
       const VkClearRect*            pRects) {
-      m_vkd->vkCmdClearAttachments(getCmdBuffer(),
-        attachmentCount, pAttachments, rectCount, pRects);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        attachmentCount, rectCount,
+        pAttachments = deferData(DxvkCmdBuffer::ExecBuffer, pAttachments, attachmentCount),
+        pRects = deferData(DxvkCmdBuffer::ExecBuffer, pRects, rectCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdClearAttachments(cmd,
+          attachmentCount, pAttachments, rectCount, pRects);
+      });
     }
-    
-    
+
+
     void cmdClearColorImage(
             DxvkCmdBuffer           cmdBuffer,
             VkImage                 image,
@@ -614,12 +697,18 @@ namespace dxvk {
       const VkImageSubresourceRange* pRanges) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdClearColorImage(getCmdBuffer(cmdBuffer),
-        image, imageLayout, pColor,
-        rangeCount, pRanges);
+      recordCmd(cmdBuffer, [
+        image, imageLayout, rangeCount,
+        pColor = deferData(cmdBuffer, pColor, 1),
+        pRanges = deferData(cmdBuffer, pRanges, rangeCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdClearColorImage(cmd,
+          image, imageLayout, pColor,
+          rangeCount, pRanges);
+      });
     }
-    
-    
+
+
     void cmdClearDepthStencilImage(
             DxvkCmdBuffer           cmdBuffer,
             VkImage                 image,
@@ -629,45 +718,67 @@ namespace dxvk {
       const VkImageSubresourceRange* pRanges) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdClearDepthStencilImage(getCmdBuffer(cmdBuffer),
-        image, imageLayout, pDepthStencil,
-        rangeCount, pRanges);
+      recordCmd(cmdBuffer, [
+        image, imageLayout, rangeCount,
+        pDepthStencil = deferData(cmdBuffer, pDepthStencil, 1),
+        pRanges = deferData(cmdBuffer, pRanges, rangeCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdClearDepthStencilImage(cmd,
+          image, imageLayout, pDepthStencil,
+          rangeCount, pRanges);
+      });
     }
-    
-    
+
+
     void cmdCopyBuffer(
             DxvkCmdBuffer           cmdBuffer,
       const VkCopyBufferInfo2*      copyInfo) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdCopyBuffer2(getCmdBuffer(cmdBuffer), copyInfo);
+      recordCmd(cmdBuffer, [
+        copyInfo = deferRegionInfo(cmdBuffer, copyInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdCopyBuffer2(cmd, copyInfo);
+      });
     }
-    
-    
+
+
     void cmdCopyBufferToImage(
             DxvkCmdBuffer           cmdBuffer,
       const VkCopyBufferToImageInfo2* copyInfo) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdCopyBufferToImage2(getCmdBuffer(cmdBuffer), copyInfo);
+      recordCmd(cmdBuffer, [
+        copyInfo = deferRegionInfo(cmdBuffer, copyInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdCopyBufferToImage2(cmd, copyInfo);
+      });
     }
-    
-    
+
+
     void cmdCopyImage(
             DxvkCmdBuffer           cmdBuffer,
       const VkCopyImageInfo2*       copyInfo) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdCopyImage2(getCmdBuffer(cmdBuffer), copyInfo);
+      recordCmd(cmdBuffer, [
+        copyInfo = deferRegionInfo(cmdBuffer, copyInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdCopyImage2(cmd, copyInfo);
+      });
     }
-    
-    
+
+
     void cmdCopyImageToBuffer(
             DxvkCmdBuffer           cmdBuffer,
       const VkCopyImageToBufferInfo2* copyInfo) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdCopyImageToBuffer2(getCmdBuffer(cmdBuffer), copyInfo);
+      recordCmd(cmdBuffer, [
+        copyInfo = deferRegionInfo(cmdBuffer, copyInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdCopyImageToBuffer2(cmd, copyInfo);
+      });
     }
 
 
@@ -682,12 +793,14 @@ namespace dxvk {
             VkQueryResultFlags      flags) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdCopyQueryPoolResults(getCmdBuffer(cmdBuffer),
-        queryPool, firstQuery, queryCount,
-        dstBuffer, dstOffset, stride, flags);
+      recordCmd(cmdBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdCopyQueryPoolResults(cmd,
+          queryPool, firstQuery, queryCount,
+          dstBuffer, dstOffset, stride, flags);
+      });
     }
-    
-    
+
+
     void cmdDispatch(
             DxvkCmdBuffer           cmdBuffer,
             uint32_t                x,
@@ -696,10 +809,12 @@ namespace dxvk {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
       m_statCounters.addCtr(DxvkStatCounter::CmdDispatchCalls, 1);
 
-      m_vkd->vkCmdDispatch(getCmdBuffer(cmdBuffer), x, y, z);
+      recordCmd(cmdBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDispatch(cmd, x, y, z);
+      });
     }
-    
-    
+
+
     void cmdDispatchIndirect(
             DxvkCmdBuffer           cmdBuffer,
             VkBuffer                buffer,
@@ -707,10 +822,12 @@ namespace dxvk {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
       m_statCounters.addCtr(DxvkStatCounter::CmdDispatchCalls, 1);
 
-      m_vkd->vkCmdDispatchIndirect(getCmdBuffer(cmdBuffer), buffer, offset);
+      recordCmd(cmdBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDispatchIndirect(cmd, buffer, offset);
+      });
     }
-    
-    
+
+
     void cmdDraw(
             uint32_t                vertexCount,
             uint32_t                instanceCount,
@@ -718,12 +835,14 @@ namespace dxvk {
             uint32_t                firstInstance) {
       m_statCounters.addCtr(DxvkStatCounter::CmdDrawCalls, 1);
 
-      m_vkd->vkCmdDraw(getCmdBuffer(),
-        vertexCount, instanceCount,
-        firstVertex, firstInstance);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDraw(cmd,
+          vertexCount, instanceCount,
+          firstVertex, firstInstance);
+      });
     }
-    
-    
+
+
     void cmdDrawIndirect(
             VkBuffer                buffer,
             VkDeviceSize            offset,
@@ -731,11 +850,12 @@ namespace dxvk {
             uint32_t                stride) {
       m_statCounters.addCtr(DxvkStatCounter::CmdDrawCalls, 1);
 
-      m_vkd->vkCmdDrawIndirect(getCmdBuffer(),
-        buffer, offset, drawCount, stride);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDrawIndirect(cmd, buffer, offset, drawCount, stride);
+      });
     }
-    
-    
+
+
     void cmdDrawIndirectCount(
             VkBuffer                buffer,
             VkDeviceSize            offset,
@@ -745,11 +865,13 @@ namespace dxvk {
             uint32_t                stride) {
       m_statCounters.addCtr(DxvkStatCounter::CmdDrawCalls, 1);
 
-      m_vkd->vkCmdDrawIndirectCount(getCmdBuffer(),
-        buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDrawIndirectCount(cmd,
+          buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+      });
     }
-    
-    
+
+
     void cmdDrawIndexed(
             uint32_t                indexCount,
             uint32_t                instanceCount,
@@ -758,13 +880,15 @@ namespace dxvk {
             uint32_t                firstInstance) {
       m_statCounters.addCtr(DxvkStatCounter::CmdDrawCalls, 1);
 
-      m_vkd->vkCmdDrawIndexed(getCmdBuffer(),
-        indexCount, instanceCount,
-        firstIndex, vertexOffset,
-        firstInstance);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDrawIndexed(cmd,
+          indexCount, instanceCount,
+          firstIndex, vertexOffset,
+          firstInstance);
+      });
     }
-    
-    
+
+
     void cmdDrawIndexedIndirect(
             VkBuffer                buffer,
             VkDeviceSize            offset,
@@ -772,8 +896,9 @@ namespace dxvk {
             uint32_t                stride) {
       m_statCounters.addCtr(DxvkStatCounter::CmdDrawCalls, 1);
 
-      m_vkd->vkCmdDrawIndexedIndirect(getCmdBuffer(),
-        buffer, offset, drawCount, stride);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDrawIndexedIndirect(cmd, buffer, offset, drawCount, stride);
+      });
     }
 
 
@@ -786,11 +911,13 @@ namespace dxvk {
             uint32_t                stride) {
       m_statCounters.addCtr(DxvkStatCounter::CmdDrawCalls, 1);
 
-      m_vkd->vkCmdDrawIndexedIndirectCount(getCmdBuffer(),
-        buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDrawIndexedIndirectCount(cmd,
+          buffer, offset, countBuffer, countOffset, maxDrawCount, stride);
+      });
     }
-    
-    
+
+
     void cmdDrawIndirectVertexCount(
             uint32_t                instanceCount,
             uint32_t                firstInstance,
@@ -800,16 +927,20 @@ namespace dxvk {
             uint32_t                vertexStride) {
       m_statCounters.addCtr(DxvkStatCounter::CmdDrawCalls, 1);
 
-      m_vkd->vkCmdDrawIndirectByteCountEXT(getCmdBuffer(),
-        instanceCount, firstInstance, counterBuffer,
-        counterBufferOffset, counterOffset, vertexStride);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdDrawIndirectByteCountEXT(cmd,
+          instanceCount, firstInstance, counterBuffer,
+          counterBufferOffset, counterOffset, vertexStride);
+      });
     }
-    
-    
+
+
     void cmdEndQuery(
             VkQueryPool             queryPool,
             uint32_t                query) {
-      m_vkd->vkCmdEndQuery(getCmdBuffer(), queryPool, query);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdEndQuery(cmd, queryPool, query);
+      });
     }
 
 
@@ -817,23 +948,32 @@ namespace dxvk {
             VkQueryPool             queryPool,
             uint32_t                query,
             uint32_t                index) {
-      m_vkd->vkCmdEndQueryIndexedEXT(getCmdBuffer(),
-        queryPool, query, index);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdEndQueryIndexedEXT(cmd, queryPool, query, index);
+      });
     }
-    
-    
+
+
     void cmdEndRendering() {
-      m_vkd->vkCmdEndRendering(getCmdBuffer());
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdEndRendering(cmd);
+      });
     }
 
-    
+
     void cmdEndTransformFeedback(
             uint32_t                  firstBuffer,
             uint32_t                  bufferCount,
       const VkBuffer*                 counterBuffers,
       const VkDeviceSize*             counterOffsets) {
-      m_vkd->vkCmdEndTransformFeedbackEXT(getCmdBuffer(),
-        firstBuffer, bufferCount, counterBuffers, counterOffsets);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        firstBuffer, bufferCount,
+        counterBuffers = deferData(DxvkCmdBuffer::ExecBuffer, counterBuffers, bufferCount),
+        counterOffsets = deferData(DxvkCmdBuffer::ExecBuffer, counterOffsets, bufferCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdEndTransformFeedbackEXT(cmd,
+          firstBuffer, bufferCount, counterBuffers, counterOffsets);
+      });
     }
 
 
@@ -842,7 +982,12 @@ namespace dxvk {
             VkCommandBuffer*        commandBuffers) {
       m_cmd.execCommands = true;
 
-      m_vkd->vkCmdExecuteCommands(getCmdBuffer(), count, commandBuffers);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        count,
+        commandBuffers = deferData(DxvkCmdBuffer::ExecBuffer, commandBuffers, count)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdExecuteCommands(cmd, count, commandBuffers);
+      });
     }
 
 
@@ -854,21 +999,26 @@ namespace dxvk {
             uint32_t                data) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdFillBuffer(getCmdBuffer(cmdBuffer),
-        dstBuffer, dstOffset, size, data);
+      recordCmd(cmdBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdFillBuffer(cmd, dstBuffer, dstOffset, size, data);
+      });
     }
-    
-    
+
+
     void cmdPipelineBarrier(
             DxvkCmdBuffer           cmdBuffer,
       const VkDependencyInfo*       dependencyInfo) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
       m_statCounters.addCtr(DxvkStatCounter::CmdBarrierCount, 1);
 
-      m_vkd->vkCmdPipelineBarrier2(getCmdBuffer(cmdBuffer), dependencyInfo);
+      recordCmd(cmdBuffer, [
+        dependencyInfo = deferDependencyInfo(cmdBuffer, dependencyInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdPipelineBarrier2(cmd, dependencyInfo);
+      });
     }
-    
-    
+
+
     void cmdPushConstants(
             DxvkCmdBuffer           cmdBuffer,
             VkPipelineLayout        layout,
@@ -876,8 +1026,13 @@ namespace dxvk {
             uint32_t                offset,
             uint32_t                size,
       const void*                   pValues) {
-      m_vkd->vkCmdPushConstants(getCmdBuffer(cmdBuffer),
-        layout, stageFlags, offset, size, pValues);
+      recordCmd(cmdBuffer, [
+        layout, stageFlags, offset, size,
+        pValues = deferData(cmdBuffer, reinterpret_cast<const char*>(pValues), size)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdPushConstants(cmd,
+          layout, stageFlags, offset, size, pValues);
+      });
     }
 
 
@@ -888,8 +1043,9 @@ namespace dxvk {
             uint32_t                queryCount) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdResetQueryPool(getCmdBuffer(cmdBuffer),
-        queryPool, firstQuery, queryCount);
+      recordCmd(cmdBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdResetQueryPool(cmd, queryPool, firstQuery, queryCount);
+      });
     }
 
 
@@ -897,10 +1053,14 @@ namespace dxvk {
       const VkResolveImageInfo2*    resolveInfo) {
       m_cmd.execCommands = true;
 
-      m_vkd->vkCmdResolveImage2(getCmdBuffer(), resolveInfo);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        resolveInfo = deferRegionInfo(DxvkCmdBuffer::ExecBuffer, resolveInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdResolveImage2(cmd, resolveInfo);
+      });
     }
-    
-    
+
+
     void cmdUpdateBuffer(
             DxvkCmdBuffer           cmdBuffer,
             VkBuffer                dstBuffer,
@@ -909,31 +1069,91 @@ namespace dxvk {
       const void*                   pData) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdUpdateBuffer(getCmdBuffer(cmdBuffer),
-        dstBuffer, dstOffset, dataSize, pData);
+      recordCmd(cmdBuffer, [
+        dstBuffer, dstOffset, dataSize,
+        pData = deferData(cmdBuffer, reinterpret_cast<const char*>(pData), dataSize)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdUpdateBuffer(cmd, dstBuffer, dstOffset, dataSize, pData);
+      });
+    }
+
+
+    void cmdSetAlphaToOneState(
+            VkBool32                alphaToOneEnable) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetAlphaToOneEnableEXT(cmd, alphaToOneEnable);
+      });
     }
 
 
     void cmdSetAlphaToCoverageState(
             VkBool32                alphaToCoverageEnable) {
-      m_vkd->vkCmdSetAlphaToCoverageEnableEXT(getCmdBuffer(), alphaToCoverageEnable);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetAlphaToCoverageEnableEXT(cmd, alphaToCoverageEnable);
+      });
     }
 
-    
+
     void cmdSetBlendConstants(const float blendConstants[4]) {
-      m_vkd->vkCmdSetBlendConstants(getCmdBuffer(), blendConstants);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        blendConstants = deferData(DxvkCmdBuffer::ExecBuffer, blendConstants, 4)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetBlendConstants(cmd, blendConstants);
+      });
     }
-    
+
+
+    void cmdSetColorBlendState(
+            uint32_t                attachmentCount,
+      const VkBool32*               pBlendEnables,
+      const VkColorBlendEquationEXT* pBlendEquations,
+      const VkColorComponentFlags*  pWriteMasks) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        attachmentCount,
+        pBlendEnables = deferData(DxvkCmdBuffer::ExecBuffer, pBlendEnables, attachmentCount),
+        pBlendEquations = deferData(DxvkCmdBuffer::ExecBuffer, pBlendEquations, attachmentCount),
+        pWriteMasks = deferData(DxvkCmdBuffer::ExecBuffer, pWriteMasks, attachmentCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetColorBlendEnableEXT(cmd, 0, attachmentCount, pBlendEnables);
+        vk.vkCmdSetColorBlendEquationEXT(cmd, 0, attachmentCount, pBlendEquations);
+        vk.vkCmdSetColorWriteMaskEXT(cmd, 0, attachmentCount, pWriteMasks);
+      });
+    }
+
+
+    void cmdSetConservativeRasterizationState(
+            VkConservativeRasterizationModeEXT conservativeMode,
+            float                   extraOverestimationSize) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetConservativeRasterizationModeEXT(cmd, conservativeMode);
+
+        if (conservativeMode == VK_CONSERVATIVE_RASTERIZATION_MODE_OVERESTIMATE_EXT)
+          vk.vkCmdSetExtraPrimitiveOverestimationSizeEXT(cmd, extraOverestimationSize);
+      });
+    }
+
 
     void cmdSetDepthBiasState(
             VkBool32                depthBiasEnable) {
-      m_vkd->vkCmdSetDepthBiasEnable(getCmdBuffer(), depthBiasEnable);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthBiasEnable(cmd, depthBiasEnable);
+      });
+    }
+
+
+    void cmdSetDepthClampState(
+            VkBool32                depthClampEnable) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthClampEnableEXT(cmd, depthClampEnable);
+      });
     }
 
 
     void cmdSetDepthClipState(
             VkBool32                depthClipEnable) {
-      m_vkd->vkCmdSetDepthClipEnableEXT(getCmdBuffer(), depthClipEnable);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthClipEnableEXT(cmd, depthClipEnable);
+      });
     }
 
 
@@ -941,31 +1161,41 @@ namespace dxvk {
             float                   depthBiasConstantFactor,
             float                   depthBiasClamp,
             float                   depthBiasSlopeFactor) {
-      m_vkd->vkCmdSetDepthBias(getCmdBuffer(),
-        depthBiasConstantFactor,
-        depthBiasClamp,
-        depthBiasSlopeFactor);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthBias(cmd,
+          depthBiasConstantFactor,
+          depthBiasClamp,
+          depthBiasSlopeFactor);
+      });
     }
 
 
     void cmdSetDepthBias2(
       const VkDepthBiasInfoEXT     *depthBiasInfo) {
-      m_vkd->vkCmdSetDepthBias2EXT(getCmdBuffer(), depthBiasInfo);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        depthBiasInfo = deferDepthBiasInfo(depthBiasInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthBias2EXT(cmd, depthBiasInfo);
+      });
     }
 
 
     void cmdSetDepthBounds(
             float                   minDepthBounds,
             float                   maxDepthBounds) {
-      m_vkd->vkCmdSetDepthBounds(getCmdBuffer(),
-        minDepthBounds,
-        maxDepthBounds);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthBounds(cmd,
+          minDepthBounds,
+          maxDepthBounds);
+      });
     }
 
 
     void cmdSetDepthBoundsState(
             VkBool32                depthBoundsTestEnable) {
-      m_vkd->vkCmdSetDepthBoundsTestEnable(getCmdBuffer(), depthBoundsTestEnable);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthBoundsTestEnable(cmd, depthBoundsTestEnable);
+      });
     }
 
 
@@ -973,16 +1203,17 @@ namespace dxvk {
             VkBool32                depthTestEnable,
             VkBool32                depthWriteEnable,
             VkCompareOp             depthCompareOp) {
-      VkCommandBuffer cmdBuffer = getCmdBuffer();
-      m_vkd->vkCmdSetDepthTestEnable(cmdBuffer, depthTestEnable);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetDepthTestEnable(cmd, depthTestEnable);
 
-      if (depthTestEnable) {
-        m_vkd->vkCmdSetDepthWriteEnable(cmdBuffer, depthWriteEnable);
-        m_vkd->vkCmdSetDepthCompareOp(cmdBuffer, depthCompareOp);
-      } else {
-        m_vkd->vkCmdSetDepthWriteEnable(cmdBuffer, VK_FALSE);
-        m_vkd->vkCmdSetDepthCompareOp(cmdBuffer, VK_COMPARE_OP_ALWAYS);
-      }
+        if (depthTestEnable) {
+          vk.vkCmdSetDepthWriteEnable(cmd, depthWriteEnable);
+          vk.vkCmdSetDepthCompareOp(cmd, depthCompareOp);
+        } else {
+          vk.vkCmdSetDepthWriteEnable(cmd, VK_FALSE);
+          vk.vkCmdSetDepthCompareOp(cmd, VK_COMPARE_OP_ALWAYS);
+        }
+      });
     }
 
 
@@ -991,34 +1222,92 @@ namespace dxvk {
       const VkDependencyInfo*       dependencyInfo) {
       m_cmd.execCommands = true;
 
-      m_vkd->vkCmdSetEvent2(getCmdBuffer(), event, dependencyInfo);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        event,
+        dependencyInfo = deferDependencyInfo(DxvkCmdBuffer::ExecBuffer, dependencyInfo)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetEvent2(cmd, event, dependencyInfo);
+      });
+    }
+
+
+    void cmdSetInputAssemblyState(
+            VkPrimitiveTopology     topology,
+            VkBool32                primitiveRestartEnable) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetPrimitiveTopology(cmd, topology);
+        vk.vkCmdSetPrimitiveRestartEnable(cmd, primitiveRestartEnable);
+      });
+    }
+
+
+    void cmdSetLineRasterizationState(
+            VkLineRasterizationModeEXT lineMode) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetLineRasterizationModeEXT(cmd, lineMode);
+      });
+    }
+
+
+    void cmdSetLogicOpState(
+            VkBool32                logicOpEnable,
+            VkLogicOp               logicOp) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetLogicOpEnableEXT(cmd, logicOpEnable);
+        vk.vkCmdSetLogicOpEXT(cmd, logicOp);
+      });
     }
 
 
     void cmdSetMultisampleState(
             VkSampleCountFlagBits   sampleCount,
             VkSampleMask            sampleMask) {
-      VkCommandBuffer cmdBuffer = getCmdBuffer();
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetRasterizationSamplesEXT(cmd, sampleCount);
+        vk.vkCmdSetSampleMaskEXT(cmd, sampleCount, &sampleMask);
+      });
+    }
+
+
+    void cmdSetPolygonState(
+            VkBool32                rasterizerDiscardEnable,
+            VkPolygonMode           polygonMode,
+            float                   lineWidth) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetRasterizerDiscardEnable(cmd, rasterizerDiscardEnable);
+        vk.vkCmdSetPolygonModeEXT(cmd, polygonMode);
+        vk.vkCmdSetLineWidth(cmd, lineWidth);
+      });
+    }
+
 
-      m_vkd->vkCmdSetRasterizationSamplesEXT(cmdBuffer, sampleCount);
-      m_vkd->vkCmdSetSampleMaskEXT(cmdBuffer, sampleCount, &sampleMask);
+    void cmdSetRasterizationStream(
+            uint32_t                rasterizationStream) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetRasterizationStreamEXT(cmd, rasterizationStream);
+      });
     }
 
 
     void cmdSetRasterizerState(
             VkCullModeFlags         cullMode,
             VkFrontFace             frontFace) {
-      VkCommandBuffer cmdBuffer = getCmdBuffer();
-
-      m_vkd->vkCmdSetCullMode(cmdBuffer, cullMode);
-      m_vkd->vkCmdSetFrontFace(cmdBuffer, frontFace);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetCullMode(cmd, cullMode);
+        vk.vkCmdSetFrontFace(cmd, frontFace);
+      });
     }
 
-    
+
     void cmdSetScissor(
             uint32_t                scissorCount,
       const VkRect2D*               scissors) {
-      m_vkd->vkCmdSetScissorWithCount(getCmdBuffer(), scissorCount, scissors);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        scissorCount,
+        scissors = deferData(DxvkCmdBuffer::ExecBuffer, scissors, scissorCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetScissorWithCount(cmd, scissorCount, scissors);
+      });
     }
 
 
@@ -1026,59 +1315,83 @@ namespace dxvk {
             VkBool32                enableStencilTest,
       const VkStencilOpState&       front,
       const VkStencilOpState&       back) {
-      VkCommandBuffer cmdBuffer = getCmdBuffer();
-
-      m_vkd->vkCmdSetStencilTestEnable(
-        cmdBuffer, enableStencilTest);
-
-      if (enableStencilTest) {
-        m_vkd->vkCmdSetStencilOp(cmdBuffer,
-          VK_STENCIL_FACE_FRONT_BIT, front.failOp,
-          front.passOp, front.depthFailOp, front.compareOp);
-        m_vkd->vkCmdSetStencilCompareMask(cmdBuffer,
-          VK_STENCIL_FACE_FRONT_BIT, front.compareMask);
-        m_vkd->vkCmdSetStencilWriteMask(cmdBuffer,
-          VK_STENCIL_FACE_FRONT_BIT, front.writeMask);
-
-        m_vkd->vkCmdSetStencilOp(cmdBuffer,
-          VK_STENCIL_FACE_BACK_BIT, back.failOp,
-          back.passOp, back.depthFailOp, back.compareOp);
-        m_vkd->vkCmdSetStencilCompareMask(cmdBuffer,
-          VK_STENCIL_FACE_BACK_BIT, back.compareMask);
-        m_vkd->vkCmdSetStencilWriteMask(cmdBuffer,
-          VK_STENCIL_FACE_BACK_BIT, back.writeMask);
-      } else {
-        m_vkd->vkCmdSetStencilOp(cmdBuffer,
-          VK_STENCIL_FACE_FRONT_AND_BACK,
-          VK_STENCIL_OP_KEEP, VK_STENCIL_OP_KEEP,
-          VK_STENCIL_OP_KEEP, VK_COMPARE_OP_ALWAYS);
-        m_vkd->vkCmdSetStencilCompareMask(cmdBuffer,
-          VK_STENCIL_FACE_FRONT_AND_BACK, 0x0);
-        m_vkd->vkCmdSetStencilWriteMask(cmdBuffer,
-          VK_STENCIL_FACE_FRONT_AND_BACK, 0x0);
-      }
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        enableStencilTest, front, back
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetStencilTestEnable(cmd, enableStencilTest);
+
+        if (enableStencilTest) {
+          vk.vkCmdSetStencilOp(cmd,
+            VK_STENCIL_FACE_FRONT_BIT, front.failOp,
+            front.passOp, front.depthFailOp, front.compareOp);
+          vk.vkCmdSetStencilCompareMask(cmd,
+            VK_STENCIL_FACE_FRONT_BIT, front.compareMask);
+          vk.vkCmdSetStencilWriteMask(cmd,
+            VK_STENCIL_FACE_FRONT_BIT, front.writeMask);
+
+          vk.vkCmdSetStencilOp(cmd,
+            VK_STENCIL_FACE_BACK_BIT, back.failOp,
+            back.passOp, back.depthFailOp, back.compareOp);
+          vk.vkCmdSetStencilCompareMask(cmd,
+            VK_STENCIL_FACE_BACK_BIT, back.compareMask);
+          vk.vkCmdSetStencilWriteMask(cmd,
+            VK_STENCIL_FACE_BACK_BIT, back.writeMask);
+        } else {
+          vk.vkCmdSetStencilOp(cmd,
+            VK_STENCIL_FACE_FRONT_AND_BACK,
+            VK_STENCIL_OP_KEEP, VK_STENCIL_OP_KEEP,
+            VK_STENCIL_OP_KEEP, VK_COMPARE_OP_ALWAYS);
+          vk.vkCmdSetStencilCompareMask(cmd,
+            VK_STENCIL_FACE_FRONT_AND_BACK, 0x0);
+          vk.vkCmdSetStencilWriteMask(cmd,
+            VK_STENCIL_FACE_FRONT_AND_BACK, 0x0);
+        }
+      });
     }
 
 
     void cmdSetStencilReference(
             VkStencilFaceFlags      faceMask,
             uint32_t                reference) {
-      m_vkd->vkCmdSetStencilReference(getCmdBuffer(),
-        faceMask, reference);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetStencilReference(cmd, faceMask, reference);
+      });
     }
 
 
     void cmdSetStencilWriteMask(
             VkStencilFaceFlags      faceMask,
             uint32_t                writeMask) {
-      m_vkd->vkCmdSetStencilWriteMask(getCmdBuffer(), faceMask, writeMask);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetStencilWriteMask(cmd, faceMask, writeMask);
+      });
     }
 
-    
+
+    void cmdSetVertexInput(
+            uint32_t                bindingCount,
+      const VkVertexInputBindingDescription2EXT* pBindings,
+            uint32_t                attributeCount,
+      const VkVertexInputAttributeDescription2EXT* pAttributes) {
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        bindingCount, attributeCount,
+        pBindings = deferData(DxvkCmdBuffer::ExecBuffer, pBindings, bindingCount),
+        pAttributes = deferData(DxvkCmdBuffer::ExecBuffer, pAttributes, attributeCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetVertexInputEXT(cmd, bindingCount, pBindings, attributeCount, pAttributes);
+      });
+    }
+
+
     void cmdSetViewport(
             uint32_t                viewportCount,
       const VkViewport*             viewports) {
-      m_vkd->vkCmdSetViewportWithCount(getCmdBuffer(), viewportCount, viewports);
+      recordCmd(DxvkCmdBuffer::ExecBuffer, [
+        viewportCount,
+        viewports = deferData(DxvkCmdBuffer::ExecBuffer, viewports, viewportCount)
+      ] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdSetViewportWithCount(cmd, viewportCount, viewports);
+      });
     }
 
 
@@ -1089,17 +1402,23 @@ namespace dxvk {
             uint32_t                query) {
       m_cmd.execCommands |= cmdBuffer == DxvkCmdBuffer::ExecBuffer;
 
-      m_vkd->vkCmdWriteTimestamp2(getCmdBuffer(cmdBuffer),
-        pipelineStage, queryPool, query);
+      recordCmd(cmdBuffer, [=] (const vk::DeviceFn& vk, VkCommandBuffer cmd) {
+        vk.vkCmdWriteTimestamp2(cmd, pipelineStage, queryPool, query);
+      });
     }
-    
+
 
     void cmdBeginDebugUtilsLabel(
             DxvkCmdBuffer           cmdBuffer,
       const VkDebugUtilsLabelEXT&   labelInfo) {
       m_cmd.execCommands = true;
 
-      m_vki->vkCmdBeginDebugUtilsLabelEXT(getCmdBuffer(cmdBuffer), &labelInfo);
+      recordCmd(cmdBuffer, [
+        vki = m_vki.ptr(),
+        labelInfo = deferLabelInfo(cmdBuffer, &labelInfo)
+      ] (const vk::DeviceFn&, VkCommandBuffer cmd) {
+        vki->vkCmdBeginDebugUtilsLabelEXT(cmd, labelInfo);
+      });
     }
 
 
@@ -1107,7 +1426,11 @@ namespace dxvk {
             DxvkCmdBuffer           cmdBuffer) {
       m_cmd.execCommands = true;
 
-      m_vki->vkCmdEndDebugUtilsLabelEXT(getCmdBuffer(cmdBuffer));
+      recordCmd(cmdBuffer, [
+        vki = m_vki.ptr()
+      ] (const vk::DeviceFn&, VkCommandBuffer cmd) {
+        vki->vkCmdEndDebugUtilsLabelEXT(cmd);
+      });
     }
 
 
@@ -1116,7 +1439,12 @@ namespace dxvk {
       const VkDebugUtilsLabelEXT&   labelInfo) {
       m_cmd.execCommands = true;
 
-      m_vki->vkCmdInsertDebugUtilsLabelEXT(getCmdBuffer(cmdBuffer), &labelInfo);
+      recordCmd(cmdBuffer, [
+        vki = m_vki.ptr(),
+        labelInfo = deferLabelInfo(cmdBuffer, &labelInfo)
+      ] (const vk::DeviceFn&, VkCommandBuffer cmd) {
+        vki->vkCmdInsertDebugUtilsLabelEXT(cmd, labelInfo);
+      });
     }
 
 
@@ -1173,6 +1501,9 @@ namespace dxvk {
     DxvkCommandSubmissionInfo m_cmd;
     VkCommandBuffer           m_execBuffer = VK_NULL_HANDLE;
 
+    bool                      m_deferExec = false;
+    DxvkCmdStream             m_execStream;
+
     PresenterSync             m_wsiSemaphores = { };
     uint64_t                  m_trackingId = 0u;
 
@@ -1211,6 +1542,52 @@ namespace dxvk {
       return buffer;
     }
 
+    template<typename Fn>
+    force_inline void recordCmd(DxvkCmdBuffer cmdBuffer, Fn&& fn) {
+      recordCmd(cmdBuffer, getCmdBuffer(cmdBuffer), std::forward<Fn>(fn));
+    }
+
+    template<typename Fn>
+    force_inline void recordCmd(DxvkCmdBuffer cmdBuffer, VkCommandBuffer cmd, Fn&& fn) {
+      if (m_deferExec && cmdBuffer == DxvkCmdBuffer::ExecBuffer) {
+        m_execStream.record([cmd, fn] (const vk::DeviceFn& vk) {
+          fn(vk, cmd);
+        });
+      } else {
+        fn(*m_vkd, cmd);
+      }
+    }
+
+    template<typename T>
+    force_inline const T* deferData(DxvkCmdBuffer cmdBuffer, const T* data, size_t count) {
+      // Any data referenced by deferred commands must
+      // be copied since it will not outlive the call
+      if (likely(!m_deferExec || cmdBuffer != DxvkCmdBuffer::ExecBuffer))
+        return data;
+
+      return m_execStream.copy(data, count);
+    }
+
+    template<typename T>
+    const T* deferRegionInfo(DxvkCmdBuffer cmdBuffer, const T* info) {
+      if (likely(!m_deferExec || cmdBuffer != DxvkCmdBuffer::ExecBuffer))
+        return info;
+
+      T* result = m_execStream.copy(info, 1);
+      result->pRegions = m_execStream.copy(info->pRegions, info->regionCount);
+      return result;
+    }
+
+    const VkRenderingInfo* deferRenderingInfo(const VkRenderingInfo* info);
+
+    const VkDependencyInfo* deferDependencyInfo(DxvkCmdBuffer cmdBuffer, const VkDependencyInfo* info);
+
+    const VkDebugUtilsLabelEXT* deferLabelInfo(DxvkCmdBuffer cmdBuffer, const VkDebugUtilsLabelEXT* info);
+
+    const VkDepthBiasInfoEXT* deferDepthBiasInfo(const VkDepthBiasInfoEXT* info);
+
+    void flushDeferredCommands();
+
     DxvkSparseBindSubmission& getSparseBindSubmission() {
       if (likely(m_cmd.sparseBind))
         return m_cmdSparseBinds[m_cmd.sparseCmd];
@@ -1221,7 +1598,7 @@ namespace dxvk {
       return m_cmdSparseBinds.emplace_back();
     }
 
-    void endCommandBuffer(VkCommandBuffer cmdBuffer);
+    void endCommandBuffer(DxvkCmdBuffer type, VkCommandBuffer cmdBuffer);
 
     VkCommandBuffer allocateCommandBuffer(DxvkCmdBuffer type);
 
@@ -67,6 +67,13 @@ namespace dxvk {
     // Add a fast path to query debug utils support
     if (m_device->isDebugEnabled())
       m_features.set(DxvkContextFeature::DebugUtils);
+
+    // Set blend state dynamically if possible in order
+    // to reduce the number of pipeline variants needed
+    if (m_device->canUseDynamicBlendState())
+      m_features.set(DxvkContextFeature::DynamicBlendState);
+
+    m_maxRenameSize = VkDeviceSize(std::max(m_device->config().maxBufferRenameSize, 0)) << 10u;
   }
   
   
@@ -264,7 +271,7 @@ namespace dxvk {
           uint32_t              value) {
     DxvkCmdBuffer cmdBuffer = DxvkCmdBuffer::InitBuffer;
 
-    if (!prepareOutOfOrderTransfer(buffer, offset, length, DxvkAccess::Write)) {
+    if (!prepareOutOfOrderTransfer(buffer, offset, align(length, sizeof(uint32_t)), DxvkAccess::Write)) {
       spillRenderPass(true);
 
       flushPendingAccesses(*buffer, offset, length, DxvkAccess::Write);
@@ -493,6 +500,82 @@ namespace dxvk {
   }
   
   
+  void DxvkContext::copyBufferRanges(
+    const Rc<DxvkBuffer>&       dstBuffer,
+    const Rc<DxvkBuffer>&       srcBuffer,
+          uint32_t              rangeCount,
+    const VkBufferCopy*         ranges) {
+    // Synchronize the union of all ranges. Destination ranges do
+    // not overlap, so the buffer can only be discarded or renamed
+    // if their total size matches the size of the union.
+    VkDeviceSize dstBegin = ranges[0].dstOffset;
+    VkDeviceSize dstEnd = ranges[0].dstOffset + ranges[0].size;
+    VkDeviceSize dstSize = 0u;
+
+    VkDeviceSize srcBegin = ranges[0].srcOffset;
+    VkDeviceSize srcEnd = ranges[0].srcOffset + ranges[0].size;
+
+    for (uint32_t i = 0; i < rangeCount; i++) {
+      dstBegin = std::min(dstBegin, ranges[i].dstOffset);
+      dstEnd = std::max(dstEnd, ranges[i].dstOffset + ranges[i].size);
+      dstSize += ranges[i].size;
+
+      srcBegin = std::min(srcBegin, ranges[i].srcOffset);
+      srcEnd = std::max(srcEnd, ranges[i].srcOffset + ranges[i].size);
+    }
+
+    DxvkCmdBuffer cmdBuffer = DxvkCmdBuffer::InitBuffer;
+
+    bool dstIsDense = dstSize == dstEnd - dstBegin;
+
+    if (!prepareOutOfOrderTransfer(srcBuffer, srcBegin, srcEnd - srcBegin, DxvkAccess::Read)
+     || (dstIsDense && !prepareOutOfOrderTransfer(dstBuffer, dstBegin, dstSize, DxvkAccess::Write))
+     || (!dstIsDense && dstBuffer->isTracked(m_trackingId, DxvkAccess::Write))) {
+      this->spillRenderPass(true);
+
+      flushPendingAccesses(*srcBuffer, srcBegin, srcEnd - srcBegin, DxvkAccess::Read);
+      flushPendingAccesses(*dstBuffer, dstBegin, dstEnd - dstBegin, DxvkAccess::Write);
+
+      cmdBuffer = DxvkCmdBuffer::ExecBuffer;
+    }
+
+    auto srcSlice = srcBuffer->getSliceHandle();
+    auto dstSlice = dstBuffer->getSliceHandle();
+
+    small_vector<VkBufferCopy2, 16> copyRegions(rangeCount);
+
+    for (uint32_t i = 0; i < rangeCount; i++) {
+      copyRegions[i] = { VK_STRUCTURE_TYPE_BUFFER_COPY_2 };
+      copyRegions[i].srcOffset = srcSlice.offset + ranges[i].srcOffset;
+      copyRegions[i].dstOffset = dstSlice.offset + ranges[i].dstOffset;
+      copyRegions[i].size      = ranges[i].size;
+    }
+
+    VkCopyBufferInfo2 copyInfo = { VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2 };
+    copyInfo.srcBuffer = srcSlice.handle;
+    copyInfo.dstBuffer = dstSlice.handle;
+    copyInfo.regionCount = rangeCount;
+    copyInfo.pRegions = copyRegions.data();
+
+    m_cmd->cmdCopyBuffer(cmdBuffer, &copyInfo);
+
+    accessBuffer(cmdBuffer,
+      *srcBuffer, srcBegin, srcEnd - srcBegin,
+      VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      VK_ACCESS_2_TRANSFER_READ_BIT);
+
+    accessBuffer(cmdBuffer,
+      *dstBuffer, dstBegin, dstEnd - dstBegin,
+      VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+    m_cmd->track(dstBuffer, DxvkAccess::Write);
+    m_cmd->track(srcBuffer, DxvkAccess::Read);
+
+    this->addStatCtr(DxvkStatCounter::CmdMergedBufferCopies, rangeCount - 1u);
+  }
+
+
   void DxvkContext::copyBufferRegion(
     const Rc<DxvkBuffer>&       dstBuffer,
           VkDeviceSize          dstOffset,
@@ -1321,168 +1404,10 @@ namespace dxvk {
     this->spillRenderPass(false);
     this->invalidateState();
 
-    // Make sure we can both render to and read from the image
-    VkFormat viewFormat = imageView->info().format;
-
-    DxvkImageUsageInfo usageInfo;
-    usageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-    usageInfo.viewFormatCount = 1;
-    usageInfo.viewFormats = &viewFormat;
-
-    if (!ensureImageCompatibility(imageView->image(), usageInfo)) {
-      Logger::err(str::format("DxvkContext: generateMipmaps: Unsupported operation:"
-        "\n  view format:  ", imageView->info().format,
-        "\n  image format: ", imageView->image()->info().format));
-      return;
-    }
-
-    flushPendingAccesses(*imageView->image(), imageView->imageSubresources(), DxvkAccess::Write);
-
-    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils))) {
-      const char* dstName = imageView->image()->info().debugName;
-
-      m_cmd->cmdBeginDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer, vk::makeLabel(0xe6dcf0,
-        str::format("Mip gen (", dstName ? dstName : "unknown", ")").c_str()));
-    }
-
-    // Create image views, etc.
-    DxvkMetaMipGenViews mipGenerator(imageView);
-    
-    VkImageLayout dstLayout = imageView->pickLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-    VkImageLayout srcLayout = imageView->pickLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-
-    // If necessary, transition first mip level to the read-only layout
-    addImageLayoutTransition(*imageView->image(),
-      mipGenerator.getTopSubresource(), srcLayout,
-      VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-      VK_ACCESS_2_SHADER_READ_BIT, false);
-
-    addImageLayoutTransition(*imageView->image(),
-      mipGenerator.getAllTargetSubresources(), dstLayout,
-      VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-      VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, true);
-
-    flushImageLayoutTransitions(DxvkCmdBuffer::ExecBuffer);
-    
-    // Common descriptor set properties that we use to
-    // bind the source image view to the fragment shader
-    Rc<DxvkSampler> sampler = createBlitSampler(filter);
-
-    VkDescriptorImageInfo descriptorImage = { };
-    descriptorImage.sampler     = sampler->handle();
-    descriptorImage.imageLayout = srcLayout;
-    
-    VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
-    descriptorWrite.dstBinding       = 0;
-    descriptorWrite.dstArrayElement  = 0;
-    descriptorWrite.descriptorCount  = 1;
-    descriptorWrite.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    descriptorWrite.pImageInfo       = &descriptorImage;
-    
-    // Common render pass info
-    VkRenderingAttachmentInfo attachmentInfo = { VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO };
-    attachmentInfo.imageLayout = dstLayout;
-    attachmentInfo.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-    attachmentInfo.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-
-    VkRenderingInfo renderingInfo = { VK_STRUCTURE_TYPE_RENDERING_INFO };
-    renderingInfo.colorAttachmentCount = 1;
-    renderingInfo.pColorAttachments = &attachmentInfo;
-    
-    // Retrieve a compatible pipeline to use for rendering
-    DxvkMetaBlitPipeline pipeInfo = m_common->metaBlit().getPipeline(
-      mipGenerator.getSrcViewType(), imageView->info().format, VK_SAMPLE_COUNT_1_BIT);
-    
-    for (uint32_t i = 0; i < mipGenerator.getPassCount(); i++) {
-      // Width, height and layer count for the current pass
-      VkExtent3D passExtent = mipGenerator.computePassExtent(i);
-      
-      // Create descriptor set with the current source view
-      descriptorImage.imageView = mipGenerator.getSrcViewHandle(i);
-      descriptorWrite.dstSet = m_descriptorPool->alloc(pipeInfo.dsetLayout);
-      m_cmd->updateDescriptorSets(1, &descriptorWrite);
-      
-      // Set up viewport and scissor rect
-      VkViewport viewport;
-      viewport.x        = 0.0f;
-      viewport.y        = 0.0f;
-      viewport.width    = float(passExtent.width);
-      viewport.height   = float(passExtent.height);
-      viewport.minDepth = 0.0f;
-      viewport.maxDepth = 1.0f;
-      
-      VkRect2D scissor;
-      scissor.offset    = { 0, 0 };
-      scissor.extent    = { passExtent.width, passExtent.height };
-      
-      // Set up rendering info
-      attachmentInfo.imageView = mipGenerator.getDstViewHandle(i);
-      renderingInfo.renderArea = scissor;
-      renderingInfo.layerCount = passExtent.depth;
-      
-      // Set up push constants
-      DxvkMetaBlitPushConstants pushConstants = { };
-      pushConstants.srcCoord0  = { 0.0f, 0.0f, 0.0f };
-      pushConstants.srcCoord1  = { 1.0f, 1.0f, 1.0f };
-      pushConstants.layerCount = passExtent.depth;
-
-      if (i) {
-        addImageLayoutTransition(*imageView->image(),
-          mipGenerator.getSourceSubresource(i), dstLayout,
-          VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-          VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, srcLayout,
-          VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-          VK_ACCESS_2_SHADER_READ_BIT);
-
-        flushImageLayoutTransitions(DxvkCmdBuffer::ExecBuffer);
-      }
-
-      m_cmd->cmdBeginRendering(&renderingInfo);
-      m_cmd->cmdBindPipeline(DxvkCmdBuffer::ExecBuffer,
-        VK_PIPELINE_BIND_POINT_GRAPHICS, pipeInfo.pipeHandle);
-      m_cmd->cmdBindDescriptorSet(DxvkCmdBuffer::ExecBuffer,
-        VK_PIPELINE_BIND_POINT_GRAPHICS, pipeInfo.pipeLayout,
-        descriptorWrite.dstSet, 0, nullptr);
-      
-      m_cmd->cmdSetViewport(1, &viewport);
-      m_cmd->cmdSetScissor(1, &scissor);
-      
-      m_cmd->cmdPushConstants(DxvkCmdBuffer::ExecBuffer,
-        pipeInfo.pipeLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
-        0, sizeof(pushConstants), &pushConstants);
-      
-      m_cmd->cmdDraw(3, passExtent.depth, 0, 0);
-      m_cmd->cmdEndRendering();
-    }
-
-    // Issue barriers to ensure we can safely access all mip
-    // levels of the image in all ways the image can be used
-    if (srcLayout == dstLayout) {
-      accessImage(DxvkCmdBuffer::ExecBuffer,
-        *imageView->image(), imageView->imageSubresources(), srcLayout,
-        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
-        VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
-        VK_ACCESS_2_SHADER_READ_BIT);
-    } else {
-      accessImage(DxvkCmdBuffer::ExecBuffer,
-        *imageView->image(), mipGenerator.getAllSourceSubresources(), srcLayout,
-        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
-        VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
-        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
-        VK_ACCESS_2_SHADER_READ_BIT);
-
-      accessImage(DxvkCmdBuffer::ExecBuffer,
-        *imageView->image(), mipGenerator.getBottomSubresource(), dstLayout,
-        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
-        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
-    }
-
-    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils)))
-      m_cmd->cmdEndDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer);
-
-    m_cmd->track(imageView->image(), DxvkAccess::Write);
-    m_cmd->track(std::move(sampler));
+    if (canGenerateMipmapsCs(imageView, filter))
+      this->generateMipmapsCs(imageView);
+    else
+      this->generateMipmapsFb(imageView, filter);
   }
   
   
@@ -2423,7 +2348,7 @@ namespace dxvk {
   void DxvkContext::setBlendMode(
           uint32_t            attachment,
     const DxvkBlendMode&      blendMode) {
-    m_state.gp.state.omBlend[attachment] = DxvkOmAttachmentBlend(
+    DxvkOmAttachmentBlend blend(
       blendMode.enableBlending,
       blendMode.colorSrcFactor,
       blendMode.colorDstFactor,
@@ -2432,7 +2357,31 @@ namespace dxvk {
       blendMode.alphaDstFactor,
       blendMode.alphaBlendOp,
       blendMode.writeMask);
-    
+
+    if (m_features.test(DxvkContextFeature::DynamicBlendState)) {
+      m_state.dyn.colorBlend[attachment] = blend;
+      m_flags.set(DxvkContextFlag::GpDirtyBlendState);
+
+      // Only keep the parts of the blend state in the pipeline key that
+      // affect shader code, i.e. whether the render target is written at
+      // all, and the full state if dual-source blending is used.
+      if (attachment || !blendMode.enableBlending || !(
+          util::isDualSourceBlendFactor(blendMode.colorSrcFactor) ||
+          util::isDualSourceBlendFactor(blendMode.colorDstFactor) ||
+          util::isDualSourceBlendFactor(blendMode.alphaSrcFactor) ||
+          util::isDualSourceBlendFactor(blendMode.alphaDstFactor))) {
+        blend = DxvkOmAttachmentBlend(VK_FALSE,
+          VK_BLEND_FACTOR_ONE, VK_BLEND_FACTOR_ZERO, VK_BLEND_OP_ADD,
+          VK_BLEND_FACTOR_ONE, VK_BLEND_FACTOR_ZERO, VK_BLEND_OP_ADD,
+          blendMode.writeMask ? VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+                              | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT : 0u);
+      }
+
+      if (!std::memcmp(&m_state.gp.state.omBlend[attachment], &blend, sizeof(blend)))
+        return;
+    }
+
+    m_state.gp.state.omBlend[attachment] = blend;
     m_flags.set(DxvkContextFlag::GpDirtyPipelineState);
   }
 
@@ -3688,85 +3637,416 @@ namespace dxvk {
           VkClearValue          value) {
     DxvkCmdBuffer cmdBuffer = DxvkCmdBuffer::InitBuffer;
 
-    if (!prepareOutOfOrderTransfer(imageView->image(), DxvkAccess::Write)) {
-      spillRenderPass(false);
-      invalidateState();
+    if (!prepareOutOfOrderTransfer(imageView->image(), DxvkAccess::Write)) {
+      spillRenderPass(false);
+      invalidateState();
+
+      flushPendingAccesses(*imageView->image(), imageView->imageSubresources(), DxvkAccess::Write);
+
+      cmdBuffer = DxvkCmdBuffer::ExecBuffer;
+    }
+
+    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils))) {
+      const char* dstName = imageView->image()->info().debugName;
+
+      m_cmd->cmdBeginDebugUtilsLabel(cmdBuffer, vk::makeLabel(0xf0dcdc,
+        str::format("Clear view (", dstName ? dstName : "unknown", ")").c_str()));
+    }
+
+    addImageLayoutTransition(*imageView->image(), imageView->imageSubresources(),
+      VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
+      imageView->image()->isFullSubresource(vk::pickSubresourceLayers(imageView->imageSubresources(), 0), extent));
+    flushImageLayoutTransitions(cmdBuffer);
+
+    // Query pipeline objects to use for this clear operation
+    DxvkMetaClearPipeline pipeInfo = m_common->metaClear().getClearImagePipeline(
+      imageView->type(), lookupFormatInfo(imageView->info().format)->flags);
+
+    // Create a descriptor set pointing to the view
+    VkDescriptorSet descriptorSet = m_descriptorPool->alloc(pipeInfo.dsetLayout);
+    
+    VkDescriptorImageInfo viewInfo;
+    viewInfo.sampler      = VK_NULL_HANDLE;
+    viewInfo.imageView    = imageView->handle();
+    viewInfo.imageLayout  = imageView->image()->info().layout;
+    
+    VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    descriptorWrite.dstSet           = descriptorSet;
+    descriptorWrite.dstBinding       = 0;
+    descriptorWrite.dstArrayElement  = 0;
+    descriptorWrite.descriptorCount  = 1;
+    descriptorWrite.descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    descriptorWrite.pImageInfo       = &viewInfo;
+    m_cmd->updateDescriptorSets(1, &descriptorWrite);
+    
+    // Prepare shader arguments
+    DxvkMetaClearArgs pushArgs = { };
+    pushArgs.clearValue = value.color;
+    pushArgs.offset = offset;
+    pushArgs.extent = extent;
+    
+    VkExtent3D workgroups = util::computeBlockCount(
+      pushArgs.extent, pipeInfo.workgroupSize);
+    
+    if (imageView->type() == VK_IMAGE_VIEW_TYPE_1D_ARRAY)
+      workgroups.height = imageView->subresources().layerCount;
+    else if (imageView->type() == VK_IMAGE_VIEW_TYPE_2D_ARRAY)
+      workgroups.depth = imageView->subresources().layerCount;
+    
+    m_cmd->cmdBindPipeline(cmdBuffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE, pipeInfo.pipeline);
+    m_cmd->cmdBindDescriptorSet(cmdBuffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE, pipeInfo.pipeLayout,
+      descriptorSet, 0, nullptr);
+    m_cmd->cmdPushConstants(cmdBuffer,
+      pipeInfo.pipeLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+      0, sizeof(pushArgs), &pushArgs);
+    m_cmd->cmdDispatch(cmdBuffer,
+      workgroups.width, workgroups.height, workgroups.depth);
+
+    accessImage(cmdBuffer,
+      *imageView->image(), imageView->imageSubresources(),
+      VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      VK_ACCESS_2_SHADER_WRITE_BIT);
+
+    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils)))
+      m_cmd->cmdEndDebugUtilsLabel(cmdBuffer);
+
+    m_cmd->track(imageView->image(), DxvkAccess::Write);
+  }
+
+  
+  bool DxvkContext::canGenerateMipmapsCs(
+    const Rc<DxvkImageView>&        imageView,
+          VkFilter                  filter) {
+    const auto& imageInfo = imageView->image()->info();
+
+    // The compute shader computes a plain 2x2 average of each
+    // texel block, which matches linear filtering only if each
+    // level is exactly half the size of the previous one.
+    VkExtent3D extent = imageView->mipLevelExtent(0);
+
+    if (filter != VK_FILTER_LINEAR
+     || imageInfo.type != VK_IMAGE_TYPE_2D
+     || imageInfo.tiling != VK_IMAGE_TILING_OPTIMAL
+     || imageView->info().aspects != VK_IMAGE_ASPECT_COLOR_BIT
+     || (extent.width & (extent.width - 1u))
+     || (extent.height & (extent.height - 1u))
+     || std::max(extent.width, extent.height) > (1u << DxvkMetaMipGenObjects::MaxMipCount)
+     || imageView->info().layerCount > DxvkMetaMipGenObjects::MaxLayerCount)
+      return false;
+
+    // Only use the compute path if the image can already be used as a
+    // storage image, since we should not change the layout of images
+    // that are mostly used as render targets for this purpose.
+    constexpr VkImageUsageFlags usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+
+    if ((imageInfo.usage & usage) != usage)
+      return false;
+
+    auto formatInfo = lookupFormatInfo(imageView->info().format);
+
+    if (formatInfo->flags.any(DxvkFormatFlag::SampledUInt, DxvkFormatFlag::SampledSInt))
+      return false;
+
+    constexpr VkFormatFeatureFlags2 features = VK_FORMAT_FEATURE_2_STORAGE_IMAGE_BIT
+      | VK_FORMAT_FEATURE_2_STORAGE_READ_WITHOUT_FORMAT_BIT
+      | VK_FORMAT_FEATURE_2_STORAGE_WRITE_WITHOUT_FORMAT_BIT;
+
+    return (m_device->getFormatFeatures(imageView->info().format).optimal & features) == features;
+  }
+
+
+  void DxvkContext::generateMipmapsCs(
+    const Rc<DxvkImageView>&        imageView) {
+    flushPendingAccesses(*imageView->image(), imageView->imageSubresources(), DxvkAccess::Write);
+
+    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils))) {
+      const char* dstName = imageView->image()->info().debugName;
+
+      m_cmd->cmdBeginDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer, vk::makeLabel(0xe6dcf0,
+        str::format("Mip gen (", dstName ? dstName : "unknown", ")").c_str()));
+    }
+
+    DxvkMetaMipGenViews mipGenerator(imageView, VK_IMAGE_USAGE_STORAGE_BIT);
+
+    // The shader needs one counter per layer in order to determine
+    // which workgroup finishes last. The counters are persistent and
+    // reset by the shader itself, we only need to order dispatches.
+    uint32_t layerCount = imageView->info().layerCount;
+
+    Rc<DxvkBuffer> counterBuffer = createMipGenCounterBuffer();
+    DxvkBufferSliceHandle counterSlice = counterBuffer->getSliceHandle(0, layerCount * sizeof(uint32_t));
+
+    flushPendingAccesses(*counterBuffer, 0, counterSlice.length, DxvkAccess::Write);
+
+    // All levels are accessed in a single dispatch, so use the
+    // general layout for everything and discard target levels
+    addImageLayoutTransition(*imageView->image(),
+      mipGenerator.getTopSubresource(), VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      VK_ACCESS_2_SHADER_READ_BIT, false);
+
+    addImageLayoutTransition(*imageView->image(),
+      mipGenerator.getAllTargetSubresources(), VK_IMAGE_LAYOUT_GENERAL,
+      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT, true);
+
+    flushImageLayoutTransitions(DxvkCmdBuffer::ExecBuffer);
+
+    // Write descriptors. Unused storage image descriptors must
+    // still be valid, so point them to the last generated level.
+    DxvkMetaMipGenPipeline pipeInfo = m_common->metaMipGen().getPipeline();
+
+    VkDescriptorImageInfo srcDescriptor = { };
+    srcDescriptor.imageView = mipGenerator.getSrcViewHandle(0);
+    srcDescriptor.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+    std::array<VkDescriptorImageInfo, DxvkMetaMipGenObjects::MaxMipCount> dstDescriptors = { };
+
+    for (uint32_t i = 0; i < dstDescriptors.size(); i++) {
+      uint32_t pass = std::min(i, mipGenerator.getPassCount() - 1u);
+
+      dstDescriptors[i].imageView = mipGenerator.getDstViewHandle(pass);
+      dstDescriptors[i].imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+    }
+
+    VkDescriptorBufferInfo counterDescriptor = { };
+    counterDescriptor.buffer = counterSlice.handle;
+    counterDescriptor.offset = counterSlice.offset;
+    counterDescriptor.range = counterSlice.length;
+
+    VkDescriptorSet descriptorSet = m_descriptorPool->alloc(pipeInfo.dsetLayout);
+
+    std::array<VkWriteDescriptorSet, 3> descriptorWrites = { };
+
+    for (uint32_t i = 0; i < descriptorWrites.size(); i++) {
+      descriptorWrites[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+      descriptorWrites[i].dstSet = descriptorSet;
+      descriptorWrites[i].dstBinding = i;
+    }
+
+    descriptorWrites[0].descriptorCount = 1;
+    descriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+    descriptorWrites[0].pImageInfo = &srcDescriptor;
+
+    descriptorWrites[1].descriptorCount = dstDescriptors.size();
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+    descriptorWrites[1].pImageInfo = dstDescriptors.data();
+
+    descriptorWrites[2].descriptorCount = 1;
+    descriptorWrites[2].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    descriptorWrites[2].pBufferInfo = &counterDescriptor;
+
+    m_cmd->updateDescriptorSets(descriptorWrites.size(), descriptorWrites.data());
+
+    // Generate all levels in one go
+    VkExtent3D srcExtent = imageView->mipLevelExtent(0);
+
+    DxvkMetaMipGenArgs pushArgs = { };
+    pushArgs.srcExtent = { srcExtent.width, srcExtent.height };
+    pushArgs.mipCount = mipGenerator.getPassCount();
+
+    VkExtent3D workgroups = util::computeBlockCount(
+      VkExtent3D { srcExtent.width, srcExtent.height, 1u }, pipeInfo.tileSize);
+
+    m_cmd->cmdBindPipeline(DxvkCmdBuffer::ExecBuffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE, pipeInfo.pipeline);
+    m_cmd->cmdBindDescriptorSet(DxvkCmdBuffer::ExecBuffer,
+      VK_PIPELINE_BIND_POINT_COMPUTE, pipeInfo.pipeLayout,
+      descriptorSet, 0, nullptr);
+    m_cmd->cmdPushConstants(DxvkCmdBuffer::ExecBuffer,
+      pipeInfo.pipeLayout, VK_SHADER_STAGE_COMPUTE_BIT,
+      0, sizeof(pushArgs), &pushArgs);
+    m_cmd->cmdDispatch(DxvkCmdBuffer::ExecBuffer,
+      workgroups.width, workgroups.height, layerCount);
+
+    accessImage(DxvkCmdBuffer::ExecBuffer,
+      *imageView->image(), imageView->imageSubresources(),
+      VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT);
+
+    accessBuffer(DxvkCmdBuffer::ExecBuffer,
+      *counterBuffer, 0, counterSlice.length,
+      VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
+      VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT);
+
+    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils)))
+      m_cmd->cmdEndDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer);
+
+    m_cmd->track(imageView->image(), DxvkAccess::Write);
+    m_cmd->track(std::move(counterBuffer), DxvkAccess::Write);
+  }
+
+
+  void DxvkContext::generateMipmapsFb(
+    const Rc<DxvkImageView>&        imageView,
+          VkFilter                  filter) {
+    // Make sure we can both render to and read from the image
+    VkFormat viewFormat = imageView->info().format;
+
+    DxvkImageUsageInfo usageInfo;
+    usageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    usageInfo.viewFormatCount = 1;
+    usageInfo.viewFormats = &viewFormat;
+
+    if (!ensureImageCompatibility(imageView->image(), usageInfo)) {
+      Logger::err(str::format("DxvkContext: generateMipmaps: Unsupported operation:"
+        "\n  view format:  ", imageView->info().format,
+        "\n  image format: ", imageView->image()->info().format));
+      return;
+    }
+
+    flushPendingAccesses(*imageView->image(), imageView->imageSubresources(), DxvkAccess::Write);
+
+    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils))) {
+      const char* dstName = imageView->image()->info().debugName;
+
+      m_cmd->cmdBeginDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer, vk::makeLabel(0xe6dcf0,
+        str::format("Mip gen (", dstName ? dstName : "unknown", ")").c_str()));
+    }
+
+    // Create image views, etc.
+    DxvkMetaMipGenViews mipGenerator(imageView, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT);
+    
+    VkImageLayout dstLayout = imageView->pickLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    VkImageLayout srcLayout = imageView->pickLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // If necessary, transition first mip level to the read-only layout
+    addImageLayoutTransition(*imageView->image(),
+      mipGenerator.getTopSubresource(), srcLayout,
+      VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+      VK_ACCESS_2_SHADER_READ_BIT, false);
+
+    addImageLayoutTransition(*imageView->image(),
+      mipGenerator.getAllTargetSubresources(), dstLayout,
+      VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+      VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, true);
+
+    flushImageLayoutTransitions(DxvkCmdBuffer::ExecBuffer);
+    
+    // Common descriptor set properties that we use to
+    // bind the source image view to the fragment shader
+    Rc<DxvkSampler> sampler = createBlitSampler(filter);
+
+    VkDescriptorImageInfo descriptorImage = { };
+    descriptorImage.sampler     = sampler->handle();
+    descriptorImage.imageLayout = srcLayout;
+    
+    VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    descriptorWrite.dstBinding       = 0;
+    descriptorWrite.dstArrayElement  = 0;
+    descriptorWrite.descriptorCount  = 1;
+    descriptorWrite.descriptorType   = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptorWrite.pImageInfo       = &descriptorImage;
+    
+    // Common render pass info
+    VkRenderingAttachmentInfo attachmentInfo = { VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO };
+    attachmentInfo.imageLayout = dstLayout;
+    attachmentInfo.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    attachmentInfo.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+
+    VkRenderingInfo renderingInfo = { VK_STRUCTURE_TYPE_RENDERING_INFO };
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachments = &attachmentInfo;
+    
+    // Retrieve a compatible pipeline to use for rendering
+    DxvkMetaBlitPipeline pipeInfo = m_common->metaBlit().getPipeline(
+      mipGenerator.getSrcViewType(), imageView->info().format, VK_SAMPLE_COUNT_1_BIT);
+    
+    for (uint32_t i = 0; i < mipGenerator.getPassCount(); i++) {
+      // Width, height and layer count for the current pass
+      VkExtent3D passExtent = mipGenerator.computePassExtent(i);
+      
+      // Create descriptor set with the current source view
+      descriptorImage.imageView = mipGenerator.getSrcViewHandle(i);
+      descriptorWrite.dstSet = m_descriptorPool->alloc(pipeInfo.dsetLayout);
+      m_cmd->updateDescriptorSets(1, &descriptorWrite);
+      
+      // Set up viewport and scissor rect
+      VkViewport viewport;
+      viewport.x        = 0.0f;
+      viewport.y        = 0.0f;
+      viewport.width    = float(passExtent.width);
+      viewport.height   = float(passExtent.height);
+      viewport.minDepth = 0.0f;
+      viewport.maxDepth = 1.0f;
+      
+      VkRect2D scissor;
+      scissor.offset    = { 0, 0 };
+      scissor.extent    = { passExtent.width, passExtent.height };
+      
+      // Set up rendering info
+      attachmentInfo.imageView = mipGenerator.getDstViewHandle(i);
+      renderingInfo.renderArea = scissor;
+      renderingInfo.layerCount = passExtent.depth;
+      
+      // Set up push constants
+      DxvkMetaBlitPushConstants pushConstants = { };
+      pushConstants.srcCoord0  = { 0.0f, 0.0f, 0.0f };
+      pushConstants.srcCoord1  = { 1.0f, 1.0f, 1.0f };
+      pushConstants.layerCount = passExtent.depth;
+
+      if (i) {
+        addImageLayoutTransition(*imageView->image(),
+          mipGenerator.getSourceSubresource(i), dstLayout,
+          VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+          VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, srcLayout,
+          VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+          VK_ACCESS_2_SHADER_READ_BIT);
 
-      flushPendingAccesses(*imageView->image(), imageView->imageSubresources(), DxvkAccess::Write);
+        flushImageLayoutTransitions(DxvkCmdBuffer::ExecBuffer);
+      }
 
-      cmdBuffer = DxvkCmdBuffer::ExecBuffer;
+      m_cmd->cmdBeginRendering(&renderingInfo);
+      m_cmd->cmdBindPipeline(DxvkCmdBuffer::ExecBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS, pipeInfo.pipeHandle);
+      m_cmd->cmdBindDescriptorSet(DxvkCmdBuffer::ExecBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS, pipeInfo.pipeLayout,
+        descriptorWrite.dstSet, 0, nullptr);
+      
+      m_cmd->cmdSetViewport(1, &viewport);
+      m_cmd->cmdSetScissor(1, &scissor);
+      
+      m_cmd->cmdPushConstants(DxvkCmdBuffer::ExecBuffer,
+        pipeInfo.pipeLayout, VK_SHADER_STAGE_FRAGMENT_BIT,
+        0, sizeof(pushConstants), &pushConstants);
+      
+      m_cmd->cmdDraw(3, passExtent.depth, 0, 0);
+      m_cmd->cmdEndRendering();
     }
 
-    if (unlikely(m_features.test(DxvkContextFeature::DebugUtils))) {
-      const char* dstName = imageView->image()->info().debugName;
+    // Issue barriers to ensure we can safely access all mip
+    // levels of the image in all ways the image can be used
+    if (srcLayout == dstLayout) {
+      accessImage(DxvkCmdBuffer::ExecBuffer,
+        *imageView->image(), imageView->imageSubresources(), srcLayout,
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
+        VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_2_SHADER_READ_BIT);
+    } else {
+      accessImage(DxvkCmdBuffer::ExecBuffer,
+        *imageView->image(), mipGenerator.getAllSourceSubresources(), srcLayout,
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT |
+        VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT,
+        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT |
+        VK_ACCESS_2_SHADER_READ_BIT);
 
-      m_cmd->cmdBeginDebugUtilsLabel(cmdBuffer, vk::makeLabel(0xf0dcdc,
-        str::format("Clear view (", dstName ? dstName : "unknown", ")").c_str()));
+      accessImage(DxvkCmdBuffer::ExecBuffer,
+        *imageView->image(), mipGenerator.getBottomSubresource(), dstLayout,
+        VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT,
+        VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
     }
 
-    addImageLayoutTransition(*imageView->image(), imageView->imageSubresources(),
-      VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_WRITE_BIT,
-      imageView->image()->isFullSubresource(vk::pickSubresourceLayers(imageView->imageSubresources(), 0), extent));
-    flushImageLayoutTransitions(cmdBuffer);
-
-    // Query pipeline objects to use for this clear operation
-    DxvkMetaClearPipeline pipeInfo = m_common->metaClear().getClearImagePipeline(
-      imageView->type(), lookupFormatInfo(imageView->info().format)->flags);
-
-    // Create a descriptor set pointing to the view
-    VkDescriptorSet descriptorSet = m_descriptorPool->alloc(pipeInfo.dsetLayout);
-    
-    VkDescriptorImageInfo viewInfo;
-    viewInfo.sampler      = VK_NULL_HANDLE;
-    viewInfo.imageView    = imageView->handle();
-    viewInfo.imageLayout  = imageView->image()->info().layout;
-    
-    VkWriteDescriptorSet descriptorWrite = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
-    descriptorWrite.dstSet           = descriptorSet;
-    descriptorWrite.dstBinding       = 0;
-    descriptorWrite.dstArrayElement  = 0;
-    descriptorWrite.descriptorCount  = 1;
-    descriptorWrite.descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
-    descriptorWrite.pImageInfo       = &viewInfo;
-    m_cmd->updateDescriptorSets(1, &descriptorWrite);
-    
-    // Prepare shader arguments
-    DxvkMetaClearArgs pushArgs = { };
-    pushArgs.clearValue = value.color;
-    pushArgs.offset = offset;
-    pushArgs.extent = extent;
-    
-    VkExtent3D workgroups = util::computeBlockCount(
-      pushArgs.extent, pipeInfo.workgroupSize);
-    
-    if (imageView->type() == VK_IMAGE_VIEW_TYPE_1D_ARRAY)
-      workgroups.height = imageView->subresources().layerCount;
-    else if (imageView->type() == VK_IMAGE_VIEW_TYPE_2D_ARRAY)
-      workgroups.depth = imageView->subresources().layerCount;
-    
-    m_cmd->cmdBindPipeline(cmdBuffer,
-      VK_PIPELINE_BIND_POINT_COMPUTE, pipeInfo.pipeline);
-    m_cmd->cmdBindDescriptorSet(cmdBuffer,
-      VK_PIPELINE_BIND_POINT_COMPUTE, pipeInfo.pipeLayout,
-      descriptorSet, 0, nullptr);
-    m_cmd->cmdPushConstants(cmdBuffer,
-      pipeInfo.pipeLayout, VK_SHADER_STAGE_COMPUTE_BIT,
-      0, sizeof(pushArgs), &pushArgs);
-    m_cmd->cmdDispatch(cmdBuffer,
-      workgroups.width, workgroups.height, workgroups.depth);
-
-    accessImage(cmdBuffer,
-      *imageView->image(), imageView->imageSubresources(),
-      VK_IMAGE_LAYOUT_GENERAL, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT,
-      VK_ACCESS_2_SHADER_WRITE_BIT);
-
     if (unlikely(m_features.test(DxvkContextFeature::DebugUtils)))
-      m_cmd->cmdEndDebugUtilsLabel(cmdBuffer);
+      m_cmd->cmdEndDebugUtilsLabel(DxvkCmdBuffer::ExecBuffer);
 
     m_cmd->track(imageView->image(), DxvkAccess::Write);
+    m_cmd->track(std::move(sampler));
   }
 
-  
+
   void DxvkContext::copyImageHw(
     const Rc<DxvkImage>&        dstImage,
           VkImageSubresourceLayers dstSubresource,
@@ -4957,6 +5237,7 @@ namespace dxvk {
         DxvkContextFlag::GpDirtyIndexBuffer,
         DxvkContextFlag::GpDirtyXfbBuffers,
         DxvkContextFlag::GpDirtyBlendConstants,
+        DxvkContextFlag::GpDirtyBlendState,
         DxvkContextFlag::GpDirtyStencilRef,
         DxvkContextFlag::GpDirtyMultisampleState,
         DxvkContextFlag::GpDirtyRasterizerState,
@@ -5446,6 +5727,7 @@ namespace dxvk {
       DxvkContextFlag::GpDirtyIndexBuffer,
       DxvkContextFlag::GpDirtyXfbBuffers,
       DxvkContextFlag::GpDirtyBlendConstants,
+      DxvkContextFlag::GpDirtyBlendState,
       DxvkContextFlag::GpDirtyStencilRef,
       DxvkContextFlag::GpDirtyMultisampleState,
       DxvkContextFlag::GpDirtyRasterizerState,
@@ -5518,6 +5800,7 @@ namespace dxvk {
     // Check which dynamic states need to be active. States that
     // are not dynamic will be invalidated in the command buffer.
     m_flags.clr(DxvkContextFlag::GpDynamicBlendConstants,
+                DxvkContextFlag::GpDynamicBlendState,
                 DxvkContextFlag::GpDynamicDepthStencilState,
                 DxvkContextFlag::GpDynamicDepthBias,
                 DxvkContextFlag::GpDynamicDepthBounds,
@@ -5526,9 +5809,17 @@ namespace dxvk {
                 DxvkContextFlag::GpDynamicRasterizerState,
                 DxvkContextFlag::GpIndependentSets);
     
-    m_flags.set(m_state.gp.state.useDynamicBlendConstants()
-      ? DxvkContextFlag::GpDynamicBlendConstants
-      : DxvkContextFlag::GpDirtyBlendConstants);
+    if (m_features.test(DxvkContextFeature::DynamicBlendState)) {
+      // The effective write mask depends on shader outputs and render
+      // target formats, so re-apply blend state whenever those change.
+      m_flags.set(DxvkContextFlag::GpDynamicBlendConstants,
+                  DxvkContextFlag::GpDynamicBlendState,
+                  DxvkContextFlag::GpDirtyBlendState);
+    } else {
+      m_flags.set(m_state.gp.state.useDynamicBlendConstants()
+        ? DxvkContextFlag::GpDynamicBlendConstants
+        : DxvkContextFlag::GpDirtyBlendConstants);
+    }
     
     m_flags.set((!m_state.gp.flags.test(DxvkGraphicsPipelineFlag::HasRasterizerDiscard))
       ? DxvkContextFlag::GpDynamicRasterizerState
@@ -5537,15 +5828,31 @@ namespace dxvk {
     // Retrieve and bind actual Vulkan pipeline handle
     auto pipelineInfo = m_state.gp.pipeline->getPipelineHandle(m_state.gp.state);
 
-    if (unlikely(!pipelineInfo.first))
-      return false;
+    if (pipelineInfo.second == DxvkGraphicsPipelineType::ShaderObjects) {
+      this->bindShaderObjects();
+    } else {
+      if (unlikely(!pipelineInfo.first))
+        return false;
 
-    m_cmd->cmdBindPipeline(DxvkCmdBuffer::ExecBuffer,
-      VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineInfo.first);
+      m_cmd->cmdBindPipeline(DxvkCmdBuffer::ExecBuffer,
+        VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineInfo.first);
+    }
+
+    // For shader objects and pipelines created from graphics pipeline libraries,
+    // we need to apply a bunch of dynamic state that is otherwise static or unused.
+    // Any state that was static in a previously bound pipeline is already dirty.
+    if (pipelineInfo.second == DxvkGraphicsPipelineType::ShaderObjects) {
+      m_flags.set(
+        DxvkContextFlag::GpDynamicDepthStencilState,
+        DxvkContextFlag::GpDynamicDepthBias,
+        DxvkContextFlag::GpDynamicStencilRef,
+        DxvkContextFlag::GpDynamicMultisampleState);
+
+      if (m_device->features().core.features.depthBounds)
+        m_flags.set(DxvkContextFlag::GpDynamicDepthBounds);
 
-    // For pipelines created from graphics pipeline libraries, we need to
-    // apply a bunch of dynamic state that is otherwise static or unused
-    if (pipelineInfo.second == DxvkGraphicsPipelineType::BasePipeline) {
+      this->updateShaderObjectState();
+    } else if (pipelineInfo.second == DxvkGraphicsPipelineType::BasePipeline) {
       m_flags.set(
         DxvkContextFlag::GpDynamicDepthStencilState,
         DxvkContextFlag::GpDynamicDepthBias,
@@ -5678,8 +5985,8 @@ namespace dxvk {
 
     uint32_t layoutSetMask = layout->getSetMask();
     uint32_t dirtySetMask = BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS
-      ? m_descriptorState.getDirtyGraphicsSets()
-      : m_descriptorState.getDirtyComputeSets();
+      ? m_descriptorState.getDirtyGraphicsSets(layout->getSamplerSetMask())
+      : m_descriptorState.getDirtyComputeSets(layout->getSamplerSetMask());
     dirtySetMask &= layoutSetMask;
 
     std::array<VkDescriptorSet, DxvkDescriptorSets::SetCount> sets;
@@ -5871,6 +6178,70 @@ namespace dxvk {
           0, nullptr);
       }
     }
+
+    if (bindings.getSamplerHeapBindingCount())
+      this->updateSamplerHeapBindings<BindPoint>(layout);
+  }
+
+
+  template<VkPipelineBindPoint BindPoint>
+  void DxvkContext::updateSamplerHeapBindings(const DxvkBindingLayoutObjects* layout) {
+    const auto& bindings = layout->layout();
+
+    VkShaderStageFlags stages = BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS
+      ? VkShaderStageFlags(VK_SHADER_STAGE_ALL_GRAPHICS)
+      : VkShaderStageFlags(VK_SHADER_STAGE_COMPUTE_BIT);
+
+    // The heap set needs to be rebound whenever the pipeline layout
+    // changes, since it comes after all regular descriptor sets.
+    if (m_descriptorState.hasDirtySamplerHeap(stages)) {
+      bool independentSets = BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS
+                          && m_flags.test(DxvkContextFlag::GpIndependentSets);
+
+      VkDescriptorSet set = m_device->getSamplerHeap().getSet();
+
+      m_cmd->cmdBindDescriptorSets(DxvkCmdBuffer::ExecBuffer,
+        BindPoint, layout->getPipelineLayout(independentSets),
+        layout->getSamplerHeapSet(), 1, &set, 0, nullptr);
+    }
+
+    if (!m_descriptorState.hasDirtySamplers(stages))
+      return;
+
+    // Pass heap indices to the shader via push constants. Unbound
+    // samplers use index 0, which contains the default sampler.
+    bool changed = false;
+
+    for (uint32_t i = 0; i < bindings.getSamplerHeapBindingCount(); i++) {
+      const auto& binding = bindings.getSamplerHeapBinding(i);
+      const auto& res = m_rc[binding.resourceBinding];
+
+      uint16_t index = 0u;
+
+      if (res.sampler != nullptr) {
+        index = res.sampler->heapIndex();
+
+        m_cmd->track(res.sampler);
+      }
+
+      uint16_t oldIndex;
+      std::memcpy(&oldIndex, &m_state.pc.data[binding.pushConstOffset], sizeof(index));
+
+      if (oldIndex != index) {
+        std::memcpy(&m_state.pc.data[binding.pushConstOffset], &index, sizeof(index));
+        changed = true;
+      }
+    }
+
+    // Push constant data is shared between bind points, so
+    // make sure the other bind point rewrites its indices.
+    if (changed) {
+      m_flags.set(DxvkContextFlag::DirtyPushConstants);
+
+      m_descriptorState.dirtySamplerHeap(BindPoint == VK_PIPELINE_BIND_POINT_GRAPHICS
+        ? VkShaderStageFlags(VK_SHADER_STAGE_COMPUTE_BIT)
+        : VkShaderStageFlags(VK_SHADER_STAGE_ALL_GRAPHICS));
+    }
   }
 
 
@@ -6305,6 +6676,37 @@ namespace dxvk {
       m_cmd->cmdSetBlendConstants(&m_state.dyn.blendConstants.r);
     }
 
+    if (unlikely(m_flags.all(DxvkContextFlag::GpDirtyBlendState,
+                             DxvkContextFlag::GpDynamicBlendState))) {
+      m_flags.clr(DxvkContextFlag::GpDirtyBlendState);
+
+      // Apply the same fixups as we would during pipeline creation
+      uint32_t fsOutputMask = DxvkGraphicsPipelineFragmentOutputState::getOutputMask(
+        m_state.gp.state, m_state.gp.shaders.fs.ptr());
+
+      std::array<VkBool32,                MaxNumRenderTargets> blendEnables;
+      std::array<VkColorBlendEquationEXT, MaxNumRenderTargets> blendEquations;
+      std::array<VkColorComponentFlags,   MaxNumRenderTargets> writeMasks;
+
+      for (uint32_t i = 0; i < MaxNumRenderTargets; i++) {
+        auto state = DxvkGraphicsPipelineFragmentOutputState::getAttachmentState(
+          m_state.gp.state, m_state.dyn.colorBlend[i], i, fsOutputMask);
+
+        blendEnables[i] = state.blendEnable;
+        writeMasks[i] = state.colorWriteMask;
+
+        blendEquations[i].srcColorBlendFactor = state.srcColorBlendFactor;
+        blendEquations[i].dstColorBlendFactor = state.dstColorBlendFactor;
+        blendEquations[i].colorBlendOp        = state.colorBlendOp;
+        blendEquations[i].srcAlphaBlendFactor = state.srcAlphaBlendFactor;
+        blendEquations[i].dstAlphaBlendFactor = state.dstAlphaBlendFactor;
+        blendEquations[i].alphaBlendOp        = state.alphaBlendOp;
+      }
+
+      m_cmd->cmdSetColorBlendState(MaxNumRenderTargets,
+        blendEnables.data(), blendEquations.data(), writeMasks.data());
+    }
+
     if (m_flags.all(DxvkContextFlag::GpDirtyRasterizerState,
                     DxvkContextFlag::GpDynamicRasterizerState)) {
       m_flags.clr(DxvkContextFlag::GpDirtyRasterizerState);
@@ -6358,6 +6760,126 @@ namespace dxvk {
   }
 
 
+  void DxvkContext::bindShaderObjects() {
+    const auto& features = m_device->features().core.features;
+
+    auto shaderObjects = m_state.gp.pipeline->getShaderObjects();
+
+    std::array<VkShaderStageFlagBits, 5> stages;
+    std::array<VkShaderEXT, 5> handles;
+
+    uint32_t stageCount = 0;
+
+    stages[stageCount] = VK_SHADER_STAGE_VERTEX_BIT;
+    handles[stageCount++] = shaderObjects.vs;
+
+    // Shader objects are only used without tessellation and geometry
+    // shaders, but any shaders bound previously must be unbound. This
+    // is only legal if the corresponding feature is enabled.
+    if (features.tessellationShader) {
+      stages[stageCount] = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+      handles[stageCount++] = VK_NULL_HANDLE;
+
+      stages[stageCount] = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+      handles[stageCount++] = VK_NULL_HANDLE;
+    }
+
+    if (features.geometryShader) {
+      stages[stageCount] = VK_SHADER_STAGE_GEOMETRY_BIT;
+      handles[stageCount++] = VK_NULL_HANDLE;
+    }
+
+    stages[stageCount] = VK_SHADER_STAGE_FRAGMENT_BIT;
+    handles[stageCount++] = shaderObjects.fs;
+
+    m_cmd->cmdBindShaders(stageCount, stages.data(), handles.data());
+  }
+
+
+  void DxvkContext::updateShaderObjectState() {
+    const auto& state = m_state.gp.state;
+    const auto& shaders = m_state.gp.shaders;
+
+    // Derive state the same way as we would for pipelines
+    DxvkGraphicsPipelineVertexInputState viState(m_device, state, shaders.vs.ptr());
+    DxvkGraphicsPipelinePreRasterizationState prState(m_device, state,
+      shaders.tes.ptr(), shaders.gs.ptr(), shaders.fs.ptr());
+
+    m_cmd->cmdSetInputAssemblyState(
+      viState.iaInfo.topology,
+      viState.iaInfo.primitiveRestartEnable);
+
+    m_cmd->cmdSetPolygonState(
+      prState.rsInfo.rasterizerDiscardEnable,
+      prState.rsInfo.polygonMode,
+      prState.rsInfo.lineWidth);
+
+    m_cmd->cmdSetDepthClampState(prState.rsInfo.depthClampEnable);
+
+    if (m_device->features().extDepthClipEnable.depthClipEnable)
+      m_cmd->cmdSetDepthClipState(prState.rsDepthClipInfo.depthClipEnable);
+
+    if (m_device->features().extConservativeRasterization) {
+      m_cmd->cmdSetConservativeRasterizationState(
+        prState.rsConservativeInfo.conservativeRasterizationMode,
+        prState.rsConservativeInfo.extraPrimitiveOverestimationSize);
+    }
+
+    if (m_device->features().extLineRasterization.rectangularLines)
+      m_cmd->cmdSetLineRasterizationState(prState.rsLineInfo.lineRasterizationMode);
+
+    if (m_device->features().extTransformFeedback.geometryStreams)
+      m_cmd->cmdSetRasterizationStream(0);
+
+    if (m_device->features().core.features.logicOp)
+      m_cmd->cmdSetLogicOpState(state.om.enableLogicOp(), state.om.logicOp());
+
+    if (m_device->features().core.features.alphaToOne)
+      m_cmd->cmdSetAlphaToOneState(VK_FALSE);
+
+    // Dynamic multisample state does not touch alpha to coverage if
+    // the fragment shader exports the sample mask, so disable it here.
+    if (m_state.gp.flags.test(DxvkGraphicsPipelineFlag::HasSampleMaskExport))
+      m_cmd->cmdSetAlphaToCoverageState(VK_FALSE);
+
+    // Vertex strides set here will be overridden when binding vertex
+    // buffers with dynamic strides, so use the actual strides here.
+    std::array<VkVertexInputBindingDescription2EXT,   MaxNumVertexBindings>   bindings;
+    std::array<VkVertexInputAttributeDescription2EXT, MaxNumVertexAttributes> attributes;
+
+    bool dynamicStrides = m_flags.test(DxvkContextFlag::GpDynamicVertexStrides);
+    bool supportsDivisor = m_device->features().extVertexAttributeDivisor.vertexAttributeInstanceRateDivisor;
+
+    for (uint32_t i = 0; i < viState.viInfo.vertexBindingDescriptionCount; i++) {
+      const auto& binding = viState.viBindings[i];
+      const auto& ilBinding = state.ilBindings[binding.binding];
+
+      bindings[i] = { VK_STRUCTURE_TYPE_VERTEX_INPUT_BINDING_DESCRIPTION_2_EXT };
+      bindings[i].binding = binding.binding;
+      bindings[i].stride = dynamicStrides ? m_state.vi.vertexStrides[ilBinding.binding()] : binding.stride;
+      bindings[i].inputRate = binding.inputRate;
+      bindings[i].divisor = 1;
+
+      if (binding.inputRate == VK_VERTEX_INPUT_RATE_INSTANCE && supportsDivisor)
+        bindings[i].divisor = ilBinding.divisor();
+    }
+
+    for (uint32_t i = 0; i < viState.viInfo.vertexAttributeDescriptionCount; i++) {
+      const auto& attribute = viState.viAttributes[i];
+
+      attributes[i] = { VK_STRUCTURE_TYPE_VERTEX_INPUT_ATTRIBUTE_DESCRIPTION_2_EXT };
+      attributes[i].location = attribute.location;
+      attributes[i].binding = attribute.binding;
+      attributes[i].format = attribute.format;
+      attributes[i].offset = attribute.offset;
+    }
+
+    m_cmd->cmdSetVertexInput(
+      viState.viInfo.vertexBindingDescriptionCount, bindings.data(),
+      viState.viInfo.vertexAttributeDescriptionCount, attributes.data());
+  }
+
+
   template<VkPipelineBindPoint BindPoint>
   void DxvkContext::updatePushConstants() {
     m_flags.clr(DxvkContextFlag::DirtyPushConstants);
@@ -7219,6 +7741,44 @@ namespace dxvk {
     m_cmd->cmdPipelineBarrier(DxvkCmdBuffer::InitBuffer, &depInfo);
     return m_zeroBuffer;
   }
+
+
+  Rc<DxvkBuffer> DxvkContext::createMipGenCounterBuffer() {
+    if (m_mipGenCounterBuffer != nullptr)
+      return m_mipGenCounterBuffer;
+
+    DxvkBufferCreateInfo bufInfo;
+    bufInfo.size    = DxvkMetaMipGenObjects::MaxLayerCount * sizeof(uint32_t);
+    bufInfo.usage   = VK_BUFFER_USAGE_TRANSFER_DST_BIT
+                    | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    bufInfo.stages  = VK_PIPELINE_STAGE_TRANSFER_BIT
+                    | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    bufInfo.access  = VK_ACCESS_TRANSFER_WRITE_BIT
+                    | VK_ACCESS_SHADER_READ_BIT
+                    | VK_ACCESS_SHADER_WRITE_BIT;
+    bufInfo.debugName = "Mip gen counters";
+
+    m_mipGenCounterBuffer = m_device->createBuffer(bufInfo,
+      VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+    DxvkBufferSliceHandle slice = m_mipGenCounterBuffer->getSliceHandle();
+
+    m_cmd->cmdFillBuffer(DxvkCmdBuffer::InitBuffer,
+      slice.handle, slice.offset, slice.length, 0);
+
+    VkMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+    barrier.srcStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+    VkDependencyInfo depInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    depInfo.memoryBarrierCount = 1;
+    depInfo.pMemoryBarriers = &barrier;
+
+    m_cmd->cmdPipelineBarrier(DxvkCmdBuffer::InitBuffer, &depInfo);
+    return m_mipGenCounterBuffer;
+  }
   
 
   void DxvkContext::resizeDescriptorArrays(
@@ -7256,6 +7816,7 @@ namespace dxvk {
       DxvkContextFlag::GpDirtyIndexBuffer,
       DxvkContextFlag::GpDirtyXfbBuffers,
       DxvkContextFlag::GpDirtyBlendConstants,
+      DxvkContextFlag::GpDirtyBlendState,
       DxvkContextFlag::GpDirtyStencilRef,
       DxvkContextFlag::GpDirtyMultisampleState,
       DxvkContextFlag::GpDirtyRasterizerState,
@@ -7281,6 +7842,8 @@ namespace dxvk {
     this->spillRenderPass(true);
     this->flushSharedImages();
 
+    m_queryManager.resolveQueries(m_cmd);
+
     m_sdmaAcquires.finalize(m_cmd);
     m_sdmaBarriers.finalize(m_cmd);
     m_initAcquires.finalize(m_cmd);
@@ -7767,9 +8330,12 @@ namespace dxvk {
     // Otherwise, our only option is to discard. We can only do that if
     // we're writing the full buffer. Therefore, the resource being read
     // should always be checked first to avoid unnecessary discards.
-    if (access != DxvkAccess::Write || size < buffer->info().size || offset)
+    if (access != DxvkAccess::Write)
       return false;
 
+    if (size < buffer->info().size || offset)
+      return renameBuffer(buffer, offset, size);
+
     // Check if the buffer can actually be discarded at all.
     if (!buffer->canRelocate())
       return false;
@@ -7799,6 +8365,73 @@ namespace dxvk {
   }
 
 
+  bool DxvkContext::renameBuffer(
+    const Rc<DxvkBuffer>&           buffer,
+          VkDeviceSize              offset,
+          VkDeviceSize              size) {
+    // Renaming requires copying the rest of the buffer, which is only
+    // worth it if it lets us avoid interrupting the current render pass.
+    // If the buffer has already been written, that write may be pending
+    // in the main command buffer and we cannot read the old contents.
+    if (!m_flags.test(DxvkContextFlag::GpRenderPassBound)
+     || buffer->info().size > m_maxRenameSize
+     || buffer->isTracked(m_trackingId, DxvkAccess::Read)
+     || !buffer->canRelocate())
+      return false;
+
+    // Transform feedback buffers would end the render pass anyway
+    VkBufferUsageFlags xfbUsage = VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_COUNTER_BUFFER_BIT_EXT
+                                | VK_BUFFER_USAGE_TRANSFORM_FEEDBACK_BUFFER_BIT_EXT;
+
+    if ((buffer->info().usage & xfbUsage)
+     || !(buffer->info().usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT))
+      return false;
+
+    auto oldSlice = buffer->getSliceHandle();
+    this->invalidateBuffer(buffer, buffer->allocateStorage());
+    auto newSlice = buffer->getSliceHandle();
+
+    // Copy everything except the range about to be written. Pending reads
+    // of the old storage do not matter since nothing will write to it again,
+    // and the regions do not overlap the caller's write, so no barrier is
+    // needed between the two within the init command buffer.
+    std::array<VkBufferCopy2, 2> copyRegions = { };
+    uint32_t copyRegionCount = 0u;
+
+    if (offset) {
+      auto& region = copyRegions[copyRegionCount++];
+      region = { VK_STRUCTURE_TYPE_BUFFER_COPY_2 };
+      region.srcOffset = oldSlice.offset;
+      region.dstOffset = newSlice.offset;
+      region.size = offset;
+    }
+
+    if (offset + size < buffer->info().size) {
+      auto& region = copyRegions[copyRegionCount++];
+      region = { VK_STRUCTURE_TYPE_BUFFER_COPY_2 };
+      region.srcOffset = oldSlice.offset + offset + size;
+      region.dstOffset = newSlice.offset + offset + size;
+      region.size = buffer->info().size - offset - size;
+    }
+
+    VkCopyBufferInfo2 copyInfo = { VK_STRUCTURE_TYPE_COPY_BUFFER_INFO_2 };
+    copyInfo.srcBuffer = oldSlice.handle;
+    copyInfo.dstBuffer = newSlice.handle;
+    copyInfo.regionCount = copyRegionCount;
+    copyInfo.pRegions = copyRegions.data();
+
+    m_cmd->cmdCopyBuffer(DxvkCmdBuffer::InitBuffer, &copyInfo);
+
+    accessBuffer(DxvkCmdBuffer::InitBuffer,
+      *buffer, 0, buffer->info().size,
+      VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+      VK_ACCESS_2_TRANSFER_WRITE_BIT);
+
+    addStatCtr(DxvkStatCounter::CmdBufferRenameCount, 1u);
+    return true;
+  }
+
+
   bool DxvkContext::prepareOutOfOrderTransfer(
     const Rc<DxvkBufferView>&       bufferView,
           VkDeviceSize              offset,
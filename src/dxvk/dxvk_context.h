@@ -322,7 +322,7 @@ namespace dxvk {
             Rc<DxvkSampler>&&     sampler) {
       m_rc[slot].sampler = std::move(sampler);
 
-      m_descriptorState.dirtyViews(stages);
+      m_descriptorState.dirtySamplers(stages);
     }
 
     /**
@@ -533,6 +533,25 @@ namespace dxvk {
             VkDeviceSize          srcOffset,
             VkDeviceSize          numBytes);
     
+    /**
+     * \brief Copies multiple ranges between buffers
+     * 
+     * Behaves like calling \ref copyBuffer once per range,
+     * but records a single copy command and only performs
+     * synchronization once. Destination ranges must not
+     * overlap each other or any of the source ranges.
+     * \param [in] dstBuffer Destination buffer
+     * \param [in] srcBuffer Source buffer
+     * \param [in] rangeCount Number of ranges to copy
+     * \param [in] ranges Ranges to copy, with offsets
+     *    relative to the respective buffers
+     */
+    void copyBufferRanges(
+      const Rc<DxvkBuffer>&       dstBuffer,
+      const Rc<DxvkBuffer>&       srcBuffer,
+            uint32_t              rangeCount,
+      const VkBufferCopy*         ranges);
+    
     /**
      * \brief Copies overlapping buffer region
      * 
@@ -904,8 +923,10 @@ namespace dxvk {
     /**
      * \brief Generates mip maps
      * 
-     * Uses blitting to generate lower mip levels from
-     * the top-most mip level passed to this method.
+     * Generates lower mip levels from the top-most mip level
+     * passed to this method. Uses a single compute dispatch if
+     * the image supports storage access and has power-of-two
+     * dimensions, and one render pass per level otherwise.
      * \param [in] imageView The image to generate mips for
      * \param [in] filter The filter to use for generation
      */
@@ -1413,9 +1434,11 @@ namespace dxvk {
 
     uint64_t                m_trackingId = 0u;
     uint32_t                m_renderPassIndex = 0u;
+    VkDeviceSize            m_maxRenameSize = 0u;
     
     Rc<DxvkCommandList>     m_cmd;
     Rc<DxvkBuffer>          m_zeroBuffer;
+    Rc<DxvkBuffer>          m_mipGenCounterBuffer;
 
     DxvkContextFlags        m_flags;
     DxvkContextState        m_state;
@@ -1539,6 +1562,17 @@ namespace dxvk {
             VkExtent3D            extent,
             VkClearValue          value);
     
+    bool canGenerateMipmapsCs(
+      const Rc<DxvkImageView>&    imageView,
+            VkFilter              filter);
+
+    void generateMipmapsCs(
+      const Rc<DxvkImageView>&    imageView);
+
+    void generateMipmapsFb(
+      const Rc<DxvkImageView>&    imageView,
+            VkFilter              filter);
+
     void copyImageHw(
       const Rc<DxvkImage>&        dstImage,
             VkImageSubresourceLayers dstSubresource,
@@ -1694,6 +1728,9 @@ namespace dxvk {
     template<VkPipelineBindPoint BindPoint>
     void updateResourceBindings(const DxvkBindingLayoutObjects* layout);
 
+    template<VkPipelineBindPoint BindPoint>
+    void updateSamplerHeapBindings(const DxvkBindingLayoutObjects* layout);
+
     void updateComputeShaderResources();
     void updateGraphicsShaderResources();
 
@@ -1734,6 +1771,10 @@ namespace dxvk {
 
     void updateDynamicState();
 
+    void bindShaderObjects();
+
+    void updateShaderObjectState();
+
     template<VkPipelineBindPoint BindPoint>
     void updatePushConstants();
     
@@ -1807,6 +1848,8 @@ namespace dxvk {
     Rc<DxvkBuffer> createZeroBuffer(
             VkDeviceSize              size);
 
+    Rc<DxvkBuffer> createMipGenCounterBuffer();
+
     void resizeDescriptorArrays(
             uint32_t                  bindingCount);
 
@@ -1955,6 +1998,11 @@ namespace dxvk {
             VkDeviceSize              size,
             DxvkAccess                access);
 
+    bool renameBuffer(
+      const Rc<DxvkBuffer>&           buffer,
+            VkDeviceSize              offset,
+            VkDeviceSize              size);
+
     bool prepareOutOfOrderTransfer(
       const Rc<DxvkBufferView>&       bufferView,
             VkDeviceSize              offset,
@@ -20,7 +20,7 @@ namespace dxvk {
    * of the graphics and compute pipelines
    * has changed and/or needs to be updated.
    */
-  enum class DxvkContextFlag : uint32_t  {
+  enum class DxvkContextFlag : uint64_t  {
     GpRenderPassBound,          ///< Render pass is currently bound
     GpRenderPassSuspended,      ///< Render pass is currently suspended
     GpRenderPassSecondaryCmd,   ///< Render pass uses secondary command buffer
@@ -32,6 +32,7 @@ namespace dxvk {
     GpDirtyIndexBuffer,         ///< Index buffer binding are out of date
     GpDirtyXfbBuffers,          ///< Transform feedback buffer bindings are out of date
     GpDirtyBlendConstants,      ///< Blend constants have changed
+    GpDirtyBlendState,          ///< Color blend state has changed
     GpDirtyDepthStencilState,   ///< Depth-stencil state has changed
     GpDirtyDepthBias,           ///< Depth bias has changed
     GpDirtyDepthBounds,         ///< Depth bounds have changed
@@ -41,6 +42,7 @@ namespace dxvk {
     GpDirtyViewport,            ///< Viewport state has changed
     GpDirtySpecConstants,       ///< Graphics spec constants are out of date
     GpDynamicBlendConstants,    ///< Blend constants are dynamic
+    GpDynamicBlendState,        ///< Color blend state is dynamic
     GpDynamicDepthStencilState, ///< Depth-stencil state is dynamic
     GpDynamicDepthBias,         ///< Depth bias is dynamic
     GpDynamicDepthBounds,       ///< Depth bounds are dynamic
@@ -59,7 +61,7 @@ namespace dxvk {
     Count
   };
 
-  static_assert(uint32_t(DxvkContextFlag::Count) <= 32u);
+  static_assert(uint32_t(DxvkContextFlag::Count) <= 64u);
 
   using DxvkContextFlags = Flags<DxvkContextFlag>;
 
@@ -72,6 +74,7 @@ namespace dxvk {
     VariableMultisampleRate,
     IndexBufferRobustness,
     DebugUtils,
+    DynamicBlendState,
     FeatureCount
   };
 
@@ -166,6 +169,7 @@ namespace dxvk {
     uint32_t                    stencilReference        = 0;
     VkCullModeFlags             cullMode                = VK_CULL_MODE_BACK_BIT;
     VkFrontFace                 frontFace               = VK_FRONT_FACE_CLOCKWISE;
+    DxvkOmAttachmentBlend       colorBlend[MaxNumRenderTargets] = { };
   };
 
 
@@ -2,6 +2,18 @@
 
 namespace dxvk {
   
+  DxvkCsPayloadBlock::DxvkCsPayloadBlock(size_t capacity)
+  : m_capacity  (capacity),
+    m_data      (new char[capacity]) {
+
+  }
+
+
+  DxvkCsPayloadBlock::~DxvkCsPayloadBlock() {
+    delete[] m_data;
+  }
+
+
   DxvkCsChunk::DxvkCsChunk() {
     
   }
@@ -12,7 +24,8 @@ namespace dxvk {
   }
   
   
-  void DxvkCsChunk::init(DxvkCsChunkFlags flags) {
+  void DxvkCsChunk::init(DxvkCsChunkPool* pool, DxvkCsChunkFlags flags) {
+    m_pool = pool;
     m_flags = flags;
   }
 
@@ -54,6 +67,30 @@ namespace dxvk {
     m_tail = nullptr;
 
     m_commandOffset = 0;
+
+    freePayload();
+  }
+
+
+  void* DxvkCsChunk::allocPayload(size_t size) {
+    if (likely(!m_payloadBlocks.empty())) {
+      void* payload = m_payloadBlocks.back()->alloc(size);
+
+      if (likely(payload != nullptr))
+        return payload;
+    }
+
+    DxvkCsPayloadBlock* block = m_pool->allocPayloadBlock(size);
+    m_payloadBlocks.push_back(block);
+    return block->alloc(size);
+  }
+
+
+  void DxvkCsChunk::freePayload() {
+    for (auto block : m_payloadBlocks)
+      m_pool->freePayloadBlock(block);
+
+    m_payloadBlocks.clear();
   }
   
   
@@ -65,6 +102,9 @@ namespace dxvk {
   DxvkCsChunkPool::~DxvkCsChunkPool() {
     for (DxvkCsChunk* chunk : m_chunks)
       delete chunk;
+
+    for (DxvkCsPayloadBlock* block : m_payloadBlocks)
+      delete block;
   }
   
   
@@ -82,7 +122,7 @@ namespace dxvk {
     if (!chunk)
       chunk = new DxvkCsChunk();
     
-    chunk->init(flags);
+    chunk->init(this, flags);
     return chunk;
   }
   
@@ -93,6 +133,38 @@ namespace dxvk {
     std::lock_guard<dxvk::mutex> lock(m_mutex);
     m_chunks.push_back(chunk);
   }
+
+
+  DxvkCsPayloadBlock* DxvkCsChunkPool::allocPayloadBlock(size_t size) {
+    if (likely(size <= DxvkCsPayloadBlock::DefaultSize)) {
+      { std::lock_guard<dxvk::mutex> lock(m_mutex);
+
+        if (!m_payloadBlocks.empty()) {
+          DxvkCsPayloadBlock* block = m_payloadBlocks.back();
+          m_payloadBlocks.pop_back();
+          return block;
+        }
+      }
+
+      return new DxvkCsPayloadBlock(DxvkCsPayloadBlock::DefaultSize);
+    }
+
+    // Oversized payload, allocate a dedicated block
+    return new DxvkCsPayloadBlock(size);
+  }
+
+
+  void DxvkCsChunkPool::freePayloadBlock(DxvkCsPayloadBlock* block) {
+    if (unlikely(block->capacity() != DxvkCsPayloadBlock::DefaultSize)) {
+      delete block;
+      return;
+    }
+
+    block->reset();
+
+    std::lock_guard<dxvk::mutex> lock(m_mutex);
+    m_payloadBlocks.push_back(block);
+  }
   
   
   DxvkCsThread::DxvkCsThread(
@@ -120,6 +120,73 @@ namespace dxvk {
   };
   
   
+  /**
+   * \brief Payload block
+   * 
+   * Linear allocator for command payloads that are stored
+   * out of line, such as buffer update data and the range
+   * arrays of merged buffer updates. Blocks of the default
+   * size are recycled by the chunk pool.
+   */
+  class DxvkCsPayloadBlock {
+    constexpr static size_t Alignment = 16;
+  public:
+
+    constexpr static size_t DefaultSize = 16384;
+
+    DxvkCsPayloadBlock(size_t capacity);
+    ~DxvkCsPayloadBlock();
+
+    DxvkCsPayloadBlock             (const DxvkCsPayloadBlock&) = delete;
+    DxvkCsPayloadBlock& operator = (const DxvkCsPayloadBlock&) = delete;
+
+    /**
+     * \brief Queries block capacity
+     * \returns Block capacity, in bytes
+     */
+    size_t capacity() const {
+      return m_capacity;
+    }
+
+    /**
+     * \brief Allocates payload memory
+     * 
+     * \param [in] size Number of bytes to allocate
+     * \returns Pointer to payload memory, or \c nullptr
+     *    if the block does not have enough space left
+     */
+    void* alloc(size_t size) {
+      size = align(size, Alignment);
+
+      if (unlikely(m_offset + size > m_capacity))
+        return nullptr;
+
+      void* result = m_data + m_offset;
+      m_offset += size;
+      return result;
+    }
+
+    /**
+     * \brief Resets block
+     * 
+     * Frees all payload allocations at once.
+     */
+    void reset() {
+      m_offset = 0;
+    }
+
+  private:
+
+    size_t    m_capacity  = 0;
+    size_t    m_offset    = 0;
+    char*     m_data      = nullptr;
+
+  };
+
+
+  class DxvkCsChunkPool;
+
+
   /**
    * \brief Submission flags
    */
@@ -215,11 +282,24 @@ namespace dxvk {
       return func->data();
     }
     
+    /**
+     * \brief Allocates payload memory
+     *
+     * Can be used to attach additional data to a command
+     * that was previously added to this chunk. The memory
+     * remains valid until the chunk gets reset.
+     * \param [in] size Payload size, in bytes
+     * \returns Pointer to payload memory
+     */
+    void* allocPayload(size_t size);
+
     /**
      * \brief Initializes chunk for recording
+     *
+     * \param [in] pool Pool to allocate payload blocks from
      * \param [in] flags Chunk flags
      */
-    void init(DxvkCsChunkFlags flags);
+    void init(DxvkCsChunkPool* pool, DxvkCsChunkFlags flags);
     
     /**
      * \brief Executes all commands
@@ -247,9 +327,15 @@ namespace dxvk {
     DxvkCsCmd* m_tail = nullptr;
 
     DxvkCsChunkFlags m_flags;
+
+    DxvkCsChunkPool* m_pool = nullptr;
+
+    small_vector<DxvkCsPayloadBlock*, 4> m_payloadBlocks;
     
     alignas(64)
     char m_data[MaxBlockSize];
+
+    void freePayload();
     
   };
   
@@ -259,7 +345,8 @@ namespace dxvk {
    * 
    * Implements a pool of CS chunks which can be
    * recycled. The goal is to reduce the number
-   * of dynamic memory allocations.
+   * of dynamic memory allocations. Also manages
+   * payload blocks.
    */
   class DxvkCsChunkPool {
     
@@ -288,11 +375,33 @@ namespace dxvk {
      * \param [in] chunk Chunk to release
      */
     void freeChunk(DxvkCsChunk* chunk);
+
+    /**
+     * \brief Allocates a payload block
+     * 
+     * Returns a recycled block if the payload fits
+     * into a block of the default size, or creates
+     * a dedicated block otherwise.
+     * \param [in] size Minimum payload size
+     * \returns Payload block
+     */
+    DxvkCsPayloadBlock* allocPayloadBlock(size_t size);
+
+    /**
+     * \brief Releases a payload block
+     * 
+     * Resets the block and adds it to the pool,
+     * or destroys it if it is a dedicated block.
+     * \param [in] block Block to release
+     */
+    void freePayloadBlock(DxvkCsPayloadBlock* block);
     
   private:
     
     dxvk::mutex               m_mutex;
     std::vector<DxvkCsChunk*> m_chunks;
+
+    std::vector<DxvkCsPayloadBlock*> m_payloadBlocks;
     
   };
   
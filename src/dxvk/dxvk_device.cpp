@@ -22,7 +22,10 @@ namespace dxvk {
     m_perfHints         (getPerfHints()),
     m_objects           (this),
     m_submissionQueue   (this, queueCallback) {
+    std::string statsExportPath = env::getEnvVar("DXVK_STATS_EXPORT");
 
+    if (!statsExportPath.empty())
+      m_statsExporter = std::make_unique<DxvkStatsExporter>(this, statsExportPath);
   }
   
   
@@ -34,6 +37,11 @@ namespace dxvk {
     if (this_thread::isInModuleDetachment())
       return;
 
+    // The exporter thread queries various device
+    // objects, so make sure it is stopped first.
+    if (m_statsExporter)
+      m_statsExporter->stop();
+
     // Wait for all pending Vulkan commands to be
     // executed before we destroy any resources.
     this->waitForIdle();
@@ -99,6 +107,83 @@ namespace dxvk {
   }
 
 
+  bool DxvkDevice::canUseHostImageCopy(
+    const DxvkImageCreateInfo&        createInfo) const {
+    if (!m_features.extHostImageCopy.hostImageCopy)
+      return false;
+
+    // Mapped images can be written directly, and we don't
+    // want to deal with sparse or shared images here.
+    if (createInfo.tiling != VK_IMAGE_TILING_OPTIMAL || createInfo.shared
+     || (createInfo.flags & VK_IMAGE_CREATE_SPARSE_BINDING_BIT))
+      return false;
+
+    const auto& properties = m_properties.extHostImageCopy;
+    bool supportsLayout = false;
+
+    for (uint32_t i = 0; i < properties.copyDstLayoutCount && !supportsLayout; i++)
+      supportsLayout = properties.pCopyDstLayouts[i] == createInfo.layout;
+
+    if (!supportsLayout)
+      return false;
+
+    DxvkFormatQuery formatQuery = { };
+    formatQuery.format = createInfo.format;
+    formatQuery.type = createInfo.type;
+    formatQuery.tiling = createInfo.tiling;
+    formatQuery.usage = createInfo.usage | VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT;
+    formatQuery.flags = createInfo.flags;
+
+    auto limits = getFormatLimits(formatQuery);
+    return limits && limits->optimalHostImageCopy;
+  }
+
+
+  bool DxvkDevice::canUseComputeMipGen(
+    const DxvkImageCreateInfo&        createInfo) const {
+    if (!m_options.enableComputeMipGen)
+      return false;
+
+    if (createInfo.type != VK_IMAGE_TYPE_2D
+     || createInfo.tiling != VK_IMAGE_TILING_OPTIMAL
+     || createInfo.sampleCount != VK_SAMPLE_COUNT_1_BIT
+     || createInfo.shared
+     || (createInfo.flags & VK_IMAGE_CREATE_SPARSE_BINDING_BIT))
+      return false;
+
+    auto formatInfo = lookupFormatInfo(createInfo.format);
+
+    if (formatInfo->aspectMask != VK_IMAGE_ASPECT_COLOR_BIT
+     || formatInfo->flags.any(DxvkFormatFlag::SampledUInt, DxvkFormatFlag::SampledSInt))
+      return false;
+
+    constexpr VkFormatFeatureFlags2 features = VK_FORMAT_FEATURE_2_STORAGE_IMAGE_BIT
+      | VK_FORMAT_FEATURE_2_STORAGE_READ_WITHOUT_FORMAT_BIT
+      | VK_FORMAT_FEATURE_2_STORAGE_WRITE_WITHOUT_FORMAT_BIT;
+
+    if ((getFormatFeatures(createInfo.format).optimal & features) != features)
+      return false;
+
+    DxvkFormatQuery formatQuery = { };
+    formatQuery.format = createInfo.format;
+    formatQuery.type = createInfo.type;
+    formatQuery.tiling = createInfo.tiling;
+    formatQuery.usage = createInfo.usage | VK_IMAGE_USAGE_STORAGE_BIT;
+    formatQuery.flags = createInfo.flags;
+
+    if (createInfo.flags & VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT)
+      formatQuery.flags |= VK_IMAGE_CREATE_EXTENDED_USAGE_BIT;
+
+    auto limits = getFormatLimits(formatQuery);
+
+    return limits
+        && limits->maxExtent.width >= createInfo.extent.width
+        && limits->maxExtent.height >= createInfo.extent.height
+        && limits->maxMipLevels >= createInfo.mipLevels
+        && limits->maxArrayLayers >= createInfo.numLayers;
+  }
+
+
   bool DxvkDevice::isUnifiedMemoryArchitecture() const {
     return m_adapter->isUnifiedMemoryArchitecture();
   }
@@ -114,6 +199,41 @@ namespace dxvk {
   }
 
 
+  bool DxvkDevice::canUseDynamicBlendState() const {
+    // All three are needed, since otherwise we would have to
+    // keep some of the blend state in the pipeline key anyway.
+    return m_features.extExtendedDynamicState3.extendedDynamicState3ColorBlendEnable
+        && m_features.extExtendedDynamicState3.extendedDynamicState3ColorBlendEquation
+        && m_features.extExtendedDynamicState3.extendedDynamicState3ColorWriteMask
+        && m_options.enableDynamicBlendState != Tristate::False;
+  }
+
+
+  bool DxvkDevice::canUseShaderObjects() const {
+    // Reuse the regular dynamic state code paths for blend and
+    // multisample state rather than adding separate ones here.
+    return m_features.extShaderObject.shaderObject
+        && m_features.extExtendedDynamicState3.extendedDynamicState3RasterizationSamples
+        && m_features.extExtendedDynamicState3.extendedDynamicState3SampleMask
+        && m_features.extExtendedDynamicState3.extendedDynamicState3AlphaToCoverageEnable
+        && canUseDynamicBlendState()
+        && m_options.enableShaderObjects != Tristate::False;
+  }
+
+
+  bool DxvkDevice::canUseSamplerHeap() const {
+    const auto& limits = m_properties.vk12;
+
+    return m_features.core.features.shaderSampledImageArrayDynamicIndexing
+        && m_features.vk12.descriptorBindingSampledImageUpdateAfterBind
+        && m_features.vk12.descriptorBindingUpdateUnusedWhilePending
+        && m_features.vk12.descriptorBindingPartiallyBound
+        && limits.maxPerStageDescriptorUpdateAfterBindSamplers >= DxvkSamplerHeapInfo::DescriptorCount
+        && limits.maxDescriptorSetUpdateAfterBindSamplers >= DxvkSamplerHeapInfo::DescriptorCount
+        && m_options.enableSamplerHeap != Tristate::False;
+  }
+
+
   bool DxvkDevice::canUsePipelineCacheControl() const {
     // Don't bother with this unless the device also supports shader module
     // identifiers, since decoding and hashing the shaders is slow otherwise
@@ -291,6 +411,16 @@ namespace dxvk {
   }
 
 
+  DxvkSharedAllocationCacheStats DxvkDevice::getMemoryAllocationCacheStats() {
+    return m_objects.memoryManager().getAllocationCacheStats();
+  }
+
+
+  DxvkPipelineWorkerStats DxvkDevice::getPipelineWorkerStats() {
+    return m_objects.pipelineManager().getWorkerStats();
+  }
+
+
   uint32_t DxvkDevice::getCurrentFrameId() const {
     return m_statCounters.getCtr(DxvkStatCounter::QueuePresentCount);
   }
@@ -320,7 +450,8 @@ namespace dxvk {
     }
 
     return new DxvkBuiltInLatencyTracker(presenter,
-      m_options.latencyTolerance, m_features.nvLowLatency2);
+      m_options.latencyTolerance, m_features.nvLowLatency2,
+      m_options.latencyPredictive, TimeSource::getSystemTimeSource());
   }
 
 
@@ -344,6 +475,13 @@ namespace dxvk {
   }
 
 
+  void DxvkDevice::notifyLatencyStats(
+    const Rc<DxvkLatencyTracker>&   tracker) {
+    if (m_statsExporter)
+      m_statsExporter->notifyLatencyStats(tracker->getPublishedStatistics());
+  }
+
+
   void DxvkDevice::submitCommandList(
     const Rc<DxvkCommandList>&      commandList,
     const Rc<DxvkLatencyTracker>&   tracker,
@@ -24,6 +24,7 @@
 #include "dxvk_shader.h"
 #include "dxvk_sparse.h"
 #include "dxvk_stats.h"
+#include "dxvk_stats_export.h"
 #include "dxvk_unbound.h"
 
 namespace dxvk {
@@ -227,6 +228,18 @@ namespace dxvk {
       return m_submissionQueue.getLastError();
     }
 
+    /**
+     * \brief Estimates remaining GPU work
+     *
+     * Useful for flush heuristics. This is only an
+     * estimate based on recent GPU execution times.
+     * \returns Predicted time until the GPU finishes all
+     *    submitted work. Not positive if the GPU is idle.
+     */
+    high_resolution_clock::duration estimateGpuBusyTime() const {
+      return m_submissionQueue.predictGpuIdleTime() - high_resolution_clock::now();
+    }
+
     /**
      * \brief Queries mapped image subresource layout
      *
@@ -240,6 +253,36 @@ namespace dxvk {
       const DxvkImageCreateInfo&        createInfo,
       const VkImageSubresource&         subresource);
 
+    /**
+     * \brief Checks whether host image copies can be used
+     *
+     * Host copies are only considered if they do not affect the
+     * performance of device access to the image, and if the image
+     * can be accessed by the host in its default layout.
+     * \param [in] createInfo Image create info
+     * \returns \c true if the image can be created with
+     *    host transfer usage and initialized on the host.
+     */
+    bool canUseHostImageCopy(
+      const DxvkImageCreateInfo&        createInfo) const;
+
+    /**
+     * \brief Checks whether compute mip generation can be used
+     *
+     * Compute mip generation needs storage usage on the image,
+     * as well as storage reads and writes without a format for
+     * the image format. If this returns \c true, the image can
+     * be created with storage usage. Mutable images must also
+     * be created with the extended usage flag in that case.
+     * Always returns \c false unless enabled by the user,
+     * since storage usage may hurt render target performance.
+     * \param [in] createInfo Image create info
+     * \returns \c true if storage usage can be added to the
+     *    image in order to use compute mip generation.
+     */
+    bool canUseComputeMipGen(
+      const DxvkImageCreateInfo&        createInfo) const;
+
     /**
      * \brief Checks whether this is a UMA system
      *
@@ -255,6 +298,34 @@ namespace dxvk {
      */
     bool canUseGraphicsPipelineLibrary() const;
 
+    /**
+     * \brief Checks whether blend state can be set dynamically
+     *
+     * If this returns \c true, color blend enable, blend equations
+     * and color write masks are dynamic for all graphics pipelines.
+     * \returns \c true if all required features are supported.
+     */
+    bool canUseDynamicBlendState() const;
+
+    /**
+     * \brief Checks whether shader objects can be used
+     *
+     * Shader objects require all pipeline state to be set
+     * dynamically, so this also checks for dynamic blend
+     * and multisample state support.
+     * \returns \c true if all required features are supported.
+     */
+    bool canUseShaderObjects() const;
+
+    /**
+     * \brief Checks whether the global sampler heap can be used
+     *
+     * The sampler heap requires samplers to be dynamically
+     * indexable and updatable while the heap is bound.
+     * \returns \c true if all required features are supported.
+     */
+    bool canUseSamplerHeap() const;
+
     /**
      * \brief Checks whether pipeline creation cache control can be used
      * \returns \c true if all required features are supported.
@@ -439,6 +510,18 @@ namespace dxvk {
      */
     DxvkSharedAllocationCacheStats getMemoryAllocationStats(DxvkMemoryAllocationStats& stats);
 
+    /**
+     * \brief Queries shared allocation cache statistics
+     * \returns Shared allocation cache stats
+     */
+    DxvkSharedAllocationCacheStats getMemoryAllocationCacheStats();
+
+    /**
+     * \brief Queries pipeline compiler worker statistics
+     * \returns Pipeline worker stats
+     */
+    DxvkPipelineWorkerStats getPipelineWorkerStats();
+
     /**
      * \brief Queries sampler statistics
      * \returns Sampler stats
@@ -447,6 +530,16 @@ namespace dxvk {
       return m_objects.samplerPool().getStats();
     }
 
+    /**
+     * \brief Queries global sampler heap
+     *
+     * The heap has no set layout if not supported.
+     * \returns Sampler heap
+     */
+    const DxvkSamplerHeap& getSamplerHeap() {
+      return m_objects.samplerPool().getHeap();
+    }
+
     /**
      * \brief Retreves current frame ID
      * \returns Current frame ID
@@ -507,6 +600,19 @@ namespace dxvk {
       const Rc<DxvkLatencyTracker>&   tracker,
             uint64_t                  frameId,
             DxvkSubmitStatus*         status);
+
+    /**
+     * \brief Forwards latency stats to the stats exporter
+     *
+     * Called on the submission thread once a frame has been
+     * presented. Only reads the snapshot that the tracker
+     * published at the end of the last completed frame, so
+     * this never takes the tracker lock. Does nothing if
+     * stats export is disabled.
+     * \param [in] tracker Latency tracker
+     */
+    void notifyLatencyStats(
+      const Rc<DxvkLatencyTracker>&   tracker);
     
     /**
      * \brief Submits a command list
@@ -617,6 +723,8 @@ namespace dxvk {
     
     DxvkSubmissionQueue         m_submissionQueue;
 
+    std::unique_ptr<DxvkStatsExporter> m_statsExporter;
+
     DxvkDevicePerfHints getPerfHints();
     
     void recycleCommandList(
@@ -24,6 +24,7 @@ namespace dxvk {
     VkPhysicalDeviceCustomBorderColorPropertiesEXT            extCustomBorderColor;
     VkPhysicalDeviceExtendedDynamicState3PropertiesEXT        extExtendedDynamicState3;
     VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT      extGraphicsPipelineLibrary;
+    VkPhysicalDeviceHostImageCopyPropertiesEXT                extHostImageCopy;
     VkPhysicalDeviceLineRasterizationPropertiesEXT            extLineRasterization;
     VkPhysicalDeviceRobustness2PropertiesEXT                  extRobustness2;
     VkPhysicalDeviceTransformFeedbackPropertiesEXT            extTransformFeedback;
@@ -82,6 +83,8 @@ namespace dxvk {
     VkBool32                                                  nvxImageViewHandle;
     VkBool32                                                  khrWin32KeyedMutex;
     VkDeviceMemoryOverallocationCreateInfoAMD                 amdOverallocation;
+    VkPhysicalDeviceHostImageCopyFeaturesEXT                  extHostImageCopy;
+    VkPhysicalDeviceShaderObjectFeaturesEXT                   extShaderObject;
   };
 
 }
\ No newline at end of file
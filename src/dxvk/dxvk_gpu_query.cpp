@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "dxvk_cmdlist.h"
@@ -6,6 +8,11 @@
 
 namespace dxvk {
 
+  VkDeviceSize DxvkGpuQuery::getDataSize() const {
+    return m_allocator->getDataSize();
+  }
+
+
   void DxvkGpuQuery::free() {
     m_allocator->freeQuery(this);
   }
@@ -90,18 +97,30 @@ namespace dxvk {
 
     DxvkQueryData tmpData = { };
 
-    // Try to copy query data to temporary structure
-    std::pair<VkQueryPool, uint32_t> handle = query->getQuery();
+    if (query->hasReadback()) {
+      // Query results get copied to host memory at the end of the
+      // command list, so we only need to read them back once the
+      // command list has completed.
+      const void* data = query->getData();
 
-    VkResult result = vk->vkGetQueryPoolResults(
-      vk->device(), handle.first, handle.second, 1,
-      sizeof(DxvkQueryData), &tmpData,
-      sizeof(DxvkQueryData), VK_QUERY_RESULT_64_BIT);
+      if (!data)
+        return DxvkGpuQueryStatus::Pending;
 
-    if (result == VK_NOT_READY)
-      return DxvkGpuQueryStatus::Pending;
-    else if (result != VK_SUCCESS)
-      return DxvkGpuQueryStatus::Failed;
+      std::memcpy(&tmpData, data, query->getDataSize());
+    } else {
+      // Try to copy query data to temporary structure
+      std::pair<VkQueryPool, uint32_t> handle = query->getQuery();
+
+      VkResult result = vk->vkGetQueryPoolResults(
+        vk->device(), handle.first, handle.second, 1,
+        sizeof(DxvkQueryData), &tmpData,
+        sizeof(DxvkQueryData), VK_QUERY_RESULT_64_BIT);
+
+      if (result == VK_NOT_READY)
+        return DxvkGpuQueryStatus::Pending;
+      else if (result != VK_SUCCESS)
+        return DxvkGpuQueryStatus::Failed;
+    }
 
     // Add numbers to the destination structure
     switch (m_type) {
@@ -178,7 +197,26 @@ namespace dxvk {
   : m_device        (device),
     m_queryType     (queryType),
     m_queryPoolSize (queryPoolSize) {
+    switch (queryType) {
+      case VK_QUERY_TYPE_OCCLUSION:
+        m_dataSize = sizeof(DxvkQueryOcclusionData);
+        break;
+
+      case VK_QUERY_TYPE_TIMESTAMP:
+        m_dataSize = sizeof(DxvkQueryTimestampData);
+        break;
+
+      case VK_QUERY_TYPE_PIPELINE_STATISTICS:
+        m_dataSize = sizeof(DxvkQueryStatisticData);
+        break;
+
+      case VK_QUERY_TYPE_TRANSFORM_FEEDBACK_STREAM_EXT:
+        m_dataSize = sizeof(DxvkQueryXfbStreamData);
+        break;
 
+      default:
+        m_dataSize = sizeof(DxvkQueryData);
+    }
   }
 
   
@@ -198,7 +236,9 @@ namespace dxvk {
     if (!m_free)
       createQueryPool();
 
-    return std::exchange(m_free, m_free->m_next);
+    DxvkGpuQuery* query = std::exchange(m_free, m_free->m_next);
+    query->m_resolved.store(false, std::memory_order_relaxed);
+    return query;
   }
 
 
@@ -240,6 +280,12 @@ namespace dxvk {
     auto& pool = m_pools.emplace_back();
     pool.pool = queryPool;
     pool.queries = new DxvkGpuQuery [m_queryPoolSize];
+    pool.readback = createReadbackBuffer();
+
+    DxvkBufferSliceHandle readback = { };
+
+    if (pool.readback)
+      readback = pool.readback->getSliceHandle();
 
     for (uint32_t i = 0; i < m_queryPoolSize; i++) {
       auto& query = pool.queries[i];
@@ -247,6 +293,12 @@ namespace dxvk {
       query.m_pool = queryPool;
       query.m_index = i;
 
+      if (readback.mapPtr) {
+        query.m_readbackBuffer = readback.handle;
+        query.m_readbackOffset = readback.offset + i * m_dataSize;
+        query.m_readbackData = reinterpret_cast<char*>(readback.mapPtr) + i * m_dataSize;
+      }
+
       if (i + 1u < m_queryPoolSize)
         query.m_next = &pool.queries[i + 1u];
     }
@@ -255,6 +307,27 @@ namespace dxvk {
   }
 
 
+  Rc<DxvkBuffer> DxvkGpuQueryAllocator::createReadbackBuffer() {
+    DxvkBufferCreateInfo info;
+    info.size       = m_dataSize * m_queryPoolSize;
+    info.usage      = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    info.stages     = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    info.access     = VK_ACCESS_TRANSFER_WRITE_BIT;
+    info.debugName  = "Query readback";
+
+    try {
+      return m_device->createBuffer(info,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+        VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+        VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+    } catch (const DxvkError& e) {
+      // Queries will fall back to polling the query pool
+      Logger::warn(str::format("DXVK: Failed to create query readback buffer: ", e.message()));
+      return nullptr;
+    }
+  }
+
+
 
 
   DxvkGpuQueryPool::DxvkGpuQueryPool(DxvkDevice* device)
@@ -352,7 +425,7 @@ namespace dxvk {
       VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
       handle.first, handle.second);
 
-    cmd->track(std::move(q));
+    addPendingResolve(std::move(q));
   }
 
 
@@ -399,7 +472,7 @@ namespace dxvk {
       else
         cmd->cmdEndQuery(handle.first, handle.second);
 
-      array.gpuQuery = nullptr;
+      addPendingResolve(std::move(array.gpuQuery));
     }
 
     // If the query type is still active, allocate, reset and begin
@@ -424,9 +497,75 @@ namespace dxvk {
         cmd->cmdBeginQueryIndexed(handle.first, handle.second, flags, index);
       else
         cmd->cmdBeginQuery(handle.first, handle.second, flags);
+    }
+  }
+
+
+  void DxvkGpuQueryManager::resolveQueries(
+    const Rc<DxvkCommandList>&  cmd) {
+    if (m_pendingResolves.empty())
+      return;
+
+    // Sort queries by pool and index so that we can
+    // copy ranges of adjacent queries in one go
+    std::sort(m_pendingResolves.begin(), m_pendingResolves.end(),
+      [] (const Rc<DxvkGpuQuery>& a, const Rc<DxvkGpuQuery>& b) {
+        if (a->m_pool != b->m_pool)
+          return a->m_pool < b->m_pool;
+        return a->m_index < b->m_index;
+      });
+
+    for (size_t i = 0; i < m_pendingResolves.size(); ) {
+      const auto& first = m_pendingResolves[i];
+
+      if (!first->hasReadback()) {
+        i += 1;
+        continue;
+      }
+
+      size_t count = 1;
+
+      while (i + count < m_pendingResolves.size()) {
+        const auto& next = m_pendingResolves[i + count];
+
+        if (next->m_pool != first->m_pool || next->m_index != first->m_index + count)
+          break;
 
-      cmd->track(array.gpuQuery);
+        count += 1;
+      }
+
+      cmd->cmdCopyQueryPoolResults(DxvkCmdBuffer::ExecBuffer,
+        first->m_pool, first->m_index, uint32_t(count),
+        first->m_readbackBuffer, first->m_readbackOffset,
+        first->m_allocator->getDataSize(),
+        VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT);
+
+      i += count;
     }
+
+    // Make query results visible to the host
+    VkMemoryBarrier2 barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER_2 };
+    barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    barrier.dstStageMask = VK_PIPELINE_STAGE_2_HOST_BIT;
+    barrier.dstAccessMask = VK_ACCESS_2_HOST_READ_BIT;
+
+    VkDependencyInfo depInfo = { VK_STRUCTURE_TYPE_DEPENDENCY_INFO };
+    depInfo.memoryBarrierCount = 1;
+    depInfo.pMemoryBarriers = &barrier;
+
+    cmd->cmdPipelineBarrier(DxvkCmdBuffer::ExecBuffer, &depInfo);
+
+    for (auto& q : m_pendingResolves)
+      cmd->trackQueryReadback(std::move(q));
+
+    m_pendingResolves.clear();
+  }
+
+
+  void DxvkGpuQueryManager::addPendingResolve(
+          Rc<DxvkGpuQuery>      query) {
+    m_pendingResolves.push_back(std::move(query));
   }
 
 
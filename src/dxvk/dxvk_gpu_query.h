@@ -7,10 +7,12 @@
 
 #include "../util/util_small_vector.h"
 
+#include "dxvk_access.h"
 #include "dxvk_include.h"
 
 namespace dxvk {
 
+  class DxvkBuffer;
   class DxvkDevice;
   class DxvkCommandList;
 
@@ -107,6 +109,7 @@ namespace dxvk {
    */
   class DxvkGpuQuery {
     friend class DxvkGpuQueryAllocator;
+    friend class DxvkGpuQueryManager;
   public:
 
     /**
@@ -133,6 +136,45 @@ namespace dxvk {
       return std::make_pair(m_pool, m_index);
     }
 
+    /**
+     * \brief Checks whether the query has readback memory
+     *
+     * If \c true, query results will be copied to host
+     * memory by the GPU and must be read via \ref getData
+     * rather than by polling the query pool.
+     * \returns \c true if readback memory is available
+     */
+    bool hasReadback() const {
+      return m_readbackData != nullptr;
+    }
+
+    /**
+     * \brief Retrieves query data from readback memory
+     *
+     * \returns Pointer to query results, or \c nullptr
+     *    if the results have not been copied yet.
+     */
+    const void* getData() const {
+      return m_resolved.load(std::memory_order_acquire)
+        ? m_readbackData : nullptr;
+    }
+
+    /**
+     * \brief Queries size of the query result
+     * \returns Query data size, in bytes
+     */
+    VkDeviceSize getDataSize() const;
+
+    /**
+     * \brief Marks query results as available
+     *
+     * Called once the command list that copies
+     * query results to host memory has completed.
+     */
+    void markResolved() {
+      m_resolved.store(true, std::memory_order_release);
+    }
+
   private:
 
     DxvkGpuQueryAllocator*  m_allocator = nullptr;
@@ -141,13 +183,42 @@ namespace dxvk {
     VkQueryPool             m_pool      = VK_NULL_HANDLE;
     uint32_t                m_index     = 0u;
 
+    VkBuffer                m_readbackBuffer = VK_NULL_HANDLE;
+    VkDeviceSize            m_readbackOffset = 0u;
+    void*                   m_readbackData   = nullptr;
+
     std::atomic<uint32_t>   m_refCount  = { 0u };
+    std::atomic<bool>       m_resolved  = { false };
 
     void free();
 
   };
 
 
+  /**
+   * \brief Tracking reference for query readbacks
+   *
+   * Marks the query results as available once the
+   * command list that copies them has completed.
+   */
+  class DxvkGpuQueryReadbackRef : public DxvkTrackingRef {
+
+  public:
+
+    explicit DxvkGpuQueryReadbackRef(Rc<DxvkGpuQuery>&& query)
+    : m_query(std::move(query)) { }
+
+    ~DxvkGpuQueryReadbackRef() {
+      m_query->markResolved();
+    }
+
+  private:
+
+    Rc<DxvkGpuQuery> m_query;
+
+  };
+
+
   /**
    * \brief Virtual query object
    *
@@ -302,16 +373,29 @@ namespace dxvk {
     void freeQuery(
             DxvkGpuQuery*               query);
 
+    /**
+     * \brief Queries size of a single query result
+     *
+     * This is also the stride of query results
+     * within the readback buffer of each pool.
+     * \returns Query data size, in bytes
+     */
+    VkDeviceSize getDataSize() const {
+      return m_dataSize;
+    }
+
   private:
 
     struct Pool {
-      VkQueryPool   pool    = VK_NULL_HANDLE;
-      DxvkGpuQuery* queries = nullptr;
+      VkQueryPool     pool     = VK_NULL_HANDLE;
+      DxvkGpuQuery*   queries  = nullptr;
+      Rc<DxvkBuffer>  readback = nullptr;
     };
 
     DxvkDevice*       m_device        = nullptr;
     VkQueryType       m_queryType     = VK_QUERY_TYPE_MAX_ENUM;
     uint32_t          m_queryPoolSize = 0u;
+    VkDeviceSize      m_dataSize      = 0u;
 
     dxvk::mutex       m_mutex;
     std::list<Pool>   m_pools;
@@ -320,6 +404,8 @@ namespace dxvk {
 
     void createQueryPool();
 
+    Rc<DxvkBuffer> createReadbackBuffer();
+
   };
 
 
@@ -428,6 +514,18 @@ namespace dxvk {
       const Rc<DxvkCommandList>&  cmd,
             VkQueryType           type);
 
+    /**
+     * \brief Copies query results to host memory
+     *
+     * Records copies for all queries that were ended since
+     * the last call, merging adjacent queries into a single
+     * copy where possible. Must be called outside of a render
+     * pass, after all active queries have been ended.
+     * \param [in] cmd Command list
+     */
+    void resolveQueries(
+      const Rc<DxvkCommandList>&  cmd);
+
   private:
 
     struct QuerySet {
@@ -440,6 +538,11 @@ namespace dxvk {
 
     std::array<QuerySet, MaxQueryTypes> m_activeQueries = { };
 
+    std::vector<Rc<DxvkGpuQuery>> m_pendingResolves;
+
+    void addPendingResolve(
+            Rc<DxvkGpuQuery>      query);
+
     void restartQueries(
       const Rc<DxvkCommandList>&  cmd,
             VkQueryType           type,
@@ -212,15 +212,7 @@ namespace dxvk {
     const DxvkShader*                     fs) {
     // Set up color formats and attachment blend states. Disable the write
     // mask for any attachment that the fragment shader does not write to.
-    uint32_t fsOutputMask = fs ? fs->info().outputMask : 0u;
-
-    // Dual-source blending can only write to one render target
-    if (state.useDualSourceBlending())
-      fsOutputMask &= 0x1;
-
-    const VkColorComponentFlags rgbaWriteMask
-      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
-      | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+    uint32_t fsOutputMask = getOutputMask(state, fs);
 
     cbInfo.logicOpEnable  = state.om.enableLogicOp();
     cbInfo.logicOp        = state.om.logicOp();
@@ -232,37 +224,7 @@ namespace dxvk {
 
       if (rtColorFormats[i]) {
         rtInfo.colorAttachmentCount = i + 1;
-
-        auto formatInfo = lookupFormatInfo(rtColorFormats[i]);
-
-        if ((fsOutputMask & (1 << i)) && formatInfo) {
-          VkColorComponentFlags writeMask = state.omBlend[i].colorWriteMask();
-
-          if (writeMask != rgbaWriteMask) {
-            writeMask = util::remapComponentMask(
-              state.omBlend[i].colorWriteMask(), state.omSwizzle[i].mapping());
-          }
-
-          writeMask &= formatInfo->componentMask;
-
-          if (writeMask == formatInfo->componentMask)
-            writeMask = rgbaWriteMask;
-
-          if (writeMask) {
-            cbAttachments[i] = state.omBlend[i].state();
-            cbAttachments[i].colorWriteMask = writeMask;
-
-            // If we're rendering to an emulated alpha-only render target, fix up blending
-            if (cbAttachments[i].blendEnable && formatInfo->componentMask == VK_COLOR_COMPONENT_R_BIT && state.omSwizzle[i].rIndex() == 3) {
-              cbAttachments[i].srcColorBlendFactor = util::remapAlphaToColorBlendFactor(
-                std::exchange(cbAttachments[i].srcAlphaBlendFactor, VK_BLEND_FACTOR_ONE));
-              cbAttachments[i].dstColorBlendFactor = util::remapAlphaToColorBlendFactor(
-                std::exchange(cbAttachments[i].dstAlphaBlendFactor, VK_BLEND_FACTOR_ZERO));
-              cbAttachments[i].colorBlendOp =
-                std::exchange(cbAttachments[i].alphaBlendOp, VK_BLEND_OP_ADD);
-            }
-          }
-        }
+        cbAttachments[i] = getAttachmentState(state, state.omBlend[i], i, fsOutputMask);
       }
     }
 
@@ -310,7 +272,8 @@ namespace dxvk {
 
     // We need to be fully consistent with the pipeline state here, and
     // while we could consistently infer it, just don't take any chances
-    cbUseDynamicBlendConstants = state.useDynamicBlendConstants();
+    cbUseDynamicBlendState = device->canUseDynamicBlendState();
+    cbUseDynamicBlendConstants = state.useDynamicBlendConstants() || cbUseDynamicBlendState;
   }
 
 
@@ -328,6 +291,7 @@ namespace dxvk {
            && msInfo.alphaToOneEnable         == other.msInfo.alphaToOneEnable
            && msSampleMask                    == other.msSampleMask
            && cbUseDynamicBlendConstants      == other.cbUseDynamicBlendConstants
+           && cbUseDynamicBlendState          == other.cbUseDynamicBlendState
            && cbUseDynamicAlphaToCoverage     == other.cbUseDynamicAlphaToCoverage
            && feedbackLoop                    == other.feedbackLoop;
 
@@ -368,6 +332,7 @@ namespace dxvk {
     hash.add(uint32_t(msInfo.alphaToOneEnable));
     hash.add(uint32_t(msSampleMask));
     hash.add(uint32_t(cbUseDynamicBlendConstants));
+    hash.add(uint32_t(cbUseDynamicBlendState));
     hash.add(uint32_t(cbUseDynamicAlphaToCoverage));
     hash.add(uint32_t(feedbackLoop));
 
@@ -392,6 +357,68 @@ namespace dxvk {
   }
 
 
+  VkPipelineColorBlendAttachmentState DxvkGraphicsPipelineFragmentOutputState::getAttachmentState(
+    const DxvkGraphicsPipelineStateInfo&  state,
+    const DxvkOmAttachmentBlend&          blend,
+          uint32_t                        index,
+          uint32_t                        fsOutputMask) {
+    const VkColorComponentFlags rgbaWriteMask
+      = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+      | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+
+    VkPipelineColorBlendAttachmentState result = { };
+
+    VkFormat format = state.rt.getColorFormat(index);
+    auto formatInfo = format ? lookupFormatInfo(format) : nullptr;
+
+    if (!(fsOutputMask & (1u << index)) || !formatInfo)
+      return result;
+
+    VkColorComponentFlags writeMask = blend.colorWriteMask();
+
+    if (writeMask != rgbaWriteMask) {
+      writeMask = util::remapComponentMask(
+        blend.colorWriteMask(), state.omSwizzle[index].mapping());
+    }
+
+    writeMask &= formatInfo->componentMask;
+
+    if (writeMask == formatInfo->componentMask)
+      writeMask = rgbaWriteMask;
+
+    if (!writeMask)
+      return result;
+
+    result = blend.state();
+    result.colorWriteMask = writeMask;
+
+    // If we're rendering to an emulated alpha-only render target, fix up blending
+    if (result.blendEnable && formatInfo->componentMask == VK_COLOR_COMPONENT_R_BIT && state.omSwizzle[index].rIndex() == 3) {
+      result.srcColorBlendFactor = util::remapAlphaToColorBlendFactor(
+        std::exchange(result.srcAlphaBlendFactor, VK_BLEND_FACTOR_ONE));
+      result.dstColorBlendFactor = util::remapAlphaToColorBlendFactor(
+        std::exchange(result.dstAlphaBlendFactor, VK_BLEND_FACTOR_ZERO));
+      result.colorBlendOp =
+        std::exchange(result.alphaBlendOp, VK_BLEND_OP_ADD);
+    }
+
+    return result;
+  }
+
+
+  uint32_t DxvkGraphicsPipelineFragmentOutputState::getOutputMask(
+    const DxvkGraphicsPipelineStateInfo&  state,
+    const DxvkShader*                     fs) {
+    uint32_t fsOutputMask = fs ? fs->info().outputMask : 0u;
+
+    // Dual-source blending can only write to one render target
+    if (state.useDualSourceBlending())
+      fsOutputMask &= 0x1;
+
+    return fsOutputMask;
+  }
+
+
   DxvkGraphicsPipelineFragmentOutputLibrary::DxvkGraphicsPipelineFragmentOutputLibrary(
           DxvkDevice*                               device,
     const DxvkGraphicsPipelineFragmentOutputState&  state)
@@ -399,7 +426,7 @@ namespace dxvk {
     auto vk = m_device->vkd();
 
     uint32_t dynamicStateCount = 0;
-    std::array<VkDynamicState, 4> dynamicStates = { };
+    std::array<VkDynamicState, 7> dynamicStates = { };
 
     bool hasDynamicMultisampleState = state.msInfo.sampleShadingEnable
       && m_device->features().extExtendedDynamicState3.extendedDynamicState3RasterizationSamples
@@ -419,6 +446,12 @@ namespace dxvk {
     if (state.cbUseDynamicBlendConstants)
       dynamicStates[dynamicStateCount++] = VK_DYNAMIC_STATE_BLEND_CONSTANTS;
 
+    if (state.cbUseDynamicBlendState) {
+      dynamicStates[dynamicStateCount++] = VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT;
+      dynamicStates[dynamicStateCount++] = VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT;
+      dynamicStates[dynamicStateCount++] = VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT;
+    }
+
     VkPipelineDynamicStateCreateInfo dyInfo = { VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
 
     if (dynamicStateCount) {
@@ -723,8 +756,16 @@ namespace dxvk {
     if (state.useDynamicDepthBounds())
       dyStates[dyInfo.dynamicStateCount++] = VK_DYNAMIC_STATE_DEPTH_BOUNDS;
     
-    if (state.useDynamicBlendConstants())
+    bool hasDynamicBlendState = device->canUseDynamicBlendState();
+
+    if (state.useDynamicBlendConstants() || hasDynamicBlendState)
       dyStates[dyInfo.dynamicStateCount++] = VK_DYNAMIC_STATE_BLEND_CONSTANTS;
+
+    if (hasDynamicBlendState) {
+      dyStates[dyInfo.dynamicStateCount++] = VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT;
+      dyStates[dyInfo.dynamicStateCount++] = VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT;
+      dyStates[dyInfo.dynamicStateCount++] = VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT;
+    }
     
     if (state.useDynamicStencilRef())
       dyStates[dyInfo.dynamicStateCount++] = VK_DYNAMIC_STATE_STENCIL_REFERENCE;
@@ -975,6 +1016,17 @@ namespace dxvk {
       if (m_shaders.fs->flags().test(DxvkShaderFlag::ExportsSampleMask))
         m_flags.set(DxvkGraphicsPipelineFlag::HasSampleMaskExport);
     }
+
+    // Shader objects must be created with the same pipeline layout
+    // that descriptors get bound with, so request them for this
+    // pipeline's layout. Pipelines with identical layouts share them.
+    if (this->canCreateShaderObjects()) {
+      if (m_shaders.vs->requestShaderObject(m_bindings))
+        m_workers->compileShaderObject(m_shaders.vs, m_bindings, DxvkPipelinePriority::High);
+
+      if (m_shaders.fs != nullptr && m_shaders.fs->requestShaderObject(m_bindings))
+        m_workers->compileShaderObject(m_shaders.fs, m_bindings, DxvkPipelinePriority::High);
+    }
   }
   
   
@@ -1014,7 +1066,14 @@ namespace dxvk {
         // Keep pipeline object locked, at worst we're going to stall
         // a state cache worker and the current thread needs priority.
         bool canCreateBasePipeline = this->canCreateBasePipeline(state);
-        instance = this->createInstance(state, canCreateBasePipeline);
+        bool canUseShaderObjects = this->canUseShaderObjects(state);
+
+        // Only prefer shader objects over pipeline libraries if requested,
+        // since linking libraries is typically cheap where it is supported.
+        bool doCreateBasePipeline = canCreateBasePipeline && (!canUseShaderObjects
+          || m_device->config().enableShaderObjects != Tristate::True);
+
+        instance = this->createInstance(state, doCreateBasePipeline, canUseShaderObjects);
 
         // Unlock here since we may dispatch the pipeline to a worker,
         // which will then acquire it to increment the use counter.
@@ -1038,6 +1097,9 @@ namespace dxvk {
     if (likely(fastHandle != VK_NULL_HANDLE))
       return std::make_pair(fastHandle, DxvkGraphicsPipelineType::FastPipeline);
 
+    if (instance->shaderObjects)
+      return std::make_pair(VK_NULL_HANDLE, DxvkGraphicsPipelineType::ShaderObjects);
+
     return std::make_pair(instance->baseHandle.load(), DxvkGraphicsPipelineType::BasePipeline);
   }
 
@@ -1065,7 +1127,7 @@ namespace dxvk {
       instance = this->findInstance(state);
 
       if (!instance)
-        instance = this->createInstance(state, false);
+        instance = this->createInstance(state, false, false);
     }
 
     // Exit if another thread is already compiling
@@ -1124,23 +1186,30 @@ namespace dxvk {
 
   DxvkGraphicsPipelineInstance* DxvkGraphicsPipeline::createInstance(
     const DxvkGraphicsPipelineStateInfo& state,
-          bool                           doCreateBasePipeline) {
+          bool                           doCreateBasePipeline,
+          bool                           doUseShaderObjects) {
     VkPipeline baseHandle = VK_NULL_HANDLE;
     VkPipeline fastHandle = VK_NULL_HANDLE;
+    VkBool32 shaderObjects = VK_FALSE;
 
     if (doCreateBasePipeline)
       baseHandle = this->getBasePipeline(state);
 
+    // Shader objects are owned by the shaders themselves and have
+    // already been created at this point, so this is free.
+    if (!baseHandle && doUseShaderObjects)
+      shaderObjects = VK_TRUE;
+
     // Fast-linking may fail in some situations
-    if (!baseHandle)
+    if (!baseHandle && !shaderObjects)
       fastHandle = this->getOptimizedPipeline(state);
 
     // Log pipeline state if requested, or on failure
-    if (!fastHandle && !baseHandle)
+    if (!fastHandle && !baseHandle && !shaderObjects)
       this->logPipelineState(LogLevel::Error, state);
 
     m_stats->numGraphicsPipelines += 1;
-    return &(*m_pipelines.emplace(state, baseHandle, fastHandle));
+    return &(*m_pipelines.emplace(state, baseHandle, fastHandle, shaderObjects));
   }
   
   
@@ -1238,6 +1307,83 @@ namespace dxvk {
   }
 
 
+  bool DxvkGraphicsPipeline::canCreateShaderObjects() const {
+    if (!m_device->canUseShaderObjects())
+      return false;
+
+    // Transform feedback state cannot be set dynamically
+    // in a meaningful way, so always use pipelines here
+    if (m_flags.test(DxvkGraphicsPipelineFlag::HasTransformFeedback))
+      return false;
+
+    // Unlinked shader objects are only created for standalone
+    // vertex and fragment shaders, the same way as libraries.
+    if (m_shaders.tcs != nullptr || m_shaders.tes != nullptr || m_shaders.gs != nullptr)
+      return false;
+
+    if (!m_shaders.vs->canUseShaderObject())
+      return false;
+
+    if (m_shaders.fs != nullptr && !m_shaders.fs->canUseShaderObject())
+      return false;
+
+    return true;
+  }
+
+
+  bool DxvkGraphicsPipeline::canUseShaderObjects(
+    const DxvkGraphicsPipelineStateInfo& state) {
+    if (!this->canCreateShaderObjects())
+      return false;
+
+    // Don't wait for shader objects that are still being compiled on
+    // a worker thread, use the regular pipeline code path instead.
+    if (!m_shaderObjects.vs) {
+      VkShaderEXT vs = m_shaders.vs->getShaderObject(m_bindings);
+      VkShaderEXT fs = VK_NULL_HANDLE;
+
+      if (m_shaders.fs != nullptr)
+        fs = m_shaders.fs->getShaderObject(m_bindings);
+
+      if (!vs || (m_shaders.fs != nullptr && !fs))
+        return false;
+
+      // Instances get published after this, so the
+      // context will see these handles when binding
+      m_shaderObjects.fs = fs;
+      m_shaderObjects.vs = vs;
+    }
+
+    // Feedback loops can only be enabled for pipelines
+    if (state.om.feedbackLoop())
+      return false;
+
+    if (m_shaders.fs != nullptr) {
+      // Shader objects use unpatched shader code, so any state
+      // that requires fragment shader patching is unsupported.
+      uint32_t fsIoMask = m_shaders.fs->info().inputMask;
+      uint32_t vsIoMask = m_shaders.vs->info().outputMask;
+
+      if ((vsIoMask & fsIoMask) != fsIoMask)
+        return false;
+
+      if (state.useDualSourceBlending())
+        return false;
+
+      if (state.rs.flatShading() && m_shaders.fs->info().flatShadingInputs)
+        return false;
+    }
+
+    for (uint32_t i = 0; i < MaxNumRenderTargets; i++) {
+      if ((m_fsOut & (1u << i)) && state.writesRenderTarget(i)
+       && !util::isIdentityMapping(state.omSwizzle[i].mapping()))
+        return false;
+    }
+
+    return true;
+  }
+
+
   VkPipeline DxvkGraphicsPipeline::getBasePipeline(
     const DxvkGraphicsPipelineStateInfo& state) {
     DxvkGraphicsPipelineVertexInputState    viState(m_device, state, m_shaders.vs.ptr());
@@ -117,6 +117,7 @@ namespace dxvk {
     VkSampleMask                                    msSampleMask               = 0u;
     VkBool32                                        cbUseDynamicBlendConstants = VK_FALSE;
     VkBool32                                        cbUseDynamicAlphaToCoverage = VK_FALSE;
+    VkBool32                                        cbUseDynamicBlendState     = VK_FALSE;
 
     std::array<VkPipelineColorBlendAttachmentState, MaxNumRenderTargets> cbAttachments  = { };
     std::array<VkFormat,                            MaxNumRenderTargets> rtColorFormats = { };
@@ -126,6 +127,36 @@ namespace dxvk {
     bool eq(const DxvkGraphicsPipelineFragmentOutputState& other) const;
 
     size_t hash() const;
+
+    /**
+     * \brief Computes effective blend state for an attachment
+     *
+     * Disables writes to components that the render target does not
+     * have or that the fragment shader does not write, and applies
+     * the render target swizzle. Also used to set blend state
+     * dynamically, so this must match pipeline creation exactly.
+     * \param [in] state Pipeline state
+     * \param [in] blend Attachment blend state
+     * \param [in] index Render target index
+     * \param [in] fsOutputMask Fragment shader output mask
+     * \returns Vulkan attachment blend state
+     */
+    static VkPipelineColorBlendAttachmentState getAttachmentState(
+      const DxvkGraphicsPipelineStateInfo&  state,
+      const DxvkOmAttachmentBlend&          blend,
+            uint32_t                        index,
+            uint32_t                        fsOutputMask);
+
+    /**
+     * \brief Computes fragment shader output mask
+     *
+     * \param [in] state Pipeline state
+     * \param [in] fs Fragment shader, may be \c nullptr
+     * \returns Mask of render targets written by the shader
+     */
+    static uint32_t getOutputMask(
+      const DxvkGraphicsPipelineStateInfo&  state,
+      const DxvkShader*                     fs);
   };
 
 
@@ -227,7 +258,7 @@ namespace dxvk {
             DxvkGraphicsPipelineFlags       flags);
 
     VkPipelineDynamicStateCreateInfo  dyInfo    = { VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
-    std::array<VkDynamicState, 12>    dyStates  = { };
+    std::array<VkDynamicState, 16>    dyStates  = { };
 
     bool eq(const DxvkGraphicsPipelineDynamicState& other) const;
 
@@ -342,8 +373,21 @@ namespace dxvk {
    * \brief Graphics pipeline type
    */
   enum class DxvkGraphicsPipelineType : uint32_t {
-    BasePipeline = 0, ///< Unoptimized pipeline using graphics pipeline libraries
-    FastPipeline = 1, ///< Monolithic pipeline with less dynamic state
+    BasePipeline  = 0, ///< Unoptimized pipeline using graphics pipeline libraries
+    FastPipeline  = 1, ///< Monolithic pipeline with less dynamic state
+    ShaderObjects = 2, ///< Unlinked shader objects with fully dynamic state
+  };
+
+
+  /**
+   * \brief Shader objects for a graphics pipeline
+   *
+   * Unlinked vertex and fragment shader objects that were
+   * created for the pipeline's complete pipeline layout.
+   */
+  struct DxvkGraphicsPipelineShaderObjects {
+    VkShaderEXT vs = VK_NULL_HANDLE;
+    VkShaderEXT fs = VK_NULL_HANDLE;
   };
 
 
@@ -358,16 +402,19 @@ namespace dxvk {
     DxvkGraphicsPipelineInstance(
       const DxvkGraphicsPipelineStateInfo&  state_,
             VkPipeline                      baseHandle_,
-            VkPipeline                      fastHandle_)
-    : state       (state_),
-      baseHandle  (baseHandle_),
-      fastHandle  (fastHandle_),
-      isCompiling (fastHandle_ != VK_NULL_HANDLE) { }
+            VkPipeline                      fastHandle_,
+            VkBool32                        shaderObjects_)
+    : state         (state_),
+      baseHandle    (baseHandle_),
+      fastHandle    (fastHandle_),
+      isCompiling   (fastHandle_ != VK_NULL_HANDLE),
+      shaderObjects (shaderObjects_) { }
 
     DxvkGraphicsPipelineStateInfo state;
-    std::atomic<VkPipeline>       baseHandle  = { VK_NULL_HANDLE };
-    std::atomic<VkPipeline>       fastHandle  = { VK_NULL_HANDLE };
-    std::atomic<VkBool32>         isCompiling = { VK_FALSE };
+    std::atomic<VkPipeline>       baseHandle    = { VK_NULL_HANDLE };
+    std::atomic<VkPipeline>       fastHandle    = { VK_NULL_HANDLE };
+    std::atomic<VkBool32>         isCompiling   = { VK_FALSE };
+    VkBool32                      shaderObjects = VK_FALSE;
   };
 
 
@@ -561,6 +608,17 @@ namespace dxvk {
      */
     void releasePipeline();
 
+    /**
+     * \brief Retrieves shader objects
+     *
+     * Only valid if \ref getPipelineHandle returned
+     * \c DxvkGraphicsPipelineType::ShaderObjects.
+     * \returns Vertex and fragment shader objects
+     */
+    DxvkGraphicsPipelineShaderObjects getShaderObjects() const {
+      return m_shaderObjects;
+    }
+
     /**
      * \brief Queries debug name for the pipeline
      *
@@ -593,6 +651,8 @@ namespace dxvk {
 
     uint32_t m_specConstantMask = 0;
 
+    DxvkGraphicsPipelineShaderObjects m_shaderObjects;
+
     std::string m_debugName;
 
     alignas(CACHE_LINE_SIZE)
@@ -612,7 +672,8 @@ namespace dxvk {
 
     DxvkGraphicsPipelineInstance* createInstance(
       const DxvkGraphicsPipelineStateInfo& state,
-            bool                           doCreateBasePipeline);
+            bool                           doCreateBasePipeline,
+            bool                           doUseShaderObjects);
     
     DxvkGraphicsPipelineInstance* findInstance(
       const DxvkGraphicsPipelineStateInfo& state);
@@ -620,6 +681,11 @@ namespace dxvk {
     bool canCreateBasePipeline(
       const DxvkGraphicsPipelineStateInfo& state) const;
 
+    bool canCreateShaderObjects() const;
+
+    bool canUseShaderObjects(
+      const DxvkGraphicsPipelineStateInfo& state);
+
     VkPipeline getBasePipeline(
       const DxvkGraphicsPipelineStateInfo& state);
 
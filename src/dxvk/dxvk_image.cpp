@@ -13,7 +13,8 @@ namespace dxvk {
     m_allocator     (&memAlloc),
     m_properties    (memFlags),
     m_shaderStages  (util::shaderStages(createInfo.stages)),
-    m_info          (createInfo) {
+    m_info          (createInfo),
+    m_hostInitPending (bool(createInfo.usage & VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT)) {
     m_allocator->registerResource(this);
 
     copyFormatList(createInfo.viewFormatCount, createInfo.viewFormats);
@@ -39,7 +40,7 @@ namespace dxvk {
     if (m_info.sharing.mode != DxvkSharedHandleMode::Import)
       m_uninitializedSubresourceCount = m_info.numLayers * m_info.mipLevels;
 
-    assignStorage(allocateStorage());
+    assignStorage(allocateStorageWithUsage(DxvkImageUsageInfo(), 0u));
   }
 
 
@@ -74,8 +75,13 @@ namespace dxvk {
 
 
   bool DxvkImage::canRelocate() const {
+    // Images with host transfer usage may still be getting their
+    // initial data written on the host, which would race with a
+    // relocation on the GPU. Host copies are only ever used before
+    // the image is first initialized, so this is temporary.
     return !m_imageInfo.mapPtr && !m_shared && !m_stableAddress
-        && !(m_info.flags & VK_IMAGE_CREATE_SPARSE_BINDING_BIT);
+        && !(m_info.flags & VK_IMAGE_CREATE_SPARSE_BINDING_BIT)
+        && !m_hostInitPending.load(std::memory_order_acquire);
   }
 
 
@@ -126,13 +132,15 @@ namespace dxvk {
 
 
   Rc<DxvkResourceAllocation> DxvkImage::allocateStorage() {
-    return allocateStorageWithUsage(DxvkImageUsageInfo(), 0u);
+    return allocateStorageWithUsage(DxvkImageUsageInfo(), 0u,
+      m_lifetime.notifyReplace(m_allocator->getTaskEpoch()));
   }
 
 
   Rc<DxvkResourceAllocation> DxvkImage::allocateStorageWithUsage(
     const DxvkImageUsageInfo&         usageInfo,
-          DxvkAllocationModes         mode) {
+          DxvkAllocationModes         mode,
+          DxvkAllocationLifetime      lifetime) {
     const DxvkFormatInfo* formatInfo = lookupFormatInfo(m_info.format);
     small_vector<VkFormat, 4> localViewFormats;
 
@@ -192,6 +200,7 @@ namespace dxvk {
     allocationInfo.resourceCookie = cookie();
     allocationInfo.properties = m_properties;
     allocationInfo.mode = mode;
+    allocationInfo.lifetime = lifetime;
 
     return m_allocator->createImageResource(imageInfo,
       allocationInfo, sharedMemoryInfo);
@@ -252,6 +261,10 @@ namespace dxvk {
     if (!m_uninitializedSubresourceCount)
       return;
 
+    // Host copies only happen on uninitialized images, so
+    // relocation is safe as soon as any data is written
+    m_hostInitPending.store(false, std::memory_order_release);
+
     if (subresources.levelCount == m_info.mipLevels && subresources.layerCount == m_info.numLayers) {
       // Trivial case, everything gets initialized at once
       m_uninitializedSubresourceCount = 0u;
@@ -297,6 +310,37 @@ namespace dxvk {
   }
 
 
+  void DxvkImage::initFromMemory(
+          uint32_t                  regionCount,
+    const VkMemoryToImageCopyEXT*   regions) {
+    VkImageSubresourceRange subresources = getAvailableSubresources();
+
+    VkHostImageLayoutTransitionInfoEXT transition = { VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT };
+    transition.image = m_imageInfo.image;
+    transition.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    transition.newLayout = m_info.layout;
+    transition.subresourceRange = subresources;
+
+    VkResult vr = m_vkd->vkTransitionImageLayoutEXT(m_vkd->device(), 1u, &transition);
+
+    if (vr != VK_SUCCESS)
+      throw DxvkError(str::format("DxvkImage: Host layout transition failed: ", vr));
+
+    VkCopyMemoryToImageInfoEXT copy = { VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT };
+    copy.dstImage = m_imageInfo.image;
+    copy.dstImageLayout = m_info.layout;
+    copy.regionCount = regionCount;
+    copy.pRegions = regions;
+
+    vr = m_vkd->vkCopyMemoryToImageEXT(m_vkd->device(), &copy);
+
+    if (vr != VK_SUCCESS)
+      throw DxvkError(str::format("DxvkImage: Host image copy failed: ", vr));
+
+    trackInitialization(subresources);
+  }
+
+
   void DxvkImage::setDebugName(const char* name) {
     if (likely(!m_info.debugName))
       return;
@@ -525,7 +525,9 @@ namespace dxvk {
     /**
      * \brief Creates image resource
      *
-     * The returned image can be used as backing storage.
+     * The returned image can be used as backing storage. If
+     * the image gets discarded frequently, the new storage
+     * will be hinted as transient.
      * \returns New underlying image resource
      */
     Rc<DxvkResourceAllocation> allocateStorage();
@@ -537,11 +539,13 @@ namespace dxvk {
      * enabled. Useful to expand on usage flags after creation.
      * \param [in] usage Usage flags to add
      * \param [in] mode Allocation constraints
+     * \param [in] lifetime Allocation lifetime hint
      * \returns New underlying image resource
      */
     Rc<DxvkResourceAllocation> allocateStorageWithUsage(
       const DxvkImageUsageInfo&         usage,
-            DxvkAllocationModes         mode);
+            DxvkAllocationModes         mode,
+            DxvkAllocationLifetime      lifetime = DxvkAllocationLifetime::Default);
 
     /**
      * \brief Assigns backing storage to the image
@@ -610,6 +614,22 @@ namespace dxvk {
     bool isInitialized(
       const VkImageSubresourceRange& subresources) const;
 
+    /**
+     * \brief Initializes image from host memory
+     *
+     * Uses host image copies to transition the image to its
+     * default layout and write the given data, without any GPU
+     * work. Must only be used on newly created images that have
+     * host transfer usage and are not accessed by any context yet.
+     * All subresources are considered initialized afterwards, and
+     * the image becomes eligible for relocation.
+     * \param [in] regionCount Number of regions to copy
+     * \param [in] regions Copy regions
+     */
+    void initFromMemory(
+            uint32_t                  regionCount,
+      const VkMemoryToImageCopyEXT*   regions);
+
     /**
      * \brief Sets debug name for the backing resource
      * \param [in] name New debug name
@@ -629,6 +649,8 @@ namespace dxvk {
     VkBool32                    m_shared      = VK_FALSE;
     VkBool32                    m_stableAddress = VK_FALSE;
 
+    std::atomic<bool>           m_hostInitPending = { false };
+
     DxvkResourceImageInfo       m_imageInfo   = { };
 
     Rc<DxvkResourceAllocation>  m_storage     = nullptr;
@@ -643,6 +665,8 @@ namespace dxvk {
 
     std::string                 m_debugName;
 
+    DxvkStorageLifetimeTracker  m_lifetime;
+
     void updateDebugName();
 
     std::string createDebugName(const char* name) const;
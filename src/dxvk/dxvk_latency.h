@@ -19,6 +19,7 @@ namespace dxvk {
   struct DxvkLatencyStats {
     std::chrono::microseconds frameLatency;
     std::chrono::microseconds sleepDuration;
+    std::chrono::microseconds targetLatency;
   };
 
 
@@ -48,6 +49,7 @@ namespace dxvk {
     time_point  gpuIdleEnd      = time_point();
     duration    gpuIdleTime     = duration(0u);
     duration    sleepDuration   = duration(0u);
+    duration    targetLatency   = duration(0u);
     VkResult    presentStatus   = VK_NOT_READY;
   };
 
@@ -214,10 +216,64 @@ namespace dxvk {
     virtual DxvkLatencyStats getStatistics(
             uint64_t                  frameId) = 0;
 
+    /**
+     * \brief Queries statistics of the last completed frame
+     *
+     * Returns the snapshot published when presentation of the
+     * most recent frame finished on the GPU. Does not take the
+     * tracker lock, so this is safe to call from threads that
+     * must not stall, such as the submission finish thread.
+     * \returns Statistics for the last completed frame
+     */
+    DxvkLatencyStats getPublishedStatistics() const {
+      DxvkLatencyStats stats;
+      uint32_t seq;
+
+      do {
+        seq = m_statsSeq.load(std::memory_order_acquire);
+
+        stats.frameLatency = std::chrono::microseconds(m_statsFrameLatency.load(std::memory_order_relaxed));
+        stats.sleepDuration = std::chrono::microseconds(m_statsSleepDuration.load(std::memory_order_relaxed));
+        stats.targetLatency = std::chrono::microseconds(m_statsTargetLatency.load(std::memory_order_relaxed));
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+      } while ((seq & 1u) || seq != m_statsSeq.load(std::memory_order_relaxed));
+
+      return stats;
+    }
+
+  protected:
+
+    /**
+     * \brief Publishes statistics for a completed frame
+     *
+     * Must be called with the tracker lock held, so that
+     * there is only ever one writer at any given time.
+     * \param [in] stats Statistics of the completed frame
+     */
+    void publishStatistics(
+      const DxvkLatencyStats&         stats) {
+      uint32_t seq = m_statsSeq.load(std::memory_order_relaxed);
+
+      m_statsSeq.store(seq + 1u, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      m_statsFrameLatency.store(stats.frameLatency.count(), std::memory_order_relaxed);
+      m_statsSleepDuration.store(stats.sleepDuration.count(), std::memory_order_relaxed);
+      m_statsTargetLatency.store(stats.targetLatency.count(), std::memory_order_relaxed);
+
+      m_statsSeq.store(seq + 2u, std::memory_order_release);
+    }
+
   private:
 
     std::atomic<uint64_t> m_refCount = { 0u };
 
+    std::atomic<uint32_t> m_statsSeq            = { 0u };
+    std::atomic<int64_t>  m_statsFrameLatency   = { 0 };
+    std::atomic<int64_t>  m_statsSleepDuration  = { 0 };
+    std::atomic<int64_t>  m_statsTargetLatency  = { 0 };
+
   };
 
 }
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 
 #include "dxvk_latency_builtin.h"
@@ -9,16 +10,47 @@
 
 namespace dxvk {
 
+  void DxvkLatencyStageModel::addSample(duration sample) {
+    m_samples[m_next] = std::max(sample, duration(0u));
+    m_next = (m_next + 1u) % SampleCount;
+    m_count = std::min(m_count + 1u, SampleCount);
+  }
+
+
+  DxvkLatencyStageModel::duration DxvkLatencyStageModel::estimate(uint32_t percentile) const {
+    if (!m_count)
+      return duration(0u);
+
+    std::array<duration, SampleCount> samples;
+    std::copy(m_samples.begin(), m_samples.begin() + m_count, samples.begin());
+
+    size_t index = std::min((m_count * percentile) / 100u, m_count - 1u);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.begin() + m_count);
+    return samples[index];
+  }
+
+
+  void DxvkLatencyStageModel::reset() {
+    m_count = 0u;
+    m_next = 0u;
+  }
+
+
   DxvkBuiltInLatencyTracker::DxvkBuiltInLatencyTracker(
           Rc<Presenter>             presenter,
           int32_t                   toleranceUs,
-          bool                      useNvLowLatency2)
+          bool                      useNvLowLatency2,
+          bool                      usePredictiveModel,
+          TimeSource*               timeSource)
   : m_presenter(std::move(presenter)),
+    m_timeSource(timeSource),
     m_tolerance(std::chrono::duration_cast<duration>(
       std::chrono::microseconds(std::max(toleranceUs, 0)))),
-    m_useNvLowLatency2(useNvLowLatency2) {
+    m_useNvLowLatency2(useNvLowLatency2),
+    m_usePredictiveModel(usePredictiveModel && !useNvLowLatency2) {
     Logger::info(str::format("Latency control enabled, using ",
-      useNvLowLatency2 ? "VK_NV_low_latency2" : "built-in algorithm"));
+      useNvLowLatency2 ? "VK_NV_low_latency2" :
+      m_usePredictiveModel ? "predictive algorithm" : "built-in algorithm"));
 
     auto limit = FpsLimiter::getEnvironmentOverride();
 
@@ -43,7 +75,7 @@ namespace dxvk {
     auto frame = findFrame(frameId);
 
     if (frame)
-      frame->cpuPresentBegin = dxvk::high_resolution_clock::now();
+      frame->cpuPresentBegin = m_timeSource->now();
   }
 
 
@@ -53,12 +85,20 @@ namespace dxvk {
     auto frame = findFrame(frameId);
 
     if (frame)
-      frame->cpuPresentEnd = dxvk::high_resolution_clock::now();
+      frame->cpuPresentEnd = m_timeSource->now();
   }
 
 
   void DxvkBuiltInLatencyTracker::notifyCsRenderBegin(
           uint64_t                  frameId) {
+    if (m_usePredictiveModel) {
+      std::unique_lock lock(m_mutex);
+      auto frame = findFrame(frameId);
+
+      if (frame)
+        frame->cpuRenderBegin = m_timeSource->now();
+    }
+
     if (forwardLatencyMarkerNv(frameId)) {
       m_presenter->setLatencyMarkerNv(frameId, VK_LATENCY_MARKER_SIMULATION_END_NV);
       m_presenter->setLatencyMarkerNv(frameId, VK_LATENCY_MARKER_RENDERSUBMIT_START_NV);
@@ -68,6 +108,14 @@ namespace dxvk {
 
   void DxvkBuiltInLatencyTracker::notifyCsRenderEnd(
           uint64_t                  frameId) {
+    if (m_usePredictiveModel) {
+      std::unique_lock lock(m_mutex);
+      auto frame = findFrame(frameId);
+
+      if (frame)
+        frame->cpuRenderEnd = m_timeSource->now();
+    }
+
     if (forwardLatencyMarkerNv(frameId))
       m_presenter->setLatencyMarkerNv(frameId, VK_LATENCY_MARKER_RENDERSUBMIT_END_NV);
   }
@@ -79,7 +127,7 @@ namespace dxvk {
     auto frame = findFrame(frameId);
 
     if (frame && frame->queueSubmit == time_point())
-      frame->queueSubmit = dxvk::high_resolution_clock::now();
+      frame->queueSubmit = m_timeSource->now();
   }
 
 
@@ -98,7 +146,7 @@ namespace dxvk {
 
       if (frame) {
         frame->presentStatus = status;
-        frame->queuePresent = dxvk::high_resolution_clock::now();
+        frame->queuePresent = m_timeSource->now();
       }
 
       m_cond.notify_one();
@@ -115,7 +163,7 @@ namespace dxvk {
     auto frame = findFrame(frameId);
 
     if (frame) {
-      auto now = dxvk::high_resolution_clock::now();
+      auto now = m_timeSource->now();
 
       if (frame->gpuExecStart == time_point())
         frame->gpuExecStart = now;
@@ -134,7 +182,7 @@ namespace dxvk {
     auto frame = findFrame(frameId);
 
     if (frame) {
-      auto now = dxvk::high_resolution_clock::now();
+      auto now = m_timeSource->now();
 
       frame->gpuExecEnd = now;
       frame->gpuIdleStart = now;
@@ -147,8 +195,10 @@ namespace dxvk {
     std::unique_lock lock(m_mutex);
     auto frame = findFrame(frameId);
 
-    if (frame)
-      frame->frameEnd = dxvk::high_resolution_clock::now();
+    if (frame) {
+      frame->frameEnd = m_timeSource->now();
+      publishStatistics(computeStatistics(*frame));
+    }
 
     m_cond.notify_one();
   }
@@ -157,15 +207,21 @@ namespace dxvk {
   void DxvkBuiltInLatencyTracker::sleepAndBeginFrame(
           uint64_t                  frameId,
           double                    maxFrameRate) {
-    auto duration = m_useNvLowLatency2
-      ? sleepNv(frameId, maxFrameRate)
-      : sleepBuiltin(frameId, maxFrameRate);
+    duration sleepDuration;
+
+    if (m_useNvLowLatency2)
+      sleepDuration = sleepNv(frameId, maxFrameRate);
+    else if (m_usePredictiveModel)
+      sleepDuration = sleepPredictive(frameId, maxFrameRate);
+    else
+      sleepDuration = sleepBuiltin(frameId, maxFrameRate);
 
     { std::unique_lock lock(m_mutex);
 
       auto next = initFrame(frameId);
-      next->frameStart = dxvk::high_resolution_clock::now();
-      next->sleepDuration = duration;
+      next->frameStart = m_timeSource->now();
+      next->sleepDuration = sleepDuration;
+      next->targetLatency = std::exchange(m_targetLatency, duration(0u));
     }
 
     if (m_useNvLowLatency2) {
@@ -178,6 +234,10 @@ namespace dxvk {
   void DxvkBuiltInLatencyTracker::discardTimings() {
     std::unique_lock lock(m_mutex);
     m_validRangeBegin = m_validRangeEnd + 1u;
+
+    m_cpuModel.reset();
+    m_csModel.reset();
+    m_gpuModel.reset();
   }
 
 
@@ -191,8 +251,7 @@ namespace dxvk {
       auto f = findFrame(frameId--);
 
       if (f && f->frameEnd != time_point()) {
-        stats.frameLatency = std::chrono::duration_cast<std::chrono::microseconds>(f->frameEnd - f->frameStart);
-        stats.sleepDuration = std::chrono::duration_cast<std::chrono::microseconds>(f->sleepDuration);
+        stats = computeStatistics(*f);
         break;
       }
     }
@@ -326,13 +385,108 @@ namespace dxvk {
     time_point gpuStartTime = gpuDeadline - nextGpuTime;
     time_point cpuStartTime = gpuStartTime - nextCpuTime - m_tolerance;
 
-    time_point now = dxvk::high_resolution_clock::now();
+    time_point now = m_timeSource->now();
 
     // Release lock before actually sleeping, or
     // it will affect the time measurements.
     lock.unlock();
 
-    Sleep::sleepUntil(now, cpuStartTime);
+    m_timeSource->sleepUntil(now, cpuStartTime);
+    return std::max(duration(0u), cpuStartTime - now);
+  }
+
+
+  DxvkBuiltInLatencyTracker::duration DxvkBuiltInLatencyTracker::sleepPredictive(
+          uint64_t                  frameId,
+          double                    maxFrameRate) {
+    std::unique_lock lock(m_mutex);
+
+    // Frame entry of the last frame that will fully complete before
+    // the next frame starts. Unlike the regular algorithm, we only
+    // need the previous two frames since timings are accumulated.
+    auto prev = findFrame(frameId - 2u);
+
+    if (!prev || prev->cpuPresentEnd == time_point())
+      return duration(0u);
+
+    m_cond.wait(lock, [prev] {
+      return prev->frameEnd != time_point();
+    });
+
+    // Wait for the current frame's present call to be processed,
+    // for the same reasons as in the regular algorithm.
+    auto curr = findFrame(frameId - 1u);
+
+    if (curr && curr->cpuPresentEnd != time_point()) {
+      m_cond.wait(lock, [curr] {
+        return curr->presentStatus != VK_NOT_READY;
+      });
+    }
+
+    // Feed the completed frame into the per-stage models. The CPU stage
+    // is the time until the first submission plus any GPU idle time, the
+    // CS stage ends when the final submission of the frame is recorded.
+    if (prev->queueSubmit != time_point()
+     && prev->cpuRenderEnd != time_point()
+     && prev->gpuExecEnd != time_point()) {
+      m_cpuModel.addSample((prev->queueSubmit - prev->frameStart) + prev->gpuIdleTime);
+      m_csModel.addSample(prev->cpuRenderEnd - prev->frameStart);
+      m_gpuModel.addSample((prev->gpuExecEnd - prev->gpuExecStart) - prev->gpuIdleTime);
+    }
+
+    if (m_gpuModel.sampleCount() < MinModelSamples)
+      return duration(0u);
+
+    duration cpuTime = m_cpuModel.estimate(ModelPercentile);
+    duration csTime = m_csModel.estimate(ModelPercentile);
+    duration gpuTime = m_gpuModel.estimate(ModelPercentile);
+
+    // The previous frame is still in flight on the GPU, so the
+    // next frame cannot complete before both have executed.
+    time_point gpuDeadline = prev->gpuExecEnd + 2u * gpuTime;
+
+    // If we're limited by the refresh rate or a frame rate limit,
+    // there is no point in completing the frame any earlier than
+    // the point where it can be presented.
+    duration frameInterval = computeFrameInterval(maxFrameRate);
+
+    if (frameInterval.count()) {
+      // Only every other frame would be anchored to the same completed
+      // frame, which lets odd and even frames drift out of phase. Average
+      // the projected deadlines of all completed frames instead.
+      duration nextPresentFromPrev = duration(0u);
+      uint32_t count = 0u;
+
+      for (uint32_t i = 2; i <= FrameCount; i++) {
+        auto f = findFrame(frameId - i);
+
+        if (!f || f->frameEnd == time_point())
+          break;
+
+        nextPresentFromPrev += (f->frameEnd + i * frameInterval) - prev->frameEnd;
+        count += 1u;
+      }
+
+      gpuDeadline = std::max(gpuDeadline, prev->frameEnd + nextPresentFromPrev / int32_t(count));
+    }
+
+    // GPU work can complete no earlier than the CPU time required to
+    // start GPU execution plus the GPU time, and no earlier than the
+    // final submission from the CS thread.
+    duration frameTime = std::max(cpuTime + gpuTime, csTime);
+
+    // Apply the safety margin exactly once, regardless of
+    // which of the constraints above determined the deadline.
+    time_point cpuStartTime = gpuDeadline - frameTime - m_tolerance;
+    time_point now = m_timeSource->now();
+
+    m_targetLatency = gpuDeadline - std::max(now, cpuStartTime);
+
+    // Release lock before actually sleeping, or
+    // it will affect the time measurements.
+    lock.unlock();
+
+    m_timeSource->sleepUntil(now, cpuStartTime);
     return std::max(duration(0u), cpuStartTime - now);
   }
 
@@ -372,6 +526,16 @@ namespace dxvk {
   }
 
 
+  DxvkLatencyStats DxvkBuiltInLatencyTracker::computeStatistics(
+    const DxvkLatencyFrameData&     frame) {
+    DxvkLatencyStats stats = { };
+    stats.frameLatency = std::chrono::duration_cast<std::chrono::microseconds>(frame.frameEnd - frame.frameStart);
+    stats.sleepDuration = std::chrono::duration_cast<std::chrono::microseconds>(frame.sleepDuration);
+    stats.targetLatency = std::chrono::duration_cast<std::chrono::microseconds>(frame.targetLatency);
+    return stats;
+  }
+
+
   DxvkBuiltInLatencyTracker::duration DxvkBuiltInLatencyTracker::computeFrameInterval(
           double                    maxFrameRate) {
     if (m_envFpsLimit > 0.0)
@@ -16,23 +16,81 @@
 
 namespace dxvk {
 
+  /**
+   * \brief Rolling percentile model for a frame stage
+   *
+   * Keeps a fixed number of recent timing samples of
+   * a single stage of the frame, and estimates a high
+   * percentile in order to predict the next frame.
+   */
+  class DxvkLatencyStageModel {
+    using duration = typename DxvkLatencyFrameData::duration;
+
+    constexpr static size_t SampleCount = 32u;
+  public:
+
+    /**
+     * \brief Adds a timing sample
+     * \param [in] sample Stage duration
+     */
+    void addSample(duration sample);
+
+    /**
+     * \brief Number of valid samples
+     * \returns Sample count
+     */
+    size_t sampleCount() const {
+      return m_count;
+    }
+
+    /**
+     * \brief Estimates duration of the stage
+     *
+     * \param [in] percentile Percentile to compute
+     * \returns Estimated stage duration
+     */
+    duration estimate(uint32_t percentile) const;
+
+    /**
+     * \brief Discards all samples
+     */
+    void reset();
+
+  private:
+
+    std::array<duration, SampleCount> m_samples = { };
+
+    size_t m_count = 0u;
+    size_t m_next = 0u;
+
+  };
+
+
   /**
    * \brief Built-in latency tracker
    *
    * Implements a simple latency reduction algorithm
    * based on CPU timestamps received from the backend.
+   * Optionally, a predictive variant can be used which
+   * models application, CS thread and GPU timings of
+   * each frame separately.
    */
   class DxvkBuiltInLatencyTracker : public DxvkLatencyTracker {
     using time_point = typename DxvkLatencyFrameData::time_point;
     using duration = typename DxvkLatencyFrameData::duration;
 
     constexpr static size_t FrameCount = 8u;
+
+    constexpr static size_t MinModelSamples = 8u;
+    constexpr static uint32_t ModelPercentile = 90u;
   public:
 
     DxvkBuiltInLatencyTracker(
             Rc<Presenter>             presenter,
             int32_t                   toleranceUs,
-            bool                      useNvLowLatency2);
+            bool                      useNvLowLatency2,
+            bool                      usePredictiveModel,
+            TimeSource*               timeSource);
 
     ~DxvkBuiltInLatencyTracker();
 
@@ -81,6 +139,7 @@ namespace dxvk {
   private:
 
     Rc<Presenter>             m_presenter;
+    TimeSource*               m_timeSource;
 
     dxvk::mutex               m_mutex;
     dxvk::condition_variable  m_cond;
@@ -89,6 +148,13 @@ namespace dxvk {
 
     double                    m_envFpsLimit = 0.0;
     bool                      m_useNvLowLatency2 = false;
+    bool                      m_usePredictiveModel = false;
+
+    DxvkLatencyStageModel     m_cpuModel;
+    DxvkLatencyStageModel     m_csModel;
+    DxvkLatencyStageModel     m_gpuModel;
+
+    duration                  m_targetLatency = duration(0u);
 
     std::array<DxvkLatencyFrameData, FrameCount> m_frames = { };
 
@@ -103,6 +169,10 @@ namespace dxvk {
             uint64_t                  frameId,
             double                    maxFrameRate);
 
+    duration sleepPredictive(
+            uint64_t                  frameId,
+            double                    maxFrameRate);
+
     DxvkLatencyFrameData* initFrame(
             uint64_t                  frameId);
 
@@ -112,6 +182,9 @@ namespace dxvk {
     bool forwardLatencyMarkerNv(
             uint64_t                  frameId);
 
+    static DxvkLatencyStats computeStatistics(
+      const DxvkLatencyFrameData&     frame);
+
     duration computeFrameInterval(
             double                    maxFrameRate);
 
@@ -200,6 +200,8 @@ namespace dxvk {
     frame.frameEnd = dxvk::high_resolution_clock::now();
 
     m_lastCompletedFrameId = frameId;
+
+    publishStatistics(computeStatistics(frame));
   }
 
 
@@ -229,8 +231,12 @@ namespace dxvk {
     if (!m_lastCompletedFrameId)
       return DxvkLatencyStats();
 
-    auto& frame = getFrameData(m_lastCompletedFrameId);
+    return computeStatistics(getFrameData(m_lastCompletedFrameId));
+  }
+
 
+  DxvkLatencyStats DxvkReflexLatencyTrackerNv::computeStatistics(
+    const DxvkReflexLatencyFrameData& frame) {
     if (frame.frameEnd == time_point())
       return DxvkLatencyStats();
 
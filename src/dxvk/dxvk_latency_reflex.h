@@ -189,6 +189,9 @@ namespace dxvk {
 
     void reset();
 
+    static DxvkLatencyStats computeStatistics(
+      const DxvkReflexLatencyFrameData& frame);
+
     static uint64_t mapFrameTimestampToReportUs(
       const DxvkReflexLatencyFrameData&     frame,
       const VkLatencyTimingsFrameReportNV&  report,
@@ -546,6 +546,7 @@ namespace dxvk {
 
       type.devicePool.maxChunkSize = determineMaxChunkSize(type, false);
       type.mappedPool.maxChunkSize = determineMaxChunkSize(type, true);
+      type.transientPool.maxChunkSize = determineMaxChunkSize(type, false);
 
       // Uncached system memory is going to be used for large temporary allocations
       // during resource creation. Account for that by always using full-sized chunks.
@@ -606,10 +607,13 @@ namespace dxvk {
 
       // Use correct memory pool depending on property flags. This way we avoid
       // wasting address space on fallback allocations, or on UMA devices that
-      // only expose one memory type.
+      // only expose one memory type. Keep short-lived device allocations out
+      // of the regular device pool so that they do not fragment its chunks.
       auto& selectedPool = (allocationInfo.properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
         ? type.mappedPool
-        : type.devicePool;
+        : (allocationInfo.lifetime == DxvkAllocationLifetime::Transient
+          ? type.transientPool
+          : type.devicePool);
 
       // Always try to suballocate first, even if the allocation is
       // very large. We will decide what to do if this fails.
@@ -633,23 +637,23 @@ namespace dxvk {
           return createAllocation(type, selectedPool, address, size, allocationInfo);
       }
 
-      // If the memory type is host-visible, try to find an existing chunk
-      // in the other memory pool of the memory type and move over.
-      if (type.properties.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
-        auto& oppositePool = (allocationInfo.properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
-          ? type.devicePool
-          : type.mappedPool;
+      // Try to find an existing empty chunk in one of the other memory
+      // pools of the memory type and move it over. The mapped pool can
+      // only contain chunks if the memory type is host-visible.
+      for (auto otherPool : { &type.devicePool, &type.transientPool, &type.mappedPool }) {
+        if (otherPool == &selectedPool)
+          continue;
 
-        int32_t freeChunkIndex = findEmptyChunkInPool(oppositePool,
+        int32_t freeChunkIndex = findEmptyChunkInPool(*otherPool,
           size, selectedPool.maxChunkSize);
 
         if (freeChunkIndex >= 0) {
-          uint32_t poolChunkIndex = selectedPool.pageAllocator.addChunk(oppositePool.chunks[freeChunkIndex].memory.size);
+          uint32_t poolChunkIndex = selectedPool.pageAllocator.addChunk(otherPool->chunks[freeChunkIndex].memory.size);
           selectedPool.chunks.resize(std::max<size_t>(selectedPool.chunks.size(), poolChunkIndex + 1u));
-          selectedPool.chunks[poolChunkIndex] = oppositePool.chunks[freeChunkIndex];
+          selectedPool.chunks[poolChunkIndex] = otherPool->chunks[freeChunkIndex];
 
-          oppositePool.pageAllocator.removeChunk(freeChunkIndex);
-          oppositePool.chunks[freeChunkIndex] = DxvkMemoryChunk();
+          otherPool->pageAllocator.removeChunk(freeChunkIndex);
+          otherPool->chunks[freeChunkIndex] = DxvkMemoryChunk();
 
           mapDeviceMemory(selectedPool.chunks[poolChunkIndex].memory, allocationInfo.properties);
 
@@ -1320,6 +1324,9 @@ namespace dxvk {
 
     auto allocation = m_allocationPool.create(this, &type);
 
+    if (&pool == &type.transientPool)
+      allocation->m_flags.set(DxvkAllocationFlag::Transient);
+
     if (!(allocationInfo.properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) && allocationInfo.resourceCookie)
       allocation->m_flags.set(DxvkAllocationFlag::CanMove);
 
@@ -1346,7 +1353,7 @@ namespace dxvk {
         ? chunk.memory.gpuVa + offset : 0u;
     }
 
-    if (&pool == &type.devicePool)
+    if (&pool != &type.mappedPool)
       chunk.addAllocation(allocation);
 
     return allocation;
@@ -1429,11 +1436,9 @@ namespace dxvk {
           // We free the actual allocation later, just update stats here.
           allocation->m_type->stats.memoryAllocated -= allocation->m_size;
         } else {
-          DxvkMemoryPool& pool = allocation->m_mapPtr
-            ? allocation->m_type->mappedPool
-            : allocation->m_type->devicePool;
+          DxvkMemoryPool& pool = getAllocationPool(allocation);
 
-          if (!allocation->m_mapPtr) {
+          if (&pool != &allocation->m_type->mappedPool) {
             uint32_t chunkIndex = allocation->m_address >> DxvkPageAllocator::ChunkAddressBits;
             pool.chunks[chunkIndex].removeAllocation(allocation);
           }
@@ -1474,9 +1479,7 @@ namespace dxvk {
   void DxvkMemoryAllocator::freeCachedAllocationsLocked(
           DxvkResourceAllocation* allocation) {
     while (allocation) {
-      auto& pool = allocation->m_mapPtr
-        ? allocation->m_type->mappedPool
-        : allocation->m_type->devicePool;
+      auto& pool = getAllocationPool(allocation);
 
       // Cached allocations may have a reference count of 0, but they
       // still own the memory, so make sure to release it here.
@@ -1503,6 +1506,7 @@ namespace dxvk {
 
       freed |= freeEmptyChunksInPool(type, type.devicePool, allocationSize, time);
       freed |= freeEmptyChunksInPool(type, type.mappedPool, allocationSize, time);
+      freed |= freeEmptyChunksInPool(type, type.transientPool, allocationSize, time);
     }
 
     if (freed)
@@ -1632,6 +1636,17 @@ namespace dxvk {
   }
 
 
+  DxvkMemoryPool& DxvkMemoryAllocator::getAllocationPool(
+    const DxvkResourceAllocation* allocation) const {
+    if (allocation->m_mapPtr)
+      return allocation->m_type->mappedPool;
+
+    return allocation->m_flags.test(DxvkAllocationFlag::Transient)
+      ? allocation->m_type->transientPool
+      : allocation->m_type->devicePool;
+  }
+
+
   bool DxvkMemoryAllocator::refillAllocationCache(
           DxvkLocalAllocationCache*   cache,
     const VkMemoryRequirements&       requirements,
@@ -1980,6 +1995,7 @@ namespace dxvk {
 
       getAllocationStatsForPool(typeInfo, typeInfo.devicePool, stats);
       getAllocationStatsForPool(typeInfo, typeInfo.mappedPool, stats);
+      getAllocationStatsForPool(typeInfo, typeInfo.transientPool, stats);
     }
   }
 
@@ -2074,7 +2090,7 @@ namespace dxvk {
 
       if (!allocation->m_flags.test(DxvkAllocationFlag::OwnsMemory) && !allocation->m_mapPtr) {
         uint32_t chunkIndex = allocation->m_address >> DxvkPageAllocator::ChunkAddressBits;
-        allocation->m_type->devicePool.chunks[chunkIndex].canMove = false;
+        getAllocationPool(allocation).chunks[chunkIndex].canMove = false;
       }
     }
   }
@@ -2196,9 +2212,8 @@ namespace dxvk {
 
 
   void DxvkMemoryAllocator::moveDefragChunk(
-          DxvkMemoryType&       type) {
-    auto& pool = type.devicePool;
-
+          DxvkMemoryType&       type,
+          DxvkMemoryPool&       pool) {
     // Ensure that we only process each chunk once
     uint32_t chunkIndex = std::exchange(pool.nextDefragChunk, ~0u);
 
@@ -2241,9 +2256,8 @@ namespace dxvk {
 
 
   void DxvkMemoryAllocator::pickDefragChunk(
-          DxvkMemoryType&       type) {
-    auto& pool = type.devicePool;
-
+          DxvkMemoryType&       type,
+          DxvkMemoryPool&       pool) {
     // Only engage defragmentation at all if we have a significant
     // amount of memory wasted, or if we're under memory pressure.
     auto heapStats = getMemoryStats(type.heap->index);
@@ -2307,14 +2321,17 @@ namespace dxvk {
 
     // Check if the remaining chunks in the pool have sufficient free space.
     // This is not a strong guarantee that relocation will succeed, but the
-    // chance is reasonably high.
+    // chance is reasonably high. Relocated resources always end up in the
+    // device pool, which allows evicting long-lived resources that got
+    // stuck in the transient pool.
+    auto& dstPool = type.devicePool;
     uint32_t freePages = 0u;
 
-    for (uint32_t i = 0; i < pool.chunks.size(); i++) {
-      uint32_t pagesUsed = pool.pageAllocator.pagesUsed(i);
-      uint32_t pageCount = pool.pageAllocator.pageCount(i);
+    for (uint32_t i = 0; i < dstPool.chunks.size(); i++) {
+      uint32_t pagesUsed = dstPool.pageAllocator.pagesUsed(i);
+      uint32_t pageCount = dstPool.pageAllocator.pageCount(i);
 
-      if (pagesUsed && pool.pageAllocator.chunkIsAvailable(i) && i != chunkIndex)
+      if (pagesUsed && dstPool.pageAllocator.chunkIsAvailable(i) && (&dstPool != &pool || i != chunkIndex))
         freePages += pageCount - pagesUsed;
     }
 
@@ -2362,6 +2379,8 @@ namespace dxvk {
 
 
   void DxvkMemoryAllocator::performTimedTasksLocked(high_resolution_clock::time_point currentTime) {
+    m_taskEpoch.fetch_add(1u, std::memory_order_relaxed);
+
     // Re-query current memory budgets
     updateMemoryHeapBudgets();
 
@@ -2385,11 +2404,14 @@ namespace dxvk {
     if (enableDefrag) {
       // Periodically defragment device-local memory types. We cannot
       // do anything about mapped allocations since we rely on pointer
-      // stability there.
+      // stability there. Resources that are no longer discarded may
+      // otherwise stay pinned in the transient pool indefinitely.
       for (uint32_t i = 0; i < m_memTypeCount; i++) {
         if (m_memTypes[i].properties.propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) {
-          moveDefragChunk(m_memTypes[i]);
-          pickDefragChunk(m_memTypes[i]);
+          for (auto pool : { &m_memTypes[i].devicePool, &m_memTypes[i].transientPool }) {
+            moveDefragChunk(m_memTypes[i], *pool);
+            pickDefragChunk(m_memTypes[i], *pool);
+          }
         }
       }
     }
@@ -166,6 +166,7 @@ namespace dxvk {
 
     DxvkMemoryPool    devicePool;
     DxvkMemoryPool    mappedPool;
+    DxvkMemoryPool    transientPool;
 
     DxvkSharedAllocationCache* sharedCache = nullptr;
   };
@@ -480,6 +481,9 @@ namespace dxvk {
     /// Memory must be cleared to zero when the allocation
     /// is freed. Only used to work around app bugs.
     ClearOnFree = 6,
+    /// Allocation is suballocated from the pool
+    /// reserved for short-lived allocations.
+    Transient   = 7,
   };
 
   using DxvkAllocationFlags = Flags<DxvkAllocationFlag>;
@@ -966,6 +970,66 @@ namespace dxvk {
   using DxvkAllocationModes = Flags<DxvkAllocationMode>;
 
 
+  /**
+   * \brief Allocation lifetime hint
+   *
+   * Non-mappable allocations that are expected to be freed
+   * soon are placed in a separate memory pool, so that they
+   * do not fragment chunks holding long-lived resources.
+   */
+  enum class DxvkAllocationLifetime : uint32_t {
+    /// Allocation lives as long as the resource
+    Default     = 0,
+    /// Allocation is likely to be replaced soon,
+    /// e.g. storage for a frequently discarded buffer.
+    Transient   = 1,
+  };
+
+
+  /**
+   * \brief Storage lifetime tracker
+   *
+   * Counts how often a resource replaces its backing storage
+   * within a short time window, measured in allocator task
+   * epochs. Resources that are discarded repeatedly will
+   * likely be discarded again soon, so their new storage is
+   * hinted as transient. Updates do not need to be atomic
+   * read-modify-write operations since losing one is harmless.
+   */
+  class DxvkStorageLifetimeTracker {
+    constexpr static uint32_t TransientReplaceCount = 4u;
+  public:
+
+    /**
+     * \brief Registers storage replacement
+     *
+     * \param [in] epoch Current allocator task epoch
+     * \returns Lifetime hint for the new storage
+     */
+    DxvkAllocationLifetime notifyReplace(uint32_t epoch) {
+      uint64_t state = m_state.load(std::memory_order_relaxed);
+
+      uint32_t lastEpoch = uint32_t(state);
+      uint32_t count = uint32_t(state >> 32u);
+
+      count = (epoch - lastEpoch <= 1u)
+        ? std::min(count + 1u, TransientReplaceCount)
+        : 1u;
+
+      m_state.store(uint64_t(epoch) | (uint64_t(count) << 32u), std::memory_order_relaxed);
+
+      return count >= TransientReplaceCount
+        ? DxvkAllocationLifetime::Transient
+        : DxvkAllocationLifetime::Default;
+    }
+
+  private:
+
+    std::atomic<uint64_t> m_state = { 0u };
+
+  };
+
+
   /**
    * \brief Allocation properties
    */
@@ -976,6 +1040,8 @@ namespace dxvk {
     VkMemoryPropertyFlags properties = 0u;
     /// Allocation mode flags
     DxvkAllocationModes mode = 0u;
+    /// Expected allocation lifetime
+    DxvkAllocationLifetime lifetime = DxvkAllocationLifetime::Default;
   };
 
 
@@ -1285,6 +1351,17 @@ namespace dxvk {
      */
     void performTimedTasks();
 
+    /**
+     * \brief Queries current task epoch
+     *
+     * Incremented every time periodic clean-up tasks run.
+     * Can be used as a coarse clock for heuristics.
+     * \returns Current task epoch
+     */
+    uint32_t getTaskEpoch() const {
+      return m_taskEpoch.load(std::memory_order_relaxed);
+    }
+
     /**
      * \brief Polls relocation list
      *
@@ -1323,6 +1400,7 @@ namespace dxvk {
 
     alignas(CACHE_LINE_SIZE)
     high_resolution_clock::time_point m_taskDeadline = { };
+    std::atomic<uint32_t>     m_taskEpoch = { 0u };
     std::array<DxvkMemoryStats, VK_MAX_MEMORY_HEAPS> m_adapterHeapStats = { };
 
     alignas(CACHE_LINE_SIZE)
@@ -1387,6 +1465,9 @@ namespace dxvk {
             DxvkDeviceMemory&     memory,
             VkMemoryPropertyFlags properties);
 
+    DxvkMemoryPool& getAllocationPool(
+      const DxvkResourceAllocation* allocation) const;
+
     DxvkResourceAllocation* createAllocation(
             DxvkMemoryType&       type,
             DxvkMemoryPool&       pool,
@@ -1444,10 +1525,12 @@ namespace dxvk {
             uint32_t              heapIndex);
 
     void moveDefragChunk(
-            DxvkMemoryType&       type);
+            DxvkMemoryType&       type,
+            DxvkMemoryPool&       pool);
 
     void pickDefragChunk(
-            DxvkMemoryType&       type);
+            DxvkMemoryType&       type,
+            DxvkMemoryPool&       pool);
 
     void performTimedTasksLocked(
             high_resolution_clock::time_point currentTime);
@@ -1,10 +1,110 @@
+#include "dxvk_device.h"
 #include "dxvk_meta_mipgen.h"
 
+#include <dxvk_mipgen_2darr.h>
+
 namespace dxvk {
 
+  DxvkMetaMipGenObjects::DxvkMetaMipGenObjects(const DxvkDevice* device)
+  : m_vkd(device->vkd()) {
+    m_dsetLayout = createDescriptorSetLayout();
+    m_pipeLayout = createPipelineLayout();
+    m_pipeline = createPipeline();
+  }
+
+
+  DxvkMetaMipGenObjects::~DxvkMetaMipGenObjects() {
+    m_vkd->vkDestroyPipeline(m_vkd->device(), m_pipeline, nullptr);
+    m_vkd->vkDestroyPipelineLayout(m_vkd->device(), m_pipeLayout, nullptr);
+    m_vkd->vkDestroyDescriptorSetLayout(m_vkd->device(), m_dsetLayout, nullptr);
+  }
+
+
+  DxvkMetaMipGenPipeline DxvkMetaMipGenObjects::getPipeline() const {
+    DxvkMetaMipGenPipeline result;
+    result.dsetLayout = m_dsetLayout;
+    result.pipeLayout = m_pipeLayout;
+    result.pipeline   = m_pipeline;
+    result.tileSize   = VkExtent3D { 64, 64, 1 };
+    return result;
+  }
+
+
+  VkDescriptorSetLayout DxvkMetaMipGenObjects::createDescriptorSetLayout() {
+    std::array<VkDescriptorSetLayoutBinding, 3> bindings = {{
+      { 0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,  1,           VK_SHADER_STAGE_COMPUTE_BIT },
+      { 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,  MaxMipCount, VK_SHADER_STAGE_COMPUTE_BIT },
+      { 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1,           VK_SHADER_STAGE_COMPUTE_BIT },
+    }};
+
+    VkDescriptorSetLayoutCreateInfo dsetInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    dsetInfo.bindingCount       = bindings.size();
+    dsetInfo.pBindings          = bindings.data();
+
+    VkDescriptorSetLayout result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateDescriptorSetLayout(m_vkd->device(),
+          &dsetInfo, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mip gen descriptor set layout");
+    return result;
+  }
+
+
+  VkPipelineLayout DxvkMetaMipGenObjects::createPipelineLayout() {
+    VkPushConstantRange pushInfo = { VK_SHADER_STAGE_COMPUTE_BIT, 0, uint32_t(sizeof(DxvkMetaMipGenArgs)) };
+
+    VkPipelineLayoutCreateInfo pipeInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    pipeInfo.setLayoutCount         = 1;
+    pipeInfo.pSetLayouts            = &m_dsetLayout;
+    pipeInfo.pushConstantRangeCount = 1;
+    pipeInfo.pPushConstantRanges    = &pushInfo;
+
+    VkPipelineLayout result = VK_NULL_HANDLE;
+    if (m_vkd->vkCreatePipelineLayout(m_vkd->device(),
+          &pipeInfo, nullptr, &result) != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mip gen pipeline layout");
+    return result;
+  }
+
+
+  VkPipeline DxvkMetaMipGenObjects::createPipeline() {
+    SpirvCodeBuffer spirvCode(dxvk_mipgen_2darr);
+
+    VkShaderModuleCreateInfo shaderInfo = { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+    shaderInfo.codeSize           = spirvCode.size();
+    shaderInfo.pCode              = spirvCode.data();
+
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    if (m_vkd->vkCreateShaderModule(m_vkd->device(),
+          &shaderInfo, nullptr, &shaderModule) != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mip gen shader module");
+
+    VkPipelineShaderStageCreateInfo stageInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+    stageInfo.stage               = VK_SHADER_STAGE_COMPUTE_BIT;
+    stageInfo.module              = shaderModule;
+    stageInfo.pName               = "main";
+
+    VkComputePipelineCreateInfo pipeInfo = { VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO };
+    pipeInfo.stage                = stageInfo;
+    pipeInfo.layout               = m_pipeLayout;
+    pipeInfo.basePipelineIndex    = -1;
+
+    VkPipeline result = VK_NULL_HANDLE;
+
+    const VkResult status = m_vkd->vkCreateComputePipelines(
+      m_vkd->device(), VK_NULL_HANDLE, 1, &pipeInfo, nullptr, &result);
+
+    m_vkd->vkDestroyShaderModule(m_vkd->device(), shaderModule, nullptr);
+
+    if (status != VK_SUCCESS)
+      throw DxvkError("Dxvk: Failed to create meta mip gen compute pipeline");
+    return result;
+  }
+
+
   DxvkMetaMipGenViews::DxvkMetaMipGenViews(
-    const Rc<DxvkImageView>&  view)
-  : m_view(view) {
+    const Rc<DxvkImageView>&  view,
+          VkImageUsageFlagBits dstUsage)
+  : m_view(view), m_dstUsage(dstUsage) {
     // Determine view type based on image type
     const std::array<std::pair<VkImageViewType, VkImageViewType>, 3> viewTypes = {{
       { VK_IMAGE_VIEW_TYPE_1D_ARRAY, VK_IMAGE_VIEW_TYPE_1D_ARRAY },
@@ -61,7 +161,7 @@ namespace dxvk {
     DxvkImageViewKey dstViewInfo;
     dstViewInfo.viewType = m_dstViewType;
     dstViewInfo.format = m_view->info().format;
-    dstViewInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+    dstViewInfo.usage = m_dstUsage;
     dstViewInfo.aspects = m_view->info().aspects;
     dstViewInfo.mipIndex = m_view->info().mipIndex + pass + 1;
     dstViewInfo.mipCount = 1u;
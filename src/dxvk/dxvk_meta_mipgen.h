@@ -9,10 +9,87 @@
 namespace dxvk {
   
   /**
-   * \brief Mip map generation render pass
+   * \brief Push constants for compute mip generation
+   */
+  struct DxvkMetaMipGenArgs {
+    VkExtent2D srcExtent;
+    uint32_t   mipCount;
+  };
+
+
+  /**
+   * \brief Compute mip generation pipeline
+   *
+   * Use this to bind the pipeline
+   * and allocate a descriptor set.
+   */
+  struct DxvkMetaMipGenPipeline {
+    VkDescriptorSetLayout dsetLayout;
+    VkPipelineLayout      pipeLayout;
+    VkPipeline            pipeline;
+    VkExtent3D            tileSize;
+  };
+
+
+  /**
+   * \brief Compute mip generation objects
+   *
+   * Provides a compute pipeline that generates up to twelve
+   * mip levels of a 2D array image in a single dispatch. Each
+   * workgroup processes a 64x64 tile of the top level, and the
+   * last workgroup to finish for each layer processes the lower
+   * levels. The descriptor set layout uses the following bindings:
+   *  - 0: Sampled image view of the top level
+   *  - 1: Array of storage image views, one per generated level
+   *  - 2: Storage buffer with one counter per layer
+   *
+   * Counters must be zero when the dispatch starts. The last workgroup
+   * of each layer resets its counter, so every dispatch leaves the
+   * buffer in its initial state and the buffer can be reused.
+   *
+   * Only supports images with power-of-two dimensions, since
+   * the shader computes each texel as a plain 2x2 average.
+   */
+  class DxvkMetaMipGenObjects {
+
+  public:
+
+    constexpr static uint32_t MaxMipCount = 12u;
+    constexpr static uint32_t MaxLayerCount = 2048u;
+
+    DxvkMetaMipGenObjects(const DxvkDevice* device);
+    ~DxvkMetaMipGenObjects();
+
+    /**
+     * \brief Retrieves pipeline objects
+     * \returns Compute pipeline and layouts
+     */
+    DxvkMetaMipGenPipeline getPipeline() const;
+
+  private:
+
+    Rc<vk::DeviceFn> m_vkd;
+
+    VkDescriptorSetLayout m_dsetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout      m_pipeLayout = VK_NULL_HANDLE;
+    VkPipeline            m_pipeline   = VK_NULL_HANDLE;
+
+    VkDescriptorSetLayout createDescriptorSetLayout();
+
+    VkPipelineLayout createPipelineLayout();
+
+    VkPipeline createPipeline();
+
+  };
+
+
+  /**
+   * \brief Mip map generation views
    * 
-   * Stores image views, framebuffer objects and
-   * a render pass object for mip map generation.
+   * Stores source and destination image views for
+   * mip map generation. The destination views are
+   * created with the given usage, which is either
+   * the color attachment or the storage usage.
    * This must be created per image view.
    */
   class DxvkMetaMipGenViews {
@@ -20,7 +97,8 @@ namespace dxvk {
   public:
     
     DxvkMetaMipGenViews(
-      const Rc<DxvkImageView>&  view);
+      const Rc<DxvkImageView>&  view,
+            VkImageUsageFlagBits dstUsage);
     
     ~DxvkMetaMipGenViews();
     
@@ -136,6 +214,8 @@ namespace dxvk {
     };
 
     Rc<DxvkImageView> m_view;
+
+    VkImageUsageFlagBits m_dstUsage;
     
     VkImageViewType m_srcViewType = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
     VkImageViewType m_dstViewType = VK_IMAGE_VIEW_TYPE_MAX_ENUM;
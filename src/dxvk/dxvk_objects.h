@@ -68,6 +68,10 @@ namespace dxvk {
       return m_metaCopy.get(m_device);
     }
 
+    DxvkMetaMipGenObjects& metaMipGen() {
+      return m_metaMipGen.get(m_device);
+    }
+
     DxvkMetaResolveObjects& metaResolve() {
       return m_metaResolve.get(m_device);
     }
@@ -88,6 +92,7 @@ namespace dxvk {
     Lazy<DxvkMetaBlitObjects>     m_metaBlit;
     Lazy<DxvkMetaClearObjects>    m_metaClear;
     Lazy<DxvkMetaCopyObjects>     m_metaCopy;
+    Lazy<DxvkMetaMipGenObjects>   m_metaMipGen;
     Lazy<DxvkMetaResolveObjects>  m_metaResolve;
 
   };
@@ -24,6 +24,15 @@ namespace dxvk {
     /// Enable graphics pipeline library
     Tristate enableGraphicsPipelineLibrary = Tristate::Auto;
 
+    /// Enable dynamic color blend state
+    Tristate enableDynamicBlendState = Tristate::Auto;
+
+    /// Enable shader objects
+    Tristate enableShaderObjects = Tristate::Auto;
+
+    /// Enable global sampler heap
+    Tristate enableSamplerHeap = Tristate::Auto;
+
     /// Enables pipeline lifetime tracking
     Tristate trackPipelineLifetime = Tristate::Auto;
 
@@ -43,6 +52,10 @@ namespace dxvk {
     /// Latency tolerance, in microseconds
     int32_t latencyTolerance = 0u;
 
+    /// Use per-stage timing models for
+    /// built-in latency sleep
+    bool latencyPredictive = false;
+
     /// Disable VK_NV_low_latency2. This extension
     /// appears to be all sorts of broken on 32-bit.
     Tristate disableNvLowLatency2 = Tristate::Auto;
@@ -58,6 +71,19 @@ namespace dxvk {
     /// Allows full-screen exclusive mode on Windows
     bool allowFse = false;
 
+    /// Maximum size, in kB, of buffers that may be
+    /// renamed on partial writes during rendering
+    int32_t maxBufferRenameSize = 64;
+
+    /// Record graphics commands into Vulkan
+    /// command buffers on the submission thread
+    bool deferCommandRecording = false;
+
+    /// Add storage usage to images with automatic mip
+    /// generation so that mips can be generated with
+    /// a single compute dispatch
+    bool enableComputeMipGen = false;
+
     /// Whether to enable tiler optimizations
     Tristate tilerMode = Tristate::Auto;
 
@@ -239,6 +239,16 @@ namespace dxvk {
   }
 
 
+  void DxvkBindingLayout::addSamplerHeapBinding(const DxvkSamplerHeapBinding& binding) {
+    for (const auto& e : m_samplerHeapBindings) {
+      if (e.eq(binding))
+        return;
+    }
+
+    m_samplerHeapBindings.push_back(binding);
+  }
+
+
   void DxvkBindingLayout::addPushConstantRange(VkPushConstantRange range) {
     uint32_t oldEnd = m_pushConst.offset + m_pushConst.size;
     uint32_t newEnd = range.offset + range.size;
@@ -258,6 +268,9 @@ namespace dxvk {
     for (uint32_t i = 0; i < layout.m_bindings.size(); i++)
       m_bindings[i].merge(layout.m_bindings[i]);
 
+    for (const auto& binding : layout.m_samplerHeapBindings)
+      addSamplerHeapBinding(binding);
+
     addPushConstantRange(layout.m_pushConst);
     m_pushConstStages |= layout.m_pushConstStages;
   }
@@ -272,6 +285,14 @@ namespace dxvk {
         return false;
     }
 
+    if (m_samplerHeapBindings.size() != other.m_samplerHeapBindings.size())
+      return false;
+
+    for (uint32_t i = 0; i < m_samplerHeapBindings.size(); i++) {
+      if (!m_samplerHeapBindings[i].eq(other.m_samplerHeapBindings[i]))
+        return false;
+    }
+
     if (m_pushConstStages != other.m_pushConstStages)
       return false;
 
@@ -291,6 +312,9 @@ namespace dxvk {
     for (uint32_t i = 0; i < m_bindings.size(); i++)
       hash.add(m_bindings[i].hash());
 
+    for (const auto& binding : m_samplerHeapBindings)
+      hash.add(binding.hash());
+
     hash.add(m_pushConstStages);
     hash.add(m_pushConst.stageFlags);
     hash.add(m_pushConst.offset);
@@ -306,7 +330,7 @@ namespace dxvk {
   : m_device(device), m_layout(layout) {
     auto vk = m_device->vkd();
 
-    std::array<VkDescriptorSetLayout, DxvkDescriptorSets::SetCount> setLayouts = { };
+    std::array<VkDescriptorSetLayout, DxvkDescriptorSets::SetCount + 1> setLayouts = { };
 
     // Use minimum number of sets for the given pipeline layout type
     uint32_t setCount = m_layout.getStages() == VK_SHADER_STAGE_COMPUTE_BIT
@@ -340,6 +364,38 @@ namespace dxvk {
           m_bindingCount += bindingCount;
           m_setMask |= 1u << i;
         }
+
+        for (uint32_t j = 0; j < bindingCount; j++) {
+          VkDescriptorType type = m_layout.getBinding(i, j).descriptorType;
+
+          if (type == VK_DESCRIPTOR_TYPE_SAMPLER
+           || type == VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER)
+            m_samplerSetMask |= 1u << i;
+        }
+      }
+    }
+
+    // Append the global sampler heap to all pipeline layouts if supported,
+    // so that the heap binding remains valid across pipeline changes. The
+    // shader binding for the heap is identical for all stages.
+    uint32_t layoutSetCount = setCount;
+    m_samplerHeapSet = setCount;
+
+    VkDescriptorSetLayout heapLayout = m_device->getSamplerHeap().getSetLayout();
+
+    if (heapLayout) {
+      setLayouts[layoutSetCount++] = heapLayout;
+
+      for (auto stageIndex : bit::BitMask(m_layout.getStages())) {
+        DxvkBindingKey key;
+        key.stage = VkShaderStageFlagBits(1u << stageIndex);
+        key.binding = DxvkSamplerHeapInfo::ShaderBinding;
+
+        DxvkBindingMapping mapping;
+        mapping.set = m_samplerHeapSet;
+        mapping.binding = 0;
+
+        m_mapping.insert({ key, mapping });
       }
     }
 
@@ -348,7 +404,7 @@ namespace dxvk {
     VkPushConstantRange pushConstIndependent = m_layout.getPushConstantRange(true);
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo = { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
-    pipelineLayoutInfo.setLayoutCount = setCount;
+    pipelineLayoutInfo.setLayoutCount = layoutSetCount;
     pipelineLayoutInfo.pSetLayouts = setLayouts.data();
 
     if (pushConstComplete.stageFlags && pushConstComplete.size) {
@@ -22,6 +22,19 @@ namespace dxvk {
 
     static constexpr uint32_t CsAll       = 0;
     static constexpr uint32_t CsSetCount  = 1;
+
+    static constexpr uint32_t GpSamplerHeap = SetCount;
+    static constexpr uint32_t CsSamplerHeap = CsSetCount;
+  };
+
+  /**
+   * \brief Global sampler heap properties
+   */
+  struct DxvkSamplerHeapInfo {
+    /// Resource binding that shaders use to declare the heap
+    static constexpr uint32_t ShaderBinding   = ~0u;
+    /// Number of sampler descriptors in the heap
+    static constexpr uint32_t DescriptorCount = 4096u;
   };
 
   /**
@@ -70,6 +83,34 @@ namespace dxvk {
 
   };
 
+  /**
+   * \brief Sampler heap binding
+   *
+   * Stores metadata for a sampler that a shader reads from
+   * the global sampler heap. Instead of writing a descriptor,
+   * the heap index of the sampler is written to push constant
+   * data as a 16-bit integer.
+   */
+  struct DxvkSamplerHeapBinding {
+    uint32_t              resourceBinding;  ///< API binding slot for the sampler
+    uint32_t              pushConstOffset;  ///< Byte offset of the heap index
+    VkShaderStageFlagBits stage;            ///< Shader stage
+
+    bool eq(const DxvkSamplerHeapBinding& other) const {
+      return resourceBinding == other.resourceBinding
+          && pushConstOffset == other.pushConstOffset
+          && stage           == other.stage;
+    }
+
+    size_t hash() const {
+      DxvkHashState hash;
+      hash.add(resourceBinding);
+      hash.add(pushConstOffset);
+      hash.add(uint32_t(stage));
+      return hash;
+    }
+  };
+
   /**
    * \brief Binding list
    *
@@ -288,6 +329,24 @@ namespace dxvk {
       return m_bindings[set];
     }
 
+    /**
+     * \brief Number of sampler heap bindings
+     * \returns Sampler heap binding count
+     */
+    uint32_t getSamplerHeapBindingCount() const {
+      return uint32_t(m_samplerHeapBindings.size());
+    }
+
+    /**
+     * \brief Retrieves sampler heap binding
+     *
+     * \param [in] idx Binding index
+     * \returns Sampler heap binding
+     */
+    const DxvkSamplerHeapBinding& getSamplerHeapBinding(uint32_t idx) const {
+      return m_samplerHeapBindings[idx];
+    }
+
     /**
      * \brief Retrieves push constant range
      * \returns Push constant range
@@ -329,6 +388,12 @@ namespace dxvk {
      */
     void addBinding(const DxvkBindingInfo& binding);
 
+    /**
+     * \brief Adds a sampler heap binding to the layout
+     * \param [in] binding Sampler heap binding
+     */
+    void addSamplerHeapBinding(const DxvkSamplerHeapBinding& binding);
+
     /**
      * \brief Adds push constant range
      * \param [in] range Push constant range
@@ -369,6 +434,7 @@ namespace dxvk {
   private:
 
     std::array<DxvkBindingList, DxvkDescriptorSets::SetCount> m_bindings;
+    std::vector<DxvkSamplerHeapBinding>                       m_samplerHeapBindings;
     VkPushConstantRange                                       m_pushConst;
     VkShaderStageFlags                                        m_pushConstStages;
     VkShaderStageFlags                                        m_stages;
@@ -456,6 +522,29 @@ namespace dxvk {
       return m_setMask;
     }
 
+    /**
+     * \brief Queries descriptor sets containing samplers
+     *
+     * Only these sets need to be updated when a sampler
+     * changes. Samplers read from the global sampler
+     * heap are not included.
+     * \returns Bit mask of sets with sampler descriptors
+     */
+    uint32_t getSamplerSetMask() const {
+      return m_samplerSetMask;
+    }
+
+    /**
+     * \brief Queries sampler heap set index
+     *
+     * Only meaningful if the layout has sampler heap
+     * bindings, which requires device support.
+     * \returns Descriptor set index of the sampler heap
+     */
+    uint32_t getSamplerHeapSet() const {
+      return m_samplerHeapSet;
+    }
+
     /**
      * \brief Retrieves descriptor set layout for a given set
      *
@@ -524,6 +613,8 @@ namespace dxvk {
 
     uint32_t            m_bindingCount      = 0;
     uint32_t            m_setMask           = 0;
+    uint32_t            m_samplerSetMask    = 0;
+    uint32_t            m_samplerHeapSet    = 0;
 
     std::array<const DxvkBindingSetLayout*, DxvkDescriptorSets::SetCount> m_bindingObjects = { };
 
@@ -547,39 +638,65 @@ namespace dxvk {
       m_dirtyViews    |= stages;
     }
 
+    void dirtySamplers(VkShaderStageFlags stages) {
+      m_dirtySamplers |= stages;
+    }
+
+    void dirtySamplerHeap(VkShaderStageFlags stages) {
+      m_dirtyHeap     |= stages;
+    }
+
     void dirtyStages(VkShaderStageFlags stages) {
       m_dirtyBuffers  |= stages;
       m_dirtyViews    |= stages;
+      m_dirtySamplers |= stages;
+      m_dirtyHeap     |= stages;
     }
 
     void clearStages(VkShaderStageFlags stages) {
       m_dirtyBuffers  &= ~stages;
       m_dirtyViews    &= ~stages;
+      m_dirtySamplers &= ~stages;
+      m_dirtyHeap     &= ~stages;
     }
 
     bool hasDirtyGraphicsSets() const {
-      return (m_dirtyBuffers | m_dirtyViews) & (VK_SHADER_STAGE_ALL_GRAPHICS);
+      return (m_dirtyBuffers | m_dirtyViews | m_dirtySamplers | m_dirtyHeap) & (VK_SHADER_STAGE_ALL_GRAPHICS);
     }
 
     bool hasDirtyComputeSets() const {
-      return (m_dirtyBuffers | m_dirtyViews) & (VK_SHADER_STAGE_COMPUTE_BIT);
+      return (m_dirtyBuffers | m_dirtyViews | m_dirtySamplers | m_dirtyHeap) & (VK_SHADER_STAGE_COMPUTE_BIT);
+    }
+
+    bool hasDirtySamplers(VkShaderStageFlags stages) const {
+      return (m_dirtySamplers | m_dirtyHeap) & stages;
+    }
+
+    bool hasDirtySamplerHeap(VkShaderStageFlags stages) const {
+      return m_dirtyHeap & stages;
     }
 
-    uint32_t getDirtyGraphicsSets() const {
+    uint32_t getDirtyGraphicsSets(uint32_t samplerSets) const {
       uint32_t result = 0;
       if (m_dirtyBuffers & VK_SHADER_STAGE_FRAGMENT_BIT)
         result |= (1u << DxvkDescriptorSets::FsBuffers);
       if (m_dirtyViews & VK_SHADER_STAGE_FRAGMENT_BIT)
         result |= (1u << DxvkDescriptorSets::FsViews);
+      if (m_dirtySamplers & VK_SHADER_STAGE_FRAGMENT_BIT)
+        result |= (1u << DxvkDescriptorSets::FsViews) & samplerSets;
       if ((m_dirtyBuffers | m_dirtyViews) & (VK_SHADER_STAGE_ALL_GRAPHICS & ~VK_SHADER_STAGE_FRAGMENT_BIT))
         result |= (1u << DxvkDescriptorSets::VsAll);
+      if (m_dirtySamplers & (VK_SHADER_STAGE_ALL_GRAPHICS & ~VK_SHADER_STAGE_FRAGMENT_BIT))
+        result |= (1u << DxvkDescriptorSets::VsAll) & samplerSets;
       return result;
     }
 
-    uint32_t getDirtyComputeSets() const {
+    uint32_t getDirtyComputeSets(uint32_t samplerSets) const {
       uint32_t result = 0;
       if ((m_dirtyBuffers | m_dirtyViews) & VK_SHADER_STAGE_COMPUTE_BIT)
         result |= (1u << DxvkDescriptorSets::CsAll);
+      if (m_dirtySamplers & VK_SHADER_STAGE_COMPUTE_BIT)
+        result |= (1u << DxvkDescriptorSets::CsAll) & samplerSets;
       return result;
     }
 
@@ -587,7 +704,9 @@ namespace dxvk {
 
     VkShaderStageFlags m_dirtyBuffers   = 0;
     VkShaderStageFlags m_dirtyViews     = 0;
+    VkShaderStageFlags m_dirtySamplers  = 0;
+    VkShaderStageFlags m_dirtyHeap      = 0;
 
   };
   
-}
\ No newline at end of file
+}
@@ -31,6 +31,20 @@ namespace dxvk {
   }
 
 
+  void DxvkPipelineWorkers::compileShaderObject(
+    const Rc<DxvkShader>&                 shader,
+    const DxvkBindingLayoutObjects*       layout,
+          DxvkPipelinePriority            priority) {
+    std::unique_lock lock(m_lock);
+    this->startWorkers();
+
+    m_tasksTotal += 1;
+
+    m_buckets[uint32_t(priority)].queue.emplace(shader, layout);
+    notifyWorkers(priority);
+  }
+
+
   void DxvkPipelineWorkers::compileGraphicsPipeline(
           DxvkGraphicsPipeline*           pipeline,
     const DxvkGraphicsPipelineStateInfo&  state,
@@ -105,7 +119,7 @@ namespace dxvk {
       for (size_t i = 0; i < workerCount; i++) {
         DxvkPipelinePriority priority = DxvkPipelinePriority::Normal;
 
-        if (m_device->canUseGraphicsPipelineLibrary()) {
+        if (m_device->canUseGraphicsPipelineLibrary() || m_device->canUseShaderObjects()) {
           if (i >= npWorkerCount)
             priority = DxvkPipelinePriority::High;
           else if (i < lpWorkerCount)
@@ -164,6 +178,8 @@ namespace dxvk {
       } else if (entry.graphicsPipeline) {
         entry.graphicsPipeline->compilePipeline(entry.graphicsState);
         entry.graphicsPipeline->releasePipeline();
+      } else if (entry.shader != nullptr) {
+        entry.shader->createShaderObject(m_device, entry.shaderLayout);
       }
 
       m_tasksCompleted += 1;
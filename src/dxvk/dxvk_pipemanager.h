@@ -89,6 +89,21 @@ namespace dxvk {
             DxvkShaderPipelineLibrary*      library,
             DxvkPipelinePriority            priority);
 
+    /**
+     * \brief Creates an unlinked shader object
+     *
+     * Asynchronously creates the shader object for a single
+     * vertex or fragment shader. The shader object must have
+     * been requested for the given layout before.
+     * \param [in] shader The shader
+     * \param [in] layout Complete graphics pipeline layout
+     * \param [in] priority Pipeline priority
+     */
+    void compileShaderObject(
+      const Rc<DxvkShader>&                 shader,
+      const DxvkBindingLayoutObjects*       layout,
+            DxvkPipelinePriority            priority);
+
     /**
      * \brief Compiles an optimized graphics pipeline
      *
@@ -112,17 +127,22 @@ namespace dxvk {
 
     struct PipelineEntry {
       PipelineEntry()
-      : pipelineLibrary(nullptr), graphicsPipeline(nullptr) { }
+      : pipelineLibrary(nullptr), graphicsPipeline(nullptr), shaderLayout(nullptr) { }
 
       PipelineEntry(DxvkShaderPipelineLibrary* l)
-      : pipelineLibrary(l), graphicsPipeline(nullptr) { }
+      : pipelineLibrary(l), graphicsPipeline(nullptr), shaderLayout(nullptr) { }
 
       PipelineEntry(DxvkGraphicsPipeline* p, const DxvkGraphicsPipelineStateInfo& s)
-      : pipelineLibrary(nullptr), graphicsPipeline(p), graphicsState(s) { }
+      : pipelineLibrary(nullptr), graphicsPipeline(p), graphicsState(s), shaderLayout(nullptr) { }
+
+      PipelineEntry(const Rc<DxvkShader>& s, const DxvkBindingLayoutObjects* l)
+      : pipelineLibrary(nullptr), graphicsPipeline(nullptr), shader(s), shaderLayout(l) { }
 
-      DxvkShaderPipelineLibrary*    pipelineLibrary;
-      DxvkGraphicsPipeline*         graphicsPipeline;
-      DxvkGraphicsPipelineStateInfo graphicsState;
+      DxvkShaderPipelineLibrary*      pipelineLibrary;
+      DxvkGraphicsPipeline*           graphicsPipeline;
+      DxvkGraphicsPipelineStateInfo   graphicsState;
+      Rc<DxvkShader>                  shader;
+      const DxvkBindingLayoutObjects* shaderLayout;
     };
 
     struct PipelineBucket {
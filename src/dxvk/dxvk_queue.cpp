@@ -163,6 +163,7 @@ namespace dxvk {
           entry.result = entry.submit.cmdList->submit(
             m_semaphores, m_timelines, trackedSubmitId);
           entry.timelines = m_timelines;
+          entry.submitTime = high_resolution_clock::now();
         } else if (entry.present.presenter != nullptr) {
           if (entry.latency.tracker)
             entry.latency.tracker->notifyQueuePresentBegin(entry.latency.frameId);
@@ -197,7 +198,13 @@ namespace dxvk {
         (entry.present.presenter != nullptr && entry.result != VK_ERROR_DEVICE_LOST);
 
       if (doForward) {
+        bool isCmdList = entry.submit.cmdList != nullptr;
         m_finishQueue.push(std::move(entry));
+
+        if (isCmdList) {
+          m_gpuIdlePredictor.notifySubmit(high_resolution_clock::now());
+          updateGpuIdlePrediction();
+        }
       } else {
         Logger::err(str::format("DxvkSubmissionQueue: Command submission failed: ", entry.result));
         m_lastError = entry.result;
@@ -241,6 +248,8 @@ namespace dxvk {
       DxvkSubmitEntry entry = std::move(m_finishQueue.front());
       lock.unlock();
       
+      high_resolution_clock::time_point completionTime = { };
+
       if (entry.submit.cmdList != nullptr) {
         VkResult status = m_lastError.load();
 
@@ -262,6 +271,8 @@ namespace dxvk {
             entry.latency.tracker->notifyGpuExecutionEnd(entry.latency.frameId);
         }
 
+        completionTime = high_resolution_clock::now();
+
         if (status != VK_SUCCESS) {
           m_lastError = status;
 
@@ -274,6 +285,9 @@ namespace dxvk {
         // destroy the presenter object. 
         entry.present.presenter->signalFrame(entry.present.frameId, entry.latency.tracker);
         entry.present.presenter = nullptr;
+
+        if (entry.latency.tracker)
+          m_device->notifyLatencyStats(entry.latency.tracker);
       }
 
       // Release resources and signal events, then immediately wake
@@ -284,6 +298,14 @@ namespace dxvk {
 
       lock.lock();
       m_finishQueue.pop();
+
+      // Present entries do not occupy the GPU, so
+      // only count command lists for the prediction
+      if (entry.submit.cmdList != nullptr) {
+        m_gpuIdlePredictor.notifyCompletion(entry.submitTime, completionTime);
+        updateGpuIdlePrediction();
+      }
+
       m_finishCond.notify_all();
       lock.unlock();
 
@@ -294,5 +316,14 @@ namespace dxvk {
       }
     }
   }
+
+
+  void DxvkSubmissionQueue::updateGpuIdlePrediction() {
+    // Must be called with the lock held, since both the submit
+    // and finish threads update the predictor. Publish the result
+    // so that it can be queried without taking the lock.
+    auto prediction = m_gpuIdlePredictor.predictIdleTime();
+    m_gpuIdlePrediction.store(prediction.time_since_epoch().count(), std::memory_order_relaxed);
+  }
   
 }
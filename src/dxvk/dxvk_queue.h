@@ -5,6 +5,7 @@
 #include <queue>
 
 #include "../util/thread.h"
+#include "../util/util_gpu_idle.h"
 
 #include "dxvk_cmdlist.h"
 #include "dxvk_latency.h"
@@ -70,6 +71,7 @@ namespace dxvk {
     DxvkPresentInfo     present;
     DxvkLatencyInfo     latency;
     DxvkTimelineSemaphoreValues timelines;
+    high_resolution_clock::time_point submitTime;
   };
 
 
@@ -98,6 +100,21 @@ namespace dxvk {
       return m_gpuIdle.load();
     }
 
+    /**
+     * \brief Predicts when the GPU will go idle
+     *
+     * Based on the average GPU execution time of recent
+     * command lists and the number of command lists that
+     * are currently executing. May be in the past if the
+     * GPU is already idle.
+     * \returns Predicted point in time when the GPU
+     *    finishes executing all submitted work
+     */
+    high_resolution_clock::time_point predictGpuIdleTime() const {
+      return high_resolution_clock::time_point(
+        high_resolution_clock::duration(m_gpuIdlePrediction.load(std::memory_order_relaxed)));
+    }
+
     /**
      * \brief Retrieves last submission error
      * 
@@ -205,6 +222,9 @@ namespace dxvk {
     std::atomic<bool>           m_stopped = { false };
     std::atomic<uint64_t>       m_gpuIdle = { 0ull };
 
+    GpuIdlePredictor<high_resolution_clock> m_gpuIdlePredictor;
+    std::atomic<high_resolution_clock::rep> m_gpuIdlePrediction = { 0 };
+
     dxvk::mutex                 m_mutex;
     dxvk::mutex                 m_mutexQueue;
     
@@ -221,6 +241,8 @@ namespace dxvk {
     void submitCmdLists();
 
     void finishCmdLists();
+
+    void updateGpuIdlePrediction();
     
   };
   
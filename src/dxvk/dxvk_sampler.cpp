@@ -2,7 +2,12 @@
 #include "dxvk_device.h"
 
 namespace dxvk {
-    
+
+  // Index 0 of the heap is reserved for the default sampler
+  constexpr static uint32_t MaxHeapSamplerCount = DxvkSamplerHeapInfo::DescriptorCount - 1u;
+
+  static_assert(DxvkSamplerPool::MaxSamplerCount < MaxHeapSamplerCount);
+
   DxvkSampler::DxvkSampler(
           DxvkSamplerPool*        pool,
     const DxvkSamplerKey&         key)
@@ -51,12 +56,16 @@ namespace dxvk {
     if (vk->vkCreateSampler(vk->device(),
         &samplerInfo, nullptr, &m_sampler) != VK_SUCCESS)
       throw DxvkError("DxvkSampler::DxvkSampler: Failed to create sampler");
+
+    m_heapIndex = m_pool->m_heap.allocIndex(m_sampler);
   }
 
 
   DxvkSampler::~DxvkSampler() {
     auto vk = m_pool->m_device->vkd();
 
+    m_pool->m_heap.freeIndex(m_heapIndex);
+
     vk->vkDestroySampler(vk->device(), m_sampler, nullptr);
   }
 
@@ -116,13 +125,161 @@ namespace dxvk {
 
 
 
-  DxvkSamplerPool::DxvkSamplerPool(DxvkDevice* device)
+  DxvkSamplerHeap::DxvkSamplerHeap(DxvkDevice* device)
   : m_device(device) {
+    if (m_device->canUseSamplerHeap())
+      createObjects();
+  }
+
+
+  DxvkSamplerHeap::~DxvkSamplerHeap() {
+    auto vk = m_device->vkd();
+
+    vk->vkDestroyDescriptorPool(vk->device(), m_pool, nullptr);
+    vk->vkDestroyDescriptorSetLayout(vk->device(), m_setLayout, nullptr);
+    vk->vkDestroySampler(vk->device(), m_sampler, nullptr);
+  }
+
+
+  uint16_t DxvkSamplerHeap::allocIndex(VkSampler sampler) {
+    if (!m_set)
+      return 0u;
+
+    uint16_t index = 0u;
+
+    if (!m_freeIndices.empty()) {
+      index = m_freeIndices.back();
+      m_freeIndices.pop_back();
+    } else if (m_nextIndex < DxvkSamplerHeapInfo::DescriptorCount) {
+      index = uint16_t(m_nextIndex++);
+    } else {
+      // The sampler pool never holds more samplers than the heap has
+      // descriptors for, so this cannot happen. Do not hand out index
+      // 0 here since shaders would silently use the wrong sampler.
+      throw DxvkError("DxvkSamplerHeap: Sampler heap exhausted");
+    }
+
+    writeDescriptor(index, sampler);
+    return index;
+  }
+
+
+  void DxvkSamplerHeap::freeIndex(uint16_t index) {
+    // Index 0 is the default sampler and never freed. Since the
+    // set is created with UPDATE_UNUSED_WHILE_PENDING, we can
+    // overwrite the descriptor once the sampler is not in use.
+    if (index)
+      m_freeIndices.push_back(index);
+  }
+
+
+  void DxvkSamplerHeap::writeDescriptor(uint16_t index, VkSampler sampler) {
+    auto vk = m_device->vkd();
+
+    VkDescriptorImageInfo imageInfo = { };
+    imageInfo.sampler = sampler;
+
+    VkWriteDescriptorSet write = { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+    write.dstSet = m_set;
+    write.dstBinding = 0;
+    write.dstArrayElement = index;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    write.pImageInfo = &imageInfo;
+
+    vk->vkUpdateDescriptorSets(vk->device(), 1, &write, 0, nullptr);
+  }
+
+
+  void DxvkSamplerHeap::createObjects() {
+    auto vk = m_device->vkd();
+
+    // Default sampler used for unbound samplers, matches the
+    // properties of the dummy sampler used for descriptors
+    VkSamplerCreateInfo samplerInfo = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
+    samplerInfo.magFilter = VK_FILTER_LINEAR;
+    samplerInfo.minFilter = VK_FILTER_LINEAR;
+    samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerInfo.minLod = -256.0f;
+    samplerInfo.maxLod = 256.0f;
+    samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_TRANSPARENT_BLACK;
+
+    if (vk->vkCreateSampler(vk->device(), &samplerInfo, nullptr, &m_sampler) != VK_SUCCESS)
+      throw DxvkError("DxvkSamplerHeap: Failed to create default sampler");
+
+    // Samplers get created and destroyed while the heap is in use,
+    // so we need update-after-bind semantics for the entire set.
+    VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+      | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT
+      | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO };
+    bindingFlagsInfo.bindingCount = 1;
+    bindingFlagsInfo.pBindingFlags = &bindingFlags;
+
+    VkDescriptorSetLayoutBinding bindingInfo = { };
+    bindingInfo.binding = 0;
+    bindingInfo.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+    bindingInfo.descriptorCount = DxvkSamplerHeapInfo::DescriptorCount;
+    bindingInfo.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO, &bindingFlagsInfo };
+    layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &bindingInfo;
+
+    if (vk->vkCreateDescriptorSetLayout(vk->device(), &layoutInfo, nullptr, &m_setLayout) != VK_SUCCESS)
+      throw DxvkError("DxvkSamplerHeap: Failed to create descriptor set layout");
+
+    VkDescriptorPoolSize poolSize = { };
+    poolSize.type = VK_DESCRIPTOR_TYPE_SAMPLER;
+    poolSize.descriptorCount = DxvkSamplerHeapInfo::DescriptorCount;
+
+    VkDescriptorPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+    poolInfo.maxSets = 1;
+    poolInfo.poolSizeCount = 1;
+    poolInfo.pPoolSizes = &poolSize;
 
+    if (vk->vkCreateDescriptorPool(vk->device(), &poolInfo, nullptr, &m_pool) != VK_SUCCESS)
+      throw DxvkError("DxvkSamplerHeap: Failed to create descriptor pool");
+
+    VkDescriptorSetAllocateInfo allocInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocInfo.descriptorPool = m_pool;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_setLayout;
+
+    if (vk->vkAllocateDescriptorSets(vk->device(), &allocInfo, &m_set) != VK_SUCCESS)
+      throw DxvkError("DxvkSamplerHeap: Failed to allocate descriptor set");
+
+    writeDescriptor(0, m_sampler);
+  }
+
+
+
+
+  DxvkSamplerPool::DxvkSamplerPool(DxvkDevice* device)
+  : m_device(device), m_heap(device) {
+    if (m_heap.getSet()) {
+      DxvkSamplerKey key;
+      key.setFilter(VK_FILTER_LINEAR, VK_FILTER_LINEAR, VK_SAMPLER_MIPMAP_MODE_LINEAR);
+      key.setLodRange(-256.0f, 256.0f, 0.0f);
+      key.setAddressModes(
+        VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE,
+        VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+      key.setReduction(VK_SAMPLER_REDUCTION_MODE_WEIGHTED_AVERAGE);
+
+      m_fallbackSampler = createSampler(key);
+    }
   }
 
 
   DxvkSamplerPool::~DxvkSamplerPool() {
+    m_fallbackSampler = nullptr;
     m_samplers.clear();
   }
 
@@ -164,6 +321,15 @@ namespace dxvk {
     if (m_samplers.size() >= MaxSamplerCount)
       destroyLeastRecentlyUsedSampler();
 
+    // With the global sampler heap, every sampler owns a descriptor, so
+    // we cannot go past the heap size. Hand out a shared sampler instead.
+    if (m_fallbackSampler != nullptr && m_samplers.size() >= MaxHeapSamplerCount) {
+      if (!std::exchange(m_heapExhausted, true))
+        Logger::err("DxvkSamplerPool: Sampler heap exhausted, using fallback sampler");
+
+      return m_fallbackSampler;
+    }
+
     // Create new sampler object
     DxvkSampler* sampler = &m_samplers.emplace(std::piecewise_construct,
       std::forward_as_tuple(key),
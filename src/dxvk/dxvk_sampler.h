@@ -1,6 +1,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include "../util/util_bit.h"
 #include "../util/thread.h"
@@ -195,6 +196,17 @@ namespace dxvk {
       return m_key;
     }
 
+    /**
+     * \brief Sampler heap index
+     *
+     * Stable for the lifetime of the sampler. Always
+     * zero if the global sampler heap is not used.
+     * \returns Index of the sampler within the heap
+     */
+    uint16_t heapIndex() const {
+      return m_heapIndex;
+    }
+
   private:
     
     std::atomic<uint64_t> m_refCount  = { 0u };
@@ -204,6 +216,7 @@ namespace dxvk {
     DxvkSamplerKey        m_key       = { };
 
     VkSampler             m_sampler   = VK_NULL_HANDLE;
+    uint16_t              m_heapIndex = 0u;
 
     DxvkSampler*          m_lruPrev   = nullptr;
     DxvkSampler*          m_lruNext   = nullptr;
@@ -226,6 +239,82 @@ namespace dxvk {
   };
 
 
+  /**
+   * \brief Global sampler heap
+   *
+   * Manages a descriptor set containing one sampler descriptor for
+   * each live sampler object, so that shaders can index samplers
+   * dynamically rather than requiring descriptor updates whenever
+   * a sampler changes. Index 0 always contains a default sampler
+   * that can be used for unbound samplers. Not thread-safe, all
+   * methods must be called with the sampler pool locked.
+   */
+  class DxvkSamplerHeap {
+
+  public:
+
+    DxvkSamplerHeap(DxvkDevice* device);
+
+    ~DxvkSamplerHeap();
+
+    DxvkSamplerHeap             (const DxvkSamplerHeap&) = delete;
+    DxvkSamplerHeap& operator = (const DxvkSamplerHeap&) = delete;
+
+    /**
+     * \brief Descriptor set layout
+     * \returns Set layout, or \c VK_NULL_HANDLE
+     *    if the sampler heap is not supported.
+     */
+    VkDescriptorSetLayout getSetLayout() const {
+      return m_setLayout;
+    }
+
+    /**
+     * \brief Descriptor set
+     * \returns Descriptor set containing all samplers
+     */
+    VkDescriptorSet getSet() const {
+      return m_set;
+    }
+
+    /**
+     * \brief Allocates heap index for a sampler
+     *
+     * Writes the sampler descriptor to the heap. If the heap is
+     * not supported, this returns index 0. Throws if the heap is
+     * exhausted, which the sampler pool prevents.
+     * \param [in] sampler Sampler handle
+     * \returns Heap index
+     */
+    uint16_t allocIndex(VkSampler sampler);
+
+    /**
+     * \brief Frees heap index
+     *
+     * The sampler must not be in use by the GPU anymore.
+     * \param [in] index Heap index
+     */
+    void freeIndex(uint16_t index);
+
+  private:
+
+    DxvkDevice*           m_device;
+
+    VkDescriptorPool      m_pool          = VK_NULL_HANDLE;
+    VkDescriptorSetLayout m_setLayout     = VK_NULL_HANDLE;
+    VkDescriptorSet       m_set           = VK_NULL_HANDLE;
+    VkSampler             m_sampler       = VK_NULL_HANDLE;
+
+    uint32_t              m_nextIndex     = 1u;
+    std::vector<uint16_t> m_freeIndices;
+
+    void writeDescriptor(uint16_t index, VkSampler sampler);
+
+    void createObjects();
+
+  };
+
+
   /**
    * \brief Sampler pool
    *
@@ -235,7 +324,8 @@ namespace dxvk {
     friend DxvkSampler;
   public:
 
-    // Lower limit for sampler counts in Vulkan.
+    // Lower limit for sampler counts in Vulkan. Unused samplers
+    // get destroyed once this is reached, but live ones are kept.
     constexpr static uint32_t MaxSamplerCount = 4000u;
 
     // Minimum number of samplers to keep alive.
@@ -248,6 +338,9 @@ namespace dxvk {
     /**
      * \brief Creates sampler
      *
+     * If the global sampler heap is used and all of its
+     * descriptors are taken by live samplers, this returns
+     * a shared fallback sampler instead.
      * \param [in] key Sampler key
      * \returns Sampler object
      */
@@ -266,17 +359,30 @@ namespace dxvk {
       return stats;
     }
 
+    /**
+     * \brief Retrieves global sampler heap
+     * \returns Sampler heap
+     */
+    const DxvkSamplerHeap& getHeap() const {
+      return m_heap;
+    }
+
   private:
 
     DxvkDevice* m_device;
 
     dxvk::mutex m_mutex;
+    DxvkSamplerHeap m_heap;
+
     std::unordered_map<DxvkSamplerKey,
       DxvkSampler, DxvkHash, DxvkEq> m_samplers;
 
     DxvkSampler* m_lruHead = nullptr;
     DxvkSampler* m_lruTail = nullptr;
 
+    Rc<DxvkSampler> m_fallbackSampler;
+    bool            m_heapExhausted = false;
+
     std::atomic<uint32_t> m_samplersLive = { 0u };
     std::atomic<uint32_t> m_samplersTotal = { 0u };
 
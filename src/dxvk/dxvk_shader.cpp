@@ -49,6 +49,7 @@ namespace dxvk {
   : m_info(info), m_code(spirv), m_bindings(info.stage) {
     m_info.uniformData = nullptr;
     m_info.bindings = nullptr;
+    m_info.samplerHeapBindings = nullptr;
 
     // Copy resource binding slot infos
     for (uint32_t i = 0; i < info.bindingCount; i++) {
@@ -57,6 +58,12 @@ namespace dxvk {
       m_bindings.addBinding(binding);
     }
 
+    for (uint32_t i = 0; i < info.samplerHeapBindingCount; i++) {
+      DxvkSamplerHeapBinding binding = info.samplerHeapBindings[i];
+      binding.stage = info.stage;
+      m_bindings.addSamplerHeapBinding(binding);
+    }
+
     if (info.pushConstSize) {
       VkPushConstantRange pushConst;
       pushConst.stageFlags = info.pushConstStages;
@@ -182,11 +189,20 @@ namespace dxvk {
     // Don't set pipeline library flag if the shader
     // doesn't actually support pipeline libraries
     m_needsLibraryCompile = canUsePipelineLibrary(true);
+
+    // Unlinked shader objects are only used for pipelines consisting of
+    // a vertex and fragment shader, the same way as pipeline libraries.
+    m_canUseShaderObject = m_needsLibraryCompile
+      && m_info.stage != VK_SHADER_STAGE_COMPUTE_BIT
+      && !m_flags.test(DxvkShaderFlag::HasTransformFeedback);
   }
 
 
   DxvkShader::~DxvkShader() {
-    
+    if (m_shaderObjectVkd != nullptr) {
+      for (const auto& entry : m_shaderObjects)
+        m_shaderObjectVkd->vkDestroyShaderEXT(m_shaderObjectVkd->device(), entry.second, nullptr);
+    }
   }
   
   
@@ -229,6 +245,83 @@ namespace dxvk {
   }
 
 
+  bool DxvkShader::requestShaderObject(
+    const DxvkBindingLayoutObjects*   layout) {
+    std::lock_guard lock(m_shaderObjectMutex);
+    return m_shaderObjects.emplace(layout, VK_NULL_HANDLE).second;
+  }
+
+
+  VkShaderEXT DxvkShader::getShaderObject(
+    const DxvkBindingLayoutObjects*   layout) {
+    std::lock_guard lock(m_shaderObjectMutex);
+    auto entry = m_shaderObjects.find(layout);
+
+    return entry != m_shaderObjects.end()
+      ? entry->second
+      : VK_NULL_HANDLE;
+  }
+
+
+  void DxvkShader::createShaderObject(
+          DxvkDevice*                 device,
+    const DxvkBindingLayoutObjects*   layout) {
+    auto vk = device->vkd();
+
+    SpirvCodeBuffer code = getCode(layout, DxvkShaderModuleCreateInfo());
+
+    // Descriptors and push constants get bound with the complete pipeline
+    // layout, so use the exact same set layouts and push constant range
+    // here. This includes sets used by other stages as well as the global
+    // sampler heap, which gets appended to all pipeline layouts.
+    std::array<VkDescriptorSetLayout, DxvkDescriptorSets::SetCount + 1> setLayouts = { };
+    uint32_t setCount = 0;
+
+    while (setCount < DxvkDescriptorSets::SetCount) {
+      setLayouts[setCount] = layout->getSetLayout(setCount);
+      setCount += 1;
+    }
+
+    VkDescriptorSetLayout heapLayout = device->getSamplerHeap().getSetLayout();
+
+    if (heapLayout)
+      setLayouts[setCount++] = heapLayout;
+
+    VkPushConstantRange pushConst = layout->layout().getPushConstantRange(false);
+
+    VkShaderCreateInfoEXT info = { VK_STRUCTURE_TYPE_SHADER_CREATE_INFO_EXT };
+    info.stage = m_info.stage;
+    info.codeType = VK_SHADER_CODE_TYPE_SPIRV_EXT;
+    info.codeSize = code.size();
+    info.pCode = code.data();
+    info.pName = "main";
+    info.setLayoutCount = setCount;
+    info.pSetLayouts = setLayouts.data();
+
+    if (m_info.stage == VK_SHADER_STAGE_VERTEX_BIT)
+      info.nextStage = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    if (pushConst.stageFlags && pushConst.size) {
+      info.pushConstantRangeCount = 1;
+      info.pPushConstantRanges = &pushConst;
+    }
+
+    VkShaderEXT shader = VK_NULL_HANDLE;
+    VkResult vr = vk->vkCreateShadersEXT(vk->device(), 1, &info, nullptr, &shader);
+
+    if (vr != VK_SUCCESS) {
+      // Leave the entry as a null handle so that
+      // we do not try to create it again
+      Logger::err(str::format("DxvkShader: Failed to create shader object for ", debugName(), ": ", vr));
+      return;
+    }
+
+    std::lock_guard lock(m_shaderObjectMutex);
+    m_shaderObjectVkd = vk;
+    m_shaderObjects[layout] = shader;
+  }
+
+
   bool DxvkShader::canUsePipelineLibrary(bool standalone) const {
     if (standalone) {
       // Standalone pipeline libraries are unsupported for geometry
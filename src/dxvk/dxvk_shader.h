@@ -1,5 +1,6 @@
 #pragma once
 
+#include <unordered_map>
 #include <vector>
 
 #include "dxvk_include.h"
@@ -13,6 +14,7 @@
 
 namespace dxvk {
   
+  class DxvkDevice;
   class DxvkShader;
   class DxvkShaderModule;
   class DxvkPipelineManager;
@@ -46,6 +48,9 @@ namespace dxvk {
     /// Descriptor info
     uint32_t bindingCount = 0;
     const DxvkBindingInfo* bindings = nullptr;
+    /// Sampler heap binding info
+    uint32_t samplerHeapBindingCount = 0;
+    const DxvkSamplerHeapBinding* samplerHeapBindings = nullptr;
     /// Input and output register mask
     uint32_t inputMask = 0;
     uint32_t outputMask = 0;
@@ -156,6 +161,54 @@ namespace dxvk {
       m_needsLibraryCompile.store(false);
     }
 
+    /**
+     * \brief Checks whether shader objects can be used
+     *
+     * Unlinked shader objects are only supported for vertex and
+     * fragment shaders that can be compiled without pipeline state.
+     * \returns \c true if shader objects can be created for this shader
+     */
+    bool canUseShaderObject() const {
+      return m_canUseShaderObject;
+    }
+
+    /**
+     * \brief Requests shader object for a given pipeline layout
+     *
+     * Registers the layout so that the shader object for it only gets
+     * created once. The shader object must then be created via
+     * \ref createShaderObject.
+     * \param [in] layout Pipeline layout
+     * \returns \c true if the shader object was not requested before
+     */
+    bool requestShaderObject(
+      const DxvkBindingLayoutObjects*   layout);
+
+    /**
+     * \brief Retrieves shader object for a given pipeline layout
+     *
+     * \param [in] layout Pipeline layout
+     * \returns Shader object, or \c VK_NULL_HANDLE if the shader
+     *    object has not been created successfully yet.
+     */
+    VkShaderEXT getShaderObject(
+      const DxvkBindingLayoutObjects*   layout);
+
+    /**
+     * \brief Creates unlinked shader object
+     *
+     * The shader object is compiled without any pipeline state and can
+     * be bound together with any other shader object that was created
+     * for the same pipeline layout. Descriptor set layouts and push
+     * constant ranges match the complete pipeline layout exactly, so
+     * that descriptors can be bound with that layout.
+     * \param [in] device The device
+     * \param [in] layout Complete graphics pipeline layout
+     */
+    void createShaderObject(
+            DxvkDevice*                 device,
+      const DxvkBindingLayoutObjects*   layout);
+
     /**
      * \brief Gets raw code without modification
      */
@@ -265,6 +318,13 @@ namespace dxvk {
 
     uint32_t                      m_specConstantMask = 0;
     std::atomic<bool>             m_needsLibraryCompile = { true };
+    bool                          m_canUseShaderObject = false;
+
+    dxvk::mutex                   m_shaderObjectMutex;
+    Rc<vk::DeviceFn>              m_shaderObjectVkd;
+    std::unordered_map<
+      const DxvkBindingLayoutObjects*,
+      VkShaderEXT>                m_shaderObjects;
 
     std::vector<char>             m_uniformData;
     std::vector<BindingOffsets>   m_bindingOffsets;
@@ -7,6 +7,23 @@ namespace dxvk {
   static const Sha1Hash       g_nullHash      = Sha1Hash::compute(nullptr, 0);
   static const DxvkShaderKey  g_nullShaderKey = DxvkShaderKey();
 
+  static constexpr uint32_t   g_indexVersion      = 1;
+  static constexpr uint32_t   g_indexBucketCount  = 1u << 16;
+  static constexpr uint32_t   g_indexMinCapacity  = 1u << 12;
+  static constexpr uint32_t   g_indexHashTailSize = 256;
+
+
+  /**
+   * \brief Computes index bucket for a shader key
+   *
+   * Uses the SHA-1 of the shader rather than the
+   * lookup hash, so that the on-disk layout does
+   * not depend on the width of \c size_t.
+   */
+  static uint32_t getIndexBucket(const DxvkShaderKey& key, uint32_t bucketCount) {
+    return (key.sha1().dword(0) ^ uint32_t(key.type())) & (bucketCount - 1);
+  }
+
 
   /**
    * \brief Packed entry header
@@ -269,16 +286,19 @@ namespace dxvk {
     if (!m_enable)
       return;
 
-    bool newFile = (useStateCache == "reset") || (!readCacheFile());
+    if (useStateCache == "reset" || !readCacheFile()) {
+      if (!createCacheFiles({ })) {
+        Logger::warn("DXVK: Failed to create state cache files");
+        m_enable = false;
+        return;
+      }
+    }
 
-    if (newFile) {
-      auto file = openCacheFileForWrite(true);
+    m_reader = openCacheFileForRead();
 
-      // Write all valid entries to the cache file in
-      // case we're recovering a corrupted cache file
-      for (auto& e : m_entries)
-        writeCacheEntry(file, e);
-    }
+    Logger::info(str::format(
+      "DXVK: Found ", getIndexHeader()->entryCount,
+      " state cache entries"));
   }
   
 
@@ -293,11 +313,13 @@ namespace dxvk {
       return;
 
     // Do not add an entry that is already in the cache
-    auto entries = m_entryMap.equal_range(shaders);
+    { std::lock_guard<dxvk::mutex> entryLock(m_entryLock);
+      auto entries = m_entryMap.equal_range(shaders);
 
-    for (auto e = entries.first; e != entries.second; e++) {
-      if (m_entries[e->second].type == DxvkStateCacheEntryType::PipelineLibrary)
-        return;
+      for (auto e = entries.first; e != entries.second; e++) {
+        if (m_entries[e->second].type == DxvkStateCacheEntryType::PipelineLibrary)
+          return;
+      }
     }
 
     // Queue a job to write this pipeline to the cache
@@ -319,12 +341,14 @@ namespace dxvk {
       return;
 
     // Do not add an entry that is already in the cache
-    auto entries = m_entryMap.equal_range(shaders);
+    { std::lock_guard<dxvk::mutex> entryLock(m_entryLock);
+      auto entries = m_entryMap.equal_range(shaders);
 
-    for (auto e = entries.first; e != entries.second; e++) {
-      if (m_entries[e->second].type == DxvkStateCacheEntryType::MonolithicPipeline
-       && m_entries[e->second].gpState == state)
-        return;
+      for (auto e = entries.first; e != entries.second; e++) {
+        if (m_entries[e->second].type == DxvkStateCacheEntryType::MonolithicPipeline
+         && m_entries[e->second].gpState == state)
+          return;
+      }
     }
 
     // Queue a job to write this pipeline to the cache
@@ -352,19 +376,62 @@ namespace dxvk {
     std::unique_lock<dxvk::mutex> entryLock(m_entryLock);
     m_shaderMap.insert({ key, shader });
 
+    // Find all cache entries that use this shader
+    std::vector<DxvkStateCacheKey> pipelines;
+    std::vector<uint64_t> offsets;
+    lookupPipelines(key, pipelines, offsets);
+
+    // Entries that were not read before are loaded from disk
+    // without holding the lock, so that we don't stall the
+    // writer or any other thread adding or looking up entries
+    if (!offsets.empty()) {
+      uint64_t dataSize = getIndexHeader()->dataSize;
+      entryLock.unlock();
+
+      std::vector<std::pair<uint64_t, DxvkStateCacheEntry>> entries;
+      std::vector<uint64_t> invalidOffsets;
+
+      for (auto offset : offsets) {
+        DxvkStateCacheEntry entry;
+
+        if (loadEntry(offset, dataSize, entry))
+          entries.push_back({ offset, entry });
+        else
+          invalidOffsets.push_back(offset);
+      }
+
+      entryLock.lock();
+
+      // Another thread may have loaded the same entries
+      for (const auto& e : entries) {
+        if (m_entryOffsets.find(e.first) == m_entryOffsets.end())
+          insertEntry(e.second, e.first);
+
+        bool found = false;
+
+        for (size_t i = 0; i < pipelines.size() && !found; i++)
+          found = pipelines[i].eq(e.second.shaders);
+
+        if (!found)
+          pipelines.push_back(e.second.shaders);
+      }
+
+      // Remember invalid entries so we don't read them again
+      for (auto offset : invalidOffsets)
+        m_entryOffsets.insert({ offset, ~size_t(0u) });
+    }
+
     // Deferred lock, don't stall workers unless we have to
     std::unique_lock<dxvk::mutex> workerLock;
 
-    auto pipelines = m_pipelineMap.equal_range(key);
-
-    for (auto p = pipelines.first; p != pipelines.second; p++) {
+    for (const auto& p : pipelines) {
       WorkerItem item;
 
-      if (!getShaderByKey(p->second.vs,  item.gp.vs)
-       || !getShaderByKey(p->second.tcs, item.gp.tcs)
-       || !getShaderByKey(p->second.tes, item.gp.tes)
-       || !getShaderByKey(p->second.gs,  item.gp.gs)
-       || !getShaderByKey(p->second.fs,  item.gp.fs))
+      if (!getShaderByKey(p.vs,  item.gp.vs)
+       || !getShaderByKey(p.tcs, item.gp.tcs)
+       || !getShaderByKey(p.tes, item.gp.tes)
+       || !getShaderByKey(p.gs,  item.gp.gs)
+       || !getShaderByKey(p.fs,  item.gp.fs))
         continue;
       
       if (!workerLock)
@@ -419,18 +486,75 @@ namespace dxvk {
   }
 
 
-  void DxvkStateCache::mapPipelineToEntry(
-    const DxvkStateCacheKey&        key,
-          size_t                    entryId) {
-    m_entryMap.insert({ key, entryId });
+  void DxvkStateCache::lookupPipelines(
+    const DxvkShaderKey&            shader,
+          std::vector<DxvkStateCacheKey>& pipelines,
+          std::vector<uint64_t>&    offsets) {
+    auto header = getIndexHeader();
+    auto buckets = getIndexBuckets();
+    auto records = getIndexRecords();
+
+    uint32_t index = buckets[getIndexBucket(shader, header->bucketCount)];
+
+    // Records only ever link to older records, which
+    // guarantees that a corrupted index cannot loop
+    while (index && index <= header->recordCount) {
+      const DxvkStateCacheIndexRecord& record = records[index - 1];
+
+      if (record.key.eq(shader)) {
+        auto e = m_entryOffsets.find(record.offset);
+
+        if (e == m_entryOffsets.end()) {
+          offsets.push_back(record.offset);
+        } else if (e->second < m_entries.size()) {
+          const auto& entry = m_entries[e->second];
+          bool found = false;
+
+          for (size_t i = 0; i < pipelines.size() && !found; i++)
+            found = pipelines[i].eq(entry.shaders);
+
+          if (!found)
+            pipelines.push_back(entry.shaders);
+        }
+      }
+
+      if (record.next >= index)
+        break;
+
+      index = record.next;
+    }
   }
 
-  
-  void DxvkStateCache::mapShaderToPipeline(
-    const DxvkShaderKey&            shader,
-    const DxvkStateCacheKey&        key) {
-    if (!shader.eq(g_nullShaderKey))
-      m_pipelineMap.insert({ shader, key });
+
+  bool DxvkStateCache::loadEntry(
+          uint64_t                  offset,
+          uint64_t                  dataSize,
+          DxvkStateCacheEntry&      entry) {
+    std::lock_guard<dxvk::mutex> lock(m_readerLock);
+
+    DxvkStateCacheHeader header;
+
+    m_reader.clear();
+    m_reader.seekg(offset);
+
+    if (offset < sizeof(header) || offset >= dataSize
+     || !readCacheEntry(header.version, m_reader, entry)) {
+      Logger::warn(str::format("DXVK: Invalid state cache entry at offset ", offset));
+      return false;
+    }
+
+    return true;
+  }
+
+
+  void DxvkStateCache::insertEntry(
+    const DxvkStateCacheEntry&      entry,
+          uint64_t                  offset) {
+    size_t entryId = m_entries.size();
+    m_entries.push_back(entry);
+
+    m_entryMap.insert({ entry.shaders, entryId });
+    m_entryOffsets.insert({ offset, entryId });
   }
 
 
@@ -442,12 +566,20 @@ namespace dxvk {
     key.gs  = getShaderKey(item.gp.gs);
     key.fs  = getShaderKey(item.gp.fs);
 
-    DxvkGraphicsPipeline* pipeline = nullptr;
-    auto entries = m_entryMap.equal_range(key);
+    // Copy relevant entries so that we don't hold
+    // the lock while creating pipeline objects
+    std::vector<DxvkStateCacheEntry> entries;
 
-    for (auto e = entries.first; e != entries.second; e++) {
-      const auto& entry = m_entries[e->second];
+    { std::lock_guard<dxvk::mutex> entryLock(m_entryLock);
+      auto range = m_entryMap.equal_range(key);
 
+      for (auto e = range.first; e != range.second; e++)
+        entries.push_back(m_entries[e->second]);
+    }
+
+    DxvkGraphicsPipeline* pipeline = nullptr;
+
+    for (const auto& entry : entries) {
       switch (entry.type) {
         case DxvkStateCacheEntryType::MonolithicPipeline: {
           if (!pipeline)
@@ -476,13 +608,11 @@ namespace dxvk {
 
 
   bool DxvkStateCache::readCacheFile() {
-    // Return success if the file was not found.
-    // This way we will only create it on demand.
     std::ifstream ifile = openCacheFileForRead();
 
     if (!ifile) {
       Logger::warn("DXVK: No state cache file found");
-      return true;
+      return false;
     }
 
     // The header stores the state cache version,
@@ -502,47 +632,301 @@ namespace dxvk {
       return false;
     }
 
-    // Notify user about format conversion
-    if (curHeader.version != newHeader.version)
+    // Older versions have no index, so we need to read the
+    // entire file once and write out a new file and index.
+    if (curHeader.version != newHeader.version) {
       Logger::warn(str::format("DXVK: Updating state cache version to v", newHeader.version));
 
-    // Read actual cache entries from the file.
-    // If we encounter invalid entries, we should
-    // regenerate the entire state cache file.
+      std::vector<DxvkStateCacheEntry> entries;
+
+      while (ifile) {
+        DxvkStateCacheEntry entry;
+
+        if (readCacheEntry(curHeader.version, ifile, entry))
+          entries.push_back(entry);
+      }
+
+      ifile.close();
+      return createCacheFiles(entries);
+    }
+
+    // Map the index and only parse the parts of the cache
+    // file that were appended since the index was written.
+    bool hasIndex = openIndexFile();
+
+    if (!hasIndex && !createIndexFile())
+      return false;
+
+    ifile.clear();
+    ifile.seekg(0, std::ios_base::end);
+
+    uint64_t fileSize = uint64_t(ifile.tellg());
+    uint64_t dataSize = getIndexHeader()->dataSize;
+
+    if (hasIndex && (dataSize > fileSize
+     || computeIndexHash(ifile, dataSize) != getIndexHeader()->dataHash)) {
+      Logger::warn("DXVK: State cache index out of date");
+
+      if (!createIndexFile())
+        return false;
+    }
+
+    if (getIndexHeader()->dataSize < fileSize) {
+      uint32_t entryCount = getIndexHeader()->entryCount;
+      uint32_t numInvalidEntries = indexCacheFile(ifile, fileSize);
+
+      Logger::info(str::format(
+        "DXVK: Indexed ", getIndexHeader()->entryCount - entryCount,
+        " new state cache entries"));
+
+      if (numInvalidEntries) {
+        Logger::warn(str::format(
+          "DXVK: Skipped ", numInvalidEntries,
+          " invalid state cache entries"));
+      }
+    }
+
+    auto header = getIndexHeader();
+    header->dataHash = computeIndexHash(ifile, header->dataSize);
+    return true;
+  }
+
+
+  bool DxvkStateCache::createCacheFiles(
+    const std::vector<DxvkStateCacheEntry>& entries) {
+    std::ofstream file = openCacheFileForWrite(true);
+
+    if (!file || !createIndexFile())
+      return false;
+
+    // Write all valid entries to the cache file in case
+    // we're converting or recovering an existing cache
+    uint64_t offset = getIndexHeader()->dataSize;
+
+    for (const auto& e : entries) {
+      uint64_t size = writeCacheEntry(file, e);
+
+      if (!file)
+        return false;
+
+      indexCacheEntry(e, offset, size);
+      offset += size;
+    }
+
+    if (!file.flush())
+      return false;
+
+    std::ifstream ifile = openCacheFileForRead();
+
+    auto header = getIndexHeader();
+    header->dataHash = computeIndexHash(ifile, header->dataSize);
+    return true;
+  }
+
+
+  uint32_t DxvkStateCache::indexCacheFile(
+          std::istream&             stream,
+          uint64_t                  fileSize) {
+    DxvkStateCacheHeader header;
+
+    uint64_t offset = getIndexHeader()->dataSize;
     uint32_t numInvalidEntries = 0;
 
-    while (ifile) {
+    stream.clear();
+    stream.seekg(offset);
+
+    while (stream && offset < fileSize) {
       DxvkStateCacheEntry entry;
 
-      if (readCacheEntry(curHeader.version, ifile, entry)) {
-        size_t entryId = m_entries.size();
-        m_entries.push_back(entry);
+      bool valid = readCacheEntry(header.version, stream, entry);
 
-        mapPipelineToEntry(entry.shaders, entryId);
+      // Stop at incomplete entries, the writer
+      // will overwrite them with new data later.
+      if (!stream)
+        break;
 
-        mapShaderToPipeline(entry.shaders.vs,  entry.shaders);
-        mapShaderToPipeline(entry.shaders.tcs, entry.shaders);
-        mapShaderToPipeline(entry.shaders.tes, entry.shaders);
-        mapShaderToPipeline(entry.shaders.gs,  entry.shaders);
-        mapShaderToPipeline(entry.shaders.fs,  entry.shaders);
-      } else if (ifile) {
+      uint64_t size = uint64_t(stream.tellg()) - offset;
+
+      if (valid) {
+        indexCacheEntry(entry, offset, size);
+      } else {
+        getIndexHeader()->dataSize = offset + size;
         numInvalidEntries += 1;
       }
+
+      offset += size;
     }
 
-    Logger::info(str::format(
-      "DXVK: Read ", m_entries.size(),
-      " valid state cache entries"));
+    return numInvalidEntries;
+  }
+
+
+  bool DxvkStateCache::openIndexFile() {
+    if (!m_index.open(getIndexFileName(), true))
+      return false;
+
+    auto header = getIndexHeader();
 
-    if (numInvalidEntries) {
-      Logger::warn(str::format(
-        "DXVK: Skipped ", numInvalidEntries,
-        " invalid state cache entries"));
+    if (!header)
       return false;
+
+    DxvkStateCacheIndexHeader expected;
+    expected.version = DxvkStateCacheHeader().version;
+    expected.indexVersion = g_indexVersion;
+    expected.bucketCount = g_indexBucketCount;
+
+    for (uint32_t i = 0; i < 4; i++) {
+      if (expected.magic[i] != header->magic[i])
+        return false;
     }
-    
-    // Rewrite entire state cache if it is outdated
-    return curHeader.version == newHeader.version;
+
+    if (header->version != expected.version
+     || header->indexVersion != expected.indexVersion
+     || header->bucketCount != expected.bucketCount
+     || header->recordCount > getIndexCapacity()
+     || header->dataSize < sizeof(DxvkStateCacheHeader))
+      return false;
+
+    return true;
+  }
+
+
+  bool DxvkStateCache::createIndexFile() {
+    if (!m_index.isOpen() && !m_index.open(getIndexFileName(), true))
+      return false;
+
+    size_t size = sizeof(DxvkStateCacheIndexHeader)
+                + sizeof(uint32_t) * g_indexBucketCount
+                + sizeof(DxvkStateCacheIndexRecord) * g_indexMinCapacity;
+
+    if (!m_index.resize(0) || !m_index.resize(size))
+      return false;
+
+    std::memset(m_index.data(), 0, size);
+
+    DxvkStateCacheIndexHeader header;
+    header.version = DxvkStateCacheHeader().version;
+    header.indexVersion = g_indexVersion;
+    header.bucketCount = g_indexBucketCount;
+    header.dataSize = sizeof(DxvkStateCacheHeader);
+
+    std::memcpy(m_index.data(), &header, sizeof(header));
+    return true;
+  }
+
+
+  bool DxvkStateCache::addIndexRecord(
+    const DxvkShaderKey&            key,
+          uint64_t                  offset) {
+    uint32_t capacity = getIndexCapacity();
+
+    if (getIndexHeader()->recordCount == capacity) {
+      size_t size = m_index.size() + sizeof(DxvkStateCacheIndexRecord) * capacity;
+
+      if (!m_index.resize(size))
+        return false;
+    }
+
+    auto header = getIndexHeader();
+    auto buckets = getIndexBuckets();
+    auto records = getIndexRecords();
+
+    uint32_t bucket = getIndexBucket(key, header->bucketCount);
+
+    DxvkStateCacheIndexRecord& record = records[header->recordCount];
+    record.key = key;
+    record.next = buckets[bucket];
+    record.reserved = 0;
+    record.offset = offset;
+
+    buckets[bucket] = ++header->recordCount;
+    return true;
+  }
+
+
+  void DxvkStateCache::indexCacheEntry(
+    const DxvkStateCacheEntry&      entry,
+          uint64_t                  offset,
+          uint64_t                  size) {
+    std::array<const DxvkShaderKey*, 5> keys = {
+      &entry.shaders.vs,  &entry.shaders.tcs,
+      &entry.shaders.tes, &entry.shaders.gs,
+      &entry.shaders.fs,
+    };
+
+    for (auto key : keys) {
+      if (!key->eq(g_nullShaderKey) && !addIndexRecord(*key, offset))
+        return;
+    }
+
+    // Only mark the entry as indexed once all
+    // records have been written successfully
+    auto header = getIndexHeader();
+    header->entryCount += 1;
+    header->dataSize = offset + size;
+  }
+
+
+  DxvkStateCacheIndexHeader* DxvkStateCache::getIndexHeader() const {
+    if (m_index.size() < sizeof(DxvkStateCacheIndexHeader))
+      return nullptr;
+
+    return reinterpret_cast<DxvkStateCacheIndexHeader*>(m_index.data());
+  }
+
+
+  uint32_t* DxvkStateCache::getIndexBuckets() const {
+    return reinterpret_cast<uint32_t*>(reinterpret_cast<char*>(m_index.data())
+      + sizeof(DxvkStateCacheIndexHeader));
+  }
+
+
+  DxvkStateCacheIndexRecord* DxvkStateCache::getIndexRecords() const {
+    return reinterpret_cast<DxvkStateCacheIndexRecord*>(reinterpret_cast<char*>(m_index.data())
+      + sizeof(DxvkStateCacheIndexHeader) + sizeof(uint32_t) * g_indexBucketCount);
+  }
+
+
+  uint32_t DxvkStateCache::getIndexCapacity() const {
+    size_t baseSize = sizeof(DxvkStateCacheIndexHeader)
+                    + sizeof(uint32_t) * g_indexBucketCount;
+
+    if (m_index.size() < baseSize)
+      return 0;
+
+    return uint32_t((m_index.size() - baseSize) / sizeof(DxvkStateCacheIndexRecord));
+  }
+
+
+  uint64_t DxvkStateCache::computeIndexHash(
+          std::istream&             stream,
+          uint64_t                  dataSize) const {
+    std::array<char, sizeof(DxvkStateCacheHeader)> head = { };
+    std::array<char, g_indexHashTailSize> tail = { };
+
+    uint64_t tailOffset = std::max<uint64_t>(sizeof(head),
+      dataSize > g_indexHashTailSize ? dataSize - g_indexHashTailSize : 0);
+    uint64_t tailSize = dataSize > tailOffset ? dataSize - tailOffset : 0;
+
+    stream.clear();
+    stream.seekg(0);
+
+    if (!stream.read(head.data(), head.size()))
+      return 0;
+
+    stream.seekg(tailOffset);
+
+    if (tailSize && !stream.read(tail.data(), tailSize))
+      return 0;
+
+    std::array<Sha1Data, 3> chunks = {{
+      { head.data(), head.size() },
+      { &dataSize,   sizeof(dataSize) },
+      { tail.data(), size_t(tailSize) },
+    }};
+
+    Sha1Hash hash = Sha1Hash::compute(chunks.size(), chunks.data());
+    return uint64_t(hash.dword(0)) | (uint64_t(hash.dword(1)) << 32);
   }
 
 
@@ -688,9 +1072,9 @@ namespace dxvk {
   }
 
 
-  void DxvkStateCache::writeCacheEntry(
+  size_t DxvkStateCache::writeCacheEntry(
           std::ostream&             stream, 
-          DxvkStateCacheEntry&      entry) const {
+    const DxvkStateCacheEntry&      entry) const {
     DxvkStateCacheEntryData data;
     VkShaderStageFlags stageMask = 0;
 
@@ -762,6 +1146,8 @@ namespace dxvk {
     stream.write(reinterpret_cast<char*>(&hash), sizeof(hash));
     stream.write(data.data(), data.size());
     stream.flush();
+
+    return sizeof(header) + sizeof(hash) + data.size();
   }
 
 
@@ -796,6 +1182,7 @@ namespace dxvk {
     env::setThreadName("dxvk-writer");
 
     std::ofstream file;
+    std::ifstream reader;
 
     while (!m_stopThreads.load()) {
       DxvkStateCacheEntry entry;
@@ -817,7 +1204,38 @@ namespace dxvk {
       if (!file.is_open())
         file = openCacheFileForWrite(false);
 
-      writeCacheEntry(file, entry);
+      // Entries are appended to the end of the indexed
+      // region, which may overwrite incomplete entries
+      uint64_t offset;
+
+      { std::lock_guard<dxvk::mutex> lock(m_entryLock);
+        offset = getIndexHeader()->dataSize;
+      }
+
+      file.seekp(offset);
+
+      uint64_t size = writeCacheEntry(file, entry);
+
+      if (!file.flush()) {
+        file = std::ofstream();
+        continue;
+      }
+
+      // Update the hash of the indexed data along with the
+      // index itself, reading the tail back from the file
+      if (!reader.is_open())
+        reader = openCacheFileForRead();
+
+      uint64_t dataHash = computeIndexHash(reader, offset + size);
+
+      std::lock_guard<dxvk::mutex> lock(m_entryLock);
+      indexCacheEntry(entry, offset, size);
+      insertEntry(entry, offset);
+
+      auto header = getIndexHeader();
+
+      if (header->dataSize == offset + size)
+        header->dataHash = dataHash;
     }
   }
 
@@ -835,14 +1253,24 @@ namespace dxvk {
 
 
   str::path_string DxvkStateCache::getCacheFileName() const {
+    std::string path = getCacheFileBaseName() + ".dxvk-cache";
+    return str::topath(path.c_str());
+  }
+
+
+  str::path_string DxvkStateCache::getIndexFileName() const {
+    std::string path = getCacheFileBaseName() + ".dxvk-cache-index";
+    return str::topath(path.c_str());
+  }
+
+
+  std::string DxvkStateCache::getCacheFileBaseName() const {
     std::string path = getCacheDir();
 
     if (!path.empty() && *path.rbegin() != '/')
       path += '/';
     
-    std::string exeName = env::getExeBaseName();
-    path += exeName + ".dxvk-cache";
-    return str::topath(path.c_str());
+    return path + env::getExeBaseName();
   }
 
 
@@ -854,12 +1282,6 @@ namespace dxvk {
   std::ofstream DxvkStateCache::openCacheFileForWrite(bool recreate) const {
     std::ofstream file;
 
-    if (!recreate) {
-      // Apparently there's no other way to check whether
-      // the file is empty after creating an ofstream
-      recreate = !openCacheFileForRead();
-    }
-
     if (recreate) {
       file = std::ofstream(getCacheFileName().c_str(),
         std::ios_base::binary |
@@ -871,9 +1293,12 @@ namespace dxvk {
           std::ios_base::trunc);
       }
     } else {
+      // Open in read-write mode so that the writer can
+      // position entries at the end of the indexed data
       file = std::ofstream(getCacheFileName().c_str(),
         std::ios_base::binary |
-        std::ios_base::app);
+        std::ios_base::in |
+        std::ios_base::out);
     }
 
     if (!file)
@@ -10,6 +10,8 @@
 
 #include "dxvk_state_cache_types.h"
 
+#include "../util/util_mmap.h"
+
 namespace dxvk {
 
   class DxvkDevice;
@@ -24,6 +26,12 @@ namespace dxvk {
    * game, which allows DXVK to compile them ahead
    * of time instead of compiling them on the first
    * draw.
+   *
+   * Entries are appended to the cache file and looked
+   * up through a memory-mapped index only once one of
+   * their shaders gets registered, so that the cost of
+   * using the cache scales with the number of shaders
+   * that the application actually uses.
    */
   class DxvkStateCache {
 
@@ -96,14 +104,18 @@ namespace dxvk {
       DxvkStateCacheKey, size_t,
       DxvkHash, DxvkEq> m_entryMap;
 
-    std::unordered_multimap<
-      DxvkShaderKey, DxvkStateCacheKey,
-      DxvkHash, DxvkEq> m_pipelineMap;
+    std::unordered_map<
+      uint64_t, size_t>               m_entryOffsets;
     
     std::unordered_map<
       DxvkShaderKey, Rc<DxvkShader>,
       DxvkHash, DxvkEq> m_shaderMap;
 
+    MappedFile                        m_index;
+
+    dxvk::mutex                       m_readerLock;
+    std::ifstream                     m_reader;
+
     dxvk::mutex                       m_workerLock;
     dxvk::condition_variable          m_workerCond;
     std::queue<WorkerItem>            m_workerQueue;
@@ -121,19 +133,57 @@ namespace dxvk {
       const DxvkShaderKey&            key,
             Rc<DxvkShader>&           shader) const;
     
-    void mapPipelineToEntry(
-      const DxvkStateCacheKey&        key,
-            size_t                    entryId);
-    
-    void mapShaderToPipeline(
+    void lookupPipelines(
       const DxvkShaderKey&            shader,
-      const DxvkStateCacheKey&        key);
+            std::vector<DxvkStateCacheKey>& pipelines,
+            std::vector<uint64_t>&    offsets);
+
+    bool loadEntry(
+            uint64_t                  offset,
+            uint64_t                  dataSize,
+            DxvkStateCacheEntry&      entry);
+
+    void insertEntry(
+      const DxvkStateCacheEntry&      entry,
+            uint64_t                  offset);
 
     void compilePipelines(
       const WorkerItem&               item);
 
     bool readCacheFile();
 
+    bool createCacheFiles(
+      const std::vector<DxvkStateCacheEntry>& entries);
+
+    uint32_t indexCacheFile(
+            std::istream&             stream,
+            uint64_t                  fileSize);
+
+    bool openIndexFile();
+
+    bool createIndexFile();
+
+    bool addIndexRecord(
+      const DxvkShaderKey&            key,
+            uint64_t                  offset);
+
+    void indexCacheEntry(
+      const DxvkStateCacheEntry&      entry,
+            uint64_t                  offset,
+            uint64_t                  size);
+
+    DxvkStateCacheIndexHeader* getIndexHeader() const;
+
+    uint32_t* getIndexBuckets() const;
+
+    DxvkStateCacheIndexRecord* getIndexRecords() const;
+
+    uint32_t getIndexCapacity() const;
+
+    uint64_t computeIndexHash(
+            std::istream&             stream,
+            uint64_t                  dataSize) const;
+
     bool readCacheHeader(
             std::istream&             stream,
             DxvkStateCacheHeader&     header) const;
@@ -143,9 +193,9 @@ namespace dxvk {
             std::istream&             stream, 
             DxvkStateCacheEntry&      entry) const;
     
-    void writeCacheEntry(
+    size_t writeCacheEntry(
             std::ostream&             stream, 
-            DxvkStateCacheEntry&      entry) const;
+      const DxvkStateCacheEntry&      entry) const;
     
     void workerFunc();
 
@@ -157,6 +207,10 @@ namespace dxvk {
 
     str::path_string getCacheFileName() const;
 
+    str::path_string getIndexFileName() const;
+
+    std::string getCacheFileBaseName() const;
+
     std::ifstream openCacheFileForRead() const;
 
     std::ofstream openCacheFileForWrite(
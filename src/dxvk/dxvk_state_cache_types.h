@@ -60,12 +60,58 @@ namespace dxvk {
    */
   struct DxvkStateCacheHeader {
     char     magic[4]   = { 'D', 'X', 'V', 'K' };
-    uint32_t version    = 18;
+    uint32_t version    = 19;
     uint32_t entrySize  = 0; /* no longer meaningful */
   };
 
   static_assert(sizeof(DxvkStateCacheHeader) == 12);
 
+
+  /**
+   * \brief State cache index header
+   *
+   * The index is stored in a separate file and maps
+   * shader keys to the offsets of all cache entries
+   * using that shader. It is laid out as this header,
+   * followed by the bucket array, followed by records.
+   * The data size is the number of bytes of the cache
+   * file covered by the index, anything past that is
+   * indexed on the next run. The data hash is computed
+   * from the cache file header and the last bytes of
+   * the covered data, and is used to detect whether
+   * the cache file was replaced or modified.
+   */
+  struct DxvkStateCacheIndexHeader {
+    char     magic[4]     = { 'D', 'X', 'V', 'I' };
+    uint32_t version      = 0;
+    uint32_t bucketCount  = 0;
+    uint32_t entryCount   = 0;
+    uint32_t recordCount  = 0;
+    uint32_t indexVersion = 0;
+    uint64_t dataSize     = 0;
+    uint64_t dataHash     = 0;
+  };
+
+  static_assert(sizeof(DxvkStateCacheIndexHeader) == 40);
+
+
+  /**
+   * \brief State cache index record
+   *
+   * Links a shader key to a cache entry. Records of
+   * the same bucket form a singly-linked list, where
+   * \c next is the one-based index of the previous
+   * record in the bucket, or zero for the last one.
+   */
+  struct DxvkStateCacheIndexRecord {
+    DxvkShaderKey key;
+    uint32_t      next;
+    uint32_t      reserved;
+    uint64_t      offset;
+  };
+
+  static_assert(sizeof(DxvkStateCacheIndexRecord) == 40);
+
   using DxvkBindingMaskV10 = DxvkBindingSet<384>;
   using DxvkBindingMaskV8 = DxvkBindingSet<128>;
 
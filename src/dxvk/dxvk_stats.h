@@ -30,6 +30,8 @@ namespace dxvk {
     CsChunkCount,             ///< Submitted CS chunks
     DescriptorPoolCount,      ///< Descriptor pool count
     DescriptorSetCount,       ///< Descriptor sets allocated
+    CmdMergedBufferCopies,    ///< Buffer copies merged into others
+    CmdBufferRenameCount,     ///< Buffers renamed for partial writes
     NumCounters,              ///< Number of counters available
   };
   
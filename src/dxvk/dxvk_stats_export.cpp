@@ -0,0 +1,162 @@
+#include <cstring>
+
+#include "dxvk_device.h"
+#include "dxvk_stats_export.h"
+
+namespace dxvk {
+
+  static_assert(uint32_t(DxvkStatCounter::NumCounters) <= DxvkStatsExportRecord::MaxCounters);
+
+  std::atomic<uint32_t> DxvkStatsExporter::s_deviceCount = { 0u };
+
+  DxvkStatsExporter::DxvkStatsExporter(
+          DxvkDevice*               device,
+    const std::string&              path)
+  : m_device    (device),
+    m_memory    (device->adapter()->memoryProperties()),
+    m_startTime (high_resolution_clock::now()) {
+    uint32_t deviceIndex = s_deviceCount.fetch_add(1u, std::memory_order_relaxed);
+
+    std::string devicePath = deviceIndex
+      ? str::format(path, ".", deviceIndex)
+      : path;
+
+    if (!initFile(devicePath)) {
+      Logger::warn(str::format("Failed to create stats export file: ", devicePath));
+      return;
+    }
+
+    Logger::info(str::format("Exporting stats to ", devicePath));
+    m_thread = dxvk::thread([this] () { runExporter(); });
+  }
+
+
+  DxvkStatsExporter::~DxvkStatsExporter() {
+    stop();
+  }
+
+
+  void DxvkStatsExporter::notifyLatencyStats(
+    const DxvkLatencyStats&         stats) {
+    m_frameLatency.store(stats.frameLatency.count(), std::memory_order_relaxed);
+    m_sleepDuration.store(stats.sleepDuration.count(), std::memory_order_relaxed);
+    m_targetLatency.store(stats.targetLatency.count(), std::memory_order_relaxed);
+  }
+
+
+  void DxvkStatsExporter::stop() {
+    { std::lock_guard lock(m_mutex);
+
+      if (m_stopped)
+        return;
+
+      m_stopped = true;
+      m_cond.notify_one();
+    }
+
+    if (m_thread.joinable())
+      m_thread.join();
+  }
+
+
+  bool DxvkStatsExporter::initFile(
+    const std::string&              path) {
+    size_t size = sizeof(DxvkStatsExportHeader)
+      + sizeof(DxvkStatsExportRecord) * RecordCount;
+
+    // Readers may already have the file open, so reuse it
+    // rather than deleting it, and reset the contents.
+    if (!m_file.open(str::topath(path.c_str()), true)
+     || !m_file.resize(size))
+      return false;
+
+    std::memset(m_file.data(), 0, size);
+
+    auto header = reinterpret_cast<DxvkStatsExportHeader*>(m_file.data());
+    header->version = 2u;
+    header->headerSize = sizeof(DxvkStatsExportHeader);
+    header->recordSize = sizeof(DxvkStatsExportRecord);
+    header->recordCount = RecordCount;
+    header->counterCount = uint32_t(DxvkStatCounter::NumCounters);
+    header->heapCount = m_memory.memoryHeapCount;
+
+    // Write the magic last so that readers never
+    // see a valid header with garbage contents
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(header->magic, "DXVKSTAT", sizeof(header->magic));
+    return true;
+  }
+
+
+  void DxvkStatsExporter::writeRecord(
+          uint64_t                  recordId) {
+    auto header = reinterpret_cast<DxvkStatsExportHeader*>(m_file.data());
+    auto records = reinterpret_cast<DxvkStatsExportRecord*>(header + 1);
+
+    // Gather all stats up front to keep the window
+    // in which the record is invalid small
+    DxvkStatsExportRecord record = { };
+    record.sequence = recordId;
+    record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+      high_resolution_clock::now() - m_startTime).count();
+
+    DxvkStatCounters counters = m_device->getStatCounters();
+
+    for (uint32_t i = 0; i < uint32_t(DxvkStatCounter::NumCounters); i++)
+      record.counters[i] = counters.getCtr(DxvkStatCounter(i));
+
+    for (uint32_t i = 0; i < m_memory.memoryHeapCount; i++) {
+      DxvkMemoryStats heapStats = m_device->getMemoryStats(i);
+      record.heaps[i].allocated = heapStats.memoryAllocated;
+      record.heaps[i].used = heapStats.memoryUsed;
+      record.heaps[i].budget = heapStats.memoryBudget;
+    }
+
+    DxvkSharedAllocationCacheStats cacheStats = m_device->getMemoryAllocationCacheStats();
+    record.cacheRequestCount = cacheStats.requestCount;
+    record.cacheMissCount = cacheStats.missCount;
+    record.cacheSize = cacheStats.size;
+
+    record.frameLatency = m_frameLatency.load(std::memory_order_relaxed);
+    record.sleepDuration = m_sleepDuration.load(std::memory_order_relaxed);
+    record.targetLatency = m_targetLatency.load(std::memory_order_relaxed);
+
+    DxvkPipelineWorkerStats workerStats = m_device->getPipelineWorkerStats();
+    record.pipeTasksCompleted = workerStats.tasksCompleted;
+    record.pipeTasksTotal = workerStats.tasksTotal;
+
+    // Invalidate the ring entry, then write the record contents,
+    // and publish the sequence number and record count last.
+    auto& dst = records[(recordId - 1u) % RecordCount];
+    dst.sequence = 0u;
+
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(reinterpret_cast<char*>(&dst) + sizeof(dst.sequence),
+      reinterpret_cast<const char*>(&record) + sizeof(record.sequence),
+      sizeof(record) - sizeof(record.sequence));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    dst.sequence = recordId;
+    header->recordsWritten = recordId;
+  }
+
+
+  void DxvkStatsExporter::runExporter() {
+    env::setThreadName("dxvk-stats");
+
+    uint64_t recordId = 0u;
+
+    std::unique_lock lock(m_mutex);
+
+    while (!m_stopped) {
+      lock.unlock();
+      writeRecord(++recordId);
+      lock.lock();
+
+      m_cond.wait_for(lock, Interval, [this] {
+        return m_stopped;
+      });
+    }
+  }
+
+}
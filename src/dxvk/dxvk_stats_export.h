@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+
+#include "dxvk_include.h"
+#include "dxvk_latency.h"
+#include "dxvk_stats.h"
+
+#include "../util/thread.h"
+#include "../util/util_mmap.h"
+
+namespace dxvk {
+
+  class DxvkDevice;
+
+  /**
+   * \brief Stats export file header
+   *
+   * The export file starts with this header and is followed
+   * by a ring of \c recordCount records, each \c recordSize
+   * bytes in size. All values use native byte order.
+   *
+   * Readers should load \c recordsWritten, read the record
+   * at index <tt>(recordsWritten - 1) % recordCount</tt>, and
+   * discard it unless its \c sequence field equals the value
+   * of \c recordsWritten both before and after copying it.
+   */
+  struct DxvkStatsExportHeader {
+    /// File magic, always \c "DXVKSTAT"
+    char      magic[8];
+    /// Format version, currently 2
+    uint32_t  version;
+    /// Size of this header, in bytes
+    uint32_t  headerSize;
+    /// Size of a single record, in bytes
+    uint32_t  recordSize;
+    /// Number of records in the ring
+    uint32_t  recordCount;
+    /// Number of valid stat counters per record. Counters
+    /// are indexed by the \ref DxvkStatCounter enum.
+    uint32_t  counterCount;
+    /// Number of valid memory heaps per record
+    uint32_t  heapCount;
+    /// Total number of records written so far. Written
+    /// after the record itself is complete.
+    uint64_t  recordsWritten;
+  };
+
+
+  /**
+   * \brief Memory heap stats in exported records
+   */
+  struct DxvkStatsExportHeap {
+    uint64_t  allocated;
+    uint64_t  used;
+    uint64_t  budget;
+  };
+
+
+  /**
+   * \brief Exported stats record
+   */
+  struct DxvkStatsExportRecord {
+    constexpr static uint32_t MaxCounters = 32u;
+
+    /// Record number, starting at 1. Set to
+    /// 0 while the record is being written.
+    uint64_t            sequence;
+    /// Time since the exporter was started, in microseconds
+    uint64_t            timestamp;
+    /// Stat counter values
+    uint64_t            counters[MaxCounters];
+    /// Per-heap memory statistics, in bytes
+    DxvkStatsExportHeap heaps[VK_MAX_MEMORY_HEAPS];
+    /// Shared allocation cache statistics
+    uint64_t            cacheRequestCount;
+    uint64_t            cacheMissCount;
+    uint64_t            cacheSize;
+    /// Latency stats of the most recently presented
+    /// frame, in microseconds. Zero if unavailable.
+    uint64_t            frameLatency;
+    uint64_t            sleepDuration;
+    uint64_t            targetLatency;
+    /// Pipeline compiler worker statistics
+    uint64_t            pipeTasksCompleted;
+    uint64_t            pipeTasksTotal;
+  };
+
+
+  /**
+   * \brief Headless stats exporter
+   *
+   * Periodically samples device statistics on a dedicated
+   * thread and writes them to a memory-mapped file, which
+   * acts as shared memory if placed on a tmpfs mount such
+   * as \c /dev/shm. Enabled via \c DXVK_STATS_EXPORT, which
+   * specifies the file path. If a process creates more than
+   * one device, each device after the first one appends its
+   * index to the path, e.g. \c /dev/shm/dxvk.1, so that no
+   * two devices ever write to the same file.
+   *
+   * Only queries statistics that the HUD also uses, so no
+   * synchronization is added to any rendering code paths.
+   */
+  class DxvkStatsExporter {
+
+  public:
+
+    DxvkStatsExporter(
+            DxvkDevice*               device,
+      const std::string&              path);
+
+    ~DxvkStatsExporter();
+
+    /**
+     * \brief Updates latency statistics
+     *
+     * Stores the given stats for the next record.
+     * \param [in] stats Latency stats for the last frame
+     */
+    void notifyLatencyStats(
+      const DxvkLatencyStats&         stats);
+
+    /**
+     * \brief Stops the exporter thread
+     */
+    void stop();
+
+  private:
+
+    constexpr static uint32_t RecordCount = 256u;
+
+    static std::atomic<uint32_t> s_deviceCount;
+    constexpr static auto     Interval    = std::chrono::milliseconds(500);
+
+    DxvkDevice*                 m_device;
+    VkPhysicalDeviceMemoryProperties m_memory = { };
+
+    MappedFile                  m_file;
+
+    std::atomic<uint64_t>       m_frameLatency  = { 0u };
+    std::atomic<uint64_t>       m_sleepDuration = { 0u };
+    std::atomic<uint64_t>       m_targetLatency = { 0u };
+
+    high_resolution_clock::time_point m_startTime;
+
+    dxvk::mutex                 m_mutex;
+    dxvk::condition_variable    m_cond;
+    bool                        m_stopped = false;
+
+    dxvk::thread                m_thread;
+
+    bool initFile(
+      const std::string&              path);
+
+    void writeRecord(
+            uint64_t                  recordId);
+
+    void runExporter();
+
+  };
+
+}
@@ -1608,6 +1608,7 @@ namespace dxvk::hud {
     if (stats.frameLatency.count()) {
       m_accumStats.frameLatency += stats.frameLatency;
       m_accumStats.sleepDuration += stats.sleepDuration;
+      m_accumStats.targetLatency += stats.targetLatency;
 
       m_accumFrames += 1u;
     } else {
@@ -1630,6 +1631,14 @@ namespace dxvk::hud {
         m_latencyString = str::format(latency / 10, ".", latency % 10, " ms");
         m_sleepString = str::format(sleep / 10, ".", sleep % 10, " ms");
 
+        // Only the predictive model reports a target latency
+        if (m_accumStats.targetLatency.count()) {
+          uint32_t target = (m_accumStats.targetLatency / m_accumFrames).count() / 100u;
+          m_targetString = str::format(target / 10, ".", target % 10, " ms");
+        } else {
+          m_targetString.clear();
+        }
+
         m_accumStats = { };
         m_accumFrames = 0u;
 
@@ -1637,6 +1646,7 @@ namespace dxvk::hud {
       } else {
         m_latencyString = "--";
         m_sleepString = "--";
+        m_targetString.clear();
 
         if (m_invalidUpdates < MaxInvalidUpdates)
           m_invalidUpdates += 1u;
@@ -1666,6 +1676,13 @@ namespace dxvk::hud {
     renderer.drawText(16, position, 0xffff60a0u, "Sleep: ");
     renderer.drawText(16, { position.x + 108, position.y }, 0xffffffffu, m_sleepString);
 
+    if (!m_targetString.empty()) {
+      position.y += 20;
+
+      renderer.drawText(16, position, 0xffff60a0u, "Target: ");
+      renderer.drawText(16, { position.x + 108, position.y }, 0xffffffffu, m_targetString);
+    }
+
     position.y += 8;
     return position;
   }
@@ -768,6 +768,7 @@ namespace dxvk::hud {
 
     std::string         m_latencyString;
     std::string         m_sleepString;
+    std::string         m_targetString;
 
     dxvk::high_resolution_clock::time_point m_lastUpdate
       = dxvk::high_resolution_clock::now();
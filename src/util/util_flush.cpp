@@ -10,9 +10,13 @@ namespace dxvk {
   bool GpuFlushTracker::considerFlush(
           GpuFlushType          flushType,
           uint64_t              chunkId,
-          uint32_t              lastCompleteSubmissionId) {
+          uint32_t              lastCompleteSubmissionId,
+          high_resolution_clock::duration gpuBusyTime) {
     constexpr uint32_t minPendingSubmissions = 2;
 
+    constexpr auto minGpuBusyTime = std::chrono::microseconds(500);
+    constexpr auto maxGpuBusyTime = std::chrono::milliseconds(8);
+
     constexpr uint32_t minChunkCount =  3u;
     constexpr uint32_t maxChunkCount = 20u;
 
@@ -60,9 +64,14 @@ namespace dxvk {
         // required if the application is spinning on a query or resource.
         uint32_t pendingSubmissions = uint32_t(m_lastFlushSubmissionId - lastCompleteSubmissionId);
 
-        if (pendingSubmissions < minPendingSubmissions)
+        if (pendingSubmissions < minPendingSubmissions || gpuBusyTime < minGpuBusyTime)
           return true;
 
+        // If the GPU has plenty of work queued up, submitting more
+        // often will not improve utilization, so batch more commands.
+        if (gpuBusyTime > maxGpuBusyTime)
+          return chunkCount >= maxChunkCount;
+
         // Use the number of pending submissions to decide whether to flush. Other
         // than ignoring the minimum chunk count condition, we should treat this
         // the same as weak hints to avoid unnecessary synchronization.
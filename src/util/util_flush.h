@@ -4,6 +4,8 @@
 #include <cstdint>
 #include <vector>
 
+#include "util_time.h"
+
 namespace dxvk {
 
   /**
@@ -47,12 +49,14 @@ namespace dxvk {
      * \param [in] flushType Flush type
      * \param [in] chunkId GPU command sequence number
      * \param [in] lastCompleteSubmissionId Last completed command submission ID
+     * \param [in] gpuBusyTime Predicted time until the GPU goes idle
      * \returns \c true if a flush should be performed
      */
     bool considerFlush(
             GpuFlushType          flushType,
             uint64_t              chunkId,
-            uint32_t              lastCompleteSubmissionId);
+            uint32_t              lastCompleteSubmissionId,
+            high_resolution_clock::duration gpuBusyTime);
 
     /**
      * \brief Notifies tracker about a context flush
@@ -12,7 +12,14 @@ using namespace std::chrono_literals;
 
 namespace dxvk {
   
-  FpsLimiter::FpsLimiter() {
+  FpsLimiter::FpsLimiter()
+  : FpsLimiter(TimeSource::getSystemTimeSource()) {
+
+  }
+
+
+  FpsLimiter::FpsLimiter(TimeSource* timeSource)
+  : m_timeSource(timeSource) {
     auto override = getEnvironmentOverride();
 
     if (override) {
@@ -58,7 +65,7 @@ namespace dxvk {
       return;
     }
 
-    auto t1 = dxvk::high_resolution_clock::now();
+    auto t1 = m_timeSource->now();
 
     if (interval < TimerDuration::zero()) {
       interval = -interval;
@@ -72,7 +79,7 @@ namespace dxvk {
     lock.unlock();
 
     if (t1 < m_nextFrame)
-      Sleep::sleepUntil(t1, m_nextFrame);
+      m_timeSource->sleepUntil(t1, m_nextFrame);
 
     m_nextFrame = (t1 < m_nextFrame + interval)
       ? m_nextFrame + interval
@@ -4,6 +4,7 @@
 #include <optional>
 
 #include "thread.h"
+#include "util_sleep.h"
 #include "util_time.h"
 
 namespace dxvk {
@@ -23,6 +24,12 @@ namespace dxvk {
      */
     FpsLimiter();
 
+    /**
+     * \brief Creates frame rate limiter with custom time source
+     * \param [in] timeSource Time source to use for sleeping
+     */
+    explicit FpsLimiter(TimeSource* timeSource);
+
     ~FpsLimiter();
 
     /**
@@ -53,6 +60,8 @@ namespace dxvk {
 
     dxvk::mutex     m_mutex;
 
+    TimeSource*     m_timeSource      = nullptr;
+
     TimerDuration   m_targetInterval  = TimerDuration::zero();
     TimePoint       m_nextFrame       = TimePoint();
     uint32_t        m_maxLatency      = 0;
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+namespace dxvk {
+
+  /**
+   * \brief GPU idle time predictor
+   *
+   * Predicts when the GPU will have finished executing all
+   * submitted work, assuming that each pending submission
+   * takes as long as recently completed submissions did on
+   * average. The clock is a template parameter so that the
+   * predictor can be driven with virtual time in tests.
+   *
+   * Not thread-safe, callers must synchronize access.
+   */
+  template<typename Clock>
+  class GpuIdlePredictor {
+
+  public:
+
+    using time_point = typename Clock::time_point;
+    using duration   = typename Clock::duration;
+
+    /**
+     * \brief Notifies a new submission
+     *
+     * The submission will start executing once the GPU
+     * has finished all previously submitted work.
+     * \param [in] submitTime Time of the submission
+     */
+    void notifySubmit(time_point submitTime) {
+      m_pendingCount += 1u;
+      m_prediction = std::max(submitTime, m_prediction) + m_averageTime;
+    }
+
+    /**
+     * \brief Notifies completion of the oldest submission
+     *
+     * Submissions must complete in submission order. If the
+     * GPU was still busy with previous work at the time the
+     * submission was made, it cannot have started executing
+     * before that work completed, which is accounted for
+     * when estimating its execution time.
+     * \param [in] submitTime Time of the submission
+     * \param [in] completionTime Time of completion
+     */
+    void notifyCompletion(time_point submitTime, time_point completionTime) {
+      time_point startTime = std::max(submitTime, m_lastCompletion);
+
+      duration gpuTime = completionTime > startTime
+        ? duration(completionTime - startTime)
+        : duration(0);
+
+      m_lastCompletion = completionTime;
+      m_averageTime = (7 * m_averageTime + gpuTime) / 8;
+
+      if (m_pendingCount)
+        m_pendingCount -= 1u;
+
+      m_prediction = completionTime + m_averageTime * int64_t(m_pendingCount);
+    }
+
+    /**
+     * \brief Predicts when the GPU will go idle
+     *
+     * May be in the past if the GPU is already idle.
+     * \returns Predicted point in time when the GPU
+     *    finishes executing all submitted work
+     */
+    time_point predictIdleTime() const {
+      return m_prediction;
+    }
+
+    /**
+     * \brief Average execution time per submission
+     * \returns Moving average of GPU execution times
+     */
+    duration averageTime() const {
+      return m_averageTime;
+    }
+
+    /**
+     * \brief Number of submissions still executing
+     * \returns Pending submission count
+     */
+    uint64_t pendingCount() const {
+      return m_pendingCount;
+    }
+
+  private:
+
+    time_point  m_lastCompletion  = { };
+    time_point  m_prediction      = { };
+    duration    m_averageTime     = { };
+    uint64_t    m_pendingCount    = 0u;
+
+  };
+
+}
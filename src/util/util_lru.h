@@ -1,68 +1,123 @@
+#include <atomic>
 #include <cstdint>
-#include <list>
-#include <unordered_map>
 
 namespace dxvk {
 
+  /**
+   * \brief LRU list link
+   *
+   * Must be embedded in objects that are
+   * stored in an \ref lru_list.
+   */
   template<typename T>
+  struct lru_list_link {
+    T*                prev    = nullptr;
+    T*                next    = nullptr;
+    bool              linked  = false;
+    std::atomic<bool> used    = { false };
+  };
+
+
+  /**
+   * \brief Intrusive LRU list
+   *
+   * Objects are linked through an embedded \ref lru_list_link,
+   * so no list operation allocates memory. Objects can also be
+   * marked as used without modifying the list, which is safe to
+   * do without synchronization. Such marks are applied lazily
+   * by the owner when it walks the list, e.g. during eviction.
+   */
+  template<typename T, lru_list_link<T>& (T::*Link)()>
   class lru_list {
 
   public:
-    typedef typename std::list<T>::const_iterator const_iterator;
 
-    void insert(T value) {
-      auto cacheIter = m_cache.find(value);
-      if (cacheIter != m_cache.end())
-        m_list.erase(cacheIter->second);
+    void insert(T* value) {
+      auto& link = getLink(value);
+
+      if (link.linked)
+        unlink(value);
+
+      link.used.store(false, std::memory_order_relaxed);
+      append(value);
+    }
 
-      m_list.push_back(value);
-      auto iter = m_list.cend();
-      iter--;
-      m_cache[value] = iter;
+    void remove(T* value) {
+      if (getLink(value).linked)
+        unlink(value);
     }
 
-    void remove(const T& value) {
-      auto cacheIter = m_cache.find(value);
-      if (cacheIter == m_cache.end())
+    void touch(T* value) {
+      if (!getLink(value).linked)
         return;
 
-      m_list.erase(cacheIter->second);
-      m_cache.erase(cacheIter);
+      unlink(value);
+      append(value);
     }
 
-    const_iterator remove(const_iterator iter) {
-      auto cacheIter = m_cache.find(*iter);
-      m_cache.erase(cacheIter);
-      return m_list.erase(iter);
+    static void markUsed(T* value) {
+      getLink(value).used.store(true, std::memory_order_relaxed);
     }
 
-    void touch(const T& value) {
-      auto cacheIter = m_cache.find(value);
-      if (cacheIter == m_cache.end())
-        return;
-
-      m_list.erase(cacheIter->second);
-      m_list.push_back(value);
-      auto iter = m_list.cend();
-      --iter;
-      m_cache[value] = iter;
+    static bool checkAndClearUsed(T* value) {
+      return getLink(value).used.exchange(false, std::memory_order_relaxed);
     }
 
-    const_iterator leastRecentlyUsedIter() const {
-      return m_list.cbegin();
+    T* leastRecentlyUsed() const {
+      return m_head;
     }
 
-    const_iterator leastRecentlyUsedEndIter() const {
-      return m_list.cend();
+    static T* next(T* value) {
+      return getLink(value).next;
     }
 
     uint32_t size() const noexcept {
-      return m_list.size();
+      return m_size;
     }
 
   private:
-    std::list<T> m_list;
-    std::unordered_map<T, const_iterator> m_cache;
+
+    T*        m_head = nullptr;
+    T*        m_tail = nullptr;
+    uint32_t  m_size = 0u;
+
+    static lru_list_link<T>& getLink(T* value) {
+      return (value->*Link)();
+    }
+
+    void append(T* value) {
+      auto& link = getLink(value);
+      link.prev = m_tail;
+      link.next = nullptr;
+      link.linked = true;
+
+      if (m_tail)
+        getLink(m_tail).next = value;
+      else
+        m_head = value;
+
+      m_tail = value;
+      m_size += 1u;
+    }
+
+    void unlink(T* value) {
+      auto& link = getLink(value);
+
+      if (link.prev)
+        getLink(link.prev).next = link.next;
+      else
+        m_head = link.next;
+
+      if (link.next)
+        getLink(link.next).prev = link.prev;
+      else
+        m_tail = link.prev;
+
+      link.prev = nullptr;
+      link.next = nullptr;
+      link.linked = false;
+      m_size -= 1u;
+    }
 
   };
 
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "util_bit.h"
+#include "util_lz.h"
+
+namespace dxvk::lz {
+
+  constexpr static size_t   MinMatch    = 4u;
+  constexpr static size_t   MaxOffset   = 65535u;
+  constexpr static uint32_t HashBits    = 12u;
+
+  /* Each sequence starts with a token byte, where the upper four bits
+   * store the literal count and the lower four bits store the match
+   * length minus MinMatch. A value of 15 in either field means that
+   * additional length bytes follow, each of which adds its value and
+   * terminates the length unless it is 255. The token is followed by
+   * literal bytes, the 16-bit little-endian match offset, and the
+   * extra match length bytes, in that order. The final sequence only
+   * stores literals. */
+
+  static uint32_t read32(const uint8_t* p) {
+    uint32_t result;
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+  }
+
+
+  static uint64_t read64(const uint8_t* p) {
+    uint64_t result;
+    std::memcpy(&result, p, sizeof(result));
+    return result;
+  }
+
+
+  static uint32_t hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32u - HashBits);
+  }
+
+
+  static size_t countMatch(
+    const uint8_t*  a,
+    const uint8_t*  b,
+          size_t    maxLength) {
+    size_t length = 0u;
+
+    while (length + 8u <= maxLength) {
+      uint64_t diff = read64(a + length) ^ read64(b + length);
+
+      if (diff)
+        return length + bit::tzcnt(diff) / 8u;
+
+      length += 8u;
+    }
+
+    while (length < maxLength && a[length] == b[length])
+      length += 1u;
+
+    return length;
+  }
+
+
+  static size_t writeLength(
+          uint8_t*  dst,
+          size_t    length) {
+    size_t count = 0u;
+
+    while (length >= 255u) {
+      dst[count++] = 255u;
+      length -= 255u;
+    }
+
+    dst[count++] = uint8_t(length);
+    return count;
+  }
+
+
+  static bool readLength(
+    const uint8_t*  src,
+          size_t    srcSize,
+          size_t&   offset,
+          size_t&   length) {
+    uint8_t value;
+
+    do {
+      if (offset >= srcSize)
+        return false;
+
+      value = src[offset++];
+      length += value;
+    } while (value == 255u);
+
+    return true;
+  }
+
+
+  static bool writeSequence(
+          uint8_t*  dst,
+          size_t    dstSize,
+          size_t&   dstOffset,
+    const uint8_t*  literals,
+          size_t    literalCount,
+          size_t    matchOffset,
+          size_t    matchLength) {
+    // Conservatively estimate the encoded size up front
+    size_t maxSize = 1u + literalCount + (literalCount / 255u + 1u);
+
+    if (matchLength)
+      maxSize += 2u + ((matchLength - MinMatch) / 255u + 1u);
+
+    if (dstSize - dstOffset < maxSize)
+      return false;
+
+    size_t matchCode = matchLength ? matchLength - MinMatch : 0u;
+
+    dst[dstOffset++] = uint8_t((std::min<size_t>(literalCount, 15u) << 4)
+                              | std::min<size_t>(matchCode, 15u));
+
+    if (literalCount >= 15u)
+      dstOffset += writeLength(&dst[dstOffset], literalCount - 15u);
+
+    std::memcpy(&dst[dstOffset], literals, literalCount);
+    dstOffset += literalCount;
+
+    if (matchLength) {
+      dst[dstOffset++] = uint8_t(matchOffset);
+      dst[dstOffset++] = uint8_t(matchOffset >> 8);
+
+      if (matchCode >= 15u)
+        dstOffset += writeLength(&dst[dstOffset], matchCode - 15u);
+    }
+
+    return true;
+  }
+
+
+  size_t compress(
+          void*     dst,
+          size_t    dstSize,
+    const void*     src,
+          size_t    srcSize) {
+    auto in = reinterpret_cast<const uint8_t*>(src);
+    auto out = reinterpret_cast<uint8_t*>(dst);
+
+    std::array<uint32_t, 1u << HashBits> table = { };
+
+    size_t srcOffset = 0u;
+    size_t dstOffset = 0u;
+    size_t anchor = 0u;
+
+    while (srcOffset + MinMatch <= srcSize) {
+      uint32_t sequence = read32(&in[srcOffset]);
+      uint32_t& entry = table[hash(sequence)];
+
+      size_t candidate = entry;
+      entry = uint32_t(srcOffset);
+
+      if (candidate >= srcOffset || srcOffset - candidate > MaxOffset
+       || read32(&in[candidate]) != sequence) {
+        // Skip ahead faster in incompressible regions
+        srcOffset += 1u + ((srcOffset - anchor) >> 6u);
+        continue;
+      }
+
+      size_t matchLength = MinMatch + countMatch(
+        &in[candidate + MinMatch], &in[srcOffset + MinMatch],
+        srcSize - srcOffset - MinMatch);
+
+      if (!writeSequence(out, dstSize, dstOffset, &in[anchor],
+          srcOffset - anchor, srcOffset - candidate, matchLength))
+        return 0u;
+
+      srcOffset += matchLength;
+      anchor = srcOffset;
+    }
+
+    if (!writeSequence(out, dstSize, dstOffset, &in[anchor], srcSize - anchor, 0u, 0u))
+      return 0u;
+
+    return dstOffset;
+  }
+
+
+  bool decompress(
+          void*     dst,
+          size_t    dstSize,
+    const void*     src,
+          size_t    srcSize) {
+    auto in = reinterpret_cast<const uint8_t*>(src);
+    auto out = reinterpret_cast<uint8_t*>(dst);
+
+    size_t srcOffset = 0u;
+    size_t dstOffset = 0u;
+
+    while (srcOffset < srcSize) {
+      uint8_t token = in[srcOffset++];
+
+      size_t literalCount = token >> 4;
+
+      if (literalCount == 15u && !readLength(in, srcSize, srcOffset, literalCount))
+        return false;
+
+      if (literalCount > srcSize - srcOffset || literalCount > dstSize - dstOffset)
+        return false;
+
+      std::memcpy(&out[dstOffset], &in[srcOffset], literalCount);
+      srcOffset += literalCount;
+      dstOffset += literalCount;
+
+      // The last sequence does not have a match
+      if (srcOffset == srcSize)
+        break;
+
+      if (srcSize - srcOffset < 2u)
+        return false;
+
+      size_t matchOffset = size_t(in[srcOffset]) | (size_t(in[srcOffset + 1u]) << 8);
+      srcOffset += 2u;
+
+      size_t matchLength = (token & 0xfu) + MinMatch;
+
+      if ((token & 0xfu) == 15u && !readLength(in, srcSize, srcOffset, matchLength))
+        return false;
+
+      if (!matchOffset || matchOffset > dstOffset || matchLength > dstSize - dstOffset)
+        return false;
+
+      // Matches may overlap the data being written, in which
+      // case we can only copy up to offset bytes at a time.
+      const uint8_t* match = &out[dstOffset - matchOffset];
+
+      if (matchOffset == 1u) {
+        std::memset(&out[dstOffset], match[0], matchLength);
+        dstOffset += matchLength;
+      } else {
+        while (matchLength) {
+          size_t count = std::min(matchLength, matchOffset);
+          std::memcpy(&out[dstOffset], match, count);
+
+          match += count;
+          dstOffset += count;
+          matchLength -= count;
+        }
+      }
+    }
+
+    return dstOffset == dstSize;
+  }
+
+}
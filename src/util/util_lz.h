@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dxvk::lz {
+
+  /**
+   * \brief Compresses data
+   *
+   * Uses a simple byte-oriented LZ77 format that favours
+   * speed over compression ratio, with 64 kB matching
+   * window. Intended for data that is kept in memory.
+   * \param [out] dst Output buffer
+   * \param [in] dstSize Output buffer size
+   * \param [in] src Uncompressed data
+   * \param [in] srcSize Uncompressed data size
+   * \returns Compressed size, or 0 if the
+   *    output buffer is not large enough.
+   */
+  size_t compress(
+          void*     dst,
+          size_t    dstSize,
+    const void*     src,
+          size_t    srcSize);
+
+  /**
+   * \brief Decompresses data
+   *
+   * \param [out] dst Output buffer
+   * \param [in] dstSize Exact uncompressed size
+   * \param [in] src Compressed data
+   * \param [in] srcSize Compressed data size
+   * \returns \c true on success, \c false if the
+   *    compressed data is malformed.
+   */
+  bool decompress(
+          void*     dst,
+          size_t    dstSize,
+    const void*     src,
+          size_t    srcSize);
+
+}
@@ -0,0 +1,206 @@
+#include <utility>
+
+#ifdef _WIN32
+#include "./com/com_include.h"
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "util_mmap.h"
+
+namespace dxvk {
+
+  MappedFile::MappedFile() {
+
+  }
+
+
+  MappedFile::MappedFile(MappedFile&& other) {
+    *this = std::move(other);
+  }
+
+
+  MappedFile& MappedFile::operator = (MappedFile&& other) {
+    if (this == &other)
+      return *this;
+
+    close();
+
+#ifdef _WIN32
+    m_file    = std::exchange(other.m_file,     nullptr);
+    m_mapping = std::exchange(other.m_mapping,  nullptr);
+#else
+    m_file    = std::exchange(other.m_file,     -1);
+#endif
+    m_open    = std::exchange(other.m_open,     false);
+    m_data    = std::exchange(other.m_data,     nullptr);
+    m_size    = std::exchange(other.m_size,     0);
+    return *this;
+  }
+
+
+  MappedFile::~MappedFile() {
+    close();
+  }
+
+
+  bool MappedFile::open(
+    const str::path_string&   path,
+          bool                create) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = ::CreateFileW(path.c_str(),
+      GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+      create ? OPEN_ALWAYS : OPEN_EXISTING,
+      FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+      return false;
+
+    LARGE_INTEGER size = { };
+
+    if (!::GetFileSizeEx(file, &size)) {
+      ::CloseHandle(file);
+      return false;
+    }
+
+    m_file = file;
+    m_size = size_t(size.QuadPart);
+#else
+    int file = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT : 0), 0644);
+
+    if (file < 0)
+      return false;
+
+    struct stat st = { };
+
+    if (::fstat(file, &st)) {
+      ::close(file);
+      return false;
+    }
+
+    m_file = file;
+    m_size = size_t(st.st_size);
+#endif
+
+    m_open = true;
+
+    if (!map()) {
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+
+  void MappedFile::close() {
+    if (!m_open)
+      return;
+
+    unmap();
+
+#ifdef _WIN32
+    ::CloseHandle(m_file);
+    m_file = nullptr;
+#else
+    ::close(m_file);
+    m_file = -1;
+#endif
+
+    m_open = false;
+    m_size = 0;
+  }
+
+
+  bool MappedFile::lock() {
+    if (!m_open)
+      return false;
+
+#ifdef _WIN32
+    return true;
+#else
+    return !::flock(m_file, LOCK_EX | LOCK_NB);
+#endif
+  }
+
+
+  bool MappedFile::resize(
+          size_t              size) {
+    if (!m_open)
+      return false;
+
+    unmap();
+
+#ifdef _WIN32
+    LARGE_INTEGER offset;
+    offset.QuadPart = LONGLONG(size);
+
+    bool success = ::SetFilePointerEx(m_file, offset, nullptr, FILE_BEGIN)
+                && ::SetEndOfFile(m_file);
+#else
+    bool success = !::ftruncate(m_file, off_t(size));
+#endif
+
+    if (success)
+      m_size = size;
+
+    // Restore the mapping even if resizing failed, so
+    // that the previous file contents remain accessible
+    return map() && success;
+  }
+
+
+  bool MappedFile::map() {
+    if (!m_size)
+      return true;
+
+#ifdef _WIN32
+    m_mapping = ::CreateFileMappingW(m_file, nullptr, PAGE_READWRITE,
+      DWORD(uint64_t(m_size) >> 32), DWORD(m_size), nullptr);
+
+    if (!m_mapping)
+      return false;
+
+    m_data = ::MapViewOfFile(m_mapping, FILE_MAP_ALL_ACCESS, 0, 0, m_size);
+
+    if (!m_data) {
+      ::CloseHandle(m_mapping);
+      m_mapping = nullptr;
+      return false;
+    }
+#else
+    void* data = ::mmap(nullptr, m_size,
+      PROT_READ | PROT_WRITE, MAP_SHARED, m_file, 0);
+
+    if (data == MAP_FAILED)
+      return false;
+
+    m_data = data;
+#endif
+
+    return true;
+  }
+
+
+  void MappedFile::unmap() {
+    if (!m_data)
+      return;
+
+#ifdef _WIN32
+    ::UnmapViewOfFile(m_data);
+    ::CloseHandle(m_mapping);
+    m_mapping = nullptr;
+#else
+    ::munmap(m_data, m_size);
+#endif
+
+    m_data = nullptr;
+  }
+
+}
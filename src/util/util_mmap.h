@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "util_string.h"
+
+namespace dxvk {
+
+  /**
+   * \brief Memory-mapped file
+   *
+   * Maps an entire file into the address space of
+   * the process with read and write access. The file
+   * can be grown, which will invalidate any pointers
+   * previously retrieved via \ref data. Not thread-safe.
+   */
+  class MappedFile {
+
+  public:
+
+    MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other);
+    MappedFile& operator = (MappedFile&& other);
+
+    ~MappedFile();
+
+    /**
+     * \brief Opens and maps file
+     *
+     * Closes any previously opened file.
+     * \param [in] path File path
+     * \param [in] create Whether to create the file
+     *    if it does not exist. Existing files are
+     *    never truncated.
+     * \returns \c true on success
+     */
+    bool open(
+      const str::path_string&   path,
+            bool                create);
+
+    /**
+     * \brief Closes file
+     *
+     * Unmaps the file and closes the file handle.
+     */
+    void close();
+
+    /**
+     * \brief Locks file for exclusive access
+     *
+     * Fails if another process holds the lock. The lock is
+     * released when the file gets closed. On Windows, files
+     * are opened without write sharing, so the file is
+     * already exclusive to this process once opened.
+     * \returns \c true on success
+     */
+    bool lock();
+
+    /**
+     * \brief Changes file size
+     *
+     * Resizes the file and updates the mapping. All
+     * pointers into the old mapping become invalid.
+     * \param [in] size New file size, in bytes
+     * \returns \c true on success
+     */
+    bool resize(
+            size_t              size);
+
+    /**
+     * \brief Checks whether a file is mapped
+     * \returns \c true if the file is open
+     */
+    bool isOpen() const {
+      return m_open;
+    }
+
+    /**
+     * \brief Queries mapped pointer
+     *
+     * May be \c nullptr if the file is empty.
+     * \returns Pointer to mapped file contents
+     */
+    void* data() const {
+      return m_data;
+    }
+
+    /**
+     * \brief Queries file size
+     * \returns File size, in bytes
+     */
+    size_t size() const {
+      return m_size;
+    }
+
+  private:
+
+#ifdef _WIN32
+    void*   m_file    = nullptr;
+    void*   m_mapping = nullptr;
+#else
+    int     m_file    = -1;
+#endif
+
+    bool    m_open    = false;
+    void*   m_data    = nullptr;
+    size_t  m_size    = 0;
+
+    bool map();
+
+    void unmap();
+
+  };
+
+}
@@ -122,4 +122,52 @@ namespace dxvk {
 #endif
   }
 
+
+
+  class SystemTimeSource : public TimeSource {
+
+  public:
+
+    TimePoint now() {
+      return dxvk::high_resolution_clock::now();
+    }
+
+    TimePoint sleepUntil(TimePoint t0, TimePoint t1) {
+      return Sleep::sleepUntil(t0, t1);
+    }
+
+  };
+
+
+  TimeSource* TimeSource::getSystemTimeSource() {
+    static SystemTimeSource s_source;
+    return &s_source;
+  }
+
+
+  VirtualTimeSource::VirtualTimeSource() {
+
+  }
+
+
+  VirtualTimeSource::~VirtualTimeSource() {
+
+  }
+
+
+  VirtualTimeSource::TimePoint VirtualTimeSource::now() {
+    return m_now;
+  }
+
+
+  VirtualTimeSource::TimePoint VirtualTimeSource::sleepUntil(TimePoint t0, TimePoint t1) {
+    advance(t1);
+    return m_now;
+  }
+
+
+  void VirtualTimeSource::advance(TimePoint t) {
+    m_now = std::max(m_now, t);
+  }
+
 }
@@ -75,4 +75,82 @@ namespace dxvk {
 
   };
 
+
+  /**
+   * \brief Time source
+   *
+   * Provides the current time as well as the ability
+   * to sleep. Code that relies on timing heuristics
+   * can use this in order to be driven by a virtual
+   * clock, e.g. to replay synthetic frame timings.
+   */
+  class TimeSource {
+
+  public:
+
+    using TimePoint = Sleep::TimePoint;
+
+    virtual ~TimeSource() { }
+
+    /**
+     * \brief Queries current time
+     * \returns Current time
+     */
+    virtual TimePoint now() = 0;
+
+    /**
+     * \brief Sleeps until a given time point
+     *
+     * \param [in] t0 Current time
+     * \param [in] t1 Target time
+     * \returns Time after sleep has finished
+     */
+    virtual TimePoint sleepUntil(TimePoint t0, TimePoint t1) = 0;
+
+    /**
+     * \brief Retrieves system time source
+     *
+     * Uses the high-resolution clock and \ref Sleep.
+     * \returns Global system time source
+     */
+    static TimeSource* getSystemTimeSource();
+
+  };
+
+
+  /**
+   * \brief Virtual time source
+   *
+   * Time only advances when explicitly requested or when
+   * a sleep is performed. Derived classes can override
+   * \ref advance to process events that happen while
+   * time is passing.
+   */
+  class VirtualTimeSource : public TimeSource {
+
+  public:
+
+    VirtualTimeSource();
+
+    ~VirtualTimeSource();
+
+    TimePoint now();
+
+    TimePoint sleepUntil(TimePoint t0, TimePoint t1);
+
+    /**
+     * \brief Advances virtual time
+     *
+     * Does nothing if the given time point
+     * is not later than the current time.
+     * \param [in] t Time point to advance to
+     */
+    virtual void advance(TimePoint t);
+
+  protected:
+
+    TimePoint m_now = TimePoint();
+
+  };
+
 }
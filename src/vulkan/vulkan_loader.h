@@ -372,6 +372,11 @@ namespace dxvk::vk {
     VULKAN_FN(vkSetDebugUtilsObjectTagEXT);
     #endif
 
+    #ifdef VK_EXT_extended_dynamic_state2
+    VULKAN_FN(vkCmdSetLogicOpEXT);
+    VULKAN_FN(vkCmdSetPatchControlPointsEXT);
+    #endif
+
     #ifdef VK_EXT_extended_dynamic_state3
     VULKAN_FN(vkCmdSetTessellationDomainOriginEXT);
     VULKAN_FN(vkCmdSetDepthClampEnableEXT);
@@ -401,6 +406,11 @@ namespace dxvk::vk {
     VULKAN_FN(vkSetHdrMetadataEXT);
     #endif
 
+    #ifdef VK_EXT_host_image_copy
+    VULKAN_FN(vkCopyMemoryToImageEXT);
+    VULKAN_FN(vkTransitionImageLayoutEXT);
+    #endif
+
     #ifdef VK_EXT_pageable_device_local_memory
     VULKAN_FN(vkSetDeviceMemoryPriorityEXT);
     #endif
@@ -410,6 +420,12 @@ namespace dxvk::vk {
     VULKAN_FN(vkGetShaderModuleIdentifierEXT);
     #endif
 
+    #ifdef VK_EXT_shader_object
+    VULKAN_FN(vkCreateShadersEXT);
+    VULKAN_FN(vkDestroyShaderEXT);
+    VULKAN_FN(vkCmdBindShadersEXT);
+    #endif
+
     #ifdef VK_EXT_transform_feedback
     VULKAN_FN(vkCmdBindTransformFeedbackBuffersEXT);
     VULKAN_FN(vkCmdBeginTransformFeedbackEXT);
@@ -419,6 +435,10 @@ namespace dxvk::vk {
     VULKAN_FN(vkCmdEndQueryIndexedEXT);
     #endif
 
+    #ifdef VK_EXT_vertex_input_dynamic_state
+    VULKAN_FN(vkCmdSetVertexInputEXT);
+    #endif
+
     #ifdef VK_NVX_image_view_handle
     VULKAN_FN(vkGetImageViewHandleNVX);
     VULKAN_FN(vkGetImageViewAddressNVX);
@@ -0,0 +1,582 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "../../src/d3d9/d3d9_convert_cpu.h"
+
+using namespace dxvk;
+
+constexpr uint32_t RandomElementCount = 1u << 20;
+
+// Allowed difference between the reference and the CPU code, in
+// units of the destination component. Packing may round ties in
+// a different direction, the math is otherwise the same.
+constexpr uint32_t MaxReferenceError = 1u;
+
+struct Conversion {
+  const char*       name;
+  D3D9CpuConversion conversion;
+  /// Size of one source element, in bytes
+  uint32_t          srcSize;
+  /// Size of the converted data for one element
+  uint32_t          dstSize;
+  /// Number of pixels per source element
+  uint32_t          pixelCount;
+  /// Size of one destination component, in bytes
+  uint32_t          componentSize;
+};
+
+
+/**
+ * Reference implementation of the compute shaders in
+ * src/d3d9/shaders. Each function follows the shader
+ * code as literally as possible, including the GLSL
+ * matrix layout, and does not share any code with the
+ * CPU conversions that are being tested.
+ */
+namespace ref {
+
+  using vec3 = std::array<float, 3>;
+  using vec4 = std::array<float, 4>;
+
+  // GLSL matrices are initialized column by column
+  using mat3x3 = std::array<vec3, 3>;
+  using mat3x4 = std::array<vec4, 3>;
+
+  // d3d9_convert_common.h. Note that GLSL evaluates
+  // 298 / 256 etc. as integer divisions.
+  const mat3x4 g_yuv_to_rgb = {{
+    { 298 / 256,  0,          409 / 256, 0.5f },
+    { 298 / 256, -100 / 256, -208 / 256, 0.5f },
+    { 298 / 256,  516 / 256,  0,         0.5f },
+  }};
+
+  const mat3x3 g_bt709_to_rgb = {{
+    { 1.164f,  0,          1.793f    },
+    { 1.164f, -0.213f,    -0.533f    },
+    { 1.164f,  2.112f,     0         },
+  }};
+
+  int32_t bitfieldExtract(int32_t value, int32_t offset, int32_t bits) {
+    int64_t field = (int64_t(value) >> offset) & ((int64_t(1) << bits) - 1);
+    return int32_t(field >= (int64_t(1) << (bits - 1)) ? field - (int64_t(1) << bits) : field);
+  }
+
+  uint32_t bitfieldExtract(uint32_t value, int32_t offset, int32_t bits) {
+    return (value >> offset) & ((1u << bits) - 1u);
+  }
+
+  float unormalize(uint32_t value, int bits) {
+    const int range = (1 << bits) - 1;
+
+    return float(value) / float(range);
+  }
+
+  float snormalize(int32_t value, int bits) {
+    const int range = (1 << (bits - 1)) - 1;
+
+    return std::max(float(value) / float(range), -1.0f);
+  }
+
+  float unpackUnorm(uint32_t p) {
+    return float(p) / 255.0f;
+  }
+
+  vec4 unpackUnorm4x8(uint32_t p) {
+    return { unpackUnorm(p & 0xff), unpackUnorm((p >> 8) & 0xff),
+             unpackUnorm((p >> 16) & 0xff), unpackUnorm(p >> 24) };
+  }
+
+  float clamp(float value, float lo, float hi) {
+    return std::min(std::max(value, lo), hi);
+  }
+
+  vec4 convertYUV(vec3 yuv) {
+    vec4 v = { yuv[0], yuv[1], yuv[2], 1 / 255.0f };
+    vec4 result = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    // Row vector times matrix, i.e. one dot product per column
+    for (uint32_t c = 0; c < 3; c++) {
+      float dot = 0.0f;
+
+      for (uint32_t r = 0; r < 4; r++)
+        dot += v[r] * g_yuv_to_rgb[c][r];
+
+      result[c] = clamp(dot, 0, 1);
+    }
+
+    return result;
+  }
+
+  vec4 convertBT_709(vec3 cde) {
+    vec4 result = { 0.0f, 0.0f, 0.0f, 1.0f };
+
+    for (uint32_t c = 0; c < 3; c++) {
+      float dot = 0.0f;
+
+      for (uint32_t r = 0; r < 3; r++)
+        dot += cde[r] * g_bt709_to_rgb[c][r];
+
+      result[c] = clamp(dot, 0, 1);
+    }
+
+    return result;
+  }
+
+  // Image stores, following the Vulkan conversion rules
+  // for the destination formats used by D3D9.
+  void storeB8G8R8A8(uint8_t* dst, vec4 color) {
+    for (uint32_t c = 0; c < 4; c++) {
+      uint32_t index = c < 3 ? 2 - c : 3;
+      dst[index] = uint8_t(std::floor(clamp(color[c], 0, 1) * 255.0f + 0.5f));
+    }
+  }
+
+  uint16_t toHalf(float value) {
+    uint16_t sign = std::signbit(value) ? 0x8000u : 0u;
+    double abs = std::fabs(double(value));
+
+    // Values below the smallest normal half never occur
+    // here, except for zero, so flush those to zero.
+    if (abs < std::ldexp(1.0, -14))
+      return sign;
+
+    int exp = 0;
+    std::frexp(abs, &exp);
+
+    // frexp returns a mantissa in [0.5, 1), so the
+    // leading bit of the value is at exp - 1.
+    double mantissa = std::nearbyint(std::ldexp(abs, 11 - exp));
+
+    if (mantissa >= 2048.0) {
+      mantissa /= 2.0;
+      exp += 1;
+    }
+
+    return sign | uint16_t((exp + 14) << 10) | (uint16_t(mantissa) & 0x3ffu);
+  }
+
+  void storeR16G16B16A16Sfloat(uint8_t* dst, vec4 color) {
+    for (uint32_t c = 0; c < 4; c++) {
+      uint16_t value = toHalf(color[c]);
+      std::memcpy(dst + 2 * c, &value, sizeof(value));
+    }
+  }
+
+  void storeR16G16B16A16Snorm(uint8_t* dst, vec4 color) {
+    for (uint32_t c = 0; c < 4; c++) {
+      int16_t value = int16_t(std::nearbyint(clamp(color[c], -1, 1) * 32767.0f));
+      std::memcpy(dst + 2 * c, &value, sizeof(value));
+    }
+  }
+
+  // d3d9_convert_yuy2_uyvy.comp
+  void convertYUY2(uint8_t* dst, uint32_t value, bool s_is_uyvy) {
+    vec4 data = unpackUnorm4x8(value);
+
+    if (s_is_uyvy)
+      data = { data[1], data[0], data[3], data[2] };
+
+    float y0 = data[0] - (16   / 255.0f);
+    float u  = data[1] - (128  / 255.0f);
+    float y1 = data[2] - (16   / 255.0f);
+    float v  = data[3] - (128  / 255.0f);
+
+    storeB8G8R8A8(dst + 0, convertYUV({ y0, u, v }));
+    storeB8G8R8A8(dst + 4, convertYUV({ y1, u, v }));
+  }
+
+  // d3d9_convert_l6v5u5.comp
+  void convertL6V5U5(uint8_t* dst, uint32_t value) {
+    int32_t  u5 = bitfieldExtract(int32_t (value), 0,  5);
+    int32_t  v5 = bitfieldExtract(int32_t (value), 5,  5);
+    uint32_t l6 = bitfieldExtract(uint32_t(value), 10, 6);
+
+    storeR16G16B16A16Sfloat(dst, {
+      snormalize(u5, 5),
+      snormalize(v5, 5),
+      unormalize(l6, 6),
+      1.0f });
+  }
+
+  // d3d9_convert_x8l8v8u8.comp
+  void convertX8L8V8U8(uint8_t* dst, uint32_t value) {
+    int32_t  u8 = bitfieldExtract(int32_t (value), 0,  8);
+    int32_t  v8 = bitfieldExtract(int32_t (value), 8,  8);
+    uint32_t l8 = bitfieldExtract(uint32_t(value), 16, 8);
+
+    storeR16G16B16A16Sfloat(dst, {
+      snormalize(u8, 8),
+      snormalize(v8, 8),
+      unormalize(l8, 8),
+      1.0f });
+  }
+
+  // d3d9_convert_a2w10v10u10.comp
+  void convertA2W10V10U10(uint8_t* dst, uint32_t value) {
+    int32_t  u10 = bitfieldExtract(int32_t (value), 0,  10);
+    int32_t  v10 = bitfieldExtract(int32_t (value), 10, 10);
+    int32_t  w10 = bitfieldExtract(int32_t (value), 20, 10);
+    uint32_t a2  = bitfieldExtract(uint32_t(value), 30, 2);
+
+    storeR16G16B16A16Sfloat(dst, {
+      snormalize(u10, 10),
+      snormalize(v10, 10),
+      snormalize(w10, 10),
+      unormalize(a2,  2) });
+  }
+
+  // d3d9_convert_w11v11u10.comp
+  void convertW11V11U10(uint8_t* dst, uint32_t value) {
+    int32_t u10 = bitfieldExtract(int32_t(value), 0,  10);
+    int32_t v11 = bitfieldExtract(int32_t(value), 10, 11);
+    int32_t w11 = bitfieldExtract(int32_t(value), 21, 11);
+
+    storeR16G16B16A16Snorm(dst, {
+      snormalize(u10, 10),
+      snormalize(v11, 10),
+      snormalize(w11, 10),
+      1.0f });
+  }
+
+  void convertElement(D3D9CpuConversion conversion, uint8_t* dst, uint32_t value) {
+    switch (conversion) {
+      case D3D9CpuConversion::YUY2:         convertYUY2(dst, value, false); break;
+      case D3D9CpuConversion::UYVY:         convertYUY2(dst, value, true);  break;
+      case D3D9CpuConversion::L6V5U5:       convertL6V5U5(dst, value);      break;
+      case D3D9CpuConversion::X8L8V8U8:     convertX8L8V8U8(dst, value);    break;
+      case D3D9CpuConversion::A2W10V10U10:  convertA2W10V10U10(dst, value); break;
+      case D3D9CpuConversion::W11V11U10:    convertW11V11U10(dst, value);   break;
+      default: break;
+    }
+  }
+
+  // d3d9_convert_nv12.comp, run for every thread of the dispatch.
+  // The buffer view uses 16-bit texels, the extent is in units
+  // of two pixels.
+  void convertNV12(uint8_t* dst, const uint8_t* src, uint32_t width, uint32_t height) {
+    auto fetchUnorm2x8 = [src] (uint32_t offset) {
+      return std::array<float, 2> { unpackUnorm(src[2 * offset]), unpackUnorm(src[2 * offset + 1]) };
+    };
+
+    uint32_t pitch[2] = { width / 2, height };
+
+    for (uint32_t ty = 0; ty < pitch[1]; ty++) {
+      for (uint32_t tx = 0; tx < pitch[0]; tx++) {
+        uint32_t offset = tx + ty * pitch[0];
+
+        auto y = fetchUnorm2x8(offset);
+        y[0] -= (16 / 255.0f);
+        y[1] -= (16 / 255.0f);
+
+        offset = tx
+               + ty / 2 * pitch[0]
+               + pitch[0] * pitch[1];
+
+        auto uv = fetchUnorm2x8(offset);
+        uv[0] -= (128 / 255.0f);
+        uv[1] -= (128 / 255.0f);
+
+        vec4 color0 = convertBT_709({ y[0], uv[0], uv[1] });
+        vec4 color1 = convertBT_709({ y[1], uv[0], uv[1] });
+
+        storeB8G8R8A8(dst + 4 * (ty * width + 2 * tx + 0), color0);
+        storeB8G8R8A8(dst + 4 * (ty * width + 2 * tx + 1), color1);
+      }
+    }
+  }
+
+  // d3d9_convert_yv12.comp, with 8-bit buffer texels
+  void convertYV12(uint8_t* dst, const uint8_t* src, uint32_t width, uint32_t height) {
+    uint32_t pitch[2] = { width, height };
+
+    for (uint32_t ty = 0; ty < pitch[1]; ty++) {
+      for (uint32_t tx = 0; tx < pitch[0]; tx++) {
+        uint32_t offset = tx + ty * pitch[0];
+
+        float y = unpackUnorm(src[offset]) - (16 / 255.0f);
+
+        offset = (tx / 2)
+               + (ty / 2) * (pitch[0] / 2)
+               + pitch[0] * pitch[1];
+
+        float v = unpackUnorm(src[offset]) - (128 / 255.0f);
+
+        offset += (pitch[0] / 2) * (pitch[1] / 2);
+        float u = unpackUnorm(src[offset]) - (128 / 255.0f);
+
+        storeB8G8R8A8(dst + 4 * (ty * width + tx), convertBT_709({ y, u, v }));
+      }
+    }
+  }
+
+}
+
+
+/**
+ * Counts components that differ by more than
+ * the given tolerance between two buffers.
+ */
+static uint32_t countMismatches(
+  const std::vector<uint8_t>& a,
+  const std::vector<uint8_t>& b,
+        uint32_t              componentSize,
+        uint32_t              tolerance,
+        size_t*               first) {
+  uint32_t mismatches = 0u;
+
+  for (size_t i = 0; i < a.size(); i += componentSize) {
+    int32_t va = 0;
+    int32_t vb = 0;
+
+    if (componentSize == 2u) {
+      int16_t ha, hb;
+      std::memcpy(&ha, &a[i], sizeof(ha));
+      std::memcpy(&hb, &b[i], sizeof(hb));
+      va = ha;
+      vb = hb;
+    } else {
+      va = a[i];
+      vb = b[i];
+    }
+
+    if (uint32_t(std::abs(va - vb)) > tolerance) {
+      if (!mismatches++)
+        *first = i;
+    }
+  }
+
+  return mismatches;
+}
+
+
+static void printResult(
+  const char*                 name,
+  const char*                 path,
+  const char*                 input,
+        uint32_t              count,
+        uint32_t              mismatches) {
+  std::cout << std::left
+    << std::setw(14) << name
+    << std::setw(12) << path
+    << std::setw(12) << input
+    << std::right
+    << std::setw(10) << count
+    << std::setw(12) << mismatches
+    << std::endl;
+}
+
+
+/**
+ * Converts the given source data with both the SIMD and
+ * the scalar code paths, and compares the results with
+ * each other and with the reference. Rows are split up
+ * so that the scalar tail of the SIMD path is tested
+ * with different widths as well.
+ */
+static bool runConversion(
+  const Conversion&           conversion,
+  const std::vector<uint8_t>& src,
+        const char*           input) {
+  uint32_t elementCount = src.size() / conversion.srcSize;
+
+  std::vector<uint8_t> dstSimd(elementCount * conversion.dstSize);
+  std::vector<uint8_t> dstScalar(elementCount * conversion.dstSize);
+  std::vector<uint8_t> dstRef(elementCount * conversion.dstSize);
+
+  uint32_t offset = 0u;
+  uint32_t rowIndex = 0u;
+
+  while (offset < elementCount) {
+    uint32_t count = std::min(elementCount - offset, 1u + (rowIndex++ * 7u) % 1024u);
+
+    ConvertFormatRowCpu(conversion.conversion,
+      &dstSimd[offset * conversion.dstSize],
+      &src[offset * conversion.srcSize],
+      count * conversion.pixelCount, true);
+
+    ConvertFormatRowCpu(conversion.conversion,
+      &dstScalar[offset * conversion.dstSize],
+      &src[offset * conversion.srcSize],
+      count * conversion.pixelCount, false);
+
+    offset += count;
+  }
+
+  for (uint32_t i = 0; i < elementCount; i++) {
+    uint32_t value = 0u;
+    std::memcpy(&value, &src[i * conversion.srcSize], conversion.srcSize);
+    ref::convertElement(conversion.conversion, &dstRef[i * conversion.dstSize], value);
+  }
+
+  struct Comparison {
+    const char*                 path;
+    const std::vector<uint8_t>* a;
+    const std::vector<uint8_t>* b;
+    uint32_t                    tolerance;
+  };
+
+  std::array<Comparison, 3> comparisons = {{
+    { "simd/scalar",  &dstSimd,   &dstScalar, 0u                },
+    { "simd/ref",     &dstSimd,   &dstRef,    MaxReferenceError },
+    { "scalar/ref",   &dstScalar, &dstRef,    MaxReferenceError },
+  }};
+
+  bool success = true;
+
+  for (const auto& c : comparisons) {
+    size_t first = 0u;
+    uint32_t mismatches = countMismatches(*c.a, *c.b,
+      conversion.componentSize, c.tolerance, &first);
+
+    printResult(conversion.name, c.path, input, elementCount, mismatches);
+
+    if (mismatches) {
+      uint32_t element = first / conversion.dstSize;
+      uint32_t value = 0u;
+      std::memcpy(&value, &src[element * conversion.srcSize], conversion.srcSize);
+
+      std::cerr << "First mismatch for input 0x" << std::hex << value << std::dec << std::endl;
+      success = false;
+    }
+  }
+
+  return success;
+}
+
+
+/**
+ * Converts a planar image row by row and compares the
+ * result with the reference, which processes the whole
+ * image the way the compute shader dispatch does.
+ */
+static bool runPlanarConversion(
+  const char*                 name,
+        D3D9CpuConversion     conversion,
+        uint32_t              width,
+        uint32_t              height,
+  const std::vector<uint8_t>& random) {
+  uint32_t lumaSize = width * height;
+  std::vector<uint8_t> src(random.begin(), random.begin() + lumaSize + lumaSize / 2u);
+
+  std::vector<uint8_t> dstCpu(lumaSize * 4u);
+  std::vector<uint8_t> dstRef(lumaSize * 4u);
+
+  const uint8_t* chroma = &src[lumaSize];
+
+  for (uint32_t y = 0; y < height; y++) {
+    if (conversion == D3D9CpuConversion::NV12) {
+      ConvertPlanarRowCpu(conversion, &dstCpu[4u * width * y],
+        &src[width * y], chroma + width * (y / 2u), nullptr, width);
+    } else {
+      uint32_t chromaPitch = width / 2u;
+      uint32_t chromaSize = chromaPitch * (height / 2u);
+
+      ConvertPlanarRowCpu(conversion, &dstCpu[4u * width * y], &src[width * y],
+        chroma + chromaPitch * (y / 2u), chroma + chromaSize + chromaPitch * (y / 2u), width);
+    }
+  }
+
+  if (conversion == D3D9CpuConversion::NV12)
+    ref::convertNV12(dstRef.data(), src.data(), width, height);
+  else
+    ref::convertYV12(dstRef.data(), src.data(), width, height);
+
+  size_t first = 0u;
+  uint32_t mismatches = countMismatches(dstCpu, dstRef, 1u, MaxReferenceError, &first);
+
+  std::string input = std::to_string(width) + "x" + std::to_string(height);
+  printResult(name, "scalar/ref", input.c_str(), lumaSize, mismatches);
+
+  if (mismatches) {
+    uint32_t pixel = first / 4u;
+
+    std::cerr << "First mismatch at pixel (" << (pixel % width)
+              << "," << (pixel / width) << ")" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+
+int main(int argc, char** argv) {
+  std::vector<Conversion> conversions = {
+    { "yuy2",         D3D9CpuConversion::YUY2,        4u, 8u, 2u, 1u },
+    { "uyvy",         D3D9CpuConversion::UYVY,        4u, 8u, 2u, 1u },
+    { "l6v5u5",       D3D9CpuConversion::L6V5U5,      2u, 8u, 1u, 2u },
+    { "x8l8v8u8",     D3D9CpuConversion::X8L8V8U8,    4u, 8u, 1u, 2u },
+    { "a2w10v10u10",  D3D9CpuConversion::A2W10V10U10, 4u, 8u, 1u, 2u },
+    { "w11v11u10",    D3D9CpuConversion::W11V11U10,   4u, 8u, 1u, 2u },
+  };
+
+  std::cout << std::left
+    << std::setw(14) << "conversion"
+    << std::setw(12) << "paths"
+    << std::setw(12) << "input"
+    << std::right
+    << std::setw(10) << "elements"
+    << std::setw(12) << "mismatches"
+    << std::endl;
+
+  bool success = true;
+
+  // Simple LCG so that results are reproducible across platforms.
+  // Only the upper bits are used since the lower bits have short
+  // periods, so combine two iterations for each 32-bit value.
+  uint32_t seed = 0x12345678u;
+
+  auto random = [&seed] () {
+    uint32_t lo = (seed = seed * 1664525u + 1013904223u) >> 16u;
+    uint32_t hi = (seed = seed * 1664525u + 1013904223u) >> 16u;
+    return lo | (hi << 16u);
+  };
+
+  for (const auto& conversion : conversions) {
+    std::vector<uint8_t> src;
+
+    if (conversion.srcSize == 2u) {
+      // 16-bit formats are small enough to test every value
+      src.resize(2u << 16);
+
+      for (uint32_t i = 0; i < (1u << 16); i++) {
+        uint16_t value = uint16_t(i);
+        std::memcpy(&src[2u * i], &value, sizeof(value));
+      }
+
+      success &= runConversion(conversion, src, "exhaustive");
+    } else {
+      src.resize(conversion.srcSize * RandomElementCount);
+
+      for (uint32_t i = 0; i < RandomElementCount; i++) {
+        uint32_t value = random();
+        std::memcpy(&src[conversion.srcSize * i], &value, sizeof(value));
+      }
+
+      success &= runConversion(conversion, src, "random");
+    }
+  }
+
+  // Planar formats only support even dimensions
+  std::vector<std::pair<uint32_t, uint32_t>> extents = {
+    { 2u, 2u }, { 6u, 4u }, { 64u, 64u }, { 250u, 18u }, { 256u, 256u },
+  };
+
+  std::vector<uint8_t> planarData(256u * 256u * 3u / 2u);
+
+  for (auto& byte : planarData)
+    byte = uint8_t(random() >> 24u);
+
+  for (const auto& extent : extents) {
+    success &= runPlanarConversion("nv12", D3D9CpuConversion::NV12, extent.first, extent.second, planarData);
+    success &= runPlanarConversion("yv12", D3D9CpuConversion::YV12, extent.first, extent.second, planarData);
+  }
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,266 @@
+#include <cmath>
+
+#include "dxvk_latency_sim.h"
+
+namespace dxvk {
+
+  DxvkLatencySimulator::DxvkLatencySimulator(
+    const DxvkLatencySimConfig&     config)
+  : m_config(config) {
+
+  }
+
+
+  DxvkLatencySimulator::~DxvkLatencySimulator() {
+
+  }
+
+
+  void DxvkLatencySimulator::advance(TimePoint t) {
+    while (!m_events.empty() && m_events.top().time <= t) {
+      Event event = m_events.top();
+      m_events.pop();
+
+      m_now = std::max(m_now, event.time);
+      deliverEvent(event);
+    }
+
+    m_now = std::max(m_now, t);
+  }
+
+
+  DxvkLatencySimStats DxvkLatencySimulator::run(
+    const Rc<DxvkLatencyTracker>&   tracker,
+          FpsLimiter*               limiter,
+          size_t                    frameCount,
+    const DxvkLatencySimFrame*      frames) {
+    m_tracker = tracker;
+
+    // Latency trackers use a default-initialized
+    // time point to mark timestamps as invalid
+    m_start = TimePoint() + std::chrono::seconds(1);
+    m_now = m_start;
+
+    m_csFree = m_start;
+    m_gpuFree = m_start;
+    m_lastVsync = m_start;
+
+    m_lastQueuedFrame = 0u;
+    m_lastCompleteFrame = 0u;
+
+    m_frames.clear();
+    m_frames.resize(frameCount);
+
+    for (size_t i = 0; i < frameCount; i++) {
+      uint64_t frameId = i + 1u;
+
+      waitForFrameData(frameId);
+      m_tracker->sleepAndBeginFrame(frameId, m_config.maxFrameRate);
+
+      m_frames[i].frameStart = m_now;
+      scheduleFrame(frameId, frames[i]);
+
+      advance(m_now + frames[i].cpuTime);
+      m_tracker->notifyCpuPresentBegin(frameId);
+
+      // Present blocks until the swap chain has
+      // processed enough of the previous frames
+      if (frameId > m_config.maxFrameLatency)
+        advance(m_frames[frameId - m_config.maxFrameLatency - 1u].presentEnd);
+
+      m_tracker->notifyCpuPresentEnd(frameId);
+
+      if (limiter)
+        limiter->delay();
+    }
+
+    // Process remaining GPU work and presents
+    while (!m_events.empty())
+      advance(m_events.top().time);
+
+    m_tracker = nullptr;
+    return computeStats();
+  }
+
+
+  void DxvkLatencySimulator::scheduleFrame(
+          uint64_t                  frameId,
+    const DxvkLatencySimFrame&      frame) {
+    // The CS thread runs in parallel to the application, but
+    // can only submit the frame once Present has been called.
+    TimePoint presentBegin = m_now + frame.cpuTime;
+
+    TimePoint csStart = std::max(m_now, m_csFree);
+    TimePoint csEnd = std::max(csStart + frame.csTime, presentBegin);
+
+    TimePoint gpuStart = std::max(csEnd, m_gpuFree);
+    TimePoint gpuEnd = gpuStart + frame.gpuTime;
+
+    TimePoint presentEnd = computePresentTime(gpuEnd);
+
+    m_csFree = csEnd;
+    m_gpuFree = gpuEnd;
+
+    m_frames[frameId - 1u].presentEnd = presentEnd;
+
+    pushEvent(csStart,    frameId, EventType::CsRenderBegin);
+    pushEvent(csEnd,      frameId, EventType::QueueSubmit);
+    pushEvent(csEnd,      frameId, EventType::CsRenderEnd);
+    pushEvent(csEnd,      frameId, EventType::QueuePresentBegin);
+    pushEvent(csEnd,      frameId, EventType::QueuePresentEnd);
+    pushEvent(gpuStart,   frameId, EventType::GpuExecutionBegin);
+    pushEvent(gpuEnd,     frameId, EventType::GpuExecutionEnd);
+    pushEvent(presentEnd, frameId, EventType::GpuPresentEnd);
+  }
+
+
+  void DxvkLatencySimulator::pushEvent(
+          TimePoint                 time,
+          uint64_t                  frameId,
+          EventType                 type) {
+    Event event;
+    event.time = time;
+    event.seq = ++m_eventSeq;
+    event.frameId = frameId;
+    event.type = type;
+
+    m_events.push(event);
+  }
+
+
+  void DxvkLatencySimulator::deliverEvent(
+    const Event&                    event) {
+    switch (event.type) {
+      case EventType::CsRenderBegin:
+        m_tracker->notifyCsRenderBegin(event.frameId);
+        break;
+
+      case EventType::QueueSubmit:
+        m_tracker->notifyQueueSubmit(event.frameId);
+        break;
+
+      case EventType::CsRenderEnd:
+        m_tracker->notifyCsRenderEnd(event.frameId);
+        break;
+
+      case EventType::QueuePresentBegin:
+        m_tracker->notifyQueuePresentBegin(event.frameId);
+        break;
+
+      case EventType::QueuePresentEnd:
+        m_tracker->notifyQueuePresentEnd(event.frameId, VK_SUCCESS);
+        m_lastQueuedFrame = event.frameId;
+        break;
+
+      case EventType::GpuExecutionBegin:
+        m_tracker->notifyGpuExecutionBegin(event.frameId);
+        break;
+
+      case EventType::GpuExecutionEnd:
+        m_tracker->notifyGpuExecutionEnd(event.frameId);
+        break;
+
+      case EventType::GpuPresentEnd:
+        m_tracker->notifyGpuPresentEnd(event.frameId);
+        m_lastCompleteFrame = event.frameId;
+        break;
+    }
+  }
+
+
+  void DxvkLatencySimulator::waitForFrameData(
+          uint64_t                  frameId) {
+    // Latency trackers may block until the previous frame has been
+    // queued for presentation and all older frames have completed.
+    // Process events until that is the case so that we don't end
+    // up waiting for notifications that would never arrive.
+    while (!m_events.empty()) {
+      if (m_lastQueuedFrame + 1u >= frameId
+       && m_lastCompleteFrame + 2u >= frameId)
+        break;
+
+      advance(m_events.top().time);
+    }
+  }
+
+
+  DxvkLatencySimulator::TimePoint DxvkLatencySimulator::computePresentTime(
+          TimePoint                 gpuEnd) {
+    if (m_config.refreshRate <= 0.0)
+      return gpuEnd;
+
+    // Assume FIFO presentation, i.e. at most one
+    // frame can be displayed per refresh cycle
+    auto interval = std::chrono::nanoseconds(
+      uint64_t(1'000'000'000.0 / m_config.refreshRate));
+
+    auto cycles = (gpuEnd - m_start + interval - std::chrono::nanoseconds(1)) / interval;
+    TimePoint vsync = m_start + cycles * interval;
+
+    if (vsync <= m_lastVsync)
+      vsync = m_lastVsync + interval;
+
+    m_lastVsync = vsync;
+    return vsync;
+  }
+
+
+  DxvkLatencySimStats DxvkLatencySimulator::computeStats() const {
+    DxvkLatencySimStats stats = { };
+
+    if (m_frames.empty())
+      return stats;
+
+    double targetInterval = 0.0;
+
+    if (m_config.refreshRate > 0.0)
+      targetInterval = 1'000'000.0 / m_config.refreshRate;
+    else if (m_config.maxFrameRate > 0.0)
+      targetInterval = 1'000'000.0 / m_config.maxFrameRate;
+
+    double latencySum = 0.0;
+    double latencyMax = 0.0;
+
+    double intervalSum = 0.0;
+    double intervalSqSum = 0.0;
+
+    for (size_t i = 0; i < m_frames.size(); i++) {
+      const auto& frame = m_frames[i];
+
+      double latency = std::chrono::duration<double, std::micro>(
+        frame.presentEnd - frame.frameStart).count();
+
+      latencySum += latency;
+      latencyMax = std::max(latencyMax, latency);
+
+      if (i) {
+        double interval = std::chrono::duration<double, std::micro>(
+          frame.presentEnd - m_frames[i - 1u].presentEnd).count();
+
+        intervalSum += interval;
+        intervalSqSum += interval * interval;
+
+        if (targetInterval > 0.0 && interval > 1.5 * targetInterval)
+          stats.missedDeadlines += 1u;
+      }
+    }
+
+    double frameCount = double(m_frames.size());
+    double intervalCount = double(m_frames.size() - 1u);
+
+    stats.frameCount = uint32_t(m_frames.size());
+    stats.avgLatency = std::chrono::microseconds(int64_t(latencySum / frameCount));
+    stats.maxLatency = std::chrono::microseconds(int64_t(latencyMax));
+
+    if (intervalCount > 0.0) {
+      double avg = intervalSum / intervalCount;
+      double var = std::max(0.0, intervalSqSum / intervalCount - avg * avg);
+
+      stats.avgFrameTime = std::chrono::microseconds(int64_t(avg));
+      stats.frameTimeStdDev = std::chrono::microseconds(int64_t(std::sqrt(var)));
+    }
+
+    return stats;
+  }
+
+}
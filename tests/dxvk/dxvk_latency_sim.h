@@ -0,0 +1,183 @@
+#pragma once
+
+#include <queue>
+#include <vector>
+
+#include "../../src/dxvk/dxvk_latency.h"
+
+#include "../../src/util/util_fps_limiter.h"
+#include "../../src/util/util_sleep.h"
+
+namespace dxvk {
+
+  /**
+   * \brief Synthetic timings for a single frame
+   *
+   * All durations are measured on the respective timeline
+   * and do not include any time spent waiting.
+   */
+  struct DxvkLatencySimFrame {
+    /// Time the application spends on the CPU
+    /// between frame start and calling Present.
+    std::chrono::nanoseconds cpuTime;
+    /// Time the CS thread spends recording
+    /// and submitting commands for the frame.
+    std::chrono::nanoseconds csTime;
+    /// Time the GPU spends executing the frame
+    std::chrono::nanoseconds gpuTime;
+  };
+
+
+  /**
+   * \brief Simulation parameters
+   */
+  struct DxvkLatencySimConfig {
+    /// Display refresh rate. If zero, presentation
+    /// completes as soon as GPU execution ends.
+    double    refreshRate     = 0.0;
+    /// Frame rate passed to the latency tracker
+    double    maxFrameRate    = 0.0;
+    /// Maximum number of frames that can be queued
+    /// for presentation before Present blocks.
+    uint32_t  maxFrameLatency = 1u;
+  };
+
+
+  /**
+   * \brief Simulation results
+   */
+  struct DxvkLatencySimStats {
+    /// Number of frames that completed presentation
+    uint32_t                  frameCount      = 0u;
+    /// Average and maximum time between frame start
+    /// and the frame being displayed
+    std::chrono::microseconds avgLatency      = { };
+    std::chrono::microseconds maxLatency      = { };
+    /// Average and standard deviation of the
+    /// interval between presented frames
+    std::chrono::microseconds avgFrameTime    = { };
+    std::chrono::microseconds frameTimeStdDev = { };
+    /// Number of frames that were displayed at least
+    /// one refresh interval later than intended
+    uint32_t                  missedDeadlines = 0u;
+  };
+
+
+  /**
+   * \brief Latency simulator
+   *
+   * Deterministically replays synthetic frame timings
+   * through the notification hooks of a latency tracker
+   * using a virtual clock, which allows evaluating latency
+   * heuristics without a display or GPU. The application,
+   * CS thread, GPU and display are modeled as in-order
+   * timelines, and any blocking waits inside the latency
+   * tracker are resolved by processing pending events
+   * before the tracker is invoked.
+   *
+   * Latency trackers and frame rate limiters used with
+   * the simulator must use it as their time source, and
+   * must not rely on a presenter.
+   */
+  class DxvkLatencySimulator : public VirtualTimeSource {
+
+  public:
+
+    DxvkLatencySimulator(
+      const DxvkLatencySimConfig&     config);
+
+    ~DxvkLatencySimulator();
+
+    /**
+     * \brief Advances virtual time
+     *
+     * Delivers all events that happen up to
+     * the given time to the latency tracker.
+     * \param [in] t Time point to advance to
+     */
+    void advance(TimePoint t);
+
+    /**
+     * \brief Runs simulation
+     *
+     * \param [in] tracker Latency tracker to evaluate
+     * \param [in] limiter Optional frame rate limiter,
+     *    invoked after the application calls Present.
+     * \param [in] frameCount Number of frames in the trace
+     * \param [in] frames Per-frame timings
+     * \returns Latency and frame pacing statistics
+     */
+    DxvkLatencySimStats run(
+      const Rc<DxvkLatencyTracker>&   tracker,
+            FpsLimiter*               limiter,
+            size_t                    frameCount,
+      const DxvkLatencySimFrame*      frames);
+
+  private:
+
+    enum class EventType : uint32_t {
+      CsRenderBegin,
+      QueueSubmit,
+      CsRenderEnd,
+      QueuePresentBegin,
+      QueuePresentEnd,
+      GpuExecutionBegin,
+      GpuExecutionEnd,
+      GpuPresentEnd,
+    };
+
+    struct Event {
+      TimePoint time;
+      uint64_t  seq;
+      uint64_t  frameId;
+      EventType type;
+
+      bool operator < (const Event& other) const {
+        return time > other.time || (time == other.time && seq > other.seq);
+      }
+    };
+
+    struct FrameTimes {
+      TimePoint frameStart;
+      TimePoint presentEnd;
+    };
+
+    DxvkLatencySimConfig        m_config;
+    Rc<DxvkLatencyTracker>      m_tracker;
+
+    std::priority_queue<Event>  m_events;
+    uint64_t                    m_eventSeq = 0u;
+
+    std::vector<FrameTimes>     m_frames;
+
+    uint64_t                    m_lastQueuedFrame   = 0u;
+    uint64_t                    m_lastCompleteFrame = 0u;
+
+    TimePoint                   m_start     = TimePoint();
+    TimePoint                   m_csFree    = TimePoint();
+    TimePoint                   m_gpuFree   = TimePoint();
+    TimePoint                   m_lastVsync = TimePoint();
+
+    void scheduleFrame(
+            uint64_t                  frameId,
+      const DxvkLatencySimFrame&      frame);
+
+    void pushEvent(
+            TimePoint                 time,
+            uint64_t                  frameId,
+            EventType                 type);
+
+    void deliverEvent(
+      const Event&                    event);
+
+    void waitForFrameData(
+            uint64_t                  frameId);
+
+    TimePoint computePresentTime(
+            TimePoint                 gpuEnd);
+
+    DxvkLatencySimStats computeStats() const;
+
+  };
+
+}
@@ -0,0 +1,244 @@
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../../src/dxvk/dxvk_latency_builtin.h"
+#include "../../src/util/log/log.h"
+
+#include "dxvk_latency_sim.h"
+
+namespace dxvk {
+  Logger Logger::s_instance("test_latency_sim.log");
+}
+
+using namespace dxvk;
+
+using ms = std::chrono::milliseconds;
+using us = std::chrono::microseconds;
+
+constexpr size_t FrameCount = 600;
+
+/// Frame times may exceed the achievable frame
+/// interval by this factor on average
+constexpr double MaxFrameTimeFactor = 1.25;
+
+/// Frame rate limits only align frames to the given interval
+/// rather than enforcing it, so allow frames to be slightly faster
+constexpr double MinFrameRateFactor = 0.9;
+
+/// Maximum frame time deviation for steady workloads
+/// that are not quantized by the refresh rate
+constexpr us MaxSteadyFrameTimeDev = us(1000);
+
+struct Workload {
+  const char*                       name;
+  /// Whether all frames have the same timings
+  bool                              steady;
+  std::vector<DxvkLatencySimFrame>  frames;
+};
+
+struct Strategy {
+  const char* name;
+  bool        predictive;
+  double      fpsLimit;
+};
+
+struct Display {
+  const char* name;
+  double      refreshRate;
+  uint32_t    maxFrameLatency;
+};
+
+
+static DxvkLatencySimFrame makeFrame(us cpu, us cs, us gpu) {
+  DxvkLatencySimFrame frame;
+  frame.cpuTime = cpu;
+  frame.csTime  = cs;
+  frame.gpuTime = gpu;
+  return frame;
+}
+
+
+static std::vector<Workload> createWorkloads() {
+  std::vector<Workload> workloads;
+
+  Workload gpuBound = { "gpu-bound",  true  };
+  Workload cpuBound = { "cpu-bound",  true  };
+  Workload spikes   = { "gpu-spikes", false };
+  Workload variable = { "variable",   false };
+
+  // Simple LCG so that results are reproducible across platforms
+  uint32_t seed = 0x12345678u;
+
+  auto random = [&seed] (uint32_t lo, uint32_t hi) {
+    seed = seed * 1664525u + 1013904223u;
+    return us(lo + (seed >> 8) % (hi - lo + 1u));
+  };
+
+  for (size_t i = 0; i < FrameCount; i++) {
+    gpuBound.frames.push_back(makeFrame(ms(4), ms(3), ms(12)));
+    cpuBound.frames.push_back(makeFrame(ms(12), ms(4), ms(6)));
+    spikes.frames.push_back(makeFrame(ms(5), ms(3), (i % 10u) ? ms(8) : ms(25)));
+    variable.frames.push_back(makeFrame(random(5000, 10000), random(2000, 4000), random(6000, 14000)));
+  }
+
+  workloads.push_back(std::move(gpuBound));
+  workloads.push_back(std::move(cpuBound));
+  workloads.push_back(std::move(spikes));
+  workloads.push_back(std::move(variable));
+  return workloads;
+}
+
+
+static us computeInterval(double rate) {
+  return rate > 0.0 ? us(int64_t(1'000'000.0 / rate)) : us(0);
+}
+
+
+static bool runWorkload(
+  const Workload&   workload,
+  const Strategy&   strategy,
+  const Display&    display) {
+  DxvkLatencySimConfig config;
+  config.refreshRate = display.refreshRate;
+  config.maxFrameRate = strategy.fpsLimit;
+  config.maxFrameLatency = display.maxFrameLatency;
+
+  DxvkLatencySimulator sim(config);
+
+  Rc<DxvkLatencyTracker> tracker = new DxvkBuiltInLatencyTracker(
+    Rc<Presenter>(), 1000, false, strategy.predictive, &sim);
+
+  DxvkLatencySimStats stats = sim.run(tracker, nullptr,
+    workload.frames.size(), workload.frames.data());
+
+  std::cout << std::left
+    << std::setw(12) << workload.name
+    << std::setw(20) << strategy.name
+    << std::setw(12) << display.name
+    << std::right
+    << std::setw(10) << stats.avgLatency.count()
+    << std::setw(10) << stats.maxLatency.count()
+    << std::setw(10) << stats.avgFrameTime.count()
+    << std::setw(10) << stats.frameTimeStdDev.count()
+    << std::setw(8)  << stats.missedDeadlines
+    << std::endl;
+
+  if (stats.frameCount != workload.frames.size()) {
+    std::cerr << "Simulation did not complete all frames" << std::endl;
+    return false;
+  }
+
+  // Input-to-present latency can never be lower than the time it takes
+  // to run the frame on the CPU and GPU back to back. With latency control,
+  // frames should not be queued up for more than half a frame interval in
+  // addition to that, plus the wait for the next vblank.
+  us frameWork = us(0);
+  us bottleneck = us(0);
+  us minGpuTime = us(0);
+
+  for (size_t i = 0; i < workload.frames.size(); i++) {
+    const auto& frame = workload.frames[i];
+
+    frameWork += std::chrono::duration_cast<us>(frame.cpuTime + frame.gpuTime);
+    bottleneck += std::chrono::duration_cast<us>(std::max({ frame.cpuTime, frame.csTime, frame.gpuTime }));
+
+    // Frame times are measured between presents, so
+    // the first frame's GPU time is not included
+    if (i)
+      minGpuTime += std::chrono::duration_cast<us>(frame.gpuTime);
+  }
+
+  frameWork /= workload.frames.size();
+  bottleneck /= workload.frames.size();
+  minGpuTime /= workload.frames.size() - 1u;
+
+  us refreshInterval = computeInterval(display.refreshRate);
+  us limitInterval = computeInterval(strategy.fpsLimit);
+
+  // Frames can only be presented at most once per refresh cycle
+  us frameInterval = std::max(bottleneck, limitInterval);
+
+  if (refreshInterval.count())
+    frameInterval = refreshInterval * ((frameInterval + refreshInterval - us(1)) / refreshInterval);
+
+  bool success = true;
+
+  auto expect = [&] (bool condition, const char* what) {
+    if (!condition) {
+      std::cerr << workload.name << "/" << strategy.name << "/" << display.name << ": " << what << std::endl;
+      success = false;
+    }
+  };
+
+  expect(stats.avgLatency >= frameWork,
+    "Latency lower than CPU and GPU time");
+  expect(stats.avgLatency <= frameWork + frameInterval / 2 + refreshInterval,
+    "Latency exceeds half a frame interval");
+
+  // Frame pacing. The GPU and display bound the frame rate, and frames
+  // should neither be held back much further nor exceed the frame limit.
+  expect(stats.avgFrameTime >= std::max(minGpuTime, refreshInterval) - us(1),
+    "Frame time lower than GPU or display allow");
+  expect(double(stats.avgFrameTime.count()) >= MinFrameRateFactor * double(limitInterval.count()),
+    "Frame time lower than frame rate limit");
+  expect(double(stats.avgFrameTime.count()) <= MaxFrameTimeFactor * double(frameInterval.count()),
+    "Frame time exceeds achievable frame interval");
+
+  if (workload.steady) {
+    // If frames fit into the refresh interval, none should be late, and the
+    // frame time should be stable unless the frame interval is not a multiple
+    // of the refresh interval. Allow for some jitter while the tracker warms up.
+    us deadline = refreshInterval.count() ? refreshInterval : limitInterval;
+
+    if (deadline.count() && bottleneck <= deadline)
+      expect(stats.missedDeadlines <= stats.frameCount / 100u, "Steady workload misses deadlines");
+
+    expect(stats.frameTimeStdDev <= std::max(MaxSteadyFrameTimeDev, refreshInterval),
+      "Steady workload has unstable frame times");
+  }
+
+  return success;
+}
+
+
+int main(int argc, char** argv) {
+  std::vector<Workload> workloads = createWorkloads();
+
+  std::vector<Strategy> strategies = {
+    { "builtin",          false,  0.0 },
+    { "predictive",       true,   0.0 },
+    { "builtin-60fps",    false, 60.0 },
+    { "predictive-60fps", true,  60.0 },
+  };
+
+  std::vector<Display> displays = {
+    { "immediate",  0.0, 1u },
+    { "fifo-60hz", 60.0, 1u },
+    { "fifo-144hz", 144.0, 2u },
+  };
+
+  std::cout << std::left
+    << std::setw(12) << "workload"
+    << std::setw(20) << "strategy"
+    << std::setw(12) << "display"
+    << std::right
+    << std::setw(10) << "avg(us)"
+    << std::setw(10) << "max(us)"
+    << std::setw(10) << "frame(us)"
+    << std::setw(10) << "dev(us)"
+    << std::setw(8)  << "missed"
+    << std::endl;
+
+  bool success = true;
+
+  for (const auto& workload : workloads) {
+    for (const auto& strategy : strategies) {
+      for (const auto& display : displays)
+        success &= runWorkload(workload, strategy, display);
+    }
+  }
+
+  return success ? 0 : 1;
+}
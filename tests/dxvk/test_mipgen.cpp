@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+#include "../../src/dxvk/dxvk_adapter.h"
+#include "../../src/dxvk/dxvk_context.h"
+#include "../../src/dxvk/dxvk_device.h"
+#include "../../src/dxvk/dxvk_instance.h"
+#include "../../src/util/log/log.h"
+
+namespace dxvk {
+  Logger Logger::s_instance("test_mipgen.log");
+}
+
+using namespace dxvk;
+
+// Exit code that tells meson to mark the test as skipped
+constexpr int SkipTest = 77;
+
+constexpr VkFormat Format     = VK_FORMAT_R8G8B8A8_UNORM;
+constexpr uint32_t Size       = 512u;
+constexpr uint32_t MipCount   = 10u;
+constexpr uint32_t LayerCount = 3u;
+
+// The compute path keeps intermediate levels at full precision in
+// shared memory, while the render pass path reads back the rounded
+// previous level, so allow for some accumulated rounding error.
+constexpr uint32_t MaxError     = 3u;
+constexpr double   MaxMeanError = 1.0;
+
+
+static Rc<DxvkImage> createImage(
+  const Rc<DxvkDevice>&       device,
+        VkImageUsageFlags     usage,
+  const char*                 name) {
+  DxvkImageCreateInfo info;
+  info.type         = VK_IMAGE_TYPE_2D;
+  info.format       = Format;
+  info.sampleCount  = VK_SAMPLE_COUNT_1_BIT;
+  info.extent       = { Size, Size, 1u };
+  info.numLayers    = LayerCount;
+  info.mipLevels    = MipCount;
+  info.usage        = VK_IMAGE_USAGE_SAMPLED_BIT
+                    | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+                    | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+                    | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+                    | usage;
+  info.stages       = VK_PIPELINE_STAGE_TRANSFER_BIT
+                    | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT
+                    | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
+                    | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  info.access       = VK_ACCESS_TRANSFER_READ_BIT
+                    | VK_ACCESS_TRANSFER_WRITE_BIT
+                    | VK_ACCESS_SHADER_READ_BIT
+                    | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT
+                    | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+  info.tiling       = VK_IMAGE_TILING_OPTIMAL;
+  info.layout       = VK_IMAGE_LAYOUT_GENERAL;
+  info.debugName    = name;
+
+  if (usage & VK_IMAGE_USAGE_STORAGE_BIT)
+    info.access |= VK_ACCESS_SHADER_WRITE_BIT;
+
+  return device->createImage(info, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
+
+static Rc<DxvkBuffer> createBuffer(
+  const Rc<DxvkDevice>&       device,
+        VkDeviceSize          size,
+        VkBufferUsageFlags    usage) {
+  DxvkBufferCreateInfo info;
+  info.size   = size;
+  info.usage  = usage;
+  info.stages = VK_PIPELINE_STAGE_TRANSFER_BIT;
+  info.access = VK_ACCESS_TRANSFER_READ_BIT
+              | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+  return device->createBuffer(info,
+    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+    VK_MEMORY_PROPERTY_HOST_COHERENT_BIT |
+    VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+}
+
+
+static VkDeviceSize getLevelSize(uint32_t level) {
+  uint32_t extent = std::max(Size >> level, 1u);
+  return VkDeviceSize(extent) * extent * LayerCount * 4u;
+}
+
+
+static void generateMips(
+  const Rc<DxvkContext>&      ctx,
+  const Rc<DxvkImage>&        image,
+  const Rc<DxvkBuffer>&       srcBuffer,
+  const Rc<DxvkBuffer>&       dstBuffer) {
+  VkImageSubresourceRange subresources = { };
+  subresources.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  subresources.levelCount = MipCount;
+  subresources.layerCount = LayerCount;
+
+  ctx->initImage(image, subresources, VK_IMAGE_LAYOUT_UNDEFINED);
+
+  ctx->copyBufferToImage(image,
+    { VK_IMAGE_ASPECT_COLOR_BIT, 0u, 0u, LayerCount },
+    VkOffset3D { 0, 0, 0 }, VkExtent3D { Size, Size, 1u },
+    srcBuffer, 0u, 0u, 0u, Format);
+
+  DxvkImageViewKey viewKey;
+  viewKey.viewType    = VK_IMAGE_VIEW_TYPE_2D_ARRAY;
+  viewKey.usage       = VK_IMAGE_USAGE_SAMPLED_BIT;
+  viewKey.format      = Format;
+  viewKey.aspects     = VK_IMAGE_ASPECT_COLOR_BIT;
+  viewKey.mipIndex    = 0u;
+  viewKey.mipCount    = MipCount;
+  viewKey.layerIndex  = 0u;
+  viewKey.layerCount  = LayerCount;
+
+  ctx->generateMipmaps(image->createView(viewKey), VK_FILTER_LINEAR);
+
+  VkDeviceSize offset = 0u;
+
+  for (uint32_t i = 1; i < MipCount; i++) {
+    uint32_t extent = std::max(Size >> i, 1u);
+
+    ctx->copyImageToBuffer(dstBuffer, offset, 0u, 0u, Format, image,
+      { VK_IMAGE_ASPECT_COLOR_BIT, i, 0u, LayerCount },
+      VkOffset3D { 0, 0, 0 }, VkExtent3D { extent, extent, 1u });
+
+    offset += getLevelSize(i);
+  }
+}
+
+
+int main() {
+  Rc<DxvkInstance> instance;
+  Rc<DxvkAdapter> adapter;
+  Rc<DxvkDevice> device;
+
+  try {
+    instance = new DxvkInstance(DxvkInstanceFlags());
+    adapter = instance->enumAdapters(0);
+
+    if (adapter != nullptr)
+      device = adapter->createDevice(instance, DxvkDeviceFeatures());
+  } catch (const DxvkError& e) {
+    std::cerr << e.message() << std::endl;
+  }
+
+  if (device == nullptr) {
+    std::cout << "No Vulkan device available, skipping" << std::endl;
+    return SkipTest;
+  }
+
+  constexpr VkFormatFeatureFlags2 features = VK_FORMAT_FEATURE_2_STORAGE_IMAGE_BIT
+    | VK_FORMAT_FEATURE_2_STORAGE_READ_WITHOUT_FORMAT_BIT
+    | VK_FORMAT_FEATURE_2_STORAGE_WRITE_WITHOUT_FORMAT_BIT;
+
+  if ((device->getFormatFeatures(Format).optimal & features) != features) {
+    std::cout << "Format does not support storage without format, skipping" << std::endl;
+    return SkipTest;
+  }
+
+  // The compute path is only used for images that are already
+  // storage images, everything else uses one render pass per
+  // level, so the same context call exercises both paths here.
+  Rc<DxvkImage> csImage = createImage(device, VK_IMAGE_USAGE_STORAGE_BIT, "Mip gen (compute)");
+  Rc<DxvkImage> fbImage = createImage(device, 0u, "Mip gen (render pass)");
+
+  VkDeviceSize srcSize = getLevelSize(0);
+  VkDeviceSize dstSize = 0u;
+
+  for (uint32_t i = 1; i < MipCount; i++)
+    dstSize += getLevelSize(i);
+
+  Rc<DxvkBuffer> srcBuffer = createBuffer(device, srcSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+  Rc<DxvkBuffer> csBuffer = createBuffer(device, dstSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+  Rc<DxvkBuffer> fbBuffer = createBuffer(device, dstSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT);
+
+  std::mt19937 rng(0x6d697067u);
+  auto src = reinterpret_cast<uint8_t*>(srcBuffer->mapPtr(0));
+
+  for (VkDeviceSize i = 0; i < srcSize; i++)
+    src[i] = uint8_t(rng());
+
+  Rc<DxvkContext> ctx = device->createContext();
+  ctx->beginRecording(device->createCommandList());
+
+  generateMips(ctx, csImage, srcBuffer, csBuffer);
+  generateMips(ctx, fbImage, srcBuffer, fbBuffer);
+
+  ctx->flushCommandList(nullptr);
+  device->waitForIdle();
+
+  auto csData = reinterpret_cast<const uint8_t*>(csBuffer->mapPtr(0));
+  auto fbData = reinterpret_cast<const uint8_t*>(fbBuffer->mapPtr(0));
+
+  bool success = true;
+  VkDeviceSize offset = 0u;
+
+  for (uint32_t i = 1; i < MipCount; i++) {
+    VkDeviceSize size = getLevelSize(i);
+
+    uint32_t maxError = 0u;
+    uint64_t sumError = 0u;
+
+    for (VkDeviceSize j = 0; j < size; j++) {
+      uint32_t error = std::abs(int32_t(csData[offset + j]) - int32_t(fbData[offset + j]));
+      maxError = std::max(maxError, error);
+      sumError += error;
+    }
+
+    double meanError = double(sumError) / double(size);
+
+    std::cout << "Level " << i << ": max error " << maxError
+              << ", mean error " << meanError << std::endl;
+
+    if (maxError > MaxError || meanError > MaxMeanError) {
+      std::cerr << "Level " << i << ": compute and render pass results differ" << std::endl;
+      success = false;
+    }
+
+    offset += size;
+  }
+
+  return success ? 0 : 1;
+}
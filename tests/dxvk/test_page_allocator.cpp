@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "../../src/dxvk/dxvk_allocator.h"
+#include "../../src/util/util_error.h"
+
+using namespace dxvk;
+
+constexpr uint32_t MaxPageCount  = DxvkPageAllocator::ChunkPageMask + 1u;
+constexpr uint32_t MaxChunkCount = 6u;
+constexpr uint32_t Iterations    = 50000u;
+
+/**
+ * Reference model for the page allocator. Tracks one flag per
+ * page and answers the same questions the allocator does by
+ * brute force, so that results can be compared directly.
+ */
+class PageModel {
+
+public:
+
+  struct Chunk {
+    std::vector<bool> used;
+    bool              alive    = false;
+    bool              disabled = false;
+  };
+
+  struct Allocation {
+    uint32_t index;
+    uint32_t count;
+  };
+
+  std::vector<Chunk>      chunks;
+  std::vector<Allocation> allocations;
+
+  void addChunk(uint32_t chunkIndex, uint32_t pageCount) {
+    if (chunkIndex >= chunks.size())
+      chunks.resize(chunkIndex + 1u);
+
+    auto& chunk = chunks[chunkIndex];
+    chunk.used.assign(pageCount, false);
+    chunk.alive = true;
+    chunk.disabled = false;
+  }
+
+  uint32_t pagesUsed(uint32_t chunkIndex) const {
+    const auto& used = chunks[chunkIndex].used;
+    return uint32_t(std::count(used.begin(), used.end(), true));
+  }
+
+  /**
+   * \brief Finds the smallest free range that fits an allocation
+   *
+   * Free ranges are maximal runs of free pages within one chunk.
+   * \returns Size of the smallest fitting range, or 0 if none fits
+   */
+  uint32_t findBestFit(uint32_t count, uint32_t alignment) const {
+    uint32_t best = 0u;
+
+    for (uint32_t c = 0; c < chunks.size(); c++) {
+      const auto& chunk = chunks[c];
+
+      if (!chunk.alive || chunk.disabled)
+        continue;
+
+      uint32_t pageCount = uint32_t(chunk.used.size());
+      uint32_t start = 0u;
+
+      while (start < pageCount) {
+        if (chunk.used[start]) {
+          start += 1u;
+          continue;
+        }
+
+        uint32_t end = start;
+
+        while (end < pageCount && !chunk.used[end])
+          end += 1u;
+
+        // Alignment is in terms of global page indices
+        uint32_t base = c * MaxPageCount;
+        uint32_t first = align(base + start, alignment) - base;
+
+        if (first + count <= end && (!best || end - start < best))
+          best = end - start;
+
+        start = end;
+      }
+    }
+
+    return best;
+  }
+
+  /**
+   * \brief Computes size of the free range containing a page
+   * \returns Free range size, or 0 if the page is in use
+   */
+  uint32_t freeRangeSize(uint32_t pageIndex) const {
+    const auto& used = chunks[pageIndex / MaxPageCount].used;
+    uint32_t page = pageIndex % MaxPageCount;
+
+    if (page >= used.size() || used[page])
+      return 0u;
+
+    uint32_t start = page;
+    uint32_t end = page;
+
+    while (start > 0u && !used[start - 1u])
+      start -= 1u;
+
+    while (end < used.size() && !used[end])
+      end += 1u;
+
+    return end - start;
+  }
+
+};
+
+
+static uint32_t g_failures = 0u;
+
+static bool expect(bool condition, uint32_t iteration, const char* what) {
+  if (!condition && g_failures++ < 20u)
+    std::cerr << "Iteration " << iteration << ": " << what << std::endl;
+
+  return condition;
+}
+
+
+static void checkChunk(
+  const DxvkPageAllocator&  allocator,
+  const PageModel&          model,
+        uint32_t            chunkIndex,
+        uint32_t            iteration) {
+  const auto& chunk = model.chunks[chunkIndex];
+
+  if (!chunk.alive)
+    return;
+
+  expect(allocator.pageCount(chunkIndex) == chunk.used.size(), iteration, "Page count mismatch");
+  expect(allocator.pagesUsed(chunkIndex) == model.pagesUsed(chunkIndex), iteration, "Used page count mismatch");
+  expect(allocator.chunkIsAvailable(chunkIndex) == !chunk.disabled, iteration, "Chunk availability mismatch");
+
+  std::vector<uint32_t> mask(MaxPageCount / 32u, 0xdeadbeefu);
+  allocator.getPageAllocationMask(chunkIndex, mask.data());
+
+  for (uint32_t i = 0; i < chunk.used.size(); i++) {
+    bool used = (mask[i / 32u] >> (i % 32u)) & 1u;
+
+    if (!expect(used == chunk.used[i], iteration, "Page allocation mask mismatch"))
+      break;
+  }
+}
+
+
+static void testInvalidChunks() {
+  DxvkPageAllocator allocator;
+
+  for (uint64_t size : { uint64_t(0u), DxvkPageAllocator::PageSize - 1u, DxvkPageAllocator::MaxChunkSize + 1u }) {
+    bool threw = false;
+
+    try {
+      allocator.addChunk(size);
+    } catch (const DxvkError&) {
+      threw = true;
+    }
+
+    expect(threw, 0u, "Invalid chunk size accepted");
+  }
+
+  expect(allocator.chunkCount() == 0u, 0u, "Invalid chunk added");
+}
+
+
+static void testRandom(uint32_t seed) {
+  DxvkPageAllocator allocator;
+  PageModel model;
+
+  std::mt19937 rng(seed);
+
+  for (uint32_t pageCount : { MaxPageCount, MaxPageCount / 2u + 3u })
+    model.addChunk(allocator.addChunk(uint64_t(pageCount) * DxvkPageAllocator::PageSize), pageCount);
+
+  auto random = [&rng] (uint32_t lo, uint32_t hi) {
+    return std::uniform_int_distribution<uint32_t>(lo, hi)(rng);
+  };
+
+  for (uint32_t i = 0; i < Iterations && !g_failures; i++) {
+    uint32_t op = random(0u, 99u);
+
+    if (op < 55u) {
+      // Mostly small allocations with the occasional large one
+      uint32_t alignment = 1u << random(0u, 4u);
+      uint32_t count = random(0u, 7u) ? random(1u, 16u) : random(1u, MaxPageCount);
+      count = align(count, alignment);
+
+      if (count > MaxPageCount)
+        count -= alignment;
+
+      uint32_t bestFit = model.findBestFit(count, alignment);
+      int32_t pageIndex = allocator.allocPages(count, alignment);
+
+      if (pageIndex < 0) {
+        expect(!bestFit, i, "Allocation failed even though a free range fits");
+        continue;
+      }
+
+      uint32_t page = uint32_t(pageIndex);
+      uint32_t chunkIndex = page / MaxPageCount;
+      uint32_t first = page % MaxPageCount;
+
+      if (!expect(chunkIndex < model.chunks.size() && model.chunks[chunkIndex].alive, i, "Allocation in invalid chunk")
+       || !expect(!model.chunks[chunkIndex].disabled, i, "Allocation in disabled chunk")
+       || !expect(!(page % alignment), i, "Allocation misaligned")
+       || !expect(first + count <= model.chunks[chunkIndex].used.size(), i, "Allocation crosses chunk end"))
+        continue;
+
+      auto& used = model.chunks[chunkIndex].used;
+
+      bool overlaps = false;
+
+      for (uint32_t j = first; j < first + count; j++)
+        overlaps |= used[j];
+
+      if (!expect(!overlaps, i, "Allocation overlaps used pages"))
+        continue;
+
+      expect(model.freeRangeSize(page) == bestFit, i, "Allocation not taken from the best fitting range");
+
+      for (uint32_t j = first; j < first + count; j++)
+        used[j] = true;
+
+      model.allocations.push_back({ page, count });
+    } else if (op < 95u) {
+      if (model.allocations.empty())
+        continue;
+
+      uint32_t index = random(0u, uint32_t(model.allocations.size()) - 1u);
+      auto allocation = model.allocations[index];
+
+      model.allocations[index] = model.allocations.back();
+      model.allocations.pop_back();
+
+      uint32_t chunkIndex = allocation.index / MaxPageCount;
+      uint32_t first = allocation.index % MaxPageCount;
+
+      for (uint32_t j = first; j < first + allocation.count; j++)
+        model.chunks[chunkIndex].used[j] = false;
+
+      bool chunkEmpty = allocator.freePages(allocation.index, allocation.count);
+      expect(chunkEmpty == !model.pagesUsed(chunkIndex), i, "Chunk empty status mismatch");
+    } else if (op < 97u) {
+      // Add a new chunk with a random size, which may
+      // reuse the index of a previously removed chunk
+      uint32_t alive = 0u;
+
+      for (const auto& chunk : model.chunks)
+        alive += chunk.alive ? 1u : 0u;
+
+      if (alive >= MaxChunkCount)
+        continue;
+
+      uint32_t pageCount = random(0u, 1u) ? MaxPageCount : random(1u, MaxPageCount);
+      uint32_t chunkIndex = allocator.addChunk(uint64_t(pageCount) * DxvkPageAllocator::PageSize);
+
+      if (!expect(chunkIndex >= model.chunks.size() || !model.chunks[chunkIndex].alive, i, "Chunk index reused while alive"))
+        continue;
+
+      model.addChunk(chunkIndex, pageCount);
+    } else if (op < 98u) {
+      // Remove an arbitrary unused chunk
+      for (uint32_t c = 0; c < model.chunks.size(); c++) {
+        if (model.chunks[c].alive && !model.pagesUsed(c)) {
+          allocator.removeChunk(c);
+          model.chunks[c].alive = false;
+          break;
+        }
+      }
+    } else if (op < 99u) {
+      uint32_t c = random(0u, uint32_t(model.chunks.size()));
+
+      if (c < model.chunks.size() && model.chunks[c].alive) {
+        allocator.killChunk(c);
+        model.chunks[c].disabled = true;
+      }
+    } else {
+      uint32_t revived = allocator.reviveChunks();
+      uint32_t expected = 0u;
+
+      for (auto& chunk : model.chunks) {
+        if (chunk.alive && chunk.disabled) {
+          chunk.disabled = false;
+          expected += 1u;
+        }
+      }
+
+      expect(revived == expected, i, "Revived chunk count mismatch");
+    }
+
+    if (!(i % 64u)) {
+      for (uint32_t c = 0; c < model.chunks.size(); c++)
+        checkChunk(allocator, model, c, i);
+    }
+  }
+
+  // Free everything and make sure all chunks become empty
+  for (const auto& allocation : model.allocations) {
+    uint32_t chunkIndex = allocation.index / MaxPageCount;
+    uint32_t first = allocation.index % MaxPageCount;
+
+    for (uint32_t j = first; j < first + allocation.count; j++)
+      model.chunks[chunkIndex].used[j] = false;
+
+    bool chunkEmpty = allocator.freePages(allocation.index, allocation.count);
+    expect(chunkEmpty == !model.pagesUsed(chunkIndex), Iterations, "Chunk empty status mismatch");
+  }
+
+  for (uint32_t c = 0; c < model.chunks.size(); c++)
+    checkChunk(allocator, model, c, Iterations);
+
+  // Free ranges must have been merged, so each chunk must be able to
+  // serve one allocation covering all of its pages again. Disable all
+  // other chunks so that the allocation has to come from this one.
+  for (uint32_t c = 0; c < model.chunks.size(); c++) {
+    if (!model.chunks[c].alive)
+      continue;
+
+    for (uint32_t k = 0; k < model.chunks.size(); k++) {
+      if (model.chunks[k].alive && k != c)
+        allocator.killChunk(k);
+    }
+
+    allocator.reviveChunk(c);
+
+    uint32_t pageCount = uint32_t(model.chunks[c].used.size());
+    int32_t pageIndex = allocator.allocPages(pageCount, 1u);
+
+    if (expect(pageIndex == int32_t(c * MaxPageCount), Iterations, "Free ranges not merged"))
+      expect(allocator.freePages(uint32_t(pageIndex), pageCount), Iterations, "Chunk not empty after freeing");
+
+    allocator.reviveChunks();
+  }
+}
+
+
+int main() {
+  testInvalidChunks();
+
+  for (uint32_t seed = 1u; seed <= 4u; seed++)
+    testRandom(seed);
+
+  if (g_failures) {
+    std::cerr << g_failures << " checks failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "All checks passed" << std::endl;
+  return 0;
+}
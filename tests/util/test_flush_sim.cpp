@@ -0,0 +1,253 @@
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../../src/util/util_flush.h"
+#include "../../src/util/util_gpu_idle.h"
+
+using namespace dxvk;
+
+using us = std::chrono::microseconds;
+
+/**
+ * Virtual clock to drive the GPU idle predictor with
+ */
+struct VirtualClock {
+  using rep        = int64_t;
+  using period     = std::micro;
+  using duration   = us;
+  using time_point = std::chrono::time_point<VirtualClock, duration>;
+
+  static constexpr bool is_steady = true;
+};
+
+/**
+ * Simulates a context that records GPU commands in chunks, with
+ * a GPU that executes submissions in order, and feeds the same
+ * state into GpuFlushTracker that the D3D9 and D3D11 frontends
+ * do. All times are virtual, so results are reproducible.
+ */
+struct Workload {
+  const char* name;
+  /// CPU time to record one chunk
+  us          chunkCpuTime;
+  /// GPU time to execute one chunk
+  us          chunkGpuTime;
+  /// Emit a synchronization point every n chunks, 0 for never.
+  /// The CPU waits for all prior work to complete after each one.
+  uint32_t    syncInterval;
+  /// Emit an explicit flush every n chunks, i.e. present
+  uint32_t    frameInterval;
+};
+
+struct Strategy {
+  const char* name;
+  /// Whether to pass the predicted GPU busy time to the flush
+  /// tracker. Otherwise, a constant value is passed that makes
+  /// it rely solely on the number of pending submissions.
+  bool        usePrediction;
+};
+
+struct Stats {
+  uint64_t    submissions = 0u;
+  us          totalTime   = us(0);
+  us          gpuIdleTime = us(0);
+  us          syncStall   = us(0);
+};
+
+constexpr uint32_t ChunkCount = 20000u;
+
+/// Fixed CPU and GPU overhead per submission
+constexpr us SubmitCpuOverhead = us(30);
+constexpr us SubmitGpuOverhead = us(10);
+
+/// Time between two query polls while the application spins
+constexpr us SpinInterval = us(50);
+
+
+class GpuModel {
+
+public:
+
+  /// Submits work at the given time, returns submission ID
+  uint64_t submit(us now, us gpuTime) {
+    us start = std::max(now, m_busyUntil);
+    m_gpuIdleTime += start - m_busyUntil;
+    m_busyUntil = start + gpuTime + SubmitGpuOverhead;
+    m_submissions.push_back({ now, m_busyUntil });
+
+    m_predictor.notifySubmit(VirtualClock::time_point(now));
+    return ++m_submitted;
+  }
+
+  /// Retires submissions that completed before the given time
+  /// and returns the last completed submission ID
+  uint64_t update(us now) {
+    while (!m_submissions.empty() && m_submissions.front().completion <= now) {
+      Submission submission = m_submissions.front();
+      m_submissions.pop_front();
+
+      m_predictor.notifyCompletion(
+        VirtualClock::time_point(submission.submit),
+        VirtualClock::time_point(submission.completion));
+      m_completed += 1u;
+    }
+
+    return m_completed;
+  }
+
+  us predictBusyTime(us now) const {
+    return std::max(us(0), m_predictor.predictIdleTime() - VirtualClock::time_point(now));
+  }
+
+  us busyUntil() const {
+    return m_busyUntil;
+  }
+
+  us idleTime() const {
+    return m_gpuIdleTime;
+  }
+
+private:
+
+  us m_busyUntil      = us(0);
+  us m_gpuIdleTime    = us(0);
+
+  GpuIdlePredictor<VirtualClock> m_predictor;
+
+  uint64_t m_submitted = 0u;
+  uint64_t m_completed = 0u;
+
+  struct Submission {
+    us submit;
+    us completion;
+  };
+
+  std::deque<Submission> m_submissions;
+
+};
+
+
+static Stats runWorkload(
+  const Workload& workload,
+  const Strategy& strategy) {
+  GpuFlushTracker tracker(GpuFlushType::ImplicitWeakHint);
+  GpuModel gpu;
+  Stats stats;
+
+  us now = us(0);
+  us pendingGpuTime = us(0);
+
+  uint64_t chunkId = 0u;
+
+  auto flush = [&] () {
+    if (chunkId == 0u || pendingGpuTime == us(0))
+      return;
+
+    uint64_t submissionId = gpu.submit(now, pendingGpuTime);
+    tracker.notifyFlush(chunkId, submissionId);
+
+    now += SubmitCpuOverhead;
+    pendingGpuTime = us(0);
+    stats.submissions += 1u;
+  };
+
+  for (uint32_t i = 1u; i <= ChunkCount; i++) {
+    now += workload.chunkCpuTime;
+    pendingGpuTime += workload.chunkGpuTime;
+    chunkId += 1u;
+
+    uint64_t lastComplete = gpu.update(now);
+
+    auto busyTime = strategy.usePrediction
+      ? high_resolution_clock::duration(gpu.predictBusyTime(now))
+      : high_resolution_clock::duration(std::chrono::milliseconds(1));
+
+    if (workload.frameInterval && !(i % workload.frameInterval)) {
+      flush();
+    } else if (workload.syncInterval && !(i % workload.syncInterval)) {
+      // The application spins on a query until the GPU has caught
+      // up, and the frontend considers a flush on every iteration
+      us spinStart = now;
+
+      while (pendingGpuTime != us(0)) {
+        if (tracker.considerFlush(GpuFlushType::ImplicitSynchronization, chunkId, lastComplete, busyTime)) {
+          flush();
+          break;
+        }
+
+        now += SpinInterval;
+        lastComplete = gpu.update(now);
+
+        if (strategy.usePrediction)
+          busyTime = gpu.predictBusyTime(now);
+      }
+
+      now = std::max(now, gpu.busyUntil());
+      stats.syncStall += now - spinStart;
+    } else {
+      if (tracker.considerFlush(GpuFlushType::ImplicitWeakHint, chunkId, lastComplete, busyTime))
+        flush();
+    }
+  }
+
+  flush();
+
+  stats.totalTime = std::max(now, gpu.busyUntil());
+  stats.gpuIdleTime = gpu.idleTime() + (stats.totalTime - gpu.busyUntil());
+  return stats;
+}
+
+
+int main(int argc, char** argv) {
+  std::vector<Workload> workloads = {
+    { "cpu-bound",    us(40), us(15),  0u, 200u },
+    { "gpu-bound",    us(15), us(40),  0u, 200u },
+    { "balanced",     us(25), us(25),  0u, 200u },
+    { "cpu-sync",     us(40), us(15), 50u, 200u },
+    { "gpu-sync",     us(15), us(40), 50u, 200u },
+  };
+
+  std::vector<Strategy> strategies = {
+    { "pending-only", false },
+    { "predicted",    true  },
+  };
+
+  std::cout << std::left
+    << std::setw(12) << "workload"
+    << std::setw(16) << "strategy"
+    << std::right
+    << std::setw(8)  << "submits"
+    << std::setw(12) << "total(ms)"
+    << std::setw(12) << "idle(ms)"
+    << std::setw(12) << "stall(ms)"
+    << std::endl;
+
+  bool success = true;
+
+  for (const auto& workload : workloads) {
+    for (const auto& strategy : strategies) {
+      Stats stats = runWorkload(workload, strategy);
+
+      std::cout << std::left
+        << std::setw(12) << workload.name
+        << std::setw(16) << strategy.name
+        << std::right << std::fixed << std::setprecision(1)
+        << std::setw(8)  << stats.submissions
+        << std::setw(12) << double(stats.totalTime.count()) / 1000.0
+        << std::setw(12) << double(stats.gpuIdleTime.count()) / 1000.0
+        << std::setw(12) << double(stats.syncStall.count()) / 1000.0
+        << std::endl;
+
+      // Every frame must at least be submitted once
+      if (stats.submissions < ChunkCount / workload.frameInterval) {
+        std::cerr << "Too few submissions" << std::endl;
+        success = false;
+      }
+    }
+  }
+
+  return success ? 0 : 1;
+}
@@ -0,0 +1,138 @@
+#include <cstdint>
+#include <iostream>
+
+#include "../../src/util/util_gpu_idle.h"
+
+using namespace dxvk;
+
+using us = std::chrono::microseconds;
+
+struct VirtualClock {
+  using rep        = int64_t;
+  using period     = std::micro;
+  using duration   = us;
+  using time_point = std::chrono::time_point<VirtualClock, duration>;
+
+  static constexpr bool is_steady = true;
+};
+
+using Predictor = GpuIdlePredictor<VirtualClock>;
+using TimePoint = VirtualClock::time_point;
+
+static uint32_t g_failures = 0u;
+
+
+static void expect(bool condition, const char* test, const char* what) {
+  if (!condition) {
+    std::cerr << test << ": " << what << std::endl;
+    g_failures += 1u;
+  }
+}
+
+
+static TimePoint at(int64_t time) {
+  return TimePoint(us(time));
+}
+
+
+static void testInitialState() {
+  Predictor predictor;
+
+  expect(predictor.predictIdleTime() == at(0), "initial", "prediction not at epoch");
+  expect(predictor.averageTime() == us(0), "initial", "average not zero");
+  expect(predictor.pendingCount() == 0u, "initial", "pending count not zero");
+}
+
+
+static void testSteadyWork() {
+  Predictor predictor;
+
+  // Submissions that take 800us each on an otherwise idle GPU
+  for (int64_t i = 0; i < 64; i++) {
+    predictor.notifySubmit(at(i * 1000));
+    predictor.notifyCompletion(at(i * 1000), at(i * 1000 + 800));
+  }
+
+  us average = predictor.averageTime();
+
+  expect(average > us(790) && average <= us(800), "steady", "average did not converge");
+  expect(predictor.pendingCount() == 0u, "steady", "pending count not zero");
+  expect(predictor.predictIdleTime() == at(63 * 1000 + 800), "steady", "idle GPU not predicted idle at last completion");
+}
+
+
+static void testBusyGpu() {
+  Predictor predictor;
+
+  // Both are submitted at the same time, so the second one
+  // can only have started when the first one completed.
+  predictor.notifySubmit(at(0));
+  predictor.notifySubmit(at(0));
+
+  expect(predictor.pendingCount() == 2u, "busy", "pending count not two");
+
+  predictor.notifyCompletion(at(0), at(800));
+  expect(predictor.averageTime() == us(100), "busy", "first execution time not 800us");
+
+  predictor.notifyCompletion(at(0), at(1600));
+  expect(predictor.averageTime() == us(187), "busy", "second execution time not measured from previous completion");
+}
+
+
+static void testEarlyCompletion() {
+  Predictor predictor;
+
+  // A completion reported before the submission, e.g. due to clock
+  // granularity, must not produce a negative execution time
+  predictor.notifySubmit(at(1000));
+  predictor.notifyCompletion(at(1000), at(900));
+
+  expect(predictor.averageTime() == us(0), "early", "execution time not clamped to zero");
+  expect(predictor.predictIdleTime() == at(900), "early", "prediction not at completion time");
+}
+
+
+static void testPendingWork() {
+  Predictor predictor;
+
+  for (int64_t i = 0; i < 8; i++)
+    predictor.notifySubmit(at(0));
+
+  predictor.notifyCompletion(at(0), at(800));
+
+  // Remaining submissions are assumed to take the average time each
+  expect(predictor.pendingCount() == 7u, "pending", "pending count not seven");
+  expect(predictor.predictIdleTime() == at(800) + 7 * predictor.averageTime(), "pending", "prediction not completion plus pending work");
+
+  // Submitting more work while the GPU is predicted to be
+  // busy extends the prediction by the average time
+  TimePoint before = predictor.predictIdleTime();
+  predictor.notifySubmit(at(900));
+
+  expect(predictor.predictIdleTime() == before + predictor.averageTime(), "pending", "submission did not extend prediction");
+
+  // Submitting work after the predicted idle time starts from the submission
+  Predictor idle;
+  idle.notifySubmit(at(0));
+  idle.notifyCompletion(at(0), at(800));
+  idle.notifySubmit(at(5000));
+
+  expect(idle.predictIdleTime() == at(5000) + idle.averageTime(), "pending", "submission to idle GPU not predicted from submission time");
+}
+
+
+int main() {
+  testInitialState();
+  testSteadyWork();
+  testBusyGpu();
+  testEarlyCompletion();
+  testPendingWork();
+
+  if (g_failures) {
+    std::cerr << g_failures << " checks failed" << std::endl;
+    return 1;
+  }
+
+  std::cout << "All checks passed" << std::endl;
+  return 0;
+}
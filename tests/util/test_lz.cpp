@@ -0,0 +1,135 @@
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../../src/util/util_lz.h"
+
+using namespace dxvk;
+
+constexpr size_t DataSize   = 16u << 20;
+constexpr size_t Iterations = 8u;
+
+struct DataSet {
+  const char*           name;
+  std::vector<uint8_t>  data;
+  bool                  compressible;
+};
+
+
+// Simple LCG so that results are reproducible across platforms
+static uint32_t random(uint32_t& seed) {
+  seed = seed * 1664525u + 1013904223u;
+  return seed >> 8;
+}
+
+
+static std::vector<DataSet> createDataSets() {
+  std::vector<DataSet> sets;
+
+  DataSet gradient = { "rgba-gradient", std::vector<uint8_t>(DataSize), true };
+  DataSet dxt      = { "dxt1-like",     std::vector<uint8_t>(DataSize), true };
+  DataSet noise    = { "noise",         std::vector<uint8_t>(DataSize), false };
+
+  uint32_t seed = 0x12345678u;
+
+  // 1024 pixels per row, with smooth gradients in each channel
+  for (size_t i = 0; i < DataSize / 4u; i++) {
+    uint32_t x = i % 1024u;
+    uint32_t y = i / 1024u;
+
+    gradient.data[4u * i + 0u] = uint8_t(x / 4u);
+    gradient.data[4u * i + 1u] = uint8_t(y / 4u);
+    gradient.data[4u * i + 2u] = uint8_t((x + y) / 8u);
+    gradient.data[4u * i + 3u] = 0xffu;
+  }
+
+  // Blocks with a small set of endpoint colors that repeat
+  // often, and mostly random interpolation indices
+  for (size_t i = 0; i < DataSize / 8u; i++) {
+    uint32_t endpoints = 0x1f3c7b20u + (random(seed) % 16u) * 0x00410041u;
+    uint32_t indices = (i % 4u) ? random(seed) : 0u;
+
+    std::memcpy(&dxt.data[8u * i + 0u], &endpoints, 4u);
+    std::memcpy(&dxt.data[8u * i + 4u], &indices, 4u);
+  }
+
+  for (size_t i = 0; i < DataSize; i++)
+    noise.data[i] = uint8_t(random(seed));
+
+  sets.push_back(std::move(gradient));
+  sets.push_back(std::move(dxt));
+  sets.push_back(std::move(noise));
+  return sets;
+}
+
+
+static bool runDataSet(const DataSet& set) {
+  using clock = std::chrono::high_resolution_clock;
+
+  // Use the same output budget as D3D9Memory::Compress
+  std::vector<uint8_t> compressed((set.data.size() / 4u) * 3u);
+  std::vector<uint8_t> decompressed(set.data.size());
+
+  size_t compressedSize = 0u;
+  bool success = true;
+
+  auto t0 = clock::now();
+
+  for (size_t i = 0; i < Iterations; i++)
+    compressedSize = lz::compress(compressed.data(), compressed.size(), set.data.data(), set.data.size());
+
+  auto t1 = clock::now();
+
+  if (compressedSize) {
+    for (size_t i = 0; i < Iterations && success; i++)
+      success = lz::decompress(decompressed.data(), decompressed.size(), compressed.data(), compressedSize);
+  }
+
+  auto t2 = clock::now();
+
+  double mb = double(set.data.size() * Iterations) / double(1u << 20);
+  double compressTime = std::chrono::duration<double>(t1 - t0).count();
+  double decompressTime = std::chrono::duration<double>(t2 - t1).count();
+
+  std::cout << std::left
+    << std::setw(16) << set.name
+    << std::right << std::fixed << std::setprecision(1)
+    << std::setw(10) << (compressedSize ? 100.0 * double(compressedSize) / double(set.data.size()) : 100.0)
+    << std::setw(12) << mb / compressTime
+    << std::setw(12) << (compressedSize ? mb / decompressTime : 0.0)
+    << std::endl;
+
+  if (!success || (compressedSize && decompressed != set.data)) {
+    std::cerr << set.name << ": Round trip failed" << std::endl;
+    return false;
+  }
+
+  if (bool(compressedSize) != set.compressible) {
+    std::cerr << set.name << ": Unexpected compression result" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+
+int main(int argc, char** argv) {
+  std::vector<DataSet> sets = createDataSets();
+
+  std::cout << std::left
+    << std::setw(16) << "data"
+    << std::right
+    << std::setw(10) << "ratio(%)"
+    << std::setw(12) << "comp(MB/s)"
+    << std::setw(12) << "dec(MB/s)"
+    << std::endl;
+
+  bool success = true;
+
+  for (const auto& set : sets)
+    success &= runDataSet(set);
+
+  return success ? 0 : 1;
+}